@@ -5303,6 +5303,57 @@ class DWindows : AppCompatActivity() {
         return retval
     }
 
+    fun containerGetQueryRow(cont: ListView, flags: Int, after: Int): Int
+    {
+        var retval: Int = -1
+
+        waitOnUiThread {
+            val adapter: DWContainerAdapter = cont.adapter as DWContainerAdapter
+
+            // Handle DW_CRA_SELECTED
+            if((flags and 1) != 0) {
+                val checked: SparseBooleanArray = onlyBooleanArray(cont.checkedItemPositions, true)
+
+                // Find the first selected position after the last one returned
+                for (i in 0 until checked.size()) {
+                    val position: Int = checked.keyAt(i)
+
+                    if (position > after) {
+                        retval = position
+                        break
+                    }
+                }
+            } else if (after + 1 < adapter.model.rowtitle.size) {
+                retval = after + 1
+            }
+        }
+        return retval
+    }
+
+    fun containerGetRowTitle(cont: ListView, row: Int): String?
+    {
+        var retval: String? = null
+
+        waitOnUiThread {
+            val adapter: DWContainerAdapter = cont.adapter as DWContainerAdapter
+
+            retval = adapter.model.getRowTitle(row)
+        }
+        return retval
+    }
+
+    fun containerGetRowData(cont: ListView, row: Int): Long
+    {
+        var retval: Long = 0
+
+        waitOnUiThread {
+            val adapter: DWContainerAdapter = cont.adapter as DWContainerAdapter
+
+            retval = adapter.model.getRowData(row)
+        }
+        return retval
+    }
+
     fun containerAddColumn(cont: ListView, title: String, flags: Int)
     {
         waitOnUiThread {
@@ -145,6 +145,10 @@ extern "C" {
 #define _DW_SIZE_STATIC 0
 #define _DW_SIZE_EXPAND 1
 
+/* Box layout state, cleared when the box or anything in it changes */
+#define _DW_LAYOUT_MEASURED   1
+#define _DW_LAYOUT_PLACED     (1 << 1)
+
 typedef struct _user_data
 {
    struct _user_data *next;
@@ -219,6 +223,7 @@ typedef struct _user_data
 #define DW_CRA_CURSORED          CRA_CURSORED
 
 #define DW_CR_RETDATA            (1 << 10)
+#define DW_CR_RETINDEX           (1 << 11)
 
 #define DW_LS_MULTIPLESEL        LS_MULTIPLESEL
 
@@ -472,6 +477,7 @@ void _dw_pool_drain(void);
 #define DW_CRA_CURSORED          (1 << 1)
 
 #define DW_CR_RETDATA            (1 << 10)
+#define DW_CR_RETINDEX           (1 << 11)
 
 #define DW_LS_MULTIPLESEL        1
 
@@ -654,6 +660,7 @@ void _dw_pool_drain(void);
 #define DW_CRA_CURSORED          LVNI_FOCUSED
 
 #define DW_CR_RETDATA            (1 << 10)
+#define DW_CR_RETINDEX           (1 << 11)
 
 #define DW_LS_MULTIPLESEL        LBS_MULTIPLESEL
 
@@ -853,6 +860,7 @@ typedef struct _hpixmap {
 #define DW_CRA_CURSORED          (1 << 1)
 
 #define DW_CR_RETDATA            (1 << 10)
+#define DW_CR_RETINDEX           (1 << 11)
 
 #define DW_LS_MULTIPLESEL        1
 
@@ -1013,6 +1021,12 @@ typedef struct _hpixmap {
    unsigned long width, height;
    /* ?? *pixmap; */
    HWND handle;
+#ifdef __HEADLESS__
+   /* 32bit ARGB pixel buffer */
+   unsigned int *pixels;
+   char *font;
+   unsigned long transcolor;
+#endif
 } *HPIXMAP;
 
 #define DW_DT_LEFT               0
@@ -1068,12 +1082,17 @@ typedef struct _hpixmap {
 #define DW_CRA_CURSORED          (1 << 1)
 
 #define DW_CR_RETDATA            (1 << 10)
+#define DW_CR_RETINDEX           (1 << 11)
 
 #define DW_LS_MULTIPLESEL        1
 
 #define DW_LIT_NONE              -1
 
+#ifdef __HEADLESS__
+#define DW_MLE_CASESENSITIVE    1
+#else
 #define DW_MLE_CASESENSITIVE    0
+#endif
 
 #define DW_BS_NOBORDER           0
 
@@ -1203,6 +1222,14 @@ typedef struct _box {
    UserData *root;
    HWND hwndtitle, hwnd;
    int titlebar;
+#elif defined(__HEADLESS__)
+   /* Structure of arrays copy of the item sizes, kept in
+    * step with items so the measure pass can stream them.
+    */
+   int *itemwidth, *itemheight, *itempad;
+   unsigned char *itemflags;
+   /* Number of items in this box and the boxes packed in it */
+   int itemtotal;
 #endif
    /* Number of items in the box */
    int count;
@@ -1224,6 +1251,12 @@ typedef struct _box {
    unsigned long flags;
    /* Array of item structures */
    struct _item *items;
+   /* Number of item structures allocated in items */
+   int alloc;
+   /* Layout state flags (_DW_LAYOUT_*) */
+   int layout;
+   /* Size the box contents were last placed at */
+   int placedwidth, placedheight;
 } Box;
 
 #else
@@ -1310,6 +1343,7 @@ extern "C" {
 #define DW_CRA_CURSORED          (1 << 1)
 
 #define DW_CR_RETDATA            (1 << 10)
+#define DW_CR_RETINDEX           (1 << 11)
 
 #define DW_LS_MULTIPLESEL        1
 
@@ -1693,6 +1727,14 @@ typedef struct _dwexpose {
    int width, height;
 } DWExpose;
 
+/* Handler timings returned by dw_signal_stats_get() */
+typedef struct _dwsignalstats {
+   /* Number of handler calls and how many took longer than the threshold */
+   unsigned long count, slow;
+   /* Total and longest time in milliseconds */
+   double total, max;
+} DWSignalStats;
+
 typedef struct _dwdialog {
    HEV eve;
    int done;
@@ -1704,6 +1746,7 @@ typedef struct _dwdialog {
 } DWDialog;
 
 typedef void *HPRINT;
+typedef void *HCONTITER;
 
 #define DW_SIGNAL_FUNC(a) ((void *)a)
 
@@ -1746,6 +1789,17 @@ typedef void *HPRINT;
 #define DW_SCROLL_TOP 2
 #define DW_SCROLL_BOTTOM 3
 
+/* Container sorting constants */
+#define DW_SORT_ASCENDING 0
+#define DW_SORT_DESCENDING 1
+
+/* Container filter flags */
+#define DW_FILTER_CASESENSITIVE 1
+
+/* Tree lazy population flags */
+#define DW_TREE_LAZY 1
+#define DW_TREE_LAZY_DROP 2
+
 /* return values for dw_messagebox() */
 #define DW_MB_RETURN_OK           0
 #define DW_MB_RETURN_YES          1
@@ -1816,6 +1870,10 @@ typedef void *HPRINT;
 #define DW_MLE_COMPLETE_DASH      (1 << 1)
 #define DW_MLE_COMPLETE_QUOTE     (1 << 2)
 
+/* dw_trace_dump() flags */
+#define DW_TRACE_DUMP_JSON      1
+#define DW_TRACE_DUMP_RESET     (1 << 1)
+
 /* Library feature constants */
 #define DW_FEATURE_UNSUPPORTED  -1
 #define DW_FEATURE_DISABLED     0
@@ -1842,6 +1900,10 @@ typedef enum
     DW_FEATURE_CONTAINER_MODE,          /* Supports alternate container view modes */
     DW_FEATURE_HTML_MESSAGE,            /* Supports the DW_SIGNAL_HTML_MESSAGE callback */
     DW_FEATURE_RENDER_SAFE,             /* Supports render safe drawing mode, limited to expose */
+    DW_FEATURE_TEXT_CACHE,              /* Supports caching shaped text layouts in dw_draw_text() */
+    DW_FEATURE_PARALLEL_LAYOUT,         /* Supports measuring large box layouts on worker threads */
+    DW_FEATURE_TRACE,                   /* Supports recording API call counts and latencies */
+    DW_FEATURE_SIGNAL_PROFILE,          /* Supports timing signal handlers and reporting slow ones */
     DW_FEATURE_MAX
 } DWFEATURE;
 
@@ -1982,6 +2044,8 @@ int API dw_window_raise(HWND handle);
 int API dw_window_lower(HWND handle);
 int API dw_window_destroy(HWND handle);
 void API dw_window_redraw(HWND handle);
+int API dw_window_layout_freeze(HWND handle);
+int API dw_window_layout_thaw(HWND handle);
 int API dw_window_set_font(HWND handle, const char *fontname);
 char * API dw_window_get_font(HWND handle);
 int API dw_window_set_color(HWND handle, unsigned long fore, unsigned long back);
@@ -2015,6 +2079,9 @@ HWND API dw_listbox_new(unsigned long id, int multi);
 void API dw_listbox_append(HWND handle, const char *text);
 void API dw_listbox_insert(HWND handle, const char *text, int pos);
 void API dw_listbox_list_append(HWND handle, char **text, int count);
+int API dw_listbox_set_virtual(HWND handle, int count, void *textfunc, void *data);
+void API dw_listbox_freeze(HWND handle);
+void API dw_listbox_thaw(HWND handle);
 void API dw_listbox_clear(HWND handle);
 int API dw_listbox_count(HWND handle);
 void API dw_listbox_set_top(HWND handle, int top);
@@ -2055,6 +2122,8 @@ void API dw_window_default(HWND window, HWND defaultitem);
 void API dw_window_click_default(HWND window, HWND next);
 unsigned int API dw_mle_import(HWND handle, const char *buffer, int startpoint);
 void API dw_mle_export(HWND handle, char *buffer, int startpoint, int length);
+int API dw_mle_import_stream(HWND handle, void *readfunc, void *data);
+int API dw_mle_export_stream(HWND handle, void *writefunc, void *data);
 void API dw_mle_get_size(HWND handle, unsigned long *bytes, unsigned long *lines);
 void API dw_mle_delete(HWND handle, int startpoint, int length);
 void API dw_mle_clear(HWND handle);
@@ -2074,11 +2143,15 @@ int API dw_checkbox_get(HWND handle);
 void API dw_checkbox_set(HWND handle, int value);
 HTREEITEM API dw_tree_insert(HWND handle, const char *title, HICN icon, HTREEITEM parent, void *itemdata);
 HTREEITEM API dw_tree_insert_after(HWND handle, HTREEITEM item, const char *title, HICN icon, HTREEITEM parent, void *itemdata);
+int API dw_tree_insert_many(HWND handle, HTREEITEM parent, int count, char **titles, HICN *icons, void **itemdata, HTREEITEM *items);
 void API dw_tree_clear(HWND handle);
+void API dw_tree_freeze(HWND handle);
+void API dw_tree_thaw(HWND handle);
 void API dw_tree_item_delete(HWND handle, HTREEITEM item);
 void API dw_tree_item_change(HWND handle, HTREEITEM item, const char *title, HICN icon);
 void API dw_tree_item_expand(HWND handle, HTREEITEM item);
 void API dw_tree_item_collapse(HWND handle, HTREEITEM item);
+int API dw_tree_item_set_lazy(HWND handle, HTREEITEM item, int flags);
 void API dw_tree_item_select(HWND handle, HTREEITEM item);
 void API dw_tree_item_set_data(HWND handle, HTREEITEM item, void *itemdata);
 void * API dw_tree_item_get_data(HWND handle, HTREEITEM item);
@@ -2087,6 +2160,7 @@ HTREEITEM API dw_tree_get_parent(HWND handle, HTREEITEM item);
 int API dw_container_setup(HWND handle, unsigned long *flags, char **titles, int count, int separator);
 HICN API dw_icon_load(unsigned long module, unsigned long id);
 HICN API dw_icon_load_from_file(const char *filename);
+int API dw_icon_load_from_file_async(const char *filename, void *callback, void *data);
 HICN API dw_icon_load_from_data(const char *data, int len);
 void API dw_icon_free(HICN handle);
 void * API dw_container_alloc(HWND handle, int rowcount);
@@ -2102,12 +2176,21 @@ void API dw_container_clear(HWND handle, int redraw);
 void API dw_container_delete(HWND handle, int rowcount);
 char * API dw_container_query_start(HWND handle, unsigned long flags);
 char * API dw_container_query_next(HWND handle, unsigned long flags);
+void ** API dw_container_query_selected(HWND handle, unsigned long flags, int *count);
+HCONTITER API dw_container_iter_begin(HWND handle, unsigned long flags);
+int API dw_container_iter_next(HCONTITER iter, const char **title, void **data);
+void API dw_container_iter_end(HCONTITER iter);
 void API dw_container_scroll(HWND handle, int direction, long rows);
 void API dw_container_cursor(HWND handle, const char *text);
 void API dw_container_cursor_by_data(HWND handle, void *data);
 void API dw_container_delete_row(HWND handle, const char *text);
 void API dw_container_delete_row_by_data(HWND handle, void *data);
 void API dw_container_optimize(HWND handle);
+int API dw_container_sort(HWND handle, int column, int order);
+void API dw_container_set_sortable(HWND handle, int sortable);
+int API dw_container_set_filter(HWND handle, int column, const char *text, unsigned long flags);
+void API dw_container_freeze(HWND handle);
+void API dw_container_thaw(HWND handle);
 void API dw_container_set_stripe(HWND handle, unsigned long oddcolor, unsigned long evencolor);
 void API dw_filesystem_set_column_title(HWND handle, const char *title);
 int API dw_filesystem_setup(HWND handle, unsigned long *flags, char **titles, int count);
@@ -2173,12 +2256,14 @@ void API dw_draw_polygon(HWND handle, HPIXMAP pixmap, int fill, int npoints, int
 void API dw_draw_arc(HWND handle, HPIXMAP pixmap, int flags, int xorigin, int yorigin, int x1, int y1, int x2, int y2);
 void API dw_draw_text(HWND handle, HPIXMAP pixmap, int x, int y, const char *text);
 void API dw_font_text_extents_get(HWND handle, HPIXMAP pixmap, const char *text, int *width, int *height);
+void API dw_font_text_extents_get_many(HWND handle, HPIXMAP pixmap, int count, char **texts, int *widths, int *heights);
 void API dw_font_set_default(const char *fontname);
 void API dw_flush(void);
 void API dw_pixmap_bitblt(HWND dest, HPIXMAP destp, int xdest, int ydest, int width, int height, HWND src, HPIXMAP srcp, int xsrc, int ysrc);
 int API dw_pixmap_stretch_bitblt(HWND dest, HPIXMAP destp, int xdest, int ydest, int width, int height, HWND src, HPIXMAP srcp, int xsrc, int ysrc, int srcwidth, int srcheight);
 HPIXMAP API dw_pixmap_new(HWND handle, unsigned long width, unsigned long height, int depth);
 HPIXMAP API dw_pixmap_new_from_file(HWND handle, const char *filename);
+int API dw_pixmap_new_from_file_async(HWND handle, const char *filename, void *callback, void *data);
 HPIXMAP API dw_pixmap_new_from_data(HWND handle, const char *data, int len);
 HPIXMAP API dw_pixmap_grab(HWND handle, ULONG id);
 void API dw_pixmap_set_transparent_color( HPIXMAP pixmap, ULONG color );
@@ -2248,6 +2333,8 @@ wchar_t * API dw_utf8_to_wchar(const char *utf8string);
 char * API dw_wchar_to_utf8(const wchar_t *wstring);
 int API dw_feature_get(DWFEATURE feature); 
 int API dw_feature_set(DWFEATURE feature, int state); 
+int API dw_trace_dump(const char *filename, unsigned long flags);
+int API dw_signal_stats_get(const char *signame, DWSignalStats *stats);
 /* Exported for language bindings */
 void API _dw_init_thread(void);
 void API _dw_deinit_thread(void);
@@ -407,6 +407,8 @@ public:
     int Raise() { return dw_window_raise(hwnd); }
     int Lower() { return dw_window_lower(hwnd); }
     void Redraw() { dw_window_redraw(hwnd); }
+    int LayoutFreeze() { return dw_window_layout_freeze(hwnd); }
+    int LayoutThaw() { return dw_window_layout_thaw(hwnd); }
     void Default(Widget *defaultitem) { if(defaultitem) dw_window_default(hwnd, defaultitem->GetHWND()); }
     void ClickDefault(Widget *defaultitem) { if(defaultitem) dw_window_click_default(hwnd, defaultitem->GetHWND()); }
     void SetIcon(HICN icon) { dw_window_set_icon(hwnd, icon); }
@@ -852,6 +854,7 @@ public:
     int SetFont(std::string fontname) { return dw_window_set_font(hwnd, fontname.c_str()); }
     void GetTextExtents(const char *text, int *width, int *height) { dw_font_text_extents_get(hwnd, DW_NULL, text, width, height); }
     void GetTextExtents(std::string text, int *width, int *height) { dw_font_text_extents_get(hwnd, DW_NULL, text.c_str(), width, height); }
+    void GetTextExtents(int count, char **texts, int *widths, int *heights) { dw_font_text_extents_get_many(hwnd, DW_NULL, count, texts, widths, heights); }
     char *GetCFont() { return dw_window_get_font(hwnd); }
     std::string GetFont() {
         char *retval = dw_window_get_font(hwnd);
@@ -1078,6 +1081,7 @@ public:
     int SetFont(std::string fontname) { return dw_pixmap_set_font(hpixmap, fontname.c_str()); }
     void GetTextExtents(const char *text, int *width, int *height) { dw_font_text_extents_get(DW_NOHWND, hpixmap, text, width, height); }
     void GetTextExtents(std::string text, int *width, int *height) { dw_font_text_extents_get(DW_NOHWND, hpixmap, text.c_str(), width, height); }
+    void GetTextExtents(int count, char **texts, int *widths, int *heights) { dw_font_text_extents_get_many(DW_NOHWND, hpixmap, count, texts, widths, heights); }
     void SetTransparentColor(unsigned long color) { dw_pixmap_set_transparent_color(hpixmap, color); }
     unsigned long GetWidth() { return pwidth; }
     unsigned long GetHeight() { return pheight; }
@@ -1333,6 +1337,14 @@ private:
     bool ListSelectConnected;
 #ifdef DW_LAMBDA
     std::function<int(unsigned int)> _ConnectListSelect;
+    std::function<std::string(int)> _VirtualText;
+    std::string _VirtualBuffer;
+    static char *_OnVirtualText(HWND window, int index, void *data) {
+        ListBoxes *classptr = reinterpret_cast<ListBoxes *>(data);
+
+        classptr->_VirtualBuffer = classptr->_VirtualText(index);
+        return (char *)classptr->_VirtualBuffer.c_str();
+    }
 #endif
     int (*_ConnectListSelectOld)(ListBoxes *, unsigned int index);
     static int _OnListSelect(HWND window, int index, void *data) {
@@ -1350,6 +1362,8 @@ public:
     void Append(const char *text) { dw_listbox_append(hwnd, text); }
     void Append(std::string text) { dw_listbox_append(hwnd, text.c_str()); }
     void Clear() { dw_listbox_clear(hwnd); }
+    void Freeze() { dw_listbox_freeze(hwnd); }
+    void Thaw() { dw_listbox_thaw(hwnd); }
     int Count() { return dw_listbox_count(hwnd); }
     void Delete(int index) { dw_listbox_delete(hwnd, index); }
     void GetListText(unsigned int index, char *buffer, unsigned int length) { dw_listbox_get_text(hwnd, index, buffer, length); }
@@ -1384,7 +1398,14 @@ public:
     int Selected() { return dw_listbox_selected(hwnd); }
     int Selected(int where) { return dw_listbox_selected_multi(hwnd, where); }
     void SetTop(int top) { dw_listbox_set_top(hwnd, top); }
+    int SetVirtual(int count, char *(*textfunc)(HWND, int, void *), void *data) {
+        return dw_listbox_set_virtual(hwnd, count, (void *)textfunc, data);
+    }
 #ifdef DW_LAMBDA
+    int SetVirtual(int count, std::function<std::string(int)> textfunc) {
+        _VirtualText = textfunc;
+        return dw_listbox_set_virtual(hwnd, count, (void *)_OnVirtualText, this);
+    }
     void ConnectListSelect(std::function<int(unsigned int)> userfunc)
     {
         _ConnectListSelect = userfunc;
@@ -1560,6 +1581,15 @@ public:
 // Multi-line Edit widget
 class MLE : public Focusable
 {
+private:
+#ifdef DW_LAMBDA
+    static int _OnReadStream(HWND window, char *buffer, int length, void *data) {
+        return (*reinterpret_cast<std::function<int(char *, int)> *>(data))(buffer, length);
+    }
+    static int _OnWriteStream(HWND window, const char *buffer, int length, void *data) {
+        return (*reinterpret_cast<std::function<int(const char *, int)> *>(data))(buffer, length);
+    }
+#endif
 public:
     // Constructors
     MLE(unsigned long id) { SetHWND(dw_mle_new(id)); }
@@ -1583,6 +1613,12 @@ public:
     }
     int Import(const char *buffer, int startpoint) { return dw_mle_import(hwnd, buffer, startpoint); }
     int Import(std::string buffer, int startpoint) { return dw_mle_import(hwnd, buffer.c_str(), startpoint); }
+    int ImportStream(int (*readfunc)(HWND, char *, int, void *), void *data) { return dw_mle_import_stream(hwnd, (void *)readfunc, data); }
+    int ExportStream(int (*writefunc)(HWND, const char *, int, void *), void *data) { return dw_mle_export_stream(hwnd, (void *)writefunc, data); }
+#ifdef DW_LAMBDA
+    int ImportStream(std::function<int(char *, int)> readfunc) { return dw_mle_import_stream(hwnd, (void *)_OnReadStream, &readfunc); }
+    int ExportStream(std::function<int(const char *, int)> writefunc) { return dw_mle_export_stream(hwnd, (void *)_OnWriteStream, &writefunc); }
+#endif
     void GetSize(unsigned long *bytes, unsigned long *lines) { dw_mle_get_size(hwnd, bytes, lines); }
     void Search(const char *text, int point, unsigned long flags) { dw_mle_search(hwnd, text, point, flags); }
     void Search(std::string text, int point, unsigned long flags) { dw_mle_search(hwnd, text.c_str(), point, flags); }
@@ -1890,6 +1926,15 @@ public:
     void DeleteRow(void *data) { dw_container_delete_row_by_data(hwnd, data); }
     void Insert() { dw_container_insert(hwnd, allocpointer, allocrowcount); }
     void Optimize() { dw_container_optimize(hwnd); }
+    int Sort(int column, int order) { return dw_container_sort(hwnd, column, order); }
+    int Sort(int column) { return dw_container_sort(hwnd, column, DW_SORT_ASCENDING); }
+    void SetSortable(int sortable) { dw_container_set_sortable(hwnd, sortable); }
+    int SetFilter(int column, const char *text, unsigned long flags) { return dw_container_set_filter(hwnd, column, text, flags); }
+    int SetFilter(int column, std::string text, unsigned long flags) { return dw_container_set_filter(hwnd, column, text.c_str(), flags); }
+    int SetFilter(int column, const char *text) { return dw_container_set_filter(hwnd, column, text, 0); }
+    int SetFilter(int column, std::string text) { return dw_container_set_filter(hwnd, column, text.c_str(), 0); }
+    void Freeze() { dw_container_freeze(hwnd); }
+    void Thaw() { dw_container_thaw(hwnd); }
     char *QueryCNext(unsigned long flags) { return dw_container_query_next(hwnd, flags); }
     char *QueryCStart(unsigned long flags) { return dw_container_query_start(hwnd, flags); }
     std::string QueryNext(unsigned long flags) {
@@ -1900,6 +1945,51 @@ public:
         char *retval = dw_container_query_start(hwnd, flags);
         return retval ? std::string(retval) : std::string();
     }
+    void **QuerySelected(unsigned long flags, int *count) { return dw_container_query_selected(hwnd, flags, count); }
+#ifdef DW_LAMBDA
+    void ForEachSelected(std::function<void(void *)> userfunc, unsigned long flags) {
+        int count;
+        void **items = dw_container_query_selected(hwnd, flags, &count);
+
+        for(int z=0;z<count;z++)
+            userfunc(items[z]);
+        if(items)
+            dw_free(items);
+    }
+    void ForEachSelected(std::function<void(void *)> userfunc) { ForEachSelected(userfunc, DW_CRA_SELECTED | DW_CR_RETDATA); }
+#endif
+    void ForEachSelected(void (*userfunc)(Containers *, void *), unsigned long flags) {
+        int count;
+        void **items = dw_container_query_selected(hwnd, flags, &count);
+
+        for(int z=0;z<count;z++)
+            userfunc(this, items[z]);
+        if(items)
+            dw_free(items);
+    }
+    void ForEachSelected(void (*userfunc)(Containers *, void *)) { ForEachSelected(userfunc, DW_CRA_SELECTED | DW_CR_RETDATA); }
+#ifdef DW_LAMBDA
+    void ForEach(std::function<void(const char *, void *)> userfunc, unsigned long flags) {
+        HCONTITER iter = dw_container_iter_begin(hwnd, flags);
+        const char *title;
+        void *data;
+
+        while(dw_container_iter_next(iter, &title, &data))
+            userfunc(title, data);
+        dw_container_iter_end(iter);
+    }
+    void ForEach(std::function<void(const char *, void *)> userfunc) { ForEach(userfunc, 0); }
+#endif
+    void ForEach(void (*userfunc)(Containers *, const char *, void *), unsigned long flags) {
+        HCONTITER iter = dw_container_iter_begin(hwnd, flags);
+        const char *title;
+        void *data;
+
+        while(dw_container_iter_next(iter, &title, &data))
+            userfunc(this, title, data);
+        dw_container_iter_end(iter);
+    }
+    void ForEach(void (*userfunc)(Containers *, const char *, void *)) { ForEach(userfunc, 0); }
     void Scroll(int direction, long rows) { dw_container_scroll(hwnd, direction, rows); }
     void SetColumnWidth(int column, int width) { dw_container_set_column_width(hwnd, column, width); }
     void SetRowData(int row, void *data) { dw_container_set_row_data(allocpointer, row, data); }
@@ -2014,6 +2104,14 @@ public:
     void SetItem(int column, int row, void *data) { dw_filesystem_set_item(hwnd, allocpointer, column, row, data); }
 };
 
+// Describes one item for Tree::InsertMany()
+struct TreeInsertItem
+{
+    std::string title;
+    HICN icon;
+    void *data;
+};
+
 class Tree : virtual public Focusable, virtual public ObjectView
 {
 private:
@@ -2059,6 +2157,8 @@ public:
 
     // User functions
     void Clear() { dw_tree_clear(hwnd); }
+    void Freeze() { dw_tree_freeze(hwnd); }
+    void Thaw() { dw_tree_thaw(hwnd); }
     HTREEITEM GetParent(HTREEITEM item) { return dw_tree_get_parent(hwnd, item); }
     char *GetCTitle(HTREEITEM item) { return dw_tree_get_title(hwnd, item); }
     std::string GetTitle(HTREEITEM item) {
@@ -2077,9 +2177,32 @@ public:
     HTREEITEM InsertAfter(std::string title, HTREEITEM item, HICN icon, HTREEITEM parent, void *itemdata) { return dw_tree_insert_after(hwnd, item, title.c_str(), icon, parent, itemdata); }
     HTREEITEM InsertAfter(std::string title, HTREEITEM item, HICN icon, HTREEITEM parent) { return dw_tree_insert_after(hwnd, item, title.c_str(), icon, parent, NULL); }
     HTREEITEM InsertAfter(std::string title, HTREEITEM item, HICN icon) { return dw_tree_insert_after(hwnd, item, title.c_str(), icon, 0, NULL); }
+    int InsertMany(HTREEITEM parent, int count, char **titles, HICN *icons, void **itemdata, HTREEITEM *items) { return dw_tree_insert_many(hwnd, parent, count, titles, icons, itemdata, items); }
+    std::vector<HTREEITEM> InsertMany(HTREEITEM parent, const std::vector<TreeInsertItem> &items) {
+        int count = (int)items.size();
+        std::vector<HTREEITEM> handles(count);
+
+        // Convert our vector into arrays, large trees are too big for alloca()
+        if(count > 0) {
+            std::vector<const char *> titles(count);
+            std::vector<HICN> icons(count);
+            std::vector<void *> datas(count);
+
+            for(int z=0; z<count; z++) {
+                titles[z] = items[z].title.c_str();
+                icons[z] = items[z].icon;
+                datas[z] = items[z].data;
+            }
+            dw_tree_insert_many(hwnd, parent, count, (char **)&titles[0], &icons[0], &datas[0], &handles[0]);
+        }
+        return handles;
+    }
+    std::vector<HTREEITEM> InsertMany(const std::vector<TreeInsertItem> &items) { return InsertMany(0, items); }
     void Change(HTREEITEM item, const char *title, HICN icon) { dw_tree_item_change(hwnd, item, title, icon); }
     void Change(HTREEITEM item, std::string title, HICN icon) { dw_tree_item_change(hwnd, item, title.c_str(), icon); }
     void Collapse(HTREEITEM item) { dw_tree_item_collapse(hwnd, item); }
+    int SetLazy(HTREEITEM item, int flags) { return dw_tree_item_set_lazy(hwnd, item, flags); }
+    int SetLazy(HTREEITEM item) { return dw_tree_item_set_lazy(hwnd, item, DW_TREE_LAZY); }
     void Delete(HTREEITEM item) { dw_tree_item_delete(hwnd, item); }
     void Expand(HTREEITEM item) { dw_tree_item_expand(hwnd, item); }
     void *GetData(HTREEITEM item) { return dw_tree_item_get_data(hwnd, item); }
@@ -2542,10 +2665,14 @@ public:
     void Free(void *buff) { dw_free(buff); }
     int GetFeature(DWFEATURE feature) { return dw_feature_get(feature); }
     int SetFeature(DWFEATURE feature, int state) { return dw_feature_set(feature, state); }
+    int TraceDump(const char *filename, unsigned long flags) { return dw_trace_dump(filename, flags); }
+    int GetSignalStats(const char *signame, DWSignalStats *stats) { return dw_signal_stats_get(signame, stats); }
     HICN LoadIcon(unsigned long id) { return dw_icon_load(0, id); }
     HICN LoadIcon(const char *filename) { return dw_icon_load_from_file(filename); }
     HICN LoadIcon(std::string filename) { return dw_icon_load_from_file(filename.c_str()); }
     HICN LoadIcon(const char *data, int len) { return dw_icon_load_from_data(data, len); }
+    int LoadIconAsync(const char *filename, int (*func)(HICN, void *), void *data) { return dw_icon_load_from_file_async(filename, DW_SIGNAL_FUNC(func), data); }
+    int LoadIconAsync(std::string filename, int (*func)(HICN, void *), void *data) { return dw_icon_load_from_file_async(filename.c_str(), DW_SIGNAL_FUNC(func), data); }
     void FreeIcon(HICN icon) { dw_icon_free(icon); }
     void TaskBarInsert(Widget *handle, HICN icon,  const char *bubbletext) { dw_taskbar_insert(handle ? handle->GetHWND() : DW_NOHWND, icon, bubbletext); }
     void TaskBarInsert(Widget *handle, HICN icon,  std::string bubbletext) { dw_taskbar_insert(handle ? handle->GetHWND() : DW_NOHWND, icon, bubbletext.c_str()); }
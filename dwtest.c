@@ -2173,6 +2173,10 @@ char *DWFeatureList[] = {
     "Supports alternate container view modes",
     "Supports the DW_SIGNAL_HTML_MESSAGE callback",
     "Supports render safe drawing mode, limited to expose",
+    "Supports caching shaped text layouts in dw_draw_text()",
+    "Supports measuring large box layouts on worker threads",
+    "Supports recording API call counts and latencies",
+    "Supports timing signal handlers and reporting slow ones",
     NULL };
 
 /*
@@ -1968,7 +1968,11 @@ std::vector<std::string> DWFeatureList = {
     "Supports arbitrary window placement",
     "Supports alternate container view modes",
     "Supports the DW_SIGNAL_HTML_MESSAGE callback",
-    "Supports render safe drawing mode, limited to expose"
+    "Supports render safe drawing mode, limited to expose",
+    "Supports caching shaped text layouts in dw_draw_text()",
+    "Supports measuring large box layouts on worker threads",
+    "Supports recording API call counts and latencies",
+    "Supports timing signal handlers and reporting slow ones"
 };
 
 // Let's demonstrate the functionality of this library. :)
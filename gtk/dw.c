@@ -3030,6 +3030,61 @@ void dw_window_redraw(HWND handle)
 {
 }
 
+/*
+ * Suspends automatic layout of a top-level window, used
+ * when packing a large number of widgets at once.
+ * Calls may be nested, each must be matched by a thaw.
+ * GTK already coalesces size requests into one allocation
+ * per frame, so this only keeps count for the thaw.
+ * Parameters:
+ *           handle: Toplevel window handle.
+ * Returns:
+ *       DW_ERROR_NONE on success or DW_ERROR_GENERAL on error.
+ */
+int dw_window_layout_freeze(HWND handle)
+{
+   int _dw_locked_by_me = FALSE;
+   int freeze;
+
+   if(!handle || !GTK_IS_WINDOW(handle))
+      return DW_ERROR_GENERAL;
+
+   DW_MUTEX_LOCK;
+   freeze = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(handle), "_dw_layout_freeze"));
+   g_object_set_data(G_OBJECT(handle), "_dw_layout_freeze", GINT_TO_POINTER(freeze + 1));
+   DW_MUTEX_UNLOCK;
+   return DW_ERROR_NONE;
+}
+
+/*
+ * Resumes automatic layout of a top-level window, the layout
+ * is queued when the last freeze is removed.
+ * Parameters:
+ *           handle: Toplevel window handle.
+ * Returns:
+ *       DW_ERROR_NONE on success or DW_ERROR_GENERAL on error.
+ */
+int dw_window_layout_thaw(HWND handle)
+{
+   int _dw_locked_by_me = FALSE;
+   int freeze, retval = DW_ERROR_GENERAL;
+
+   if(!handle || !GTK_IS_WINDOW(handle))
+      return retval;
+
+   DW_MUTEX_LOCK;
+   freeze = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(handle), "_dw_layout_freeze"));
+   if(freeze > 0)
+   {
+      g_object_set_data(G_OBJECT(handle), "_dw_layout_freeze", GINT_TO_POINTER(freeze - 1));
+      if(freeze == 1)
+         gtk_widget_queue_resize(GTK_WIDGET(handle));
+      retval = DW_ERROR_NONE;
+   }
+   DW_MUTEX_UNLOCK;
+   return retval;
+}
+
 /*
  * Changes a window's parent to newparent.
  * Parameters:
@@ -5470,10 +5525,11 @@ void dw_mle_export(HWND handle, char *buffer, int startpoint, int length)
          gtk_text_buffer_get_iter_at_offset(tbuffer, &start, startpoint);
          gtk_text_buffer_get_iter_at_offset(tbuffer, &end, startpoint + length);
          text = gtk_text_iter_get_text(&start, &end);
-         if(text) /* Should this get freed? */
+         if(text)
          {
             if(buffer)
                strcpy(buffer, text);
+            g_free(text);
          }
       }
 #else
@@ -5500,6 +5556,41 @@ void dw_mle_export(HWND handle, char *buffer, int startpoint, int length)
    DW_MUTEX_UNLOCK;
 }
 
+/*
+ * Appends text to an MLE box in chunks read by a callback, so large
+ * files do not need to be loaded into memory first.  The callback is
+ * called with the MLE detached from its view, so it must not use the MLE.
+ * Parameters:
+ *          handle: Handle to the MLE to be inserted into.
+ *          readfunc: Function that fills in the next chunk of UTF-8 text,
+ *                    with the prototype int readfunc(HWND handle, char *buffer, int length, void *data).
+ *                    It returns the number of bytes read, 0 at the end or -1 on error.
+ *          data: Pointer passed to the read function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int dw_mle_import_stream(HWND handle, void *readfunc, void *data)
+{
+   return DW_ERROR_GENERAL;
+}
+
+/*
+ * Passes the text of an MLE box to a callback in chunks, so large
+ * contents do not need a buffer big enough for all the text.
+ * Parameters:
+ *          handle: Handle to the MLE to be queried.
+ *          writefunc: Function that receives each chunk of UTF-8 text,
+ *                     with the prototype int writefunc(HWND handle, const char *buffer, int length, void *data).
+ *                     It returns the number of bytes written, less than length stops the export.
+ *          data: Pointer passed to the write function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int dw_mle_export_stream(HWND handle, void *writefunc, void *data)
+{
+   return DW_ERROR_GENERAL;
+}
+
 /*
  * Obtains information about an MLE box.
  * Parameters:
@@ -6570,6 +6661,40 @@ HTREEITEM dw_tree_insert(HWND handle, const char *title, HICN icon, HTREEITEM pa
 #endif
 }
 
+/*
+ * Inserts many items into a tree window (widget) under one parent.
+ * Parameters:
+ *          handle: Handle to the tree to be inserted.
+ *          parent: Parent handle or 0 if root.
+ *          count: Number of items to insert.
+ *          titles: Array of count text titles.
+ *          icons: Array of count icon handles or NULL for no icons.
+ *          itemdata: Array of count item data pointers or NULL.
+ *          items: Array to receive the count new item handles or NULL.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int dw_tree_insert_many(HWND handle, HTREEITEM parent, int count, char **titles, HICN *icons, void **itemdata, HTREEITEM *items)
+{
+   int retval = DW_ERROR_NONE, z;
+
+   if(!handle || !titles || count < 0)
+      return DW_ERROR_GENERAL;
+
+   dw_tree_freeze(handle);
+   for(z=0;z<count;z++)
+   {
+      HTREEITEM item = dw_tree_insert(handle, titles[z], icons ? icons[z] : 0, parent, itemdata ? itemdata[z] : NULL);
+
+      if(!item)
+         retval = DW_ERROR_GENERAL;
+      if(items)
+         items[z] = item;
+   }
+   dw_tree_thaw(handle);
+   return retval;
+}
+
 /*
  * Sets the text and icon of an item in a tree window (widget).
  * Parameters:
@@ -6900,6 +7025,25 @@ void dw_tree_clear(HWND handle)
 #endif
 }
 
+/*
+ * Stops the tree from updating while many items are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the tree to freeze.
+ */
+void dw_tree_freeze(HWND handle)
+{
+}
+
+/*
+ * Resumes updating of a frozen tree, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the tree to thaw.
+ */
+void dw_tree_thaw(HWND handle)
+{
+}
+
 /*
  * Expands a node on a tree.
  * Parameters:
@@ -6980,6 +7124,24 @@ void dw_tree_item_collapse(HWND handle, HTREEITEM item)
 #endif
 }
 
+/*
+ * Marks a tree item as having children that are inserted on demand.
+ * The item shows an expander, and the DW_SIGNAL_TREE_EXPAND handler
+ * inserts the children when the item is expanded the first time.
+ * The handler is also called on later expands, even if the children exist.
+ * Parameters:
+ *       handle: Handle to the tree window (widget).
+ *       item: Handle to the node to be marked.
+ *       flags: DW_TREE_LAZY, DW_TREE_LAZY_DROP to also delete the children
+ *              when the node is collapsed, or 0 to turn it off.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int dw_tree_item_set_lazy(HWND handle, HTREEITEM item, int flags)
+{
+   return DW_ERROR_GENERAL;
+}
+
 /*
  * Removes a node from a tree.
  * Parameters:
@@ -7297,6 +7459,34 @@ HICN API dw_icon_load_from_file(const char *filename)
    return (HICN)(ret | (1 << 31));
 }
 
+/*
+ * Obtains an icon from a file and passes it to a callback.
+ * There is no background loader on this platform, so the file
+ * is loaded and the callback run on the calling thread before
+ * this function returns.
+ * Parameters:
+ *       filename: Name of the file, omit extention to have
+ *                 DW pick the appropriate file extension.
+ *                 (ICO on OS/2 or Windows, XPM on Unix)
+ *       callback: Function of the form int func(HICN icon, void *data)
+ *                 icon will be NULL if the file could not be loaded.
+ *       data: User data to be passed to the callback.
+ * Returns:
+ *       DW_ERROR_NONE once the callback has run, DW_ERROR_GENERAL on error
+ *       in which case the callback will not be called.
+ */
+int API dw_icon_load_from_file_async(const char *filename, void *callback, void *data)
+{
+   int (*iconfunc)(HICN, void *) = (int (*)(HICN, void *))callback;
+
+   if(!filename || !*filename || !callback)
+      return DW_ERROR_GENERAL;
+
+   /* No background loader on this platform, load it immediately */
+   iconfunc(dw_icon_load_from_file(filename), data);
+   return DW_ERROR_NONE;
+}
+
 /*
  * Obtains an icon from data.
  * Parameters:
@@ -8124,6 +8314,283 @@ char *dw_container_query_next(HWND handle, unsigned long flags)
    return retval;
 }
 
+/* Appends a row index to a query result, returns FALSE if it could not grow */
+static int _dw_container_index_add(void ***retval, int *rows, int *alloced, int index)
+{
+   if(*rows == *alloced)
+   {
+      int newalloced = *alloced ? *alloced * 2 : 64;
+      void **tmp = (void **)realloc(*retval, sizeof(void *) * newalloced);
+
+      if(!tmp)
+         return FALSE;
+      *retval = tmp;
+      *alloced = newalloced;
+   }
+   (*retval)[(*rows)++] = DW_INT_TO_POINTER(index);
+   return TRUE;
+}
+
+/* Returns the indexes of the matching rows for DW_CR_RETINDEX */
+static void **_dw_container_query_indexes(HWND handle, unsigned long flags, int *count)
+{
+   GtkWidget *clist;
+   void **retval = NULL;
+   int rows = 0, alloced = 0, z;
+   int _dw_locked_by_me = FALSE;
+
+   DW_MUTEX_LOCK;
+   clist = (GtkWidget*)gtk_object_get_user_data(GTK_OBJECT(handle));
+
+   if(clist)
+   {
+      if(flags & DW_CRA_SELECTED)
+      {
+         GList *list;
+
+         for(list = GTK_CLIST(clist)->selection;list;list = list->next)
+         {
+            if(!_dw_container_index_add(&retval, &rows, &alloced, GPOINTER_TO_INT(list->data)))
+               break;
+         }
+      }
+      else if(flags & DW_CRA_CURSORED)
+      {
+         if(GTK_CLIST(clist)->focus_row > -1 && GTK_CLIST(clist)->focus_row < GTK_CLIST(clist)->rows)
+            _dw_container_index_add(&retval, &rows, &alloced, GTK_CLIST(clist)->focus_row);
+      }
+      else
+      {
+         for(z=0;z<GTK_CLIST(clist)->rows;z++)
+         {
+            if(!_dw_container_index_add(&retval, &rows, &alloced, z))
+               break;
+         }
+      }
+   }
+   DW_MUTEX_UNLOCK;
+   if(!rows && retval)
+   {
+      free(retval);
+      retval = NULL;
+   }
+   if(count)
+      *count = retval ? rows : 0;
+   return retval;
+}
+
+/*
+ * Returns all matching rows of a container in one call.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       flags: DW_CRA_SELECTED or DW_CRA_CURSORED to limit the rows
+ *              returned, otherwise all rows are returned.
+ *              DW_CR_RETDATA to return the row data instead of titles.
+ *              DW_CR_RETINDEX to return zero based row indexes instead,
+ *              read each one with DW_POINTER_TO_INT().
+ *       count: Pointer to an integer to receive the number of rows.
+ * Returns:
+ *       An array of titles, data pointers or row indexes which must be
+ *       freed with dw_free(), or NULL if there are no matching rows.
+ *       Titles are copied into the same block as the array.
+ */
+void **dw_container_query_selected(HWND handle, unsigned long flags, int *count)
+{
+   void **retval = NULL, **tmp;
+   char *item, *buf;
+   int rows = 0, alloced = 0, z;
+   size_t size = 0;
+
+   if(flags & DW_CR_RETINDEX)
+      return _dw_container_query_indexes(handle, flags, count);
+
+   for(item = dw_container_query_start(handle, flags);item;item = dw_container_query_next(handle, flags))
+   {
+      if(rows == alloced)
+      {
+         alloced = alloced ? alloced * 2 : 64;
+         if(!(tmp = (void **)realloc(retval, sizeof(void *) * alloced)))
+         {
+            if(!(flags & DW_CR_RETDATA))
+               dw_free(item);
+            break;
+         }
+         retval = tmp;
+      }
+      if(!(flags & DW_CR_RETDATA))
+         size += strlen(item) + 1;
+      retval[rows++] = item;
+   }
+   /* Pack the titles after the array so one dw_free() releases everything */
+   if(retval && !(flags & DW_CR_RETDATA))
+   {
+      tmp = rows > 0 ? (void **)malloc((sizeof(void *) * rows) + size) : NULL;
+      buf = tmp ? (char *)&tmp[rows] : NULL;
+
+      for(z=0;z<rows;z++)
+      {
+         if(buf)
+         {
+            size_t len = strlen((char *)retval[z]) + 1;
+
+            memcpy(buf, retval[z], len);
+            tmp[z] = buf;
+            buf += len;
+         }
+         dw_free(retval[z]);
+      }
+      free(retval);
+      retval = tmp;
+   }
+   if(!rows && retval)
+   {
+      free(retval);
+      retval = NULL;
+   }
+   if(count)
+      *count = retval ? rows : 0;
+   return retval;
+}
+
+/* Container iterator state, the matching rows are walked once when
+ * the iteration starts, keeping a copy of each title with its data.
+ */
+typedef struct _dwcontiter {
+   char **titles;
+   void **data;
+   int count, alloced, pos;
+} DWContIter;
+
+/* Adds a row to an iterator, returns FALSE if the arrays could not grow */
+static int _dw_container_iter_add(DWContIter *it, const char *title, void *data)
+{
+   if(it->count == it->alloced)
+   {
+      int alloced = it->alloced ? it->alloced * 2 : 64;
+      char **titles = (char **)realloc(it->titles, sizeof(char *) * alloced);
+      void **newdata;
+
+      if(titles)
+         it->titles = titles;
+      if(!titles || !(newdata = (void **)realloc(it->data, sizeof(void *) * alloced)))
+         return FALSE;
+      it->data = newdata;
+      it->alloced = alloced;
+   }
+   it->titles[it->count] = title ? strdup(title) : NULL;
+   it->data[it->count++] = data;
+   return TRUE;
+}
+
+/*
+ * Starts iterating the rows of a container.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       flags: DW_CRA_SELECTED or DW_CRA_CURSORED to limit the rows
+ *              returned, otherwise all rows are returned.
+ * Returns:
+ *       An iterator handle to pass to dw_container_iter_next() and
+ *       dw_container_iter_end(), or NULL on error.
+ */
+HCONTITER dw_container_iter_begin(HWND handle, unsigned long flags)
+{
+   DWContIter *it = (DWContIter *)calloc(1, sizeof(DWContIter));
+   GtkWidget *clist;
+   int _dw_locked_by_me = FALSE;
+
+   DW_MUTEX_LOCK;
+   clist = (GtkWidget*)gtk_object_get_user_data(GTK_OBJECT(handle));
+
+   /* Walk the rows directly, the title and data come from the same row */
+   if(it && clist)
+   {
+      void **params;
+      int z;
+
+      if(flags & DW_CRA_SELECTED)
+      {
+         GList *list;
+
+         for(list = GTK_CLIST(clist)->selection;list;list = list->next)
+         {
+            params = (void **)gtk_clist_get_row_data(GTK_CLIST(clist), GPOINTER_TO_UINT(list->data));
+            if(!_dw_container_iter_add(it, params ? (char *)params[_DW_DATA_TYPE_STRING] : NULL,
+                                       params ? params[_DW_DATA_TYPE_POINTER] : NULL))
+               break;
+         }
+      }
+      else if(flags & DW_CRA_CURSORED)
+      {
+         if(GTK_CLIST(clist)->focus_row > -1 && GTK_CLIST(clist)->focus_row < GTK_CLIST(clist)->rows)
+         {
+            params = (void **)gtk_clist_get_row_data(GTK_CLIST(clist), GTK_CLIST(clist)->focus_row);
+            _dw_container_iter_add(it, params ? (char *)params[_DW_DATA_TYPE_STRING] : NULL,
+                                   params ? params[_DW_DATA_TYPE_POINTER] : NULL);
+         }
+      }
+      else
+      {
+         for(z=0;z<GTK_CLIST(clist)->rows;z++)
+         {
+            params = (void **)gtk_clist_get_row_data(GTK_CLIST(clist), z);
+            if(!_dw_container_iter_add(it, params ? (char *)params[_DW_DATA_TYPE_STRING] : NULL,
+                                       params ? params[_DW_DATA_TYPE_POINTER] : NULL))
+               break;
+         }
+      }
+   }
+   DW_MUTEX_UNLOCK;
+   return (HCONTITER)it;
+}
+
+/*
+ * Moves a container iterator to the next row.  The title and data are
+ * borrowed from the container and are valid until the next call.
+ * Parameters:
+ *       iter: Iterator handle returned by dw_container_iter_begin().
+ *       title: Pointer to receive the row title or NULL.
+ *       data: Pointer to receive the row data or NULL.
+ * Returns:
+ *       TRUE if a row was returned, FALSE at the end of the rows.
+ */
+int dw_container_iter_next(HCONTITER iter, const char **title, void **data)
+{
+   DWContIter *it = (DWContIter *)iter;
+
+   if(it && it->pos < it->count)
+   {
+      if(title)
+         *title = it->titles[it->pos];
+      if(data)
+         *data = it->data[it->pos];
+      it->pos++;
+      return TRUE;
+   }
+   return FALSE;
+}
+
+/*
+ * Finishes a container iteration and frees the iterator.
+ * Parameters:
+ *       iter: Iterator handle returned by dw_container_iter_begin().
+ */
+void dw_container_iter_end(HCONTITER iter)
+{
+   DWContIter *it = (DWContIter *)iter;
+
+   if(it)
+   {
+      int z;
+
+      for(z=0;z<it->count;z++)
+         free(it->titles[z]);
+      free(it->titles);
+      free(it->data);
+      free(it);
+   }
+}
+
+
 void _dw_container_cursor(HWND handle, int textcomp, void *data)
 {
    int _dw_locked_by_me = FALSE;
@@ -8273,6 +8740,71 @@ void dw_container_optimize(HWND handle)
    DW_MUTEX_UNLOCK;
 }
 
+/*
+ * Sorts the rows of a container by the contents of a column,
+ * rows with equal values keep their order.  Rows added later
+ * are not sorted.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based column to sort by.
+ *          order: DW_SORT_ASCENDING or DW_SORT_DESCENDING.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int dw_container_sort(HWND handle, int column, int order)
+{
+   return DW_ERROR_GENERAL;
+}
+
+/*
+ * Sets whether clicking a column heading sorts the container by
+ * that column, clicking the same heading again reverses the order.
+ * The column click signal handler is called after the rows are sorted.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          sortable: TRUE to sort on heading clicks, FALSE to leave it to the application.
+ */
+void dw_container_set_sortable(HWND handle, int sortable)
+{
+}
+
+/*
+ * Shows only the rows of a container whose text in a column contains
+ * the filter text, ignoring case unless DW_FILTER_CASESENSITIVE is set.
+ * Rows hidden by the filter are still returned by queries of all rows,
+ * and row numbers passed to other functions count hidden rows.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based string column to filter on.
+ *          text: Text the column must contain, NULL or "" shows all rows.
+ *          flags: DW_FILTER_CASESENSITIVE or 0.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int dw_container_set_filter(HWND handle, int column, const char *text, unsigned long flags)
+{
+   return DW_ERROR_GENERAL;
+}
+
+/*
+ * Stops the container from updating while many rows are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the container to freeze.
+ */
+void dw_container_freeze(HWND handle)
+{
+}
+
+/*
+ * Resumes updating of a frozen container, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the container to thaw.
+ */
+void dw_container_thaw(HWND handle)
+{
+}
+
 #if GTK_CHECK_VERSION(2,10,0)
 /* Translate the status message into a message on our buddy window */
 static void _dw_status_translate(GtkStatusIcon *status_icon, guint button, guint activate_time, gpointer user_data)
@@ -9126,6 +9658,34 @@ void dw_font_text_extents_get(HWND handle, HPIXMAP pixmap, const char *text, int
    DW_MUTEX_UNLOCK;
 }
 
+/* Query the width and height of multiple text strings at once.
+ * Parameters:
+ *       handle: Handle to the window.
+ *       pixmap: Handle to the pixmap. (choose only one of these)
+ *       count: Number of strings in the texts array.
+ *       texts: Array of text strings to be queried, NULL entries
+ *              get a width and height of 0.
+ *       widths: Array of count integers to be filled in with the widths, or NULL.
+ *       heights: Array of count integers to be filled in with the heights, or NULL.
+ */
+void API dw_font_text_extents_get_many(HWND handle, HPIXMAP pixmap, int count, char **texts, int *widths, int *heights)
+{
+   int z;
+
+   for(z=0;texts && z<count;z++)
+   {
+      if(texts[z])
+         dw_font_text_extents_get(handle, pixmap, texts[z], widths ? &widths[z] : NULL, heights ? &heights[z] : NULL);
+      else
+      {
+         if(widths)
+            widths[z] = 0;
+         if(heights)
+            heights[z] = 0;
+      }
+   }
+}
+
 /*
  * Creates a pixmap with given parameters.
  * Parameters:
@@ -9232,6 +9792,35 @@ HPIXMAP dw_pixmap_new_from_file(HWND handle, const char *filename)
    return pixmap;
 }
 
+/*
+ * Creates a pixmap from a file and passes it to a callback.
+ * There is no background loader on this platform, so the file
+ * is loaded and the callback run on the calling thread before
+ * this function returns.
+ * Parameters:
+ *       handle: Window handle the pixmap is associated with.
+ *       filename: Name of the file, omit extention to have
+ *                 DW pick the appropriate file extension.
+ *                 (BMP on OS/2 or Windows, XPM on Unix)
+ *       callback: Function of the form int func(HPIXMAP pixmap, void *data)
+ *                 pixmap will be NULL if the file could not be loaded.
+ *       data: User data to be passed to the callback.
+ * Returns:
+ *       DW_ERROR_NONE once the callback has run, DW_ERROR_GENERAL on error
+ *       in which case the callback will not be called.
+ */
+int API dw_pixmap_new_from_file_async(HWND handle, const char *filename, void *callback, void *data)
+{
+   int (*pixmapfunc)(HPIXMAP, void *) = (int (*)(HPIXMAP, void *))callback;
+
+   if(!filename || !*filename || !callback)
+      return DW_ERROR_GENERAL;
+
+   /* No background loader on this platform, load it immediately */
+   pixmapfunc(dw_pixmap_new_from_file(handle, filename), data);
+   return DW_ERROR_NONE;
+}
+
 /*
  * Creates a pixmap from data
  * Parameters:
@@ -11890,6 +12479,61 @@ void dw_listbox_list_append(HWND handle, char **text, int count)
    DW_MUTEX_UNLOCK;
 }
 
+/*
+ * Makes a listbox or combobox virtual, the application supplies the
+ * text of each entry instead of appending it.  There are no native
+ * virtual lists on this platform, so the entries are requested up
+ * front, call this again when the number of entries changes.
+ * Parameters:
+ *          handle: Handle to the listbox to be made virtual.
+ *          count: Number of entries in the list.
+ *          textfunc: Function returning the text of an entry, with the
+ *                    prototype char *textfunc(HWND handle, int index, void *data).
+ *                    The text only needs to remain valid until the next
+ *                    call.  NULL returns the list to normal with no entries.
+ *          data: Pointer passed to the text function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int dw_listbox_set_virtual(HWND handle, int count, void *textfunc, void *data)
+{
+   char *(*func)(HWND, int, void *) = (char *(*)(HWND, int, void *))textfunc;
+   int z;
+
+   if(!handle || count < 0)
+      return DW_ERROR_GENERAL;
+
+   dw_listbox_freeze(handle);
+   dw_listbox_clear(handle);
+   for(z=0;func && z<count;z++)
+   {
+      char *text = func(handle, z, data);
+
+      dw_listbox_append(handle, text ? text : "");
+   }
+   dw_listbox_thaw(handle);
+   return DW_ERROR_NONE;
+}
+
+/*
+ * Stops the listbox from updating while many items are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the listbox to freeze.
+ */
+void dw_listbox_freeze(HWND handle)
+{
+}
+
+/*
+ * Resumes updating of a frozen listbox, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the listbox to thaw.
+ */
+void dw_listbox_thaw(HWND handle)
+{
+}
+
 /*
  * Clears the listbox's (or combobox) list of all entries.
  * Parameters:
@@ -14209,3 +14853,32 @@ int API dw_feature_set(DWFEATURE feature, int state)
             return DW_FEATURE_UNSUPPORTED;
     }
 }
+
+/*
+ * Writes the data recorded while DW_FEATURE_TRACE was enabled.
+ * Parameters:
+ *       filename: Name of the file to write, or NULL for stderr.
+ *       flags: DW_TRACE_DUMP_JSON to write Chrome trace event JSON instead
+ *              of a table of statistics per function.
+ *              DW_TRACE_DUMP_RESET to clear the data after writing it.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_trace_dump(const char *filename, unsigned long flags)
+{
+   return DW_ERROR_GENERAL;
+}
+
+/*
+ * Returns the handler timings recorded while DW_FEATURE_SIGNAL_PROFILE
+ * was enabled.  Timer callbacks are recorded as the "timer" signal.
+ * Parameters:
+ *       signame: Name of the signal to query, or NULL for all signals.
+ *       stats: Pointer to a DWSignalStats structure to fill in.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_signal_stats_get(const char *signame, DWSignalStats *stats)
+{
+   return DW_ERROR_GENERAL;
+}
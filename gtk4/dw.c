@@ -21,6 +21,7 @@
 #include <ctype.h>
 #include <errno.h>
 #include <sys/time.h>
+#include <time.h>
 #include <dirent.h>
 #include <sys/stat.h>
 #include <signal.h>
@@ -48,6 +49,24 @@
 #include <sys/sysctl.h>
 #endif
 
+/* API tracing, see dw_trace_dump() */
+#define _DW_TRACE_LOCK     0
+#define _DW_TRACE_DISPATCH 1
+#define _DW_TRACE_SIGNAL   2
+
+static int _dw_trace_enabled = FALSE;
+static pthread_key_t _dw_trace_key;
+static guint64 _dw_trace_now(void);
+void _dw_trace_begin(const char *name);
+void _dw_trace_end(const char *name);
+void _dw_trace_wait(int type, guint64 start);
+
+/* Signal handler profiling, see dw_signal_stats_get() */
+static int _dw_signal_profile = 0;
+static void _dw_signal_record(const char *signame, HWND window, guint64 start);
+
+#define _DW_SIGNAL_TIMED(signame, window, call) do { guint64 _dw_start = _dw_signal_profile ? _dw_trace_now() : 0; call; if(_dw_start) _dw_signal_record(signame, window, _dw_start); } while(0)
+
 #if __STDC_VERSION__ < 199901L
 # if __GNUC__ >= 2
 #  define __func__ __FUNCTION__
@@ -333,19 +352,27 @@ rettype API func(__VA_ARGS__) {
     GdkRGBA * DW_UNUSED(_dw_bg_color) = (GdkRGBA *)_args[15];
 #define DW_FUNCTION_END }
 #define DW_FUNCTION_NO_RETURN(func) dw_event_reset((HEV)_args[0]); \
+    if(_dw_trace_enabled) _dw_trace_begin(#func); \
     if(_dw_thread == (pthread_t)-1 || pthread_self() == _dw_thread) \
         _##func(_args); \
     else { \
+        guint64 _dw_wait = _dw_trace_enabled ? _dw_trace_now() : 0; \
         g_idle_add_full(G_PRIORITY_HIGH_IDLE, G_SOURCE_FUNC(_##func), (gpointer)_args, NULL); \
-        dw_event_wait((HEV)_args[0], DW_TIMEOUT_INFINITE); } \
+        dw_event_wait((HEV)_args[0], DW_TIMEOUT_INFINITE); \
+        if(_dw_wait) _dw_trace_wait(_DW_TRACE_DISPATCH, _dw_wait); } \
+    if(_dw_trace_enabled) _dw_trace_end(#func); \
     }\
 gboolean _##func(void **_args) {
 #define DW_FUNCTION_RETURN(func, rettype) dw_event_reset((HEV)_args[0]); \
+    if(_dw_trace_enabled) _dw_trace_begin(#func); \
     if(_dw_thread == (pthread_t)-1 || pthread_self() == _dw_thread) \
         _##func(_args); \
     else { \
+        guint64 _dw_wait = _dw_trace_enabled ? _dw_trace_now() : 0; \
         g_idle_add_full(G_PRIORITY_HIGH_IDLE, G_SOURCE_FUNC(_##func), (gpointer)_args, NULL); \
-        dw_event_wait((HEV)_args[0], DW_TIMEOUT_INFINITE); } { \
+        dw_event_wait((HEV)_args[0], DW_TIMEOUT_INFINITE); \
+        if(_dw_wait) _dw_trace_wait(_DW_TRACE_DISPATCH, _dw_wait); } \
+    if(_dw_trace_enabled) _dw_trace_end(#func); { \
         void *tmp = _args[1]; \
         rettype myreturn = *((rettype *)tmp); \
         free(tmp); \
@@ -488,6 +515,10 @@ static void _dw_html_message_event(WebKitUserContentManager *manager, WebKitJava
 #endif
 #endif
 static void _dw_signal_disconnect(gpointer data, GClosure *closure);
+static GtkTreeModel *_dw_tree_view_get_model(GtkTreeView *view);
+static void _dw_tree_view_get_cursor(GtkTreeView *view, GtkTreePath **path, GtkTreeViewColumn **column);
+static gboolean _dw_tree_selection_get_selected(GtkTreeSelection *sel, GtkTreeModel **model, GtkTreeIter *iter);
+static int _dw_container_sort(GtkWidget *tree, int column, int order);
 static void _dw_event_coordinates_to_window(GtkWidget *widget, double *x, double *y);
 
 GObject *_DWObject = NULL;
@@ -528,6 +559,7 @@ typedef struct
    gpointer data;
    gint cid;
    void *intfunc;
+   const char *signame;
 
 } DWSignalHandler;
 
@@ -600,6 +632,22 @@ static DWSignalList _dw_findsignal(const char *signame)
    return empty;
 }
 
+/* Returns the signal table's own copy of a signal name, so handlers
+ * can keep it without copying, or NULL if the name is not known.
+ */
+static const char *_dw_findsigname(const char *signame)
+{
+   int z=0;
+
+   while(signame && DWSignalTranslate[z].func)
+   {
+      if(strcasecmp(signame, DWSignalTranslate[z].name) == 0)
+         return DWSignalTranslate[z].name;
+      z++;
+   }
+   return NULL;
+}
+
 static DWSignalHandler _dw_get_signal_handler(gpointer data)
 {
    DWSignalHandler sh = {0};
@@ -621,6 +669,8 @@ static DWSignalHandler _dw_get_signal_handler(gpointer data)
       sh.data = g_object_get_data(G_OBJECT(widget), text);
       snprintf(text, 100, "_dw_sigcid%d", counter);
       sh.cid = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(widget), text));
+      snprintf(text, 100, "_dw_signame%d", counter);
+      sh.signame = (const char *)g_object_get_data(G_OBJECT(widget), text);
    }
    return sh;
 }
@@ -643,9 +693,11 @@ static void _dw_remove_signal_handler(GtkWidget *widget, int counter)
    g_object_set_data(G_OBJECT(widget), text, NULL);
    snprintf(text, 100, "_dw_sigdata%d", counter);
    g_object_set_data(G_OBJECT(widget), text, NULL);
+   snprintf(text, 100, "_dw_signame%d", counter);
+   g_object_set_data(G_OBJECT(widget), text, NULL);
 }
 
-static int _dw_set_signal_handler(GObject *object, HWND window, void *func, gpointer data, void *intfunc, void *discfunc)
+static int _dw_set_signal_handler(GObject *object, HWND window, void *func, gpointer data, void *intfunc, void *discfunc, const char *signame)
 {
    int counter = GPOINTER_TO_INT(g_object_get_data(object, "_dw_sigcounter"));
    char text[101] = {0};
@@ -660,6 +712,8 @@ static int _dw_set_signal_handler(GObject *object, HWND window, void *func, gpoi
    g_object_set_data(object, text, (gpointer)discfunc);
    snprintf(text, 100, "_dw_sigdata%d", counter);
    g_object_set_data(object, text, (gpointer)data);
+   snprintf(text, 100, "_dw_signame%d", counter);
+   g_object_set_data(object, text, (gpointer)_dw_findsigname(signame));
 
    counter++;
    g_object_set_data(object, "_dw_sigcounter", GINT_TO_POINTER(counter));
@@ -713,7 +767,7 @@ static void _dw_html_result_event(GObject *object, GAsyncResult *result, gpointe
 #endif
     {
         if(htmlresultfunc)
-           htmlresultfunc((HWND)object, DW_ERROR_UNKNOWN, error->message, script_data, user_data);
+           _DW_SIGNAL_TIMED(DW_SIGNAL_HTML_RESULT, (HWND)object, htmlresultfunc((HWND)object, DW_ERROR_UNKNOWN, error->message, script_data, user_data));
         g_error_free (error);
         _dw_thread = saved_thread;
         return;
@@ -730,14 +784,14 @@ static void _dw_html_result_event(GObject *object, GAsyncResult *result, gpointe
         if(htmlresultfunc)
         {
            if(exception)
-               htmlresultfunc((HWND)object, DW_ERROR_UNKNOWN, (char *)jsc_exception_get_message(exception), script_data, user_data);
+               _DW_SIGNAL_TIMED(DW_SIGNAL_HTML_RESULT, (HWND)object, htmlresultfunc((HWND)object, DW_ERROR_UNKNOWN, (char *)jsc_exception_get_message(exception), script_data, user_data));
            else
-               htmlresultfunc((HWND)object, DW_ERROR_NONE, str_value, script_data, user_data);
+               _DW_SIGNAL_TIMED(DW_SIGNAL_HTML_RESULT, (HWND)object, htmlresultfunc((HWND)object, DW_ERROR_NONE, str_value, script_data, user_data));
         }
         g_free (str_value);
     }
     else if(htmlresultfunc)
-        htmlresultfunc((HWND)object, DW_ERROR_UNKNOWN, NULL, script_data, user_data);
+        _DW_SIGNAL_TIMED(DW_SIGNAL_HTML_RESULT, (HWND)object, htmlresultfunc((HWND)object, DW_ERROR_UNKNOWN, NULL, script_data, user_data));
 #ifndef USE_WEBKIT6
     webkit_javascript_result_unref (js_result);
 #endif
@@ -774,7 +828,7 @@ static void _dw_html_message_event(WebKitUserContentManager *manager, WebKitJava
         JSCException *exception = jsc_context_get_exception(jsc_value_get_context(result));
 
         if(htmlmessagefunc && !exception)
-            htmlmessagefunc(window, name, str_value, user_data);
+            _DW_SIGNAL_TIMED(DW_SIGNAL_HTML_MESSAGE, window, htmlmessagefunc(window, name, str_value, user_data));
             
         g_free(str_value);
         
@@ -782,7 +836,7 @@ static void _dw_html_message_event(WebKitUserContentManager *manager, WebKitJava
           return;
     }
     if(htmlmessagefunc)
-        htmlmessagefunc(window, name, NULL, user_data);
+        _DW_SIGNAL_TIMED(DW_SIGNAL_HTML_MESSAGE, window, htmlmessagefunc(window, name, NULL, user_data));
 }
 
 static void _dw_html_changed_event(WebKitWebView  *web_view, WebKitLoadEvent load_event, gpointer data)
@@ -809,7 +863,7 @@ static void _dw_html_changed_event(WebKitWebView  *web_view, WebKitLoadEvent loa
     {
         int (*htmlchangedfunc)(HWND, int, char *, void *) = work.func;
 
-        htmlchangedfunc(work.window, status, location, work.data);
+        _DW_SIGNAL_TIMED(DW_SIGNAL_HTML_CHANGED, work.window, htmlchangedfunc(work.window, status, location, work.data));
     }
 }
 #endif
@@ -825,7 +879,7 @@ static void _dw_set_focus_event(GObject *window, GParamSpec *pspec, gpointer dat
    {
       int (*setfocusfunc)(HWND, void *) = work.func;
 
-      setfocusfunc(work.window, work.data);
+      _DW_SIGNAL_TIMED(DW_SIGNAL_SET_FOCUS, work.window, setfocusfunc(work.window, work.data));
    }
 }
 
@@ -844,7 +898,7 @@ static gint _dw_button_press_event(GtkGestureSingle *gesture, int n_press, doubl
       else if(mybutton == 2)
          mybutton = DW_BUTTON3_MASK;
 
-      retval = buttonfunc(work.window, (int)x, (int)y, mybutton, work.data);
+      _DW_SIGNAL_TIMED(DW_SIGNAL_BUTTON_PRESS, work.window, retval = buttonfunc(work.window, (int)x, (int)y, mybutton, work.data));
       
       _dw_event_coordinates_to_window(work.window, &x, &y);
       
@@ -869,7 +923,7 @@ static gint _dw_button_release_event(GtkGestureSingle *gesture, int n_press, dou
       else if(mybutton == 2)
          mybutton = DW_BUTTON3_MASK;
 
-      retval = buttonfunc(work.window, (int)x, (int)y, mybutton, work.data);
+      _DW_SIGNAL_TIMED(DW_SIGNAL_BUTTON_RELEASE, work.window, retval = buttonfunc(work.window, (int)x, (int)y, mybutton, work.data));
       
       _dw_event_coordinates_to_window(work.window, &x, &y);
       
@@ -898,7 +952,7 @@ static gint _dw_motion_notify_event(GtkEventControllerMotion *controller, double
       if (state & GDK_BUTTON2_MASK)
          keys |= DW_BUTTON3_MASK;
 
-      retval = motionfunc(work.window, (int)x, (int)y, keys, work.data);
+      _DW_SIGNAL_TIMED(DW_SIGNAL_MOTION_NOTIFY, work.window, retval = motionfunc(work.window, (int)x, (int)y, keys, work.data));
       
       _dw_event_coordinates_to_window(work.window, &x, &y);
       
@@ -917,7 +971,7 @@ static gboolean _dw_delete_event(GtkWidget *window, gpointer data)
    {
       int (*closefunc)(HWND, void *) = work.func;
 
-      retval = closefunc(work.window, work.data);
+      _DW_SIGNAL_TIMED(DW_SIGNAL_DELETE, work.window, retval = closefunc(work.window, work.data));
    }
    return retval;
 }
@@ -935,8 +989,8 @@ static gint _dw_key_press_event(GtkEventControllerKey *controller, guint keyval,
 
       g_unichar_to_utf8(unichar, utf8);
 
-      retval = keypressfunc(work.window, (char)keycode, keyval,
-                       state & (GDK_CONTROL_MASK | GDK_SHIFT_MASK | GDK_ALT_MASK), work.data, utf8);
+      _DW_SIGNAL_TIMED(DW_SIGNAL_KEY_PRESS, work.window, retval = keypressfunc(work.window, (char)keycode, keyval,
+                       state & (GDK_CONTROL_MASK | GDK_SHIFT_MASK | GDK_ALT_MASK), work.data, utf8));
    }
    return retval;
 }
@@ -950,7 +1004,7 @@ static gint _dw_generic_event(GtkWidget *widget, gpointer data)
    {
       int (*genericfunc)(HWND, void *) = work.func;
 
-      retval = genericfunc(work.window, work.data);
+      _DW_SIGNAL_TIMED(work.signame ? work.signame : DW_SIGNAL_CLICKED, work.window, retval = genericfunc(work.window, work.data));
    }
    return retval;
 }
@@ -964,7 +1018,7 @@ static gint _dw_configure_event(GtkWidget *widget, int width, int height, gpoint
    {
       int (*sizefunc)(HWND, int, int, void *) = work.func;
 
-      retval = sizefunc(work.window, width, height, work.data);
+      _DW_SIGNAL_TIMED(DW_SIGNAL_CONFIGURE, work.window, retval = sizefunc(work.window, width, height, work.data));
    }
    return retval;
 }
@@ -1018,7 +1072,7 @@ static gint _dw_expose_event(GtkWidget *widget, cairo_t *cr, int width, int heig
       exp.width = width;
       exp.height = height;
       g_object_set_data(G_OBJECT(widget), "_dw_cr", (gpointer)cr);
-      retval = exposefunc((HWND)widget, &exp, data);
+      _DW_SIGNAL_TIMED(DW_SIGNAL_EXPOSE, (HWND)widget, retval = exposefunc((HWND)widget, &exp, data));
       g_object_set_data(G_OBJECT(widget), "_dw_cr", NULL);
 
       /* Copy the cached image to the output surface */
@@ -1060,7 +1114,7 @@ static gint _dw_combobox_select_event(GtkWidget *widget, gpointer data)
                {
                   int (*selectfunc)(HWND, int, void *) = work.func;
 
-                  retval = selectfunc(work.window, indices[0], work.data);
+                  _DW_SIGNAL_TIMED(DW_SIGNAL_LIST_SELECT, work.window, retval = selectfunc(work.window, indices[0], work.data));
                }
                gtk_tree_path_free(path);
             }
@@ -1135,11 +1189,11 @@ static gint _dw_tree_context_event(GtkGestureSingle *gesture, int n_press, doubl
          if(widget && GTK_IS_TREE_VIEW(widget))
          {
             GtkTreeSelection *sel = gtk_tree_view_get_selection(GTK_TREE_VIEW(widget));
-            GtkTreeModel *store = (GtkTreeModel *)gtk_tree_view_get_model(GTK_TREE_VIEW(widget));
+            GtkTreeModel *store = (GtkTreeModel *)_dw_tree_view_get_model(GTK_TREE_VIEW(widget));
             GtkTreeIter iter;
 
             if(sel && gtk_tree_selection_get_mode(sel) != GTK_SELECTION_MULTIPLE &&
-               gtk_tree_selection_get_selected(sel, NULL, &iter))
+               _dw_tree_selection_get_selected(sel, NULL, &iter))
             {
                if(g_object_get_data(G_OBJECT(widget), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_TREE))
                {
@@ -1154,7 +1208,7 @@ static gint _dw_tree_context_event(GtkGestureSingle *gesture, int n_press, doubl
             {
                GtkTreePath *path;
 
-               gtk_tree_view_get_cursor(GTK_TREE_VIEW(widget), &path, NULL);
+               _dw_tree_view_get_cursor(GTK_TREE_VIEW(widget), &path, NULL);
                if(path)
                {
                   GtkTreeIter iter;
@@ -1174,7 +1228,7 @@ static gint _dw_tree_context_event(GtkGestureSingle *gesture, int n_press, doubl
                }
             }
          }
-         retval = contextfunc(work.window, text, (int)x, (int)y, work.data, itemdata);
+         _DW_SIGNAL_TIMED(DW_SIGNAL_ITEM_CONTEXT, work.window, retval = contextfunc(work.window, text, (int)x, (int)y, work.data, itemdata));
          if(text)
             g_free(text);
       }
@@ -1187,7 +1241,8 @@ static gint _dw_tree_select_event(GtkTreeSelection *sel, gpointer data)
    GtkWidget *item = NULL, *widget = (GtkWidget *)gtk_tree_selection_get_tree_view(sel);
    int retval = FALSE;
 
-   if(widget)
+   /* Selection changes while frozen are not from the user */
+   if(widget && !g_object_get_data(G_OBJECT(widget), "_dw_frozen"))
    {
       DWSignalHandler work = _dw_get_signal_handler(data);
 
@@ -1197,7 +1252,7 @@ static gint _dw_tree_select_event(GtkTreeSelection *sel, gpointer data)
          GtkTreeIter iter;
          char *text = NULL;
          void *itemdata = NULL;
-         GtkTreeModel *store = (GtkTreeModel *)gtk_tree_view_get_model(GTK_TREE_VIEW(widget));
+         GtkTreeModel *store = (GtkTreeModel *)_dw_tree_view_get_model(GTK_TREE_VIEW(widget));
 
          if(g_object_get_data(G_OBJECT(widget), "_dw_double_click"))
          {
@@ -1206,17 +1261,17 @@ static gint _dw_tree_select_event(GtkTreeSelection *sel, gpointer data)
          }
 
          if(gtk_tree_selection_get_mode(sel) != GTK_SELECTION_MULTIPLE &&
-            gtk_tree_selection_get_selected(sel, NULL, &iter))
+            _dw_tree_selection_get_selected(sel, NULL, &iter))
          {
             if(g_object_get_data(G_OBJECT(widget), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_TREE))
             {
                gtk_tree_model_get(store, &iter, _DW_DATA_TYPE_STRING, &text, 2, &itemdata, 3, &item, -1);
-               retval = treeselectfunc(work.window, (HTREEITEM)item, text, work.data, itemdata);
+               _DW_SIGNAL_TIMED(DW_SIGNAL_ITEM_SELECT, work.window, retval = treeselectfunc(work.window, (HTREEITEM)item, text, work.data, itemdata));
             }
             else if(g_object_get_data(G_OBJECT(widget), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
             {
                gtk_tree_model_get(store, &iter, _DW_DATA_TYPE_STRING, &text, _DW_DATA_TYPE_POINTER, &itemdata, -1);
-               retval = treeselectfunc(work.window, (HTREEITEM)item, text, work.data, itemdata);
+               _DW_SIGNAL_TIMED(DW_SIGNAL_ITEM_SELECT, work.window, retval = treeselectfunc(work.window, (HTREEITEM)item, text, work.data, itemdata));
             }
             else
             {
@@ -1230,7 +1285,7 @@ static gint _dw_tree_select_event(GtkTreeSelection *sel, gpointer data)
                   {
                      int (*selectfunc)(HWND, int, void *) = work.func;
 
-                     retval = selectfunc(work.window, indices[0], work.data);
+                     _DW_SIGNAL_TIMED(DW_SIGNAL_LIST_SELECT, work.window, retval = selectfunc(work.window, indices[0], work.data));
                   }
                   gtk_tree_path_free(path);
                }
@@ -1240,7 +1295,7 @@ static gint _dw_tree_select_event(GtkTreeSelection *sel, gpointer data)
          {
             GtkTreePath *path;
 
-            gtk_tree_view_get_cursor(GTK_TREE_VIEW(widget), &path, NULL);
+            _dw_tree_view_get_cursor(GTK_TREE_VIEW(widget), &path, NULL);
             if(path)
             {
                GtkTreeIter iter;
@@ -1250,12 +1305,12 @@ static gint _dw_tree_select_event(GtkTreeSelection *sel, gpointer data)
                   if(g_object_get_data(G_OBJECT(widget), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_TREE))
                   {
                      gtk_tree_model_get(store, &iter, _DW_DATA_TYPE_STRING, &text, 2, &itemdata, 3, &item, -1);
-                     retval = treeselectfunc(work.window, (HTREEITEM)item, text, work.data, itemdata);
+                     _DW_SIGNAL_TIMED(DW_SIGNAL_ITEM_SELECT, work.window, retval = treeselectfunc(work.window, (HTREEITEM)item, text, work.data, itemdata));
                   }
                   else if(g_object_get_data(G_OBJECT(widget), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
                   {
                      gtk_tree_model_get(store, &iter, _DW_DATA_TYPE_STRING, &text, _DW_DATA_TYPE_POINTER, &itemdata, -1);
-                     retval = treeselectfunc(work.window, (HTREEITEM)item, text, work.data, itemdata);
+                     _DW_SIGNAL_TIMED(DW_SIGNAL_ITEM_SELECT, work.window, retval = treeselectfunc(work.window, (HTREEITEM)item, text, work.data, itemdata));
                   }
                   else
                   {
@@ -1265,7 +1320,7 @@ static gint _dw_tree_select_event(GtkTreeSelection *sel, gpointer data)
                      {
                         int (*selectfunc)(HWND, int, void *) = work.func;
 
-                        retval = selectfunc(work.window, indices[0], work.data);
+                        _DW_SIGNAL_TIMED(DW_SIGNAL_LIST_SELECT, work.window, retval = selectfunc(work.window, indices[0], work.data));
                      }
                   }
                }
@@ -1284,10 +1339,15 @@ static gint _dw_tree_expand_event(GtkTreeView *widget, GtkTreeIter *iter, GtkTre
    DWSignalHandler work = _dw_get_signal_handler(data);
    int retval = FALSE;
 
-   if(work.window)
+   if(work.window && !g_object_get_data(G_OBJECT(widget), "_dw_frozen"))
    {
       int (*treeexpandfunc)(HWND, HTREEITEM, void *) = work.func;
-      retval = treeexpandfunc(work.window, (HTREEITEM)iter, work.data);
+      int expanding = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(widget), "_dw_expanding"));
+
+      /* The model must stay attached while the view is expanding a row */
+      g_object_set_data(G_OBJECT(widget), "_dw_expanding", GINT_TO_POINTER(expanding+1));
+      _DW_SIGNAL_TIMED(DW_SIGNAL_TREE_EXPAND, work.window, retval = treeexpandfunc(work.window, (HTREEITEM)iter, work.data));
+      g_object_set_data(G_OBJECT(widget), "_dw_expanding", GINT_TO_POINTER(expanding));
    }
    return retval;
 }
@@ -1316,9 +1376,9 @@ static gint _dw_container_enter_event(GtkEventController *controller, guint keyv
          if(GTK_IS_TREE_VIEW(widget))
          {
             GtkTreePath *path;
-            GtkTreeModel *store = (GtkTreeModel *)gtk_tree_view_get_model(GTK_TREE_VIEW(widget));
+            GtkTreeModel *store = (GtkTreeModel *)_dw_tree_view_get_model(GTK_TREE_VIEW(widget));
 
-            gtk_tree_view_get_cursor(GTK_TREE_VIEW(widget), &path, NULL);
+            _dw_tree_view_get_cursor(GTK_TREE_VIEW(widget), &path, NULL);
             if(path)
             {
                GtkTreeIter iter;
@@ -1328,7 +1388,7 @@ static gint _dw_container_enter_event(GtkEventController *controller, guint keyv
                   if(g_object_get_data(G_OBJECT(widget), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
                   {
                      gtk_tree_model_get(store, &iter, _DW_DATA_TYPE_STRING, &text, _DW_DATA_TYPE_POINTER, &data, -1);
-                     retval = contextfunc(work.window, text, work.data, data);
+                     _DW_SIGNAL_TIMED(DW_SIGNAL_ITEM_ENTER, work.window, retval = contextfunc(work.window, text, work.data, data));
                      if(text)
                         g_free(text);
                   }
@@ -1375,7 +1435,7 @@ static gint _dw_switch_page_event(GtkNotebook *notebook, GtkWidget *page, guint
    if(work.window)
    {
       int (*switchpagefunc)(HWND, unsigned long, void *) = work.func;
-      retval = switchpagefunc(work.window, _dw_get_logical_page(GTK_WIDGET(notebook), page_num), work.data);
+      _DW_SIGNAL_TIMED(DW_SIGNAL_SWITCH_PAGE, work.window, retval = switchpagefunc(work.window, _dw_get_logical_page(GTK_WIDGET(notebook), page_num), work.data));
    }
    return retval;
 }
@@ -1390,6 +1450,18 @@ static gint _dw_column_click_event(GtkWidget *widget, gpointer data)
       GtkWidget *tree = (GtkWidget *)params[2];
       gint handlerdata = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(tree), "_dw_column_click_id"));
 
+      /* Built in sorting happens before the application is told */
+      if(g_object_get_data(G_OBJECT(tree), "_dw_sortable"))
+      {
+         int column_num = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(widget), "_dw_column"));
+         int order = DW_SORT_ASCENDING;
+
+         /* Clicking the sorted column again reverses the order */
+         if(GPOINTER_TO_INT(g_object_get_data(G_OBJECT(tree), "_dw_sort_column")) == column_num + 1 &&
+            GPOINTER_TO_INT(g_object_get_data(G_OBJECT(tree), "_dw_sort_order")) == DW_SORT_ASCENDING)
+            order = DW_SORT_DESCENDING;
+         _dw_container_sort(tree, column_num, order);
+      }
       if(handlerdata)
       {
          DWSignalHandler work;
@@ -1401,7 +1473,7 @@ static gint _dw_column_click_event(GtkWidget *widget, gpointer data)
          {
             int column_num = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(widget), "_dw_column"));
             int (*clickcolumnfunc)(HWND, int, void *) = work.func;
-            retval = clickcolumnfunc(work.window, column_num, work.data);
+            _DW_SIGNAL_TIMED(DW_SIGNAL_COLUMN_CLICK, work.window, retval = clickcolumnfunc(work.window, column_num, work.data));
          }
       }
    }
@@ -1446,9 +1518,9 @@ static gint _dw_value_changed_event(GtkWidget *widget, gpointer data)
          int (*valuechangedfunc)(HWND, int, void *) = work.func;
 
          if(slider && gtk_orientable_get_orientation(GTK_ORIENTABLE(slider)) == GTK_ORIENTATION_VERTICAL)
-            valuechangedfunc(work.window, (max - val) - 1,  work.data);
+            _DW_SIGNAL_TIMED(DW_SIGNAL_VALUE_CHANGED, work.window, valuechangedfunc(work.window, (max - val) - 1,  work.data));
          else
-            valuechangedfunc(work.window, val,  work.data);
+            _DW_SIGNAL_TIMED(DW_SIGNAL_VALUE_CHANGED, work.window, valuechangedfunc(work.window, val,  work.data));
       }
    }
    return FALSE;
@@ -1487,6 +1559,56 @@ static GdkPixbuf *_dw_pixbuf_from_resource(unsigned int rid)
    return gdk_pixbuf_new_from_resource(resource_path, NULL);
 }
 
+/* Decoded resource icon cache, the same resource ID is often used for
+ * every row of a container or node of a tree, so only decode it once.
+ * dw_icon_load() adds a reference and dw_icon_free() releases it,
+ * icons used by ID without being loaded stay cached until freed.
+ */
+typedef struct _dw_icon_cache {
+   GdkPixbuf *pixbuf;
+   int refcount;
+} DWIconCache;
+
+static GHashTable *_dw_icon_cache = NULL;
+static pthread_mutex_t _dw_icon_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Internal function called when an entry is removed from the icon cache */
+static void _dw_icon_cache_free(gpointer data)
+{
+   DWIconCache *ic = (DWIconCache *)data;
+
+   g_object_unref(ic->pixbuf);
+   free(ic);
+}
+
+/* Internal function to find the cache entry for a resource ID,
+ * decoding the image if create is TRUE and it is not cached yet.
+ * Must be called with _dw_icon_mutex held.
+ */
+static DWIconCache *_dw_icon_cache_get(unsigned int id, int create)
+{
+   DWIconCache *ic = NULL;
+
+   if(!_dw_icon_cache)
+      _dw_icon_cache = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, _dw_icon_cache_free);
+   if(!(ic = (DWIconCache *)g_hash_table_lookup(_dw_icon_cache, GUINT_TO_POINTER(id))) && create)
+   {
+      GdkPixbuf *pixbuf = _dw_pixbuf_from_resource(id);
+
+      if(pixbuf && (ic = calloc(1, sizeof(DWIconCache))))
+      {
+         ic->pixbuf = pixbuf;
+         g_hash_table_insert(_dw_icon_cache, GUINT_TO_POINTER(id), ic);
+      }
+      else if(pixbuf)
+         g_object_unref(pixbuf);
+   }
+   return ic;
+}
+
+/* Internal function to return the image for an icon handle,
+ * the returned pixbuf is owned by the handle or the icon cache.
+ */
 static GdkPixbuf *_dw_find_pixbuf(HICN icon, unsigned long *userwidth, unsigned long *userheight)
 {
    unsigned int id = GPOINTER_TO_INT(icon);
@@ -1499,8 +1621,15 @@ static GdkPixbuf *_dw_find_pixbuf(HICN icon, unsigned long *userwidth, unsigned
    if(id > 65535)
       icon_pixbuf = icon;
    else
-      icon_pixbuf = _dw_pixbuf_from_resource(id);
-   
+   {
+      DWIconCache *ic;
+
+      pthread_mutex_lock(&_dw_icon_mutex);
+      if((ic = _dw_icon_cache_get(id, TRUE)))
+         icon_pixbuf = ic->pixbuf;
+      pthread_mutex_unlock(&_dw_icon_mutex);
+   }
+
    if(userwidth)
       *userwidth = icon_pixbuf ? gdk_pixbuf_get_width(icon_pixbuf) : 0;
    if(userheight)
@@ -1623,6 +1752,394 @@ void _dw_init_path(char *arg)
       _dw_share_path[0] = '/';
 }
 
+/* API tracing, enabled at runtime with DW_FEATURE_TRACE or from
+ * dw_init() by building with DW_TRACE defined.  The DW_FUNCTION macros
+ * mark the start and end of each API call, the time spent in each call
+ * and waiting for calls dispatched to the main thread is recorded per
+ * function.
+ */
+#define _DW_TRACE_DEPTH 32
+#define _DW_TRACE_BUCKETS 320
+#define _DW_TRACE_EVENTS_MAX 65536
+
+typedef struct _dw_trace_stat {
+   const char *name;
+   unsigned long count;
+   /* Times in nanoseconds */
+   guint64 total, max, wait[2];
+   /* Latency histogram, eight buckets per power of two */
+   unsigned int buckets[_DW_TRACE_BUCKETS];
+} DWTraceStat;
+
+typedef struct _dw_trace_event {
+   const char *name;
+   int category, tid;
+   guint64 start, duration;
+} DWTraceEvent;
+
+typedef struct _dw_trace_thread {
+   int depth, overflow, tid;
+   struct {
+      const char *name;
+      guint64 start, wait[2];
+   } frames[_DW_TRACE_DEPTH];
+} DWTraceThread;
+
+static pthread_mutex_t _dw_trace_mutex = PTHREAD_MUTEX_INITIALIZER;
+static GHashTable *_dw_trace_stats = NULL;
+static DWTraceEvent *_dw_trace_events = NULL;
+static int _dw_trace_event_next = 0, _dw_trace_event_count = 0, _dw_trace_tids = 0;
+static guint64 _dw_trace_epoch = 0;
+
+/* Internal function to return a monotonic timestamp in nanoseconds */
+static guint64 _dw_trace_now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ((guint64)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+/* Internal function to return the tracing state of the current thread */
+static DWTraceThread *_dw_trace_thread(void)
+{
+   DWTraceThread *thread = pthread_getspecific(_dw_trace_key);
+
+   if(!thread && (thread = calloc(1, sizeof(DWTraceThread))))
+   {
+      pthread_mutex_lock(&_dw_trace_mutex);
+      thread->tid = ++_dw_trace_tids;
+      pthread_mutex_unlock(&_dw_trace_mutex);
+      pthread_setspecific(_dw_trace_key, thread);
+   }
+   return thread;
+}
+
+/* Internal function to find the histogram bucket for a duration */
+static int _dw_trace_bucket(guint64 value)
+{
+   int bits = 0;
+
+   if(value < 8)
+      return (int)value;
+   while((value >> bits) > 15)
+      bits++;
+   if(((bits + 1) * 8) + 7 >= _DW_TRACE_BUCKETS)
+      return _DW_TRACE_BUCKETS - 1;
+   return ((bits + 1) * 8) + (int)((value >> bits) - 8);
+}
+
+/* Internal function to return the largest duration in a bucket */
+static guint64 _dw_trace_bucket_max(int bucket)
+{
+   int bits = (bucket / 8) - 1;
+
+   if(bucket < 8)
+      return (guint64)bucket;
+   return (((guint64)(bucket % 8) + 9) << bits) - 1;
+}
+
+/* Internal function to add an event for the Chrome trace output.
+ * Must be called with the trace mutex held.
+ */
+static void _dw_trace_event(const char *name, int category, int tid, guint64 start, guint64 duration)
+{
+   DWTraceEvent *event;
+
+   if(!_dw_trace_events && !(_dw_trace_events = calloc(_DW_TRACE_EVENTS_MAX, sizeof(DWTraceEvent))))
+      return;
+   /* Once full the oldest events are replaced */
+   event = &_dw_trace_events[_dw_trace_event_next];
+   _dw_trace_event_next = (_dw_trace_event_next + 1) % _DW_TRACE_EVENTS_MAX;
+   if(_dw_trace_event_count < _DW_TRACE_EVENTS_MAX)
+      _dw_trace_event_count++;
+   event->name = name;
+   event->category = category;
+   event->tid = tid;
+   event->start = start;
+   event->duration = duration;
+}
+
+/* Internal function called at the start of a traced API call */
+void _dw_trace_begin(const char *name)
+{
+   DWTraceThread *thread = _dw_trace_thread();
+
+   if(thread)
+   {
+      /* Calls nested too deeply are not recorded */
+      if(thread->depth >= _DW_TRACE_DEPTH)
+         thread->overflow++;
+      else
+      {
+         thread->frames[thread->depth].name = name;
+         thread->frames[thread->depth].wait[_DW_TRACE_LOCK] = thread->frames[thread->depth].wait[_DW_TRACE_DISPATCH] = 0;
+         thread->frames[thread->depth].start = _dw_trace_now();
+         thread->depth++;
+      }
+   }
+}
+
+/* Internal function called at the end of a traced API call */
+void _dw_trace_end(const char *name)
+{
+   DWTraceThread *thread = pthread_getspecific(_dw_trace_key);
+   guint64 now = _dw_trace_now(), duration;
+   DWTraceStat *stat = NULL;
+   int depth, bucket;
+
+   if(!thread)
+      return;
+   if(thread->overflow)
+   {
+      thread->overflow--;
+      return;
+   }
+   /* Find the matching start, dropping any calls that never ended
+    * such as ones that returned early without unlocking.
+    */
+   for(depth=thread->depth-1;depth>=0;depth--)
+   {
+      if(thread->frames[depth].name == name || strcmp(thread->frames[depth].name, name) == 0)
+         break;
+   }
+   if(depth < 0)
+      return;
+   thread->depth = depth;
+   duration = now - thread->frames[depth].start;
+   bucket = _dw_trace_bucket(duration);
+
+   pthread_mutex_lock(&_dw_trace_mutex);
+   if(!_dw_trace_stats)
+      _dw_trace_stats = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, free);
+   if(_dw_trace_stats && !(stat = g_hash_table_lookup(_dw_trace_stats, name)) &&
+      (stat = calloc(1, sizeof(DWTraceStat))))
+   {
+      stat->name = name;
+      g_hash_table_insert(_dw_trace_stats, (gpointer)name, stat);
+   }
+   if(stat)
+   {
+      stat->count++;
+      stat->total += duration;
+      if(duration > stat->max)
+         stat->max = duration;
+      stat->wait[_DW_TRACE_LOCK] += thread->frames[depth].wait[_DW_TRACE_LOCK];
+      stat->wait[_DW_TRACE_DISPATCH] += thread->frames[depth].wait[_DW_TRACE_DISPATCH];
+      stat->buckets[bucket]++;
+   }
+   _dw_trace_event(name, -1, thread->tid, thread->frames[depth].start, duration);
+   pthread_mutex_unlock(&_dw_trace_mutex);
+}
+
+/* Internal function to add time spent waiting to the current call */
+void _dw_trace_wait(int type, guint64 start)
+{
+   DWTraceThread *thread = pthread_getspecific(_dw_trace_key);
+   guint64 duration = _dw_trace_now() - start;
+
+   if(thread && thread->depth > 0 && !thread->overflow)
+   {
+      thread->frames[thread->depth-1].wait[type] += duration;
+      pthread_mutex_lock(&_dw_trace_mutex);
+      _dw_trace_event(thread->frames[thread->depth-1].name, type, thread->tid, start, duration);
+      pthread_mutex_unlock(&_dw_trace_mutex);
+   }
+}
+
+/* Internal function to sort the statistics by total time, longest first */
+static int _dw_trace_compare(const void *a, const void *b)
+{
+   const DWTraceStat *stat1 = *(const DWTraceStat **)a, *stat2 = *(const DWTraceStat **)b;
+
+   if(stat1->total == stat2->total)
+      return strcmp(stat1->name, stat2->name);
+   return stat1->total > stat2->total ? -1 : 1;
+}
+
+/* Internal function to return the 99th percentile latency */
+static guint64 _dw_trace_p99(DWTraceStat *stat)
+{
+   unsigned long target = stat->count - (stat->count / 100), seen = 0;
+   int z;
+
+   for(z=0;z<_DW_TRACE_BUCKETS;z++)
+   {
+      if((seen += stat->buckets[z]) >= target)
+      {
+         guint64 value = _dw_trace_bucket_max(z);
+
+         return value > stat->max ? stat->max : value;
+      }
+   }
+   return stat->max;
+}
+
+/*
+ * Writes the data recorded while DW_FEATURE_TRACE was enabled.
+ * Parameters:
+ *       filename: Name of the file to write, or NULL for stderr.
+ *       flags: DW_TRACE_DUMP_JSON to write Chrome trace event JSON instead
+ *              of a table of statistics per function.
+ *              DW_TRACE_DUMP_RESET to clear the data after writing it.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_trace_dump(const char *filename, unsigned long flags)
+{
+   static const char *categories[] = { "lock", "dispatch", "signal" };
+   FILE *fp = filename ? fopen(filename, "w") : stderr;
+   int z;
+
+   if(!fp)
+      return DW_ERROR_GENERAL;
+
+   pthread_mutex_lock(&_dw_trace_mutex);
+   if(flags & DW_TRACE_DUMP_JSON)
+   {
+      int first = (_dw_trace_event_next - _dw_trace_event_count + _DW_TRACE_EVENTS_MAX) % _DW_TRACE_EVENTS_MAX;
+
+      fprintf(fp, "{\"traceEvents\":[");
+      for(z=0;z<_dw_trace_event_count;z++)
+      {
+         DWTraceEvent *event = &_dw_trace_events[(first + z) % _DW_TRACE_EVENTS_MAX];
+
+         /* Times are in microseconds, relative to when tracing was enabled */
+         fprintf(fp, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+                 z ? "," : "", event->name, event->category < 0 ? "api" : categories[event->category],
+                 event->start > _dw_trace_epoch ? (event->start - _dw_trace_epoch) / 1000.0 : 0.0,
+                 event->duration / 1000.0, (int)getpid(), event->tid);
+      }
+      fprintf(fp, "\n]}\n");
+   }
+   else
+   {
+      guint count = _dw_trace_stats ? g_hash_table_size(_dw_trace_stats) : 0;
+      DWTraceStat **stats = count ? calloc(count, sizeof(DWTraceStat *)) : NULL;
+
+      fprintf(fp, "%-40s %10s %12s %10s %10s %10s %12s\n", "Function", "Calls", "Total ms",
+              "Avg us", "P99 us", "Lock ms", "Dispatch ms");
+      if(stats)
+      {
+         GHashTableIter iter;
+         gpointer value;
+
+         z = 0;
+         g_hash_table_iter_init(&iter, _dw_trace_stats);
+         while(g_hash_table_iter_next(&iter, NULL, &value))
+            stats[z++] = (DWTraceStat *)value;
+         qsort(stats, count, sizeof(DWTraceStat *), _dw_trace_compare);
+         for(z=0;z<(int)count;z++)
+         {
+            DWTraceStat *stat = stats[z];
+
+            fprintf(fp, "%-40s %10lu %12.3f %10.3f %10.3f %10.3f %12.3f\n", stat->name, stat->count,
+                    stat->total / 1000000.0, (stat->total / 1000.0) / stat->count, _dw_trace_p99(stat) / 1000.0,
+                    stat->wait[_DW_TRACE_LOCK] / 1000000.0, stat->wait[_DW_TRACE_DISPATCH] / 1000000.0);
+         }
+         free(stats);
+      }
+   }
+   if(flags & DW_TRACE_DUMP_RESET)
+   {
+      if(_dw_trace_stats)
+         g_hash_table_remove_all(_dw_trace_stats);
+      _dw_trace_event_next = _dw_trace_event_count = 0;
+      _dw_trace_epoch = _dw_trace_now();
+   }
+   pthread_mutex_unlock(&_dw_trace_mutex);
+   if(fp != stderr)
+      fclose(fp);
+   else
+      fflush(fp);
+   return DW_ERROR_NONE;
+}
+
+/* Signal handler profiling, enabled with DW_FEATURE_SIGNAL_PROFILE.
+ * The time taken by each handler is added up per signal, and handlers
+ * taking longer than the threshold in milliseconds are reported.
+ */
+#define _DW_SIGNAL_PROFILE_DEFAULT 16
+
+static GHashTable *_dw_signal_stats = NULL;
+
+/* Internal function called after a profiled handler returns */
+static void _dw_signal_record(const char *signame, HWND window, guint64 start)
+{
+   DWTraceThread *thread = _dw_trace_enabled ? _dw_trace_thread() : NULL;
+   guint64 duration = _dw_trace_now() - start;
+   double ms = duration / 1000000.0;
+   int slow = (_dw_signal_profile > 0 && ms >= _dw_signal_profile);
+   DWSignalStats *stats = NULL;
+
+   pthread_mutex_lock(&_dw_trace_mutex);
+   if(!_dw_signal_stats)
+      _dw_signal_stats = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, free);
+   if(_dw_signal_stats && !(stats = g_hash_table_lookup(_dw_signal_stats, signame)) &&
+      (stats = calloc(1, sizeof(DWSignalStats))))
+      g_hash_table_insert(_dw_signal_stats, (gpointer)signame, stats);
+   if(stats)
+   {
+      stats->count++;
+      stats->total += ms;
+      if(ms > stats->max)
+         stats->max = ms;
+      if(slow)
+         stats->slow++;
+   }
+   /* Show the handler in the Chrome trace output too */
+   if(thread)
+      _dw_trace_event(signame, _DW_TRACE_SIGNAL, thread->tid, start, duration);
+   pthread_mutex_unlock(&_dw_trace_mutex);
+
+   if(slow)
+      dw_debug("Slow %s handler on window %p took %.3f ms\n", signame, (void *)window, ms);
+}
+
+/*
+ * Returns the handler timings recorded while DW_FEATURE_SIGNAL_PROFILE
+ * was enabled.  Timer callbacks are recorded as the "timer" signal.
+ * Parameters:
+ *       signame: Name of the signal to query, or NULL for all signals.
+ *       stats: Pointer to a DWSignalStats structure to fill in.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ *       DW_ERROR_GENERAL if no handlers have been recorded for the signal.
+ */
+int API dw_signal_stats_get(const char *signame, DWSignalStats *stats)
+{
+   int retval = DW_ERROR_GENERAL;
+
+   if(!stats)
+      return retval;
+
+   memset(stats, 0, sizeof(DWSignalStats));
+   pthread_mutex_lock(&_dw_trace_mutex);
+   if(_dw_signal_stats)
+   {
+      GHashTableIter iter;
+      gpointer key, value;
+
+      g_hash_table_iter_init(&iter, _dw_signal_stats);
+      while(g_hash_table_iter_next(&iter, &key, &value))
+      {
+         DWSignalStats *thisstats = (DWSignalStats *)value;
+
+         if(!signame || strcasecmp(signame, (char *)key) == 0)
+         {
+            stats->count += thisstats->count;
+            stats->slow += thisstats->slow;
+            stats->total += thisstats->total;
+            if(thisstats->max > stats->max)
+               stats->max = thisstats->max;
+            retval = DW_ERROR_NONE;
+         }
+      }
+   }
+   pthread_mutex_unlock(&_dw_trace_mutex);
+   return retval;
+}
+
 /*
  * Initializes the Dynamic Windows engine.
  * Parameters:
@@ -1642,6 +2159,13 @@ int API dw_init(int newthread, int argc, char *argv[])
    pthread_key_create(&_dw_fg_color_key, NULL);
    pthread_key_create(&_dw_bg_color_key, NULL);
    pthread_key_create(&_dw_event_key, NULL);
+   pthread_key_create(&_dw_trace_key, free);
+
+#if defined(DW_TRACE) && !defined(_DW_SINGLE_THREADED)
+   /* Trace from startup when built with tracing */
+   _dw_trace_epoch = _dw_trace_now();
+   _dw_trace_enabled = TRUE;
+#endif
 
    _dw_init_thread();
 
@@ -2210,6 +2734,64 @@ DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
    DW_FUNCTION_RETURN_NOTHING;
 }
 
+/*
+ * Suspends automatic layout of a top-level window, used
+ * when packing a large number of widgets at once.
+ * Calls may be nested, each must be matched by a thaw.
+ * GTK already coalesces size requests into one allocation
+ * per frame, so this only keeps count for the thaw.
+ * Parameters:
+ *           handle: Toplevel window handle.
+ * Returns:
+ *       DW_ERROR_NONE on success or DW_ERROR_GENERAL on error.
+ */
+DW_FUNCTION_DEFINITION(dw_window_layout_freeze, int, HWND handle)
+DW_FUNCTION_ADD_PARAM1(handle)
+DW_FUNCTION_RETURN(dw_window_layout_freeze, int)
+DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
+{
+   int retval = DW_ERROR_GENERAL;
+
+   if(handle && GTK_IS_WINDOW(handle))
+   {
+      int freeze = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(handle), "_dw_layout_freeze"));
+
+      g_object_set_data(G_OBJECT(handle), "_dw_layout_freeze", GINT_TO_POINTER(freeze + 1));
+      retval = DW_ERROR_NONE;
+   }
+   DW_FUNCTION_RETURN_THIS(retval);
+}
+
+/*
+ * Resumes automatic layout of a top-level window, the layout
+ * is queued when the last freeze is removed.
+ * Parameters:
+ *           handle: Toplevel window handle.
+ * Returns:
+ *       DW_ERROR_NONE on success or DW_ERROR_GENERAL on error.
+ */
+DW_FUNCTION_DEFINITION(dw_window_layout_thaw, int, HWND handle)
+DW_FUNCTION_ADD_PARAM1(handle)
+DW_FUNCTION_RETURN(dw_window_layout_thaw, int)
+DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
+{
+   int retval = DW_ERROR_GENERAL;
+
+   if(handle && GTK_IS_WINDOW(handle))
+   {
+      int freeze = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(handle), "_dw_layout_freeze"));
+
+      if(freeze > 0)
+      {
+         g_object_set_data(G_OBJECT(handle), "_dw_layout_freeze", GINT_TO_POINTER(freeze - 1));
+         if(freeze == 1)
+            gtk_widget_queue_resize(GTK_WIDGET(handle));
+         retval = DW_ERROR_NONE;
+      }
+   }
+   DW_FUNCTION_RETURN_THIS(retval);
+}
+
 /*
  * Changes a window's parent to newparent.
  * Parameters:
@@ -2274,36 +2856,392 @@ char *_dw_convert_font(const char *font)
    return newfont;
 }
 
-/* Internal functions to convert to GTK3 style CSS */
-static void _dw_override_color(GtkWidget *widget, const char *element, GdkRGBA *color)
+/* Font cache, parsing the font string and creating the Pango context
+ * and layout on every dw_draw_text() or dw_font_text_extents_get() call
+ * is expensive, so keep the most recently used fonts around.
+ */
+#define _DW_FONT_CACHE_MAX 16
+
+typedef struct _dw_font_cache {
+   char *fontname;
+   PangoFontDescription *font;
+   /* Context and layout used for drawing, updated for each cairo context */
+   PangoContext *context;
+   PangoLayout *layout;
+   /* Context and layout used for measuring text extents */
+   PangoContext *extcontext;
+   PangoLayout *extlayout;
+   unsigned long lastused;
+} DWFontCache;
+
+static DWFontCache _dw_font_cache[_DW_FONT_CACHE_MAX];
+static unsigned long _dw_font_cache_tick = 0;
+
+/* Internal function to release the contents of a font cache entry */
+static void _dw_font_cache_free(DWFontCache *fc)
+{
+   if(fc->layout)
+      g_object_unref(fc->layout);
+   if(fc->context)
+      g_object_unref(fc->context);
+   if(fc->extlayout)
+      g_object_unref(fc->extlayout);
+   if(fc->extcontext)
+      g_object_unref(fc->extcontext);
+   if(fc->font)
+      pango_font_description_free(fc->font);
+   if(fc->fontname)
+      free(fc->fontname);
+   memset(fc, 0, sizeof(DWFontCache));
+}
+
+/* Text extents cache, column sizing and layout code tend to measure
+ * the same strings over and over, so remember the results keyed
+ * by the font and text.  Direct mapped so the size is bounded.
+ */
+#define _DW_EXTENTS_CACHE_MAX 1024
+#define _DW_EXTENTS_CACHE_TEXT_MAX 256
+
+typedef struct _dw_extents_cache {
+   unsigned int hash;
+   char *fontname;
+   char *text;
+   int width, height;
+} DWExtentsCache;
+
+static DWExtentsCache _dw_extents_cache[_DW_EXTENTS_CACHE_MAX];
+
+/* Internal function to generate a FNV-1a hash of the font and text */
+static unsigned int _dw_extents_cache_hash(const char *fontname, const char *text)
+{
+   unsigned int hash = 2166136261U;
+
+   while(*fontname)
+      hash = (hash ^ (unsigned char)*fontname++) * 16777619U;
+   hash = (hash ^ 0xff) * 16777619U;
+   while(*text)
+      hash = (hash ^ (unsigned char)*text++) * 16777619U;
+   return hash;
+}
+
+/* Internal function to drop any cached extents for a font,
+ * or all cached extents if fontname is NULL.
+ */
+static void _dw_extents_cache_invalidate(const char *fontname)
 {
-   gchar *dataname = g_strdup_printf ("_dw_color_%s", element);
-   GtkCssProvider *provider = g_object_get_data(G_OBJECT(widget), dataname);
-   GtkStyleContext *scontext = gtk_widget_get_style_context(widget);
-   
-   /* If we have an old context from a previous override remove it */
-   if(provider)
-   {
-      gtk_style_context_remove_provider(scontext, GTK_STYLE_PROVIDER(provider));
-      g_object_unref(provider);
-      provider = NULL;
-   }
-   
-   /* If we have a new color, create a new provider and add it */
-   if(color)
+   int z;
+
+   for(z=0;z<_DW_EXTENTS_CACHE_MAX;z++)
    {
-      gchar *scolor = gdk_rgba_to_string(color);
-      gchar *css = g_strdup_printf ("* { %s: %s; }", element, scolor);
-      
-      provider = gtk_css_provider_new();
-      g_free(scolor);
-      gtk_css_provider_load_from_data(provider, css, -1);
-      g_free(css);
-      gtk_style_context_add_provider(scontext, GTK_STYLE_PROVIDER(provider), GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
-   }
-   g_object_set_data(G_OBJECT(widget), dataname, (gpointer)provider);
-   g_free(dataname);
-}
+      DWExtentsCache *ec = &_dw_extents_cache[z];
+
+      if(ec->text && (!fontname || strcmp(ec->fontname, fontname) == 0))
+      {
+         free(ec->fontname);
+         free(ec->text);
+         ec->fontname = ec->text = NULL;
+      }
+   }
+}
+
+/* Text layout cache, when DW_FEATURE_TEXT_CACHE is enabled dw_draw_text()
+ * keeps the shaped layouts of recently drawn strings, so redrawing text
+ * that has not changed (like scrolling a log view) does not shape it again.
+ */
+#define _DW_TEXT_CACHE_DEFAULT 256
+
+typedef struct _dw_text_cache {
+   char *key;
+   PangoLayout *layout;
+   /* Position in the LRU queue, most recently used at the head */
+   GList *link;
+} DWTextCache;
+
+static int _dw_text_cache_max = 0;
+static GHashTable *_dw_text_cache = NULL;
+static GQueue _dw_text_cache_lru = G_QUEUE_INIT;
+
+/* Internal function called when an entry is removed from the hash table */
+static void _dw_text_cache_free(gpointer data)
+{
+   DWTextCache *tc = (DWTextCache *)data;
+
+   g_queue_delete_link(&_dw_text_cache_lru, tc->link);
+   g_object_unref(tc->layout);
+   g_free(tc->key);
+   free(tc);
+}
+
+/* Internal function to drop the least recently used layouts until
+ * there are no more than max entries left in the cache.
+ */
+static void _dw_text_cache_trim(int max)
+{
+   while(_dw_text_cache && g_queue_get_length(&_dw_text_cache_lru) > (guint)max)
+   {
+      DWTextCache *tc = (DWTextCache *)g_queue_peek_tail(&_dw_text_cache_lru);
+
+      g_hash_table_remove(_dw_text_cache, tc->key);
+   }
+}
+
+/* Internal function to check if a cache entry belongs to a font */
+static gboolean _dw_text_cache_match(gpointer key, gpointer value, gpointer data)
+{
+   const char *fontname = (const char *)data;
+   size_t len = strlen(fontname);
+
+   return (strncmp((char *)key, fontname, len) == 0 && ((char *)key)[len] == '\x01');
+}
+
+/* Internal function to drop any cached data for a font,
+ * or the entire cache if fontname is NULL.
+ */
+static void _dw_font_cache_invalidate(const char *fontname)
+{
+   int z;
+
+   for(z=0;z<_DW_FONT_CACHE_MAX;z++)
+   {
+      if(_dw_font_cache[z].fontname && (!fontname || strcmp(_dw_font_cache[z].fontname, fontname) == 0))
+         _dw_font_cache_free(&_dw_font_cache[z]);
+   }
+   _dw_extents_cache_invalidate(fontname);
+   if(_dw_text_cache)
+   {
+      if(fontname)
+         g_hash_table_foreach_remove(_dw_text_cache, _dw_text_cache_match, (gpointer)fontname);
+      else
+         _dw_text_cache_trim(0);
+   }
+}
+
+/* Internal function to find a font in the cache, loading it into
+ * the least recently used slot if it is not already present.
+ */
+static DWFontCache *_dw_font_cache_get(const char *fontname)
+{
+   DWFontCache *fc = NULL;
+   int z;
+
+   for(z=0;z<_DW_FONT_CACHE_MAX;z++)
+   {
+      if(_dw_font_cache[z].fontname && strcmp(_dw_font_cache[z].fontname, fontname) == 0)
+      {
+         _dw_font_cache[z].lastused = ++_dw_font_cache_tick;
+         return &_dw_font_cache[z];
+      }
+      /* Remember the empty or least recently used entry */
+      if(!fc || (fc->fontname && (!_dw_font_cache[z].fontname || _dw_font_cache[z].lastused < fc->lastused)))
+         fc = &_dw_font_cache[z];
+   }
+   _dw_font_cache_free(fc);
+   if(!(fc->font = pango_font_description_from_string(fontname)))
+      return NULL;
+   fc->fontname = strdup(fontname);
+   fc->lastused = ++_dw_font_cache_tick;
+   return fc;
+}
+
+/* Internal function to return the cached drawing layout for a font,
+ * updated to match the cairo context being drawn on.
+ */
+static PangoLayout *_dw_font_cache_layout(DWFontCache *fc, cairo_t *cr)
+{
+   if(!fc->context)
+   {
+      if(!(fc->context = pango_cairo_create_context(cr)))
+         return NULL;
+   }
+   else
+      pango_cairo_update_context(cr, fc->context);
+   if(!fc->layout)
+   {
+      if((fc->layout = pango_layout_new(fc->context)))
+         pango_layout_set_font_description(fc->layout, fc->font);
+   }
+   else
+      pango_layout_context_changed(fc->layout);
+   return fc->layout;
+}
+
+/* Internal function to return the attributes for drawing text
+ * with a background color, or NULL if there is no background.
+ */
+static PangoAttrList *_dw_text_attributes(GdkRGBA *background)
+{
+   PangoAttrList *list = NULL;
+
+   /* Create a background color attribute if required */
+   if(background)
+   {
+      PangoAttribute *attr = pango_attr_background_new((guint16)(background->red * 65535),
+                                                       (guint16)(background->green * 65535),
+                                                       (guint16)(background->blue* 65535));
+      list = pango_attr_list_new();
+      pango_attr_list_change(list, attr);
+   }
+   return list;
+}
+
+/* Internal function to return a cached shaped layout for the text,
+ * creating it if needed.  Returns NULL if the text cache is disabled.
+ */
+static PangoLayout *_dw_text_cache_get(DWFontCache *fc, cairo_t *cr, const char *text, GdkRGBA *background)
+{
+   DWTextCache *tc;
+   PangoAttrList *list;
+   char *key;
+
+   if(_dw_text_cache_max < 1)
+   {
+      /* Release any layouts left over from when it was enabled */
+      _dw_text_cache_trim(0);
+      return NULL;
+   }
+
+   if(!_dw_text_cache)
+      _dw_text_cache = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, _dw_text_cache_free);
+
+   /* The font and background color are part of the shaped layout */
+   if(background)
+      key = g_strdup_printf("%s\x01%04x%04x%04x\x01%s", fc->fontname, (guint16)(background->red * 65535),
+                            (guint16)(background->green * 65535), (guint16)(background->blue * 65535), text);
+   else
+      key = g_strdup_printf("%s\x01-\x01%s", fc->fontname, text);
+
+   if((tc = (DWTextCache *)g_hash_table_lookup(_dw_text_cache, key)))
+   {
+      g_free(key);
+      g_queue_unlink(&_dw_text_cache_lru, tc->link);
+      g_queue_push_head_link(&_dw_text_cache_lru, tc->link);
+      /* The layout will only be shaped again if the context actually changed */
+      pango_cairo_update_context(cr, pango_layout_get_context(tc->layout));
+      return tc->layout;
+   }
+
+   if(!_dw_font_cache_layout(fc, cr) || !(tc = calloc(1, sizeof(DWTextCache))))
+   {
+      g_free(key);
+      return NULL;
+   }
+   tc->key = key;
+   tc->layout = pango_layout_new(fc->context);
+   pango_layout_set_font_description(tc->layout, fc->font);
+   pango_layout_set_text(tc->layout, text, -1);
+   if((list = _dw_text_attributes(background)))
+   {
+      pango_layout_set_attributes(tc->layout, list);
+      pango_attr_list_unref(list);
+   }
+   g_queue_push_head(&_dw_text_cache_lru, tc);
+   tc->link = g_queue_peek_head_link(&_dw_text_cache_lru);
+   g_hash_table_insert(_dw_text_cache, tc->key, tc);
+   _dw_text_cache_trim(_dw_text_cache_max);
+   return tc->layout;
+}
+
+/* Internal function to return the cached layout used to measure a font,
+ * the layout is recreated if the requested Pango context changes.
+ */
+static PangoLayout *_dw_font_cache_extents_layout(DWFontCache *fc, PangoContext *context)
+{
+   if(!context)
+      return NULL;
+   if(fc->extcontext != context)
+   {
+      if(fc->extlayout)
+         g_object_unref(fc->extlayout);
+      if(fc->extcontext)
+         g_object_unref(fc->extcontext);
+      fc->extlayout = NULL;
+      fc->extcontext = g_object_ref(context);
+   }
+   if(!fc->extlayout && (fc->extlayout = pango_layout_new(fc->extcontext)))
+      pango_layout_set_font_description(fc->extlayout, fc->font);
+   return fc->extlayout;
+}
+
+/* Internal function to measure text with a font, using the extents cache */
+static void _dw_text_extents(PangoContext *context, const char *fontname, const char *text, int *width, int *height)
+{
+   unsigned int hash = _dw_extents_cache_hash(fontname, text);
+   DWExtentsCache *ec = &_dw_extents_cache[hash % _DW_EXTENTS_CACHE_MAX];
+   DWFontCache *fc;
+
+   if(ec->text && ec->hash == hash && strcmp(ec->text, text) == 0 && strcmp(ec->fontname, fontname) == 0)
+   {
+      if(width)
+         *width = ec->width;
+      if(height)
+         *height = ec->height;
+      return;
+   }
+
+   if((fc = _dw_font_cache_get(fontname)))
+   {
+      PangoLayout *layout = _dw_font_cache_extents_layout(fc, context);
+
+      if(layout)
+      {
+         PangoRectangle rect;
+
+         pango_layout_set_text(layout, text, -1);
+         pango_layout_get_pixel_extents(layout, NULL, &rect);
+
+         if(width)
+            *width = rect.width;
+         if(height)
+            *height = rect.height;
+
+         /* Save the result, replacing whatever was in the slot */
+         if(strlen(text) < _DW_EXTENTS_CACHE_TEXT_MAX)
+         {
+            if(ec->text)
+            {
+               free(ec->fontname);
+               free(ec->text);
+            }
+            ec->hash = hash;
+            ec->fontname = strdup(fontname);
+            ec->text = strdup(text);
+            ec->width = rect.width;
+            ec->height = rect.height;
+         }
+      }
+   }
+}
+
+/* Internal functions to convert to GTK3 style CSS */
+static void _dw_override_color(GtkWidget *widget, const char *element, GdkRGBA *color)
+{
+   gchar *dataname = g_strdup_printf ("_dw_color_%s", element);
+   GtkCssProvider *provider = g_object_get_data(G_OBJECT(widget), dataname);
+   GtkStyleContext *scontext = gtk_widget_get_style_context(widget);
+   
+   /* If we have an old context from a previous override remove it */
+   if(provider)
+   {
+      gtk_style_context_remove_provider(scontext, GTK_STYLE_PROVIDER(provider));
+      g_object_unref(provider);
+      provider = NULL;
+   }
+   
+   /* If we have a new color, create a new provider and add it */
+   if(color)
+   {
+      gchar *scolor = gdk_rgba_to_string(color);
+      gchar *css = g_strdup_printf ("* { %s: %s; }", element, scolor);
+      
+      provider = gtk_css_provider_new();
+      g_free(scolor);
+      gtk_css_provider_load_from_data(provider, css, -1);
+      g_free(css);
+      gtk_style_context_add_provider(scontext, GTK_STYLE_PROVIDER(provider), GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+   }
+   g_object_set_data(G_OBJECT(widget), dataname, (gpointer)provider);
+   g_free(dataname);
+}
 
 static void _dw_override_font(GtkWidget *widget, const char *font)
 {
@@ -2377,7 +3315,10 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, fontname, const char *)
    data = g_object_get_data(G_OBJECT(handle2), "_dw_fontname");
    g_object_set_data(G_OBJECT(handle2), "_dw_fontname", (gpointer)font);
    if(data)
+   {
+      _dw_font_cache_invalidate((char *)data);
       free(data);
+   }
 
    if(!GTK_IS_DRAWING_AREA(handle2))
       _dw_override_font(handle2, font);
@@ -3573,131 +4514,669 @@ GtkWidget *_dw_tree_view_setup(GtkWidget *tmp, GtkTreeModel *store)
    return tree;
 }
 
-/*
- * Create a container object to be packed.
- * Parameters:
- *       id: An ID to be used for getting the resource from the
- *           resource file.
+/* Returns the model of a tree view, including while a freeze has it detached.
+ * When a container is filtered this is the store underneath the filter.
  */
-DW_FUNCTION_DEFINITION(dw_container_new, HWND, ULONG cid, int multi)
-DW_FUNCTION_ADD_PARAM2(cid, multi)
-DW_FUNCTION_RETURN(dw_container_new, HWND)
-DW_FUNCTION_RESTORE_PARAM2(cid, ULONG, multi, int)
+static GtkTreeModel *_dw_tree_view_get_model(GtkTreeView *view)
 {
-   GtkWidget *tmp;
+   GtkTreeModel *model = (GtkTreeModel *)g_object_get_data(G_OBJECT(view), "_dw_frozen_model");
 
-   if((tmp = _dw_tree_create(cid)))
-   {
-      g_object_set_data(G_OBJECT(tmp), "_dw_tree_type", GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER));
-      g_object_set_data(G_OBJECT(tmp), "_dw_multi_sel", GINT_TO_POINTER(multi));
-   }
-   DW_FUNCTION_RETURN_THIS(tmp);
+   if(!model)
+      model = gtk_tree_view_get_model(view);
+   if(model && GTK_IS_TREE_MODEL_FILTER(model))
+      return gtk_tree_model_filter_get_model(GTK_TREE_MODEL_FILTER(model));
+   return model;
 }
 
-/*
- * Create a tree object to be packed.
- * Parameters:
- *       id: An ID to be used for getting the resource from the
- *           resource file.
+/* Internal functions to convert paths between a filtered view and its store,
+ * they take over the path passed in.  Rows hidden by the filter return NULL.
  */
-DW_FUNCTION_DEFINITION(dw_tree_new, HWND, ULONG cid)
-DW_FUNCTION_ADD_PARAM1(cid)
-DW_FUNCTION_RETURN(dw_tree_new, HWND)
-DW_FUNCTION_RESTORE_PARAM1(cid, ULONG)
+static GtkTreePath *_dw_tree_view_path_to_store(GtkTreeView *view, GtkTreePath *path)
 {
-   GtkWidget *tmp, *tree;
-   GtkTreeStore *store;
-   GtkTreeViewColumn *col;
-   GtkCellRenderer *rend;
-   GtkTreeSelection *sel;
+   GtkTreeModel *model = gtk_tree_view_get_model(view);
 
-   if((tmp = _dw_tree_create(cid)))
+   if(path && model && GTK_IS_TREE_MODEL_FILTER(model))
    {
-      store = gtk_tree_store_new(4, G_TYPE_STRING, GDK_TYPE_PIXBUF, G_TYPE_POINTER, G_TYPE_POINTER);
-      tree = _dw_tree_view_setup(tmp, GTK_TREE_MODEL(store));
-      g_object_set_data(G_OBJECT(tmp), "_dw_tree_type", GINT_TO_POINTER(_DW_TREE_TYPE_TREE));
-      g_object_set_data(G_OBJECT(tree), "_dw_tree_type", GINT_TO_POINTER(_DW_TREE_TYPE_TREE));
-      col = gtk_tree_view_column_new();
+      GtkTreePath *child = gtk_tree_model_filter_convert_path_to_child_path(GTK_TREE_MODEL_FILTER(model), path);
 
-      rend = gtk_cell_renderer_pixbuf_new();
-      gtk_tree_view_column_pack_start(col, rend, FALSE);
-      gtk_tree_view_column_add_attribute(col, rend, "pixbuf", 1);
-      rend = gtk_cell_renderer_text_new();
-      gtk_tree_view_column_pack_start(col, rend, TRUE);
-      gtk_tree_view_column_add_attribute(col, rend, "text", 0);
+      gtk_tree_path_free(path);
+      return child;
+   }
+   return path;
+}
 
-      gtk_tree_view_append_column(GTK_TREE_VIEW (tree), col);
-      gtk_tree_view_set_expander_column(GTK_TREE_VIEW(tree), col);
-      gtk_tree_view_set_headers_visible(GTK_TREE_VIEW(tree), FALSE);
+static GtkTreePath *_dw_tree_view_path_from_store(GtkTreeView *view, GtkTreePath *path)
+{
+   GtkTreeModel *model = gtk_tree_view_get_model(view);
 
-      sel = gtk_tree_view_get_selection(GTK_TREE_VIEW(tree));
-      gtk_tree_selection_set_mode(sel, GTK_SELECTION_SINGLE);
-      gtk_widget_set_visible(tree, TRUE);
+   if(path && model && GTK_IS_TREE_MODEL_FILTER(model))
+   {
+      GtkTreePath *filterpath = gtk_tree_model_filter_convert_child_path_to_path(GTK_TREE_MODEL_FILTER(model), path);
 
-      if(_DWDefaultFont)
-         dw_window_set_font(tmp, _DWDefaultFont);
+      gtk_tree_path_free(path);
+      return filterpath;
    }
-   DW_FUNCTION_RETURN_THIS(tmp);
+   return path;
 }
 
+/* Versions of the GTK selection and cursor functions that return store rows */
+static void _dw_tree_view_get_cursor(GtkTreeView *view, GtkTreePath **path, GtkTreeViewColumn **column)
+{
+   gtk_tree_view_get_cursor(view, path, column);
+   if(path)
+      *path = _dw_tree_view_path_to_store(view, *path);
+}
 
-/*
- * Create a new static text window (widget) to be packed.
- * Parameters:
- *       text: The text to be display by the static text widget.
- *       id: An ID to be used with dw_window_from_id() or 0L.
- */
-DW_FUNCTION_DEFINITION(dw_text_new, HWND, const char *text, ULONG cid)
-DW_FUNCTION_ADD_PARAM2(text, cid)
-DW_FUNCTION_RETURN(dw_text_new, HWND)
-DW_FUNCTION_RESTORE_PARAM2(text, const char *, cid, ULONG)
+static GList *_dw_tree_selection_get_selected_rows(GtkTreeSelection *sel, GtkTreeModel **model)
 {
-   GtkWidget *tmp = gtk_label_new(text);
+   GtkTreeView *view = gtk_tree_selection_get_tree_view(sel);
+   GList *list = gtk_tree_selection_get_selected_rows(sel, NULL), *item;
 
-   /* Left and centered */
-   gtk_label_set_xalign(GTK_LABEL(tmp), 0.0f);
-   gtk_label_set_yalign(GTK_LABEL(tmp), 0.5f);
-   gtk_widget_set_visible(tmp, TRUE);
-   g_object_set_data(G_OBJECT(tmp), "_dw_id", GINT_TO_POINTER(cid));
-   if(_DWDefaultFont)
-      dw_window_set_font(tmp, _DWDefaultFont);
-   DW_FUNCTION_RETURN_THIS(tmp);
+   for(item=list;item;item=item->next)
+      item->data = _dw_tree_view_path_to_store(view, (GtkTreePath *)item->data);
+   if(model)
+      *model = _dw_tree_view_get_model(view);
+   return list;
 }
 
-/*
- * Create a new status text window (widget) to be packed.
- * Parameters:
- *       text: The text to be display by the static text widget.
- *       id: An ID to be used with dw_window_from_id() or 0L.
- */
-DW_FUNCTION_DEFINITION(dw_status_text_new, HWND, const char *text, ULONG cid)
-DW_FUNCTION_ADD_PARAM2(text, cid)
-DW_FUNCTION_RETURN(dw_status_text_new, HWND)
-DW_FUNCTION_RESTORE_PARAM2(text, const char *, cid, ULONG)
+static gboolean _dw_tree_selection_get_selected(GtkTreeSelection *sel, GtkTreeModel **model, GtkTreeIter *iter)
 {
-   GtkWidget *tmp, *frame = gtk_frame_new(NULL);
-   tmp = gtk_label_new(text);
-   gtk_frame_set_child(GTK_FRAME(frame), tmp);
-   gtk_widget_set_visible(tmp, TRUE);
-   gtk_widget_set_visible(frame, TRUE);
+   GtkTreeModel *filter;
+   GtkTreeIter child;
 
-   /* Left and centered */
-   gtk_label_set_xalign(GTK_LABEL(tmp), 0.0f);
-   gtk_label_set_yalign(GTK_LABEL(tmp), 0.5f);
-   g_object_set_data(G_OBJECT(frame), "_dw_id", GINT_TO_POINTER(cid));
-   g_object_set_data(G_OBJECT(frame), "_dw_label", (gpointer)tmp);
-   if(_DWDefaultFont)
-      dw_window_set_font(tmp, _DWDefaultFont);
-   DW_FUNCTION_RETURN_THIS(frame);
+   if(!gtk_tree_selection_get_selected(sel, &filter, &child))
+      return FALSE;
+   if(filter && GTK_IS_TREE_MODEL_FILTER(filter))
+   {
+      GtkTreeIter filteriter = child;
+
+      gtk_tree_model_filter_convert_iter_to_child_iter(GTK_TREE_MODEL_FILTER(filter), &child, &filteriter);
+      filter = gtk_tree_model_filter_get_model(GTK_TREE_MODEL_FILTER(filter));
+   }
+   if(model)
+      *model = filter;
+   if(iter)
+      *iter = child;
+   return TRUE;
 }
 
-/*
- * Create a new Multiline Editbox window (widget) to be packed.
- * Parameters:
- *       id: An ID to be used with dw_window_from_id() or 0L.
- */
-DW_FUNCTION_DEFINITION(dw_mle_new, HWND, ULONG cid)
-DW_FUNCTION_ADD_PARAM1(cid)
+/* Internal function to remember the expanded rows of a frozen tree */
+static void _dw_tree_view_save_expanded(GtkTreeView *tree, GtkTreePath *path, gpointer data)
+{
+   GList **refs = (GList **)data;
+
+   *refs = g_list_prepend(*refs, gtk_tree_row_reference_new(gtk_tree_view_get_model(tree), path));
+}
+
+/* Internal function to detach the model of a tree view during bulk
+ * changes, so the view does not size and validate each row as it is
+ * added.  Row references track the selection and cursor while it is
+ * detached, so they can be restored when the model is reattached.
+ */
+static void _dw_tree_view_freeze(HWND handle, int type, int freeze)
+{
+   GtkWidget *tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user");
+   int frozen;
+
+   /* Make sure it is the correct tree type */
+   if(!tree || !GTK_IS_TREE_VIEW(tree) || g_object_get_data(G_OBJECT(tree), "_dw_tree_type") != GINT_TO_POINTER(type))
+      return;
+
+   frozen = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(tree), "_dw_frozen"));
+   if(freeze)
+   {
+      g_object_set_data(G_OBJECT(tree), "_dw_frozen", GINT_TO_POINTER(frozen+1));
+      if(!frozen)
+      {
+         GtkTreeModel *model = gtk_tree_view_get_model(GTK_TREE_VIEW(tree));
+         GtkTreeSelection *sel = gtk_tree_view_get_selection(GTK_TREE_VIEW(tree));
+         GList *list = gtk_tree_selection_get_selected_rows(sel, NULL), *item, *refs = NULL;
+         GtkTreePath *path;
+
+         if(!model)
+            return;
+         for(item=list;item;item=item->next)
+            refs = g_list_prepend(refs, gtk_tree_row_reference_new(model, (GtkTreePath *)item->data));
+         g_list_foreach(list, (GFunc) gtk_tree_path_free, NULL);
+         g_list_free(list);
+         gtk_tree_view_get_cursor(GTK_TREE_VIEW(tree), &path, NULL);
+         if(path)
+         {
+            g_object_set_data(G_OBJECT(tree), "_dw_frozen_cursor", (gpointer)gtk_tree_row_reference_new(model, path));
+            gtk_tree_path_free(path);
+         }
+         g_object_set_data(G_OBJECT(tree), "_dw_frozen_selection", (gpointer)refs);
+         /* Detaching the model collapses the tree, parents are saved before children */
+         if(type == _DW_TREE_TYPE_TREE)
+         {
+            refs = NULL;
+            gtk_tree_view_map_expanded_rows(GTK_TREE_VIEW(tree), _dw_tree_view_save_expanded, &refs);
+            g_object_set_data(G_OBJECT(tree), "_dw_frozen_expanded", (gpointer)g_list_reverse(refs));
+         }
+         g_object_ref(G_OBJECT(model));
+         g_object_set_data(G_OBJECT(tree), "_dw_frozen_model", (gpointer)model);
+         gtk_tree_view_set_model(GTK_TREE_VIEW(tree), NULL);
+      }
+   }
+   else if(frozen == 1)
+   {
+      GtkTreeModel *model = (GtkTreeModel *)g_object_get_data(G_OBJECT(tree), "_dw_frozen_model");
+      GtkTreeRowReference *cursor = (GtkTreeRowReference *)g_object_get_data(G_OBJECT(tree), "_dw_frozen_cursor");
+      GList *refs = (GList *)g_object_get_data(G_OBJECT(tree), "_dw_frozen_selection"), *item;
+      GList *expanded = (GList *)g_object_get_data(G_OBJECT(tree), "_dw_frozen_expanded");
+
+      if(model)
+      {
+         GtkTreeSelection *sel = gtk_tree_view_get_selection(GTK_TREE_VIEW(tree));
+
+         gtk_tree_view_set_model(GTK_TREE_VIEW(tree), model);
+         g_object_set_data(G_OBJECT(tree), "_dw_frozen_model", NULL);
+         g_object_unref(G_OBJECT(model));
+
+         for(item=expanded;item;item=item->next)
+         {
+            GtkTreeRowReference *ref = (GtkTreeRowReference *)item->data;
+
+            if(gtk_tree_row_reference_valid(ref))
+            {
+               GtkTreePath *path = gtk_tree_row_reference_get_path(ref);
+
+               gtk_tree_view_expand_row(GTK_TREE_VIEW(tree), path, FALSE);
+               gtk_tree_path_free(path);
+            }
+         }
+         /* The cursor moves the selection, so restore it first */
+         if(cursor && gtk_tree_row_reference_valid(cursor))
+         {
+            GtkTreePath *path = gtk_tree_row_reference_get_path(cursor);
+
+            gtk_tree_view_set_cursor(GTK_TREE_VIEW(tree), path, NULL, FALSE);
+            gtk_tree_selection_unselect_all(sel);
+            gtk_tree_path_free(path);
+         }
+         for(item=refs;item;item=item->next)
+         {
+            GtkTreeRowReference *ref = (GtkTreeRowReference *)item->data;
+
+            if(gtk_tree_row_reference_valid(ref))
+            {
+               GtkTreePath *path = gtk_tree_row_reference_get_path(ref);
+
+               gtk_tree_selection_select_path(sel, path);
+               gtk_tree_path_free(path);
+            }
+         }
+      }
+      if(cursor)
+         gtk_tree_row_reference_free(cursor);
+      g_list_foreach(refs, (GFunc) gtk_tree_row_reference_free, NULL);
+      g_list_free(refs);
+      g_list_foreach(expanded, (GFunc) gtk_tree_row_reference_free, NULL);
+      g_list_free(expanded);
+      g_object_set_data(G_OBJECT(tree), "_dw_frozen_expanded", NULL);
+      g_object_set_data(G_OBJECT(tree), "_dw_frozen_cursor", NULL);
+      g_object_set_data(G_OBJECT(tree), "_dw_frozen_selection", NULL);
+      g_object_set_data(G_OBJECT(tree), "_dw_frozen", NULL);
+   }
+   else if(frozen > 1)
+      g_object_set_data(G_OBJECT(tree), "_dw_frozen", GINT_TO_POINTER(frozen-1));
+}
+
+/* Virtual list model for listboxes and comboboxes, the text of each row
+ * is requested from the application when the view needs to show it.
+ */
+typedef struct _DWVirtualList {
+   GObject parent;
+   gint stamp;
+   int count;
+   HWND handle;
+   char *(*textfunc)(HWND, int, void *);
+   void *data;
+} DWVirtualList;
+
+typedef struct _DWVirtualListClass {
+   GObjectClass parent_class;
+} DWVirtualListClass;
+
+static void _dw_virtual_list_tree_model_init(GtkTreeModelIface *iface);
+
+G_DEFINE_TYPE_WITH_CODE(DWVirtualList, _dw_virtual_list, G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(GTK_TYPE_TREE_MODEL, _dw_virtual_list_tree_model_init))
+
+#define _DW_IS_VIRTUAL_LIST(obj) G_TYPE_CHECK_INSTANCE_TYPE((obj), _dw_virtual_list_get_type())
+
+static void _dw_virtual_list_init(DWVirtualList *list)
+{
+   list->stamp = g_random_int();
+}
+
+static void _dw_virtual_list_class_init(DWVirtualListClass *klass)
+{
+}
+
+/* Internal function to point an iter at a row */
+static gboolean _dw_virtual_list_iter_set(DWVirtualList *list, GtkTreeIter *iter, gint index)
+{
+   if(index < 0 || index >= list->count)
+   {
+      iter->stamp = 0;
+      return FALSE;
+   }
+   iter->stamp = list->stamp;
+   iter->user_data = GINT_TO_POINTER(index);
+   return TRUE;
+}
+
+static GtkTreeModelFlags _dw_virtual_list_get_flags(GtkTreeModel *model)
+{
+   return GTK_TREE_MODEL_LIST_ONLY | GTK_TREE_MODEL_ITERS_PERSIST;
+}
+
+static gint _dw_virtual_list_get_n_columns(GtkTreeModel *model)
+{
+   return 1;
+}
+
+static GType _dw_virtual_list_get_column_type(GtkTreeModel *model, gint index)
+{
+   return G_TYPE_STRING;
+}
+
+static gboolean _dw_virtual_list_get_iter(GtkTreeModel *model, GtkTreeIter *iter, GtkTreePath *path)
+{
+   if(gtk_tree_path_get_depth(path) != 1)
+      return FALSE;
+   return _dw_virtual_list_iter_set((DWVirtualList *)model, iter, gtk_tree_path_get_indices(path)[0]);
+}
+
+static GtkTreePath *_dw_virtual_list_get_path(GtkTreeModel *model, GtkTreeIter *iter)
+{
+   return gtk_tree_path_new_from_indices(GPOINTER_TO_INT(iter->user_data), -1);
+}
+
+static void _dw_virtual_list_get_value(GtkTreeModel *model, GtkTreeIter *iter, gint column, GValue *value)
+{
+   DWVirtualList *list = (DWVirtualList *)model;
+   char *text = NULL;
+
+   g_value_init(value, G_TYPE_STRING);
+   if(list->textfunc && iter->stamp == list->stamp)
+      text = list->textfunc(list->handle, GPOINTER_TO_INT(iter->user_data), list->data);
+   g_value_set_string(value, text ? text : "");
+}
+
+static gboolean _dw_virtual_list_iter_next(GtkTreeModel *model, GtkTreeIter *iter)
+{
+   return _dw_virtual_list_iter_set((DWVirtualList *)model, iter, GPOINTER_TO_INT(iter->user_data) + 1);
+}
+
+static gboolean _dw_virtual_list_iter_nth_child(GtkTreeModel *model, GtkTreeIter *iter, GtkTreeIter *parent, gint n)
+{
+   if(parent)
+   {
+      iter->stamp = 0;
+      return FALSE;
+   }
+   return _dw_virtual_list_iter_set((DWVirtualList *)model, iter, n);
+}
+
+static gboolean _dw_virtual_list_iter_children(GtkTreeModel *model, GtkTreeIter *iter, GtkTreeIter *parent)
+{
+   return _dw_virtual_list_iter_nth_child(model, iter, parent, 0);
+}
+
+static gboolean _dw_virtual_list_iter_has_child(GtkTreeModel *model, GtkTreeIter *iter)
+{
+   return FALSE;
+}
+
+static gint _dw_virtual_list_iter_n_children(GtkTreeModel *model, GtkTreeIter *iter)
+{
+   return iter ? 0 : ((DWVirtualList *)model)->count;
+}
+
+static gboolean _dw_virtual_list_iter_parent(GtkTreeModel *model, GtkTreeIter *iter, GtkTreeIter *child)
+{
+   iter->stamp = 0;
+   return FALSE;
+}
+
+static void _dw_virtual_list_tree_model_init(GtkTreeModelIface *iface)
+{
+   iface->get_flags = _dw_virtual_list_get_flags;
+   iface->get_n_columns = _dw_virtual_list_get_n_columns;
+   iface->get_column_type = _dw_virtual_list_get_column_type;
+   iface->get_iter = _dw_virtual_list_get_iter;
+   iface->get_path = _dw_virtual_list_get_path;
+   iface->get_value = _dw_virtual_list_get_value;
+   iface->iter_next = _dw_virtual_list_iter_next;
+   iface->iter_children = _dw_virtual_list_iter_children;
+   iface->iter_has_child = _dw_virtual_list_iter_has_child;
+   iface->iter_n_children = _dw_virtual_list_iter_n_children;
+   iface->iter_nth_child = _dw_virtual_list_iter_nth_child;
+   iface->iter_parent = _dw_virtual_list_iter_parent;
+}
+
+/* Internal function to replace the model of a listbox or combobox,
+ * the caller's reference to the model is taken over.
+ */
+static void _dw_listbox_set_model(GtkWidget *handle2, GtkTreeModel *model, int fixed)
+{
+   if(GTK_IS_TREE_VIEW(handle2))
+   {
+      GtkTreeModel *frozen = (GtkTreeModel *)g_object_get_data(G_OBJECT(handle2), "_dw_frozen_model");
+      GtkTreeViewColumn *col = gtk_tree_view_get_column(GTK_TREE_VIEW(handle2), 0);
+
+      /* In fixed height mode the view only asks for the visible rows,
+       * which requires fixed column sizing, so switch in that order.
+       */
+      if(!fixed)
+         gtk_tree_view_set_fixed_height_mode(GTK_TREE_VIEW(handle2), FALSE);
+      if(col)
+      {
+         gtk_tree_view_column_set_sizing(col, fixed ? GTK_TREE_VIEW_COLUMN_FIXED : GTK_TREE_VIEW_COLUMN_GROW_ONLY);
+         gtk_tree_view_column_set_expand(col, fixed);
+      }
+      if(fixed)
+         gtk_tree_view_set_fixed_height_mode(GTK_TREE_VIEW(handle2), TRUE);
+      /* While frozen the new model is attached by the thaw */
+      if(frozen)
+      {
+         g_object_set_data(G_OBJECT(handle2), "_dw_frozen_model", (gpointer)model);
+         g_object_unref(G_OBJECT(frozen));
+         return;
+      }
+      gtk_tree_view_set_model(GTK_TREE_VIEW(handle2), model);
+   }
+   else if(GTK_IS_COMBO_BOX(handle2))
+      gtk_combo_box_set_model(GTK_COMBO_BOX(handle2), model);
+   g_object_unref(G_OBJECT(model));
+}
+
+/* Internal function to create a virtual list model */
+static GtkTreeModel *_dw_virtual_list_new(HWND handle, int count, void *textfunc, void *data)
+{
+   DWVirtualList *list = g_object_new(_dw_virtual_list_get_type(), NULL);
+
+   list->count = count > 0 ? count : 0;
+   list->handle = handle;
+   list->textfunc = (char *(*)(HWND, int, void *))textfunc;
+   list->data = data;
+   return GTK_TREE_MODEL(list);
+}
+
+/*
+ * Create a container object to be packed.
+ * Parameters:
+ *       id: An ID to be used for getting the resource from the
+ *           resource file.
+ */
+DW_FUNCTION_DEFINITION(dw_container_new, HWND, ULONG cid, int multi)
+DW_FUNCTION_ADD_PARAM2(cid, multi)
+DW_FUNCTION_RETURN(dw_container_new, HWND)
+DW_FUNCTION_RESTORE_PARAM2(cid, ULONG, multi, int)
+{
+   GtkWidget *tmp;
+
+   if((tmp = _dw_tree_create(cid)))
+   {
+      g_object_set_data(G_OBJECT(tmp), "_dw_tree_type", GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER));
+      g_object_set_data(G_OBJECT(tmp), "_dw_multi_sel", GINT_TO_POINTER(multi));
+   }
+   DW_FUNCTION_RETURN_THIS(tmp);
+}
+
+/* Tree item handles are GtkTreeIters carved out of blocks owned by the
+ * tree. Deleted handles are chained through user_data for reuse, and
+ * clearing the tree releases all the blocks without walking the items.
+ */
+#define _DW_TREE_SLAB_SIZE 1024
+
+typedef struct _dwtreeslab
+{
+   struct _dwtreeslab *next;
+   int used;
+   GtkTreeIter iters[_DW_TREE_SLAB_SIZE];
+} DWTreeSlab;
+
+typedef struct _dwtreearena
+{
+   DWTreeSlab *slabs;
+   GtkTreeIter *freelist;
+} DWTreeArena;
+
+static void _dw_tree_arena_clear(DWTreeArena *arena)
+{
+   while(arena->slabs)
+   {
+      DWTreeSlab *next = arena->slabs->next;
+
+      free(arena->slabs);
+      arena->slabs = next;
+   }
+   arena->freelist = NULL;
+}
+
+static void _dw_tree_arena_free(gpointer data)
+{
+   _dw_tree_arena_clear((DWTreeArena *)data);
+   free(data);
+}
+
+/* Internal function to allocate a tree item handle */
+static GtkTreeIter *_dw_tree_iter_new(DWTreeArena *arena)
+{
+   GtkTreeIter *iter;
+
+   if(!arena)
+      return NULL;
+   if((iter = arena->freelist))
+      arena->freelist = (GtkTreeIter *)iter->user_data;
+   else
+   {
+      if(!arena->slabs || arena->slabs->used == _DW_TREE_SLAB_SIZE)
+      {
+         DWTreeSlab *slab = (DWTreeSlab *)malloc(sizeof(DWTreeSlab));
+
+         if(!slab)
+            return NULL;
+         slab->next = arena->slabs;
+         slab->used = 0;
+         arena->slabs = slab;
+      }
+      iter = &arena->slabs->iters[arena->slabs->used++];
+   }
+   return iter;
+}
+
+/* Internal function to return a tree item handle for reuse */
+static void _dw_tree_iter_free(DWTreeArena *arena, GtkTreeIter *iter)
+{
+   if(arena && iter)
+   {
+      iter->user_data = (gpointer)arena->freelist;
+      arena->freelist = iter;
+   }
+}
+
+/* Internal function to free the handles of all the descendants of an item */
+static void _dw_tree_free_children(DWTreeArena *arena, GtkTreeModel *store, GtkTreeIter *parent)
+{
+   GtkTreeIter iter;
+
+   if(gtk_tree_model_iter_children(store, &iter, parent))
+   {
+      do {
+         GtkTreeIter *handle = NULL;
+
+         _dw_tree_free_children(arena, store, &iter);
+         gtk_tree_model_get(store, &iter, 3, &handle, -1);
+         _dw_tree_iter_free(arena, handle);
+      } while(gtk_tree_model_iter_next(store, &iter));
+   }
+}
+
+/* Items marked with dw_tree_item_set_lazy() have their flags in store
+ * column 4, until they are populated they hold a placeholder child
+ * with no handle so the expander is shown.
+ */
+static int _dw_tree_lazy_placeholder(GtkTreeModel *store, GtkTreeIter *parent, GtkTreeIter *child)
+{
+   if(gtk_tree_model_iter_children(store, child, parent))
+   {
+      do {
+         HTREEITEM handle = NULL;
+
+         gtk_tree_model_get(store, child, 3, &handle, -1);
+         if(!handle)
+            return TRUE;
+      } while(gtk_tree_model_iter_next(store, child));
+   }
+   return FALSE;
+}
+
+/* Internal function to remove the placeholder once the expand handlers have inserted the children */
+static void _dw_tree_lazy_expanded(GtkTreeView *widget, GtkTreeIter *iter, GtkTreePath *path, gpointer data)
+{
+   GtkTreeModel *store = gtk_tree_view_get_model(widget);
+   GtkTreeIter child;
+   gint flags = 0;
+
+   /* Handlers are not called while frozen, so keep the placeholder */
+   if(!store || g_object_get_data(G_OBJECT(widget), "_dw_frozen"))
+      return;
+   gtk_tree_model_get(store, iter, 4, &flags, -1);
+   if((flags & DW_TREE_LAZY) && _dw_tree_lazy_placeholder(store, iter, &child))
+      gtk_tree_store_remove(GTK_TREE_STORE(store), &child);
+}
+
+/* Internal function to free the children of a collapsed DW_TREE_LAZY_DROP item */
+static void _dw_tree_lazy_collapsed(GtkTreeView *widget, GtkTreeIter *iter, GtkTreePath *path, gpointer data)
+{
+   GtkTreeModel *store = gtk_tree_view_get_model(widget);
+   GtkTreeIter child;
+   gint flags = 0;
+
+   if(!store)
+      return;
+   gtk_tree_model_get(store, iter, 4, &flags, -1);
+   if((flags & DW_TREE_LAZY_DROP) && !_dw_tree_lazy_placeholder(store, iter, &child))
+   {
+      _dw_tree_free_children((DWTreeArena *)g_object_get_data(G_OBJECT(widget), "_dw_tree_arena"), store, iter);
+      while(gtk_tree_model_iter_children(store, &child, iter))
+         gtk_tree_store_remove(GTK_TREE_STORE(store), &child);
+      gtk_tree_store_append(GTK_TREE_STORE(store), &child, iter);
+   }
+}
+
+/*
+ * Create a tree object to be packed.
+ * Parameters:
+ *       id: An ID to be used for getting the resource from the
+ *           resource file.
+ */
+DW_FUNCTION_DEFINITION(dw_tree_new, HWND, ULONG cid)
+DW_FUNCTION_ADD_PARAM1(cid)
+DW_FUNCTION_RETURN(dw_tree_new, HWND)
+DW_FUNCTION_RESTORE_PARAM1(cid, ULONG)
+{
+   GtkWidget *tmp, *tree;
+   GtkTreeStore *store;
+   GtkTreeViewColumn *col;
+   GtkCellRenderer *rend;
+   GtkTreeSelection *sel;
+
+   if((tmp = _dw_tree_create(cid)))
+   {
+      store = gtk_tree_store_new(5, G_TYPE_STRING, GDK_TYPE_PIXBUF, G_TYPE_POINTER, G_TYPE_POINTER, G_TYPE_INT);
+      tree = _dw_tree_view_setup(tmp, GTK_TREE_MODEL(store));
+      g_object_set_data(G_OBJECT(tmp), "_dw_tree_type", GINT_TO_POINTER(_DW_TREE_TYPE_TREE));
+      g_object_set_data(G_OBJECT(tree), "_dw_tree_type", GINT_TO_POINTER(_DW_TREE_TYPE_TREE));
+      g_object_set_data_full(G_OBJECT(tree), "_dw_tree_arena", calloc(1, sizeof(DWTreeArena)), _dw_tree_arena_free);
+      /* Connected after so the placeholder outlives the expand handlers */
+      g_signal_connect_after(G_OBJECT(tree), "row-expanded", G_CALLBACK(_dw_tree_lazy_expanded), NULL);
+      g_signal_connect(G_OBJECT(tree), "row-collapsed", G_CALLBACK(_dw_tree_lazy_collapsed), NULL);
+      col = gtk_tree_view_column_new();
+
+      rend = gtk_cell_renderer_pixbuf_new();
+      gtk_tree_view_column_pack_start(col, rend, FALSE);
+      gtk_tree_view_column_add_attribute(col, rend, "pixbuf", 1);
+      rend = gtk_cell_renderer_text_new();
+      gtk_tree_view_column_pack_start(col, rend, TRUE);
+      gtk_tree_view_column_add_attribute(col, rend, "text", 0);
+
+      gtk_tree_view_append_column(GTK_TREE_VIEW (tree), col);
+      gtk_tree_view_set_expander_column(GTK_TREE_VIEW(tree), col);
+      gtk_tree_view_set_headers_visible(GTK_TREE_VIEW(tree), FALSE);
+
+      sel = gtk_tree_view_get_selection(GTK_TREE_VIEW(tree));
+      gtk_tree_selection_set_mode(sel, GTK_SELECTION_SINGLE);
+      gtk_widget_set_visible(tree, TRUE);
+
+      if(_DWDefaultFont)
+         dw_window_set_font(tmp, _DWDefaultFont);
+   }
+   DW_FUNCTION_RETURN_THIS(tmp);
+}
+
+
+/*
+ * Create a new static text window (widget) to be packed.
+ * Parameters:
+ *       text: The text to be display by the static text widget.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ */
+DW_FUNCTION_DEFINITION(dw_text_new, HWND, const char *text, ULONG cid)
+DW_FUNCTION_ADD_PARAM2(text, cid)
+DW_FUNCTION_RETURN(dw_text_new, HWND)
+DW_FUNCTION_RESTORE_PARAM2(text, const char *, cid, ULONG)
+{
+   GtkWidget *tmp = gtk_label_new(text);
+
+   /* Left and centered */
+   gtk_label_set_xalign(GTK_LABEL(tmp), 0.0f);
+   gtk_label_set_yalign(GTK_LABEL(tmp), 0.5f);
+   gtk_widget_set_visible(tmp, TRUE);
+   g_object_set_data(G_OBJECT(tmp), "_dw_id", GINT_TO_POINTER(cid));
+   if(_DWDefaultFont)
+      dw_window_set_font(tmp, _DWDefaultFont);
+   DW_FUNCTION_RETURN_THIS(tmp);
+}
+
+/*
+ * Create a new status text window (widget) to be packed.
+ * Parameters:
+ *       text: The text to be display by the static text widget.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ */
+DW_FUNCTION_DEFINITION(dw_status_text_new, HWND, const char *text, ULONG cid)
+DW_FUNCTION_ADD_PARAM2(text, cid)
+DW_FUNCTION_RETURN(dw_status_text_new, HWND)
+DW_FUNCTION_RESTORE_PARAM2(text, const char *, cid, ULONG)
+{
+   GtkWidget *tmp, *frame = gtk_frame_new(NULL);
+   tmp = gtk_label_new(text);
+   gtk_frame_set_child(GTK_FRAME(frame), tmp);
+   gtk_widget_set_visible(tmp, TRUE);
+   gtk_widget_set_visible(frame, TRUE);
+
+   /* Left and centered */
+   gtk_label_set_xalign(GTK_LABEL(tmp), 0.0f);
+   gtk_label_set_yalign(GTK_LABEL(tmp), 0.5f);
+   g_object_set_data(G_OBJECT(frame), "_dw_id", GINT_TO_POINTER(cid));
+   g_object_set_data(G_OBJECT(frame), "_dw_label", (gpointer)tmp);
+   if(_DWDefaultFont)
+      dw_window_set_font(tmp, _DWDefaultFont);
+   DW_FUNCTION_RETURN_THIS(frame);
+}
+
+/*
+ * Create a new Multiline Editbox window (widget) to be packed.
+ * Parameters:
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ */
+DW_FUNCTION_DEFINITION(dw_mle_new, HWND, ULONG cid)
+DW_FUNCTION_ADD_PARAM1(cid)
 DW_FUNCTION_RETURN(dw_mle_new, HWND)
 DW_FUNCTION_RESTORE_PARAM1(cid, ULONG)
 {
@@ -4465,16 +5944,163 @@ DW_FUNCTION_RESTORE_PARAM4(handle, HWND, buffer, char *, startpoint, int, length
          gtk_text_buffer_get_iter_at_offset(tbuffer, &start, startpoint);
          gtk_text_buffer_get_iter_at_offset(tbuffer, &end, startpoint + length);
          text = gtk_text_iter_get_text(&start, &end);
-         if(text) /* Should this get freed? */
+         if(text)
          {
             if(buffer)
                strcpy(buffer, text);
+            g_free(text);
          }
       }
    }
    DW_FUNCTION_RETURN_NOTHING;
 }
 
+#define _DW_MLE_CHUNK 65536
+
+/* Internal function to insert the UTF-8 text in a chunk, a character split
+ * at the end is moved to the front of the buffer and its length returned.
+ */
+static int _dw_mle_insert_chunk(GtkTextBuffer *tbuffer, GtkTextIter *iter, char *buffer, int length)
+{
+   char *pos = buffer;
+
+   for(;;)
+   {
+      const gchar *end;
+      int valid;
+
+      g_utf8_validate(pos, length, &end);
+      if((valid = (int)(end - pos)))
+      {
+         gtk_text_buffer_insert(tbuffer, iter, pos, valid);
+         pos += valid;
+         length -= valid;
+      }
+      if(!length || g_utf8_get_char_validated(pos, length) == (gunichar)-2)
+         break;
+      /* Skip bytes that are not UTF-8 */
+      pos++;
+      length--;
+   }
+   memmove(buffer, pos, length);
+   return length;
+}
+
+/*
+ * Appends text to an MLE box in chunks read by a callback, so large
+ * files do not need to be loaded into memory first.  The callback is
+ * called with the MLE detached from its view, so it must not use the MLE.
+ * Parameters:
+ *          handle: Handle to the MLE to be inserted into.
+ *          readfunc: Function that fills in the next chunk of UTF-8 text,
+ *                    with the prototype int readfunc(HWND handle, char *buffer, int length, void *data).
+ *                    It returns the number of bytes read, 0 at the end or -1 on error.
+ *          data: Pointer passed to the read function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success, DW_ERROR_GENERAL on a read error or if
+ *       the text ends partway through a UTF-8 character, which is replaced by
+ *       U+FFFD so the loss is visible.
+ */
+DW_FUNCTION_DEFINITION(dw_mle_import_stream, int, HWND handle, void *readfunc, void *data)
+DW_FUNCTION_ADD_PARAM3(handle, readfunc, data)
+DW_FUNCTION_RETURN(dw_mle_import_stream, int)
+DW_FUNCTION_RESTORE_PARAM3(handle, HWND, readfunc, void *, data, void *)
+{
+   int (*func)(HWND, char *, int, void *) = (int (*)(HWND, char *, int, void *))readfunc;
+   int retval = DW_ERROR_GENERAL;
+
+   if(func && GTK_IS_SCROLLED_WINDOW(handle))
+   {
+      GtkWidget *tmp = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user");
+      char *buffer;
+
+      if(tmp && GTK_IS_TEXT_VIEW(tmp) && (buffer = malloc(_DW_MLE_CHUNK)))
+      {
+         GtkTextBuffer *tbuffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(tmp));
+         GtkTextIter iter;
+         int carry = 0, length;
+
+         /* Detach the buffer so the view does not lay out each chunk */
+         g_object_ref(G_OBJECT(tbuffer));
+         gtk_text_view_set_buffer(GTK_TEXT_VIEW(tmp), NULL);
+         gtk_text_buffer_get_end_iter(tbuffer, &iter);
+         retval = DW_ERROR_NONE;
+         while((length = func(handle, buffer + carry, _DW_MLE_CHUNK - carry, data)) != 0)
+         {
+            if(length < 0)
+            {
+               retval = DW_ERROR_GENERAL;
+               break;
+            }
+            carry = _dw_mle_insert_chunk(tbuffer, &iter, buffer, carry + length);
+         }
+         /* The stream ended in the middle of a character */
+         if(carry && retval == DW_ERROR_NONE)
+         {
+            gtk_text_buffer_insert(tbuffer, &iter, "\xEF\xBF\xBD", 3);
+            retval = DW_ERROR_GENERAL;
+         }
+         gtk_text_view_set_buffer(GTK_TEXT_VIEW(tmp), tbuffer);
+         g_object_unref(G_OBJECT(tbuffer));
+         free(buffer);
+      }
+   }
+   DW_FUNCTION_RETURN_THIS(retval);
+}
+
+/*
+ * Passes the text of an MLE box to a callback in chunks, so large
+ * contents do not need a buffer big enough for all the text.
+ * Parameters:
+ *          handle: Handle to the MLE to be queried.
+ *          writefunc: Function that receives each chunk of UTF-8 text,
+ *                     with the prototype int writefunc(HWND handle, const char *buffer, int length, void *data).
+ *                     It returns the number of bytes written, less than length stops the export.
+ *          data: Pointer passed to the write function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+DW_FUNCTION_DEFINITION(dw_mle_export_stream, int, HWND handle, void *writefunc, void *data)
+DW_FUNCTION_ADD_PARAM3(handle, writefunc, data)
+DW_FUNCTION_RETURN(dw_mle_export_stream, int)
+DW_FUNCTION_RESTORE_PARAM3(handle, HWND, writefunc, void *, data, void *)
+{
+   int (*func)(HWND, const char *, int, void *) = (int (*)(HWND, const char *, int, void *))writefunc;
+   int retval = DW_ERROR_GENERAL;
+
+   if(func && GTK_IS_SCROLLED_WINDOW(handle))
+   {
+      GtkWidget *tmp = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user");
+
+      if(tmp && GTK_IS_TEXT_VIEW(tmp))
+      {
+         GtkTextBuffer *tbuffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(tmp));
+         GtkTextIter start, end;
+
+         retval = DW_ERROR_NONE;
+         gtk_text_buffer_get_start_iter(tbuffer, &start);
+         /* Characters are up to four bytes, so this stays within the chunk size */
+         while(!gtk_text_iter_is_end(&start))
+         {
+            gchar *text;
+            int length;
+
+            end = start;
+            gtk_text_iter_forward_chars(&end, _DW_MLE_CHUNK / 4);
+            text = gtk_text_iter_get_text(&start, &end);
+            length = text ? (int)strlen(text) : 0;
+            if(length && func(handle, text, length, data) < length)
+               retval = DW_ERROR_GENERAL;
+            g_free(text);
+            if(retval != DW_ERROR_NONE)
+               break;
+            start = end;
+         }
+      }
+   }
+   DW_FUNCTION_RETURN_THIS(retval);
+}
+
 /*
  * Obtains information about an MLE box.
  * Parameters:
@@ -5060,15 +6686,16 @@ DW_FUNCTION_RESTORE_PARAM6(handle, HWND, item, HTREEITEM, title, char *, icon, H
    {
       if((tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
          && GTK_IS_TREE_VIEW(tree) &&
-         (store = (GtkTreeStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(tree))))
+         (store = (GtkTreeStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
       {
-         iter = (GtkTreeIter *)malloc(sizeof(GtkTreeIter));
-
-         pixbuf = _dw_find_pixbuf(icon, NULL, NULL);
+         if((iter = _dw_tree_iter_new((DWTreeArena *)g_object_get_data(G_OBJECT(tree), "_dw_tree_arena"))))
+         {
+            pixbuf = _dw_find_pixbuf(icon, NULL, NULL);
 
-         gtk_tree_store_insert_after(store, iter, (GtkTreeIter *)parent, (GtkTreeIter *)item);
-         gtk_tree_store_set (store, iter, 0, title, 1, pixbuf, 2, itemdata, 3, iter, -1);
-         retval = (HTREEITEM)iter;
+            gtk_tree_store_insert_after(store, iter, (GtkTreeIter *)parent, (GtkTreeIter *)item);
+            gtk_tree_store_set (store, iter, 0, title, 1, pixbuf, 2, itemdata, 3, iter, -1);
+            retval = (HTREEITEM)iter;
+         }
       }
    }
    DW_FUNCTION_RETURN_THIS(retval);
@@ -5081,32 +6708,99 @@ DW_FUNCTION_RESTORE_PARAM6(handle, HWND, item, HTREEITEM, title, char *, icon, H
  *          title: The text title of the entry.
  *          icon: Handle to coresponding icon.
  *          parent: Parent handle or 0 if root.
- *          itemdata: Item specific data.
+ *          itemdata: Item specific data.
+ */
+DW_FUNCTION_DEFINITION(dw_tree_insert, HTREEITEM, HWND handle, const char *title, HICN icon, HTREEITEM parent, void *itemdata)
+DW_FUNCTION_ADD_PARAM5(handle, title, icon, parent, itemdata)
+DW_FUNCTION_RETURN(dw_tree_insert, HTREEITEM)
+DW_FUNCTION_RESTORE_PARAM5(handle, HWND, title, char *, icon, HICN, parent, HTREEITEM, itemdata, void *)
+{
+   GtkWidget *tree;
+   GtkTreeIter *iter;
+   GtkTreeStore *store;
+   GdkPixbuf *pixbuf;
+   HTREEITEM retval = 0;
+
+   if(handle)
+   {
+      if((tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
+         && GTK_IS_TREE_VIEW(tree) &&
+         (store = (GtkTreeStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
+      {
+         if((iter = _dw_tree_iter_new((DWTreeArena *)g_object_get_data(G_OBJECT(tree), "_dw_tree_arena"))))
+         {
+            pixbuf = _dw_find_pixbuf(icon, NULL, NULL);
+
+            gtk_tree_store_append (store, iter, (GtkTreeIter *)parent);
+            gtk_tree_store_set (store, iter, 0, title, 1, pixbuf, 2, itemdata, 3, iter, -1);
+            retval = (HTREEITEM)iter;
+         }
+      }
+   }
+   DW_FUNCTION_RETURN_THIS(retval);
+}
+
+/*
+ * Inserts many items into a tree window (widget) under one parent.
+ * Parameters:
+ *          handle: Handle to the tree to be inserted.
+ *          parent: Parent handle or 0 if root.
+ *          count: Number of items to insert.
+ *          titles: Array of count text titles.
+ *          icons: Array of count icon handles or NULL for no icons.
+ *          itemdata: Array of count item data pointers or NULL.
+ *          items: Array to receive the count new item handles or NULL.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
  */
-DW_FUNCTION_DEFINITION(dw_tree_insert, HTREEITEM, HWND handle, const char *title, HICN icon, HTREEITEM parent, void *itemdata)
-DW_FUNCTION_ADD_PARAM5(handle, title, icon, parent, itemdata)
-DW_FUNCTION_RETURN(dw_tree_insert, HTREEITEM)
-DW_FUNCTION_RESTORE_PARAM5(handle, HWND, title, char *, icon, HICN, parent, HTREEITEM, itemdata, void *)
+DW_FUNCTION_DEFINITION(dw_tree_insert_many, int, HWND handle, HTREEITEM parent, int count, char **titles, HICN *icons, void **itemdata, HTREEITEM *items)
+DW_FUNCTION_ADD_PARAM7(handle, parent, count, titles, icons, itemdata, items)
+DW_FUNCTION_RETURN(dw_tree_insert_many, int)
+DW_FUNCTION_RESTORE_PARAM7(handle, HWND, parent, HTREEITEM, count, int, titles, char **, icons, HICN *, itemdata, void **, items, HTREEITEM *)
 {
    GtkWidget *tree;
-   GtkTreeIter *iter;
    GtkTreeStore *store;
-   GdkPixbuf *pixbuf;
-   HTREEITEM retval = 0;
+   int retval = DW_ERROR_GENERAL;
 
-   if(handle)
+   if(handle && titles && count >= 0)
    {
       if((tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
          && GTK_IS_TREE_VIEW(tree) &&
-         (store = (GtkTreeStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(tree))))
+         (store = (GtkTreeStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
       {
-         iter = (GtkTreeIter *)malloc(sizeof(GtkTreeIter));
+         GdkPixbuf *pixbuf = NULL;
+         HICN lasticon = 0;
+         DWTreeArena *arena = (DWTreeArena *)g_object_get_data(G_OBJECT(tree), "_dw_tree_arena");
+         int z, detach = !g_object_get_data(G_OBJECT(tree), "_dw_expanding");
 
-         pixbuf = _dw_find_pixbuf(icon, NULL, NULL);
+         /* Detach the model so the view is only updated once */
+         if(detach)
+            _dw_tree_view_freeze(handle, _DW_TREE_TYPE_TREE, TRUE);
+         retval = DW_ERROR_NONE;
+         for(z=0;z<count;z++)
+         {
+            GtkTreeIter *iter = _dw_tree_iter_new(arena);
 
-         gtk_tree_store_append (store, iter, (GtkTreeIter *)parent);
-         gtk_tree_store_set (store, iter, 0, title, 1, pixbuf, 2, itemdata, 3, iter, -1);
-         retval = (HTREEITEM)iter;
+            if(!iter)
+            {
+               retval = DW_ERROR_NO_MEM;
+               break;
+            }
+            /* Items usually share a few icons, so only look up changes */
+            if(icons && icons[z] != lasticon)
+               pixbuf = _dw_find_pixbuf((lasticon = icons[z]), NULL, NULL);
+            gtk_tree_store_insert_with_values(store, iter, (GtkTreeIter *)parent, -1, 0, titles[z], 1, pixbuf,
+                                              2, itemdata ? itemdata[z] : NULL, 3, iter, -1);
+            if(items)
+               items[z] = (HTREEITEM)iter;
+         }
+         if(items)
+         {
+            for(;z<count;z++)
+               items[z] = 0;
+         }
+         if(detach)
+            _dw_tree_view_freeze(handle, _DW_TREE_TYPE_TREE, FALSE);
       }
    }
    DW_FUNCTION_RETURN_THIS(retval);
@@ -5133,7 +6827,7 @@ DW_FUNCTION_RESTORE_PARAM4(handle, HWND, item, HTREEITEM, title, char *, icon, H
    {
       if((tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
          && GTK_IS_TREE_VIEW(tree) &&
-         (store = (GtkTreeStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(tree))))
+         (store = (GtkTreeStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
       {
          pixbuf = _dw_find_pixbuf(icon, NULL, NULL);
 
@@ -5162,7 +6856,7 @@ DW_FUNCTION_RESTORE_PARAM3(DW_UNUSED(handle), HWND, item, HTREEITEM, itemdata, v
    {
       if((tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
          && GTK_IS_TREE_VIEW(tree) &&
-         (store = (GtkTreeStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(tree))))
+         (store = (GtkTreeStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
             gtk_tree_store_set(store, (GtkTreeIter *)item, 2, itemdata, -1);
    }
    DW_FUNCTION_RETURN_NOTHING;
@@ -5188,7 +6882,7 @@ DW_FUNCTION_RESTORE_PARAM2(DW_UNUSED(handle), HWND, item, HTREEITEM)
       tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user");
 
       if(tree && GTK_IS_TREE_VIEW(tree) &&
-         (store = (GtkTreeModel *)gtk_tree_view_get_model(GTK_TREE_VIEW(tree))))
+         (store = (GtkTreeModel *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
          gtk_tree_model_get(store, (GtkTreeIter *)item, _DW_DATA_TYPE_STRING, &text, -1);
       if(text)
       {
@@ -5220,7 +6914,7 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, item, HTREEITEM)
       tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user");
 
       if(tree && GTK_IS_TREE_VIEW(tree) &&
-         (store = (GtkTreeModel *)gtk_tree_view_get_model(GTK_TREE_VIEW(tree))))
+         (store = (GtkTreeModel *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
       {
          GtkTreeIter iter;
 
@@ -5250,7 +6944,7 @@ DW_FUNCTION_RESTORE_PARAM2(DW_UNUSED(handle), HWND, item, HTREEITEM)
    {
       if((tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
          && GTK_IS_TREE_VIEW(tree) &&
-         (store = (GtkTreeModel *)gtk_tree_view_get_model(GTK_TREE_VIEW(tree))))
+         (store = (GtkTreeModel *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
             gtk_tree_model_get(store, (GtkTreeIter *)item, 2, &ret, -1);
    }
    DW_FUNCTION_RETURN_THIS(ret);
@@ -5274,7 +6968,7 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, item, HTREEITEM)
    {
       if((tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
          && GTK_IS_TREE_VIEW(tree) &&
-         (store = (GtkTreeStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(tree))))
+         (store = (GtkTreeStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
       {
          GtkTreePath *path = gtk_tree_model_get_path(GTK_TREE_MODEL(store), (GtkTreeIter *)item);
          GtkTreeSelection *sel = gtk_tree_view_get_selection(GTK_TREE_VIEW(tree));
@@ -5287,24 +6981,6 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, item, HTREEITEM)
    DW_FUNCTION_RETURN_NOTHING;
 }
 
-static void _dw_recursive_free(GtkTreeModel *store, GtkTreeIter parent)
-{
-   void *data;
-   GtkTreeIter iter;
-
-   gtk_tree_model_get(store, &parent, 3, &data, -1);
-   if(data)
-      free(data);
-   gtk_tree_store_set(GTK_TREE_STORE(store), &parent, 3, NULL, -1);
-
-   if(gtk_tree_model_iter_children(store, &iter, &parent))
-   {
-      do {
-         _dw_recursive_free(GTK_TREE_MODEL(store), iter);
-      } while(gtk_tree_model_iter_next(GTK_TREE_MODEL(store), &iter));
-   }
-}
-
 /*
  * Removes all nodes from a tree.
  * Parameters:
@@ -5322,22 +6998,48 @@ DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
    {
       if((tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
          && GTK_IS_TREE_VIEW(tree) &&
-         (store = (GtkTreeStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(tree))))
+         (store = (GtkTreeStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
          {
-            GtkTreeIter iter;
+            DWTreeArena *arena = (DWTreeArena *)g_object_get_data(G_OBJECT(tree), "_dw_tree_arena");
 
-            if(gtk_tree_model_get_iter_first(GTK_TREE_MODEL(store), &iter))
-            {
-               do {
-                  _dw_recursive_free(GTK_TREE_MODEL(store), iter);
-               } while(gtk_tree_model_iter_next(GTK_TREE_MODEL(store), &iter));
-            }
             gtk_tree_store_clear(store);
+            /* The handles all go at once, without walking the tree */
+            if(arena)
+               _dw_tree_arena_clear(arena);
          }
    }
    DW_FUNCTION_RETURN_NOTHING;
 }
 
+/*
+ * Stops the tree from updating while many items are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the tree to freeze.
+ */
+DW_FUNCTION_DEFINITION(dw_tree_freeze, void, HWND handle)
+DW_FUNCTION_ADD_PARAM1(handle)
+DW_FUNCTION_NO_RETURN(dw_tree_freeze)
+DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
+{
+   _dw_tree_view_freeze(handle, _DW_TREE_TYPE_TREE, TRUE);
+   DW_FUNCTION_RETURN_NOTHING;
+}
+
+/*
+ * Resumes updating of a frozen tree, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the tree to thaw.
+ */
+DW_FUNCTION_DEFINITION(dw_tree_thaw, void, HWND handle)
+DW_FUNCTION_ADD_PARAM1(handle)
+DW_FUNCTION_NO_RETURN(dw_tree_thaw)
+DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
+{
+   _dw_tree_view_freeze(handle, _DW_TREE_TYPE_TREE, FALSE);
+   DW_FUNCTION_RETURN_NOTHING;
+}
+
 /*
  * Expands a node on a tree.
  * Parameters:
@@ -5356,7 +7058,7 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, item, HTREEITEM)
    {
       if((tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
          && GTK_IS_TREE_VIEW(tree) &&
-         (store = (GtkTreeStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(tree))))
+         (store = (GtkTreeStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
       {
          GtkTreePath *path = gtk_tree_model_get_path(GTK_TREE_MODEL(store), (GtkTreeIter *)item);
          gtk_tree_view_expand_row(GTK_TREE_VIEW(tree), path, FALSE);
@@ -5380,48 +7082,551 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, item, HTREEITEM)
    GtkWidget *tree;
    GtkTreeStore *store;
 
-   if(handle)
+   if(handle)
+   {
+      if((tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
+         && GTK_IS_TREE_VIEW(tree) &&
+         (store = (GtkTreeStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
+      {
+         GtkTreePath *path = gtk_tree_model_get_path(GTK_TREE_MODEL(store), (GtkTreeIter *)item);
+         gtk_tree_view_collapse_row(GTK_TREE_VIEW(tree), path);
+         gtk_tree_path_free(path);
+      }
+   }
+   DW_FUNCTION_RETURN_NOTHING;
+}
+
+/*
+ * Marks a tree item as having children that are inserted on demand.
+ * The item shows an expander, and the DW_SIGNAL_TREE_EXPAND handler
+ * inserts the children when the item is expanded the first time.
+ * The handler is also called on later expands, even if the children exist.
+ * Parameters:
+ *       handle: Handle to the tree window (widget).
+ *       item: Handle to the node to be marked.
+ *       flags: DW_TREE_LAZY, DW_TREE_LAZY_DROP to also delete the children
+ *              when the node is collapsed, or 0 to turn it off.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+DW_FUNCTION_DEFINITION(dw_tree_item_set_lazy, int, HWND handle, HTREEITEM item, int flags)
+DW_FUNCTION_ADD_PARAM3(handle, item, flags)
+DW_FUNCTION_RETURN(dw_tree_item_set_lazy, int)
+DW_FUNCTION_RESTORE_PARAM3(handle, HWND, item, HTREEITEM, flags, int)
+{
+   GtkWidget *tree;
+   GtkTreeStore *store;
+   int retval = DW_ERROR_GENERAL;
+
+   if(handle && item && (tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
+      && GTK_IS_TREE_VIEW(tree) &&
+      (store = (GtkTreeStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
+   {
+      GtkTreeIter child;
+      int placeholder = _dw_tree_lazy_placeholder(GTK_TREE_MODEL(store), (GtkTreeIter *)item, &child);
+
+      if(flags & DW_TREE_LAZY_DROP)
+         flags |= DW_TREE_LAZY;
+      gtk_tree_store_set(store, (GtkTreeIter *)item, 4, flags, -1);
+      /* Items without children need a placeholder to show the expander */
+      if((flags & DW_TREE_LAZY) && !placeholder && !gtk_tree_model_iter_has_child(GTK_TREE_MODEL(store), (GtkTreeIter *)item))
+         gtk_tree_store_append(store, &child, (GtkTreeIter *)item);
+      else if(!(flags & DW_TREE_LAZY) && placeholder)
+         gtk_tree_store_remove(store, &child);
+      retval = DW_ERROR_NONE;
+   }
+   DW_FUNCTION_RETURN_THIS(retval);
+}
+
+/*
+ * Removes a node from a tree.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be cleared.
+ *       item: Handle to node to be deleted.
+ */
+DW_FUNCTION_DEFINITION(dw_tree_item_delete, void, HWND handle, HTREEITEM item)
+DW_FUNCTION_ADD_PARAM2(handle, item)
+DW_FUNCTION_NO_RETURN(dw_tree_item_delete)
+DW_FUNCTION_RESTORE_PARAM2(handle, HWND, item, HTREEITEM)
+{
+   GtkWidget *tree;
+   GtkTreeStore *store;
+
+   if(handle)
+   {
+      if((tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
+         && GTK_IS_TREE_VIEW(tree) &&
+         (store = (GtkTreeStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(tree))))
+      {
+         DWTreeArena *arena = (DWTreeArena *)g_object_get_data(G_OBJECT(tree), "_dw_tree_arena");
+
+         /* Removing the item removes its children, so free their handles too */
+         _dw_tree_free_children(arena, GTK_TREE_MODEL(store), (GtkTreeIter *)item);
+         gtk_tree_store_remove(store, (GtkTreeIter *)item);
+         _dw_tree_iter_free(arena, (GtkTreeIter *)item);
+      }
+   }
+   DW_FUNCTION_RETURN_NOTHING;
+}
+
+#define _DW_CONTAINER_STORE_EXTRA 2
+
+/* Dates and times are stored as integers so they sort correctly,
+ * zero is an empty cell so times are stored offset by one second.
+ */
+#define _DW_CONTAINER_DATE(d) ((d).year * 10000 + (d).month * 100 + (d).day)
+#define _DW_CONTAINER_TIME(t) ((t).hours * 3600 + (t).minutes * 60 + (t).seconds + 1)
+
+/* Internal function to format a date cell when it is drawn */
+static void _dw_container_date_func(GtkTreeViewColumn *col, GtkCellRenderer *rend, GtkTreeModel *model, GtkTreeIter *iter, gpointer data)
+{
+   char textbuffer[101] = {0};
+   gint value = 0;
+
+   gtk_tree_model_get(model, iter, GPOINTER_TO_INT(data), &value, -1);
+   if(value)
+   {
+      struct tm curtm;
+
+      memset( &curtm, 0, sizeof(curtm) );
+      curtm.tm_mday = value % 100;
+      curtm.tm_mon = ((value / 100) % 100) - 1;
+      curtm.tm_year = (value / 10000) - 1900;
+
+      strftime(textbuffer, 100, "%x", &curtm);
+   }
+   g_object_set(G_OBJECT(rend), "text", textbuffer, NULL);
+}
+
+/* Internal function to format a time cell when it is drawn */
+static void _dw_container_time_func(GtkTreeViewColumn *col, GtkCellRenderer *rend, GtkTreeModel *model, GtkTreeIter *iter, gpointer data)
+{
+   char textbuffer[101] = {0};
+   gint value = 0;
+
+   gtk_tree_model_get(model, iter, GPOINTER_TO_INT(data), &value, -1);
+   if(value--)
+   {
+      struct tm curtm;
+
+      memset( &curtm, 0, sizeof(curtm) );
+      curtm.tm_hour = value / 3600;
+      curtm.tm_min = (value / 60) % 60;
+      curtm.tm_sec = value % 60;
+
+      strftime(textbuffer, 100, "%X", &curtm);
+   }
+   g_object_set(G_OBJECT(rend), "text", textbuffer, NULL);
+}
+
+/* Sort key for one row, the original index breaks ties so sorts are stable */
+typedef struct _dwsortkey
+{
+   union {
+      gchar *text;
+      guint64 value;
+   } key;
+   gint index;
+} DWSortKey;
+
+static int _dw_sort_text_compare(const void *a, const void *b)
+{
+   const DWSortKey *ka = a, *kb = b;
+   int rc = strcmp(ka->key.text, kb->key.text);
+
+   return rc ? rc : ka->index - kb->index;
+}
+
+static int _dw_sort_text_compare_desc(const void *a, const void *b)
+{
+   const DWSortKey *ka = a, *kb = b;
+   int rc = strcmp(kb->key.text, ka->key.text);
+
+   return rc ? rc : ka->index - kb->index;
+}
+
+static int _dw_sort_value_compare(const void *a, const void *b)
+{
+   const DWSortKey *ka = a, *kb = b;
+
+   if(ka->key.value != kb->key.value)
+      return ka->key.value < kb->key.value ? -1 : 1;
+   return ka->index - kb->index;
+}
+
+static int _dw_sort_value_compare_desc(const void *a, const void *b)
+{
+   const DWSortKey *ka = a, *kb = b;
+
+   if(ka->key.value != kb->key.value)
+      return ka->key.value > kb->key.value ? -1 : 1;
+   return ka->index - kb->index;
+}
+
+/* Internal function returning the store column holding a container column,
+ * or -1 if the column does not exist or only holds icons.
+ */
+static int _dw_container_store_column(GtkWidget *tree, int column, int *flag)
+{
+   char numbuf[25] = {0};
+
+   if(!gtk_tree_view_get_column(GTK_TREE_VIEW(tree), column))
+      return -1;
+   snprintf(numbuf, 24, "_dw_cont_col%d", column);
+   *flag = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(tree), numbuf));
+   if(column == 0 && *flag & DW_CFA_STRINGANDICON)
+      return _DW_CONTAINER_STORE_EXTRA + 1;
+   if((*flag & DW_CFA_BITMAPORICON) || !(*flag & (DW_CFA_STRING | DW_CFA_ULONG | DW_CFA_DATE | DW_CFA_TIME)))
+      return -1;
+   return column + _DW_CONTAINER_STORE_EXTRA + 1;
+}
+
+/* Internal function to sort the rows of a container by a column.
+ * The keys are read into one array and sorted there, then the store
+ * is reordered in a single step instead of comparing through the model.
+ */
+static int _dw_container_sort(GtkWidget *tree, int column, int order)
+{
+   GtkTreeModel *store = _dw_tree_view_get_model(GTK_TREE_VIEW(tree));
+   GtkTreeViewColumn *col;
+   int flag, storecol, count, z = 0;
+   DWSortKey *keys;
+   gint *neworder;
+   GtkTreeIter iter;
+
+   if(!store || !GTK_IS_LIST_STORE(store) || (storecol = _dw_container_store_column(tree, column, &flag)) < 0)
+      return DW_ERROR_GENERAL;
+
+   /* Show the sort order on the column headings */
+   for(z=0;(col = gtk_tree_view_get_column(GTK_TREE_VIEW(tree), z));z++)
+   {
+      gtk_tree_view_column_set_sort_indicator(col, z == column);
+      if(z == column)
+         gtk_tree_view_column_set_sort_order(col, order == DW_SORT_DESCENDING ? GTK_SORT_DESCENDING : GTK_SORT_ASCENDING);
+   }
+   g_object_set_data(G_OBJECT(tree), "_dw_sort_column", GINT_TO_POINTER(column + 1));
+   g_object_set_data(G_OBJECT(tree), "_dw_sort_order", GINT_TO_POINTER(order));
+
+   if((count = gtk_tree_model_iter_n_children(store, NULL)) < 2)
+      return DW_ERROR_NONE;
+   if(!(keys = malloc(sizeof(DWSortKey) * count)) || !(neworder = malloc(sizeof(gint) * count)))
+   {
+      if(keys)
+         free(keys);
+      return DW_ERROR_NO_MEM;
+   }
+
+   z = 0;
+   if(gtk_tree_model_get_iter_first(store, &iter))
+   {
+      do
+      {
+         keys[z].index = z;
+         if(flag & (DW_CFA_STRING | DW_CFA_STRINGANDICON))
+         {
+            gchar *text = NULL;
+
+            gtk_tree_model_get(store, &iter, storecol, &text, -1);
+            keys[z].key.text = g_utf8_collate_key(text ? text : "", -1);
+            g_free(text);
+         }
+         else if(flag & DW_CFA_ULONG)
+         {
+            gulong value = 0;
+
+            gtk_tree_model_get(store, &iter, storecol, &value, -1);
+            keys[z].key.value = value;
+         }
+         else
+         {
+            gint value = 0;
+
+            gtk_tree_model_get(store, &iter, storecol, &value, -1);
+            keys[z].key.value = (guint64)value;
+         }
+         z++;
+      } while(z < count && gtk_tree_model_iter_next(store, &iter));
+   }
+
+   if(flag & (DW_CFA_STRING | DW_CFA_STRINGANDICON))
+      qsort(keys, count, sizeof(DWSortKey), order == DW_SORT_DESCENDING ? _dw_sort_text_compare_desc : _dw_sort_text_compare);
+   else
+      qsort(keys, count, sizeof(DWSortKey), order == DW_SORT_DESCENDING ? _dw_sort_value_compare_desc : _dw_sort_value_compare);
+
+   for(z=0;z<count;z++)
+   {
+      neworder[z] = keys[z].index;
+      if(flag & (DW_CFA_STRING | DW_CFA_STRINGANDICON))
+         g_free(keys[z].key.text);
+   }
+   gtk_list_store_reorder(GTK_LIST_STORE(store), neworder);
+   free(neworder);
+   free(keys);
+   return DW_ERROR_NONE;
+}
+
+/* Filter state of a container.  The text of the filtered column is
+ * casefolded and indexed by trigram, so narrowing the filter only has
+ * to check the rows containing the rarest trigram of the filter text.
+ */
+typedef struct _dwcontfilter
+{
+   int storecol, dirty, count;
+   unsigned long flags;
+   char *text;
+   char **rows;
+   GHashTable *trigrams;
+   guchar *visible;
+} DWContFilter;
+
+#define _DW_TRIGRAM(s) GUINT_TO_POINTER(((guint)(guchar)(s)[0] << 16) | ((guint)(guchar)(s)[1] << 8) | (guint)(guchar)(s)[2])
+
+static void _dw_container_filter_postings_free(gpointer data)
+{
+   g_array_free((GArray *)data, TRUE);
+}
+
+/* Internal function to free the index of a container filter */
+static void _dw_container_filter_index_free(DWContFilter *filter)
+{
+   int z;
+
+   if(filter->rows)
+   {
+      for(z=0;z<filter->count;z++)
+         g_free(filter->rows[z]);
+      free(filter->rows);
+      filter->rows = NULL;
+   }
+   if(filter->trigrams)
+   {
+      g_hash_table_destroy(filter->trigrams);
+      filter->trigrams = NULL;
+   }
+   if(filter->visible)
+   {
+      free(filter->visible);
+      filter->visible = NULL;
+   }
+   filter->count = 0;
+   filter->dirty = TRUE;
+}
+
+static void _dw_container_filter_free(gpointer data)
+{
+   DWContFilter *filter = (DWContFilter *)data;
+
+   _dw_container_filter_index_free(filter);
+   g_free(filter->text);
+   free(filter);
+}
+
+/* Internal function to read the filtered column and index it */
+static void _dw_container_filter_index(DWContFilter *filter, GtkTreeModel *store)
+{
+   GtkTreeIter iter;
+   int z = 0;
+
+   _dw_container_filter_index_free(filter);
+   filter->count = gtk_tree_model_iter_n_children(store, NULL);
+   filter->rows = calloc(filter->count + 1, sizeof(char *));
+   filter->visible = calloc(filter->count + 1, 1);
+   if(!filter->rows || !filter->visible)
+   {
+      _dw_container_filter_index_free(filter);
+      return;
+   }
+   filter->trigrams = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, _dw_container_filter_postings_free);
+
+   if(gtk_tree_model_get_iter_first(store, &iter))
+   {
+      do
+      {
+         gchar *text = NULL;
+         size_t len, x;
+
+         gtk_tree_model_get(store, &iter, filter->storecol, &text, -1);
+         if(filter->flags & DW_FILTER_CASESENSITIVE)
+            filter->rows[z] = text ? text : g_strdup("");
+         else
+         {
+            filter->rows[z] = g_utf8_casefold(text ? text : "", -1);
+            g_free(text);
+         }
+         len = strlen(filter->rows[z]);
+         for(x=0;x+3<=len;x++)
+         {
+            gpointer key = _DW_TRIGRAM(&filter->rows[z][x]);
+            GArray *postings = (GArray *)g_hash_table_lookup(filter->trigrams, key);
+
+            if(!postings)
+            {
+               postings = g_array_new(FALSE, FALSE, sizeof(gint));
+               g_hash_table_insert(filter->trigrams, key, postings);
+            }
+            /* Rows are added in order, so only the last entry can repeat */
+            if(!postings->len || g_array_index(postings, gint, postings->len - 1) != z)
+               g_array_append_val(postings, z);
+         }
+         z++;
+      } while(z < filter->count && gtk_tree_model_iter_next(store, &iter));
+   }
+   filter->count = z;
+   filter->dirty = FALSE;
+}
+
+/* Internal function to work out which rows match the filter text */
+static void _dw_container_filter_apply(DWContFilter *filter)
+{
+   size_t len = strlen(filter->text), x;
+   GArray *rarest = NULL;
+   int z;
+
+   memset(filter->visible, 0, filter->count);
+   /* Filters shorter than a trigram check every row */
+   if(len < 3)
+   {
+      for(z=0;z<filter->count;z++)
+         filter->visible[z] = strstr(filter->rows[z], filter->text) != NULL;
+      return;
+   }
+   for(x=0;x+3<=len;x++)
+   {
+      GArray *postings = (GArray *)g_hash_table_lookup(filter->trigrams, _DW_TRIGRAM(&filter->text[x]));
+
+      /* No row contains this trigram, so nothing matches */
+      if(!postings)
+         return;
+      if(!rarest || postings->len < rarest->len)
+         rarest = postings;
+   }
+   for(x=0;x<rarest->len;x++)
+   {
+      gint row = g_array_index(rarest, gint, x);
+
+      filter->visible[row] = strstr(filter->rows[row], filter->text) != NULL;
+   }
+}
+
+/* Internal function to decide if a store row is shown by the filter */
+static gboolean _dw_container_filter_visible(GtkTreeModel *model, GtkTreeIter *iter, gpointer data)
+{
+   DWContFilter *filter = (DWContFilter *)data;
+   gboolean retval = TRUE;
+
+   if(!filter->text)
+      return TRUE;
+   if(!filter->dirty)
    {
-      if((tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
-         && GTK_IS_TREE_VIEW(tree) &&
-         (store = (GtkTreeStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(tree))))
+      GtkTreePath *path = gtk_tree_model_get_path(model, iter);
+
+      if(path)
       {
-         GtkTreePath *path = gtk_tree_model_get_path(GTK_TREE_MODEL(store), (GtkTreeIter *)item);
-         gtk_tree_view_collapse_row(GTK_TREE_VIEW(tree), path);
+         gint *indices = gtk_tree_path_get_indices(path);
+
+         if(indices && indices[0] < filter->count)
+            retval = filter->visible[indices[0]];
          gtk_tree_path_free(path);
       }
    }
-   DW_FUNCTION_RETURN_NOTHING;
+   else
+   {
+      /* The store changed since the index was built, check the row itself */
+      gchar *text = NULL, *fold = NULL;
+
+      gtk_tree_model_get(model, iter, filter->storecol, &text, -1);
+      if(!(filter->flags & DW_FILTER_CASESENSITIVE))
+         fold = g_utf8_casefold(text ? text : "", -1);
+      retval = strstr(fold ? fold : (text ? text : ""), filter->text) != NULL;
+      g_free(fold);
+      g_free(text);
+   }
+   return retval;
 }
 
-/*
- * Removes a node from a tree.
- * Parameters:
- *       handle: Handle to the window (widget) to be cleared.
- *       item: Handle to node to be deleted.
- */
-DW_FUNCTION_DEFINITION(dw_tree_item_delete, void, HWND handle, HTREEITEM item)
-DW_FUNCTION_ADD_PARAM2(handle, item)
-DW_FUNCTION_NO_RETURN(dw_tree_item_delete)
-DW_FUNCTION_RESTORE_PARAM2(handle, HWND, item, HTREEITEM)
+/* Any change to the store makes the filter index stale */
+static void _dw_container_filter_dirty(GtkWidget *tree)
 {
-   GtkWidget *tree;
-   GtkTreeStore *store;
+   DWContFilter *filter = (DWContFilter *)g_object_get_data(G_OBJECT(tree), "_dw_filter");
 
-   if(handle)
+   if(filter)
+      filter->dirty = TRUE;
+}
+
+/* Internal function to filter the rows of a container */
+static int _dw_container_filter(GtkWidget *tree, int column, const char *text, unsigned long flags)
+{
+   GtkTreeModel *store = _dw_tree_view_get_model(GTK_TREE_VIEW(tree));
+   GtkTreeModel *frozen = (GtkTreeModel *)g_object_get_data(G_OBJECT(tree), "_dw_frozen_model");
+   GtkTreeModel *model = frozen ? frozen : gtk_tree_view_get_model(GTK_TREE_VIEW(tree));
+   DWContFilter *filter = (DWContFilter *)g_object_get_data(G_OBJECT(tree), "_dw_filter");
+   int flag, storecol;
+
+   if(!store || !GTK_IS_LIST_STORE(store))
+      return DW_ERROR_GENERAL;
+
+   /* An empty filter shows all the rows again */
+   if(!text || !*text)
    {
-      if((tree = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user"))
-         && GTK_IS_TREE_VIEW(tree) &&
-         (store = (GtkTreeStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(tree))))
+      if(filter && filter->text)
       {
-         gtk_tree_store_remove(store, (GtkTreeIter *)item);
-         free(item);
+         g_free(filter->text);
+         filter->text = NULL;
+         if(GTK_IS_TREE_MODEL_FILTER(model))
+            gtk_tree_model_filter_refilter(GTK_TREE_MODEL_FILTER(model));
       }
+      return DW_ERROR_NONE;
    }
-   DW_FUNCTION_RETURN_NOTHING;
-}
+   if((storecol = _dw_container_store_column(tree, column, &flag)) < 0 || !(flag & (DW_CFA_STRING | DW_CFA_STRINGANDICON)))
+      return DW_ERROR_GENERAL;
 
-#define _DW_CONTAINER_STORE_EXTRA 2
+   if(!filter)
+   {
+      if(!(filter = calloc(1, sizeof(DWContFilter))))
+         return DW_ERROR_NO_MEM;
+      filter->dirty = TRUE;
+      g_object_set_data_full(G_OBJECT(tree), "_dw_filter", (gpointer)filter, _dw_container_filter_free);
+      /* Connected before the filter model is created, so the index is
+       * marked stale before the filter model checks a changed row.
+       */
+      g_signal_connect_object(G_OBJECT(store), "row-inserted", G_CALLBACK(_dw_container_filter_dirty), tree, G_CONNECT_SWAPPED);
+      g_signal_connect_object(G_OBJECT(store), "row-changed", G_CALLBACK(_dw_container_filter_dirty), tree, G_CONNECT_SWAPPED);
+      g_signal_connect_object(G_OBJECT(store), "row-deleted", G_CALLBACK(_dw_container_filter_dirty), tree, G_CONNECT_SWAPPED);
+      g_signal_connect_object(G_OBJECT(store), "rows-reordered", G_CALLBACK(_dw_container_filter_dirty), tree, G_CONNECT_SWAPPED);
+   }
+   /* The index depends on the column and the case sensitivity */
+   if(filter->storecol != storecol || (filter->flags & DW_FILTER_CASESENSITIVE) != (flags & DW_FILTER_CASESENSITIVE))
+      filter->dirty = TRUE;
+   filter->storecol = storecol;
+   filter->flags = flags;
+   g_free(filter->text);
+   filter->text = (flags & DW_FILTER_CASESENSITIVE) ? g_strdup(text) : g_utf8_casefold(text, -1);
+   if(filter->dirty)
+      _dw_container_filter_index(filter, store);
+   if(!filter->dirty)
+      _dw_container_filter_apply(filter);
+
+   /* The first filter puts a filter model between the view and the store */
+   if(!GTK_IS_TREE_MODEL_FILTER(model))
+   {
+      GtkTreeModel *filtermodel = gtk_tree_model_filter_new(store, NULL);
+
+      gtk_tree_model_filter_set_visible_func(GTK_TREE_MODEL_FILTER(filtermodel), _dw_container_filter_visible, filter, NULL);
+      if(frozen)
+      {
+         g_object_set_data(G_OBJECT(tree), "_dw_frozen_model", (gpointer)filtermodel);
+         g_object_unref(G_OBJECT(frozen));
+      }
+      else
+      {
+         gtk_tree_view_set_model(GTK_TREE_VIEW(tree), filtermodel);
+         g_object_unref(G_OBJECT(filtermodel));
+      }
+   }
+   else
+      gtk_tree_model_filter_refilter(GTK_TREE_MODEL_FILTER(model));
+   return DW_ERROR_NONE;
+}
 
 static int _dw_container_setup_int(HWND handle, unsigned long *flags, char **titles, int count, int separator, int extra)
 {
@@ -5465,11 +7670,11 @@ static int _dw_container_setup_int(HWND handle, unsigned long *flags, char **tit
       }
       else if(flags[z] & DW_CFA_TIME)
       {
-         array[z+_DW_CONTAINER_STORE_EXTRA+1] = G_TYPE_STRING;
+         array[z+_DW_CONTAINER_STORE_EXTRA+1] = G_TYPE_INT;
       }
       else if(flags[z] & DW_CFA_DATE)
       {
-         array[z+_DW_CONTAINER_STORE_EXTRA+1] = G_TYPE_STRING;
+         array[z+_DW_CONTAINER_STORE_EXTRA+1] = G_TYPE_INT;
       }
    }
    /* Create the store and then the tree */
@@ -5518,14 +7723,14 @@ static int _dw_container_setup_int(HWND handle, unsigned long *flags, char **tit
       {
          rend = gtk_cell_renderer_text_new();
          gtk_tree_view_column_pack_start(col, rend, TRUE);
-         gtk_tree_view_column_add_attribute(col, rend, "text", z+_DW_CONTAINER_STORE_EXTRA+1);
+         gtk_tree_view_column_set_cell_data_func(col, rend, _dw_container_time_func, GINT_TO_POINTER(z+_DW_CONTAINER_STORE_EXTRA+1), NULL);
          gtk_tree_view_column_set_resizable(col, TRUE);
       }
       else if(flags[z] & DW_CFA_DATE)
       {
          rend = gtk_cell_renderer_text_new();
          gtk_tree_view_column_pack_start(col, rend, TRUE);
-         gtk_tree_view_column_add_attribute(col, rend, "text", z+_DW_CONTAINER_STORE_EXTRA+1);
+         gtk_tree_view_column_set_cell_data_func(col, rend, _dw_container_date_func, GINT_TO_POINTER(z+_DW_CONTAINER_STORE_EXTRA+1), NULL);
          gtk_tree_view_column_set_resizable(col, TRUE);
       }
       g_object_set_data(G_OBJECT(col), "_dw_column", GINT_TO_POINTER(z));
@@ -5642,6 +7847,16 @@ DW_FUNCTION_RESTORE_PARAM4(handle, HWND, flags, unsigned long *, titles, char **
  */
 HICN API dw_icon_load(unsigned long module, unsigned long id)
 {
+   if(id && id < 65536)
+   {
+      DWIconCache *ic;
+
+      /* Decode it now and hold a reference until dw_icon_free() */
+      pthread_mutex_lock(&_dw_icon_mutex);
+      if((ic = _dw_icon_cache_get((unsigned int)id, TRUE)))
+         ic->refcount++;
+      pthread_mutex_unlock(&_dw_icon_mutex);
+   }
    return (HICN)id;
 }
 
@@ -5663,6 +7878,141 @@ GdkPixbuf *_dw_icon_resize(GdkPixbuf *ret)
    return ret;
 }
 
+/* Internal function to locate an image file on disk, trying each of
+ * the known extensions when the name was given without one.
+ * The file buffer must be at least strlen(filename) + 6 bytes.
+ */
+static int _dw_image_file(const char *filename, char *file)
+{
+   int i;
+
+   strcpy(file, filename);
+
+   /* check if we can read from this file (it exists and read permission) */
+   if(access(file, 04) == 0)
+      return TRUE;
+
+   /* Try with various extentions */
+   for(i = 0; _dw_image_exts[i]; i++)
+   {
+      strcpy(file, filename);
+      strcat(file, _dw_image_exts[i]);
+      if(access(file, 04) == 0)
+         return TRUE;
+   }
+   return FALSE;
+}
+
+/* Pending asynchronous image load, decoded on a worker
+ * thread and handed to the callback from the main loop.
+ */
+typedef struct _dwimageload
+{
+   HWND handle;
+   char *filename;
+   void *callback;
+   void *data;
+   int icon;
+   GdkPixbuf *pixbuf;
+   cairo_surface_t *image;
+} DWImageLoad;
+
+#define _DW_IMAGE_LOAD_THREADS 4
+
+static GThreadPool *_dw_image_pool = NULL;
+static pthread_mutex_t _dw_image_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Runs on the main loop to wrap the decoded image and call the callback */
+static gboolean _dw_image_load_done(gpointer data)
+{
+   DWImageLoad *load = (DWImageLoad *)data;
+
+   if(load->icon)
+   {
+      int (*iconfunc)(HICN, void *) = load->callback;
+
+      iconfunc((HICN)load->pixbuf, load->data);
+   }
+   else
+   {
+      int (*pixmapfunc)(HPIXMAP, void *) = load->callback;
+      HPIXMAP pixmap = NULL;
+
+      if(load->pixbuf && (pixmap = calloc(1, sizeof(struct _hpixmap))))
+      {
+         pixmap->pixbuf = load->pixbuf;
+         pixmap->image = load->image;
+         pixmap->width = gdk_pixbuf_get_width(load->pixbuf);
+         pixmap->height = gdk_pixbuf_get_height(load->pixbuf);
+         pixmap->handle = load->handle;
+      }
+      else
+      {
+         if(load->pixbuf)
+            g_object_unref(G_OBJECT(load->pixbuf));
+         if(load->image)
+            cairo_surface_destroy(load->image);
+      }
+      pixmapfunc(pixmap, load->data);
+   }
+   free(load->filename);
+   free(load);
+   return FALSE;
+}
+
+/* Worker thread function, does the file probing and decoding
+ * without holding the GDK lock.
+ */
+static void _dw_image_load_thread(gpointer data, gpointer user_data)
+{
+   DWImageLoad *load = (DWImageLoad *)data;
+   char *file = malloc(strlen(load->filename) + 6);
+
+   if(file && _dw_image_file(load->filename, file))
+   {
+      load->pixbuf = gdk_pixbuf_new_from_file(file, NULL);
+      if(load->icon)
+         load->pixbuf = _dw_icon_resize(load->pixbuf);
+      else if(load->pixbuf)
+         load->image = cairo_image_surface_create_from_png(file);
+   }
+   if(file)
+      free(file);
+   g_idle_add(_dw_image_load_done, load);
+}
+
+/* Queue a file on the image loading thread pool */
+static int _dw_image_load_start(HWND handle, const char *filename, void *callback, void *data, int icon)
+{
+   DWImageLoad *load;
+   GThreadPool *pool;
+
+   if(!filename || !*filename || !callback || !(load = calloc(1, sizeof(DWImageLoad))))
+      return DW_ERROR_GENERAL;
+
+   load->handle = handle;
+   load->filename = strdup(filename);
+   load->callback = callback;
+   load->data = data;
+   load->icon = icon;
+
+   pthread_mutex_lock(&_dw_image_mutex);
+   if(!_dw_image_pool)
+      _dw_image_pool = g_thread_pool_new(_dw_image_load_thread, NULL, _DW_IMAGE_LOAD_THREADS, FALSE, NULL);
+   pool = _dw_image_pool;
+   pthread_mutex_unlock(&_dw_image_mutex);
+
+   if(!pool || !load->filename)
+   {
+      if(load->filename)
+         free(load->filename);
+      free(load);
+      return DW_ERROR_GENERAL;
+   }
+   g_thread_pool_push(pool, load, NULL);
+   return DW_ERROR_NONE;
+}
+
 /*
  * Obtains an icon from a file.
  * Parameters:
@@ -5701,6 +8051,26 @@ HICN API dw_icon_load_from_file(const char *filename)
    return retval;
 }
 
+/*
+ * Obtains an icon from a file without blocking the caller.
+ * The file is located and decoded on a worker thread and the
+ * callback is then run on the main thread with the result.
+ * Parameters:
+ *       filename: Name of the file, omit extention to have
+ *                 DW pick the appropriate file extension.
+ *                 (ICO on OS/2 or Windows, XPM on Unix)
+ *       callback: Function of the form int func(HICN icon, void *data)
+ *                 icon will be NULL if the file could not be loaded.
+ *       data: User data to be passed to the callback.
+ * Returns:
+ *       DW_ERROR_NONE if the load was queued, DW_ERROR_GENERAL on error
+ *       in which case the callback will not be called.
+ */
+int API dw_icon_load_from_file_async(const char *filename, void *callback, void *data)
+{
+   return _dw_image_load_start(DW_NOHWND, filename, callback, data, TRUE);
+}
+
 /*
  * Obtains an icon from data.
  * Parameters:
@@ -5743,6 +8113,17 @@ void API dw_icon_free(HICN handle)
    {
       g_object_unref(handle);
    }
+   else if(iicon > 0)
+   {
+      DWIconCache *ic;
+
+      /* Release the cached image when the last reference is freed */
+      pthread_mutex_lock(&_dw_icon_mutex);
+      if((ic = _dw_icon_cache_get((unsigned int)iicon, FALSE)) &&
+         (ic->refcount < 1 || --ic->refcount == 0))
+         g_hash_table_remove(_dw_icon_cache, GUINT_TO_POINTER(iicon));
+      pthread_mutex_unlock(&_dw_icon_mutex);
+   }
 }
 
 /*
@@ -5764,7 +8145,7 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, rowcount, int)
 
    /* Make sure it is the correct tree type */
    if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(cont));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(cont));
 
    if(store)
    {
@@ -5788,7 +8169,7 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, rowcount, int)
  */
 void _dw_container_set_item_int(HWND handle, void *pointer, int column, int row, void *data)
 {
-   char numbuf[25] = {0}, textbuffer[101] = {0};
+   char numbuf[25] = {0};
    int flag = 0;
    GtkWidget *cont;
    GtkListStore *store = NULL;
@@ -5797,7 +8178,7 @@ void _dw_container_set_item_int(HWND handle, void *pointer, int column, int row,
 
    /* Make sure it is the correct tree type */
    if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(cont));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(cont));
 
    if(store)
    {
@@ -5842,35 +8223,15 @@ void _dw_container_set_item_int(HWND handle, void *pointer, int column, int row,
          }
          else if(flag & DW_CFA_DATE)
          {
-            if(data)
-            {
-               struct tm curtm;
-               CDATE cdate = *((CDATE *)data);
+            gint tmp = data ? _DW_CONTAINER_DATE(*((CDATE *)data)) : 0;
 
-               memset( &curtm, 0, sizeof(curtm) );
-               curtm.tm_mday = cdate.day;
-               curtm.tm_mon = cdate.month - 1;
-               curtm.tm_year = cdate.year - 1900;
-
-               strftime(textbuffer, 100, "%x", &curtm);
-            }
-            gtk_list_store_set(store, &iter, column + _DW_CONTAINER_STORE_EXTRA + 1, textbuffer, -1);
+            gtk_list_store_set(store, &iter, column + _DW_CONTAINER_STORE_EXTRA + 1, tmp, -1);
          }
          else if(flag & DW_CFA_TIME)
          {
-            if(data)
-            {
-               struct tm curtm;
-               CTIME ctime = *((CTIME *)data);
+            gint tmp = data ? _DW_CONTAINER_TIME(*((CTIME *)data)) : 0;
 
-               memset( &curtm, 0, sizeof(curtm) );
-               curtm.tm_hour = ctime.hours;
-               curtm.tm_min = ctime.minutes;
-               curtm.tm_sec = ctime.seconds;
-
-               strftime(textbuffer, 100, "%X", &curtm);
-            }
-            gtk_list_store_set(store, &iter, column + _DW_CONTAINER_STORE_EXTRA + 1, textbuffer, -1);
+            gtk_list_store_set(store, &iter, column + _DW_CONTAINER_STORE_EXTRA + 1, tmp, -1);
          }
       }
    }
@@ -6079,7 +8440,7 @@ void _dw_container_set_row_data_int(HWND handle, void *pointer, int row, int typ
 
    /* Make sure it is the correct tree type */
    if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(cont));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(cont));
 
    if(store)
    {
@@ -6191,7 +8552,7 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, rowcount, int)
 
    /* Make sure it is the correct tree type */
    if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(cont));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(cont));
 
    if(store)
    {
@@ -6234,7 +8595,7 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, DW_UNUSED(redraw), int)
 
    /* Make sure it is the correct tree type */
    if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(cont));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(cont));
 
    if(store)
    {
@@ -6342,7 +8703,7 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, flags, unsigned long)
 
    /* Make sure it is the correct tree type */
    if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(cont));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(cont));
 
    if(store)
    {
@@ -6350,7 +8711,7 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, flags, unsigned long)
       if(flags & DW_CRA_SELECTED)
       {
          GtkTreeSelection *sel = gtk_tree_view_get_selection(GTK_TREE_VIEW(cont));
-         GList *list = gtk_tree_selection_get_selected_rows(sel, NULL);
+         GList *list = _dw_tree_selection_get_selected_rows(sel, NULL);
          if(list)
          {
             GtkTreePath *path = g_list_nth_data(list, 0);
@@ -6378,7 +8739,7 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, flags, unsigned long)
       {
          GtkTreePath *path;
 
-         gtk_tree_view_get_cursor(GTK_TREE_VIEW(cont), &path, NULL);
+         _dw_tree_view_get_cursor(GTK_TREE_VIEW(cont), &path, NULL);
          if(path)
          {
             GtkTreeIter iter;
@@ -6433,7 +8794,7 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, flags, unsigned long)
 
    /* Make sure it is the correct tree type */
    if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(cont));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(cont));
 
    if(store)
    {
@@ -6444,7 +8805,7 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, flags, unsigned long)
       if(flags & DW_CRA_SELECTED)
       {
          GtkTreeSelection *sel = gtk_tree_view_get_selection(GTK_TREE_VIEW(cont));
-         GList *list = gtk_tree_selection_get_selected_rows(sel, NULL);
+         GList *list = _dw_tree_selection_get_selected_rows(sel, NULL);
 
          if(list)
          {
@@ -6458,43 +8819,303 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, flags, unsigned long)
                {
                   GtkTreeIter iter;
 
-                  if(gtk_tree_model_iter_nth_child(GTK_TREE_MODEL(store), &iter, NULL, indices[0]))
-                  {
-                     gtk_tree_model_get(GTK_TREE_MODEL(store), &iter, type, &retval, -1);
-                     g_object_set_data(G_OBJECT(cont), "_dw_querypos", GINT_TO_POINTER(pos+1));
-                  }
-               }
-            }
-            g_list_foreach(list, (GFunc) gtk_tree_path_free, NULL);
-            g_list_free(list);
-         }
-      }
+                  if(gtk_tree_model_iter_nth_child(GTK_TREE_MODEL(store), &iter, NULL, indices[0]))
+                  {
+                     gtk_tree_model_get(GTK_TREE_MODEL(store), &iter, type, &retval, -1);
+                     g_object_set_data(G_OBJECT(cont), "_dw_querypos", GINT_TO_POINTER(pos+1));
+                  }
+               }
+            }
+            g_list_foreach(list, (GFunc) gtk_tree_path_free, NULL);
+            g_list_free(list);
+         }
+      }
+      else if(flags & DW_CRA_CURSORED)
+      {
+         /* There will only be one item cursored,
+          * retrieve it with dw_container_query_start()
+          */
+         retval = NULL;
+      }
+      else
+      {
+         GtkTreeIter iter;
+
+         if(pos < count && gtk_tree_model_iter_nth_child(GTK_TREE_MODEL(store), &iter, NULL, pos))
+         {
+            gtk_tree_model_get(GTK_TREE_MODEL(store), &iter, type, &retval, -1);
+            g_object_set_data(G_OBJECT(cont), "_dw_querypos", GINT_TO_POINTER(pos+1));
+         }
+      }
+   }
+   /* If there is a title, duplicate it and free the temporary copy */
+   if(retval && type == _DW_DATA_TYPE_STRING)
+   {
+      char *temp = retval;
+      retval = strdup(temp);
+      g_free(temp);
+   }
+   DW_FUNCTION_RETURN_THIS(retval);
+}
+
+/*
+ * Returns all matching rows of a container in one call, which is much
+ * faster than dw_container_query_start()/next() on large selections.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       flags: DW_CRA_SELECTED or DW_CRA_CURSORED to limit the rows
+ *              returned, otherwise all rows are returned.
+ *              DW_CR_RETDATA to return the row data instead of titles.
+ *              DW_CR_RETINDEX to return zero based row indexes instead,
+ *              read each one with DW_POINTER_TO_INT().
+ *       count: Pointer to an integer to receive the number of rows.
+ * Returns:
+ *       An array of titles, data pointers or row indexes which must be
+ *       freed with dw_free(), or NULL if there are no matching rows.
+ *       Titles are copied into the same block as the array.
+ */
+DW_FUNCTION_DEFINITION(dw_container_query_selected, void **, HWND handle, unsigned long flags, int *count)
+DW_FUNCTION_ADD_PARAM3(handle, flags, count)
+DW_FUNCTION_RETURN(dw_container_query_selected, void **)
+DW_FUNCTION_RESTORE_PARAM3(handle, HWND, flags, unsigned long, count, int *)
+{
+   GtkWidget *cont;
+   GtkListStore *store = NULL;
+   void **retval = NULL;
+   int rows = 0, z;
+   size_t size = 0;
+   int type = flags & (DW_CR_RETDATA | DW_CR_RETINDEX) ? _DW_DATA_TYPE_POINTER : _DW_DATA_TYPE_STRING;
+
+   cont = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user");
+
+   /* Make sure it is the correct tree type */
+   if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(cont));
+
+   if(store)
+   {
+      GtkTreeModel *model = GTK_TREE_MODEL(store);
+      GtkTreeIter iter;
+      GList *list = NULL, *item;
+      int valid = FALSE;
+
+      /* Fetch the selection once instead of once per row */
+      if(flags & DW_CRA_SELECTED)
+      {
+         GtkTreeSelection *sel = gtk_tree_view_get_selection(GTK_TREE_VIEW(cont));
+
+         list = _dw_tree_selection_get_selected_rows(sel, NULL);
+         rows = g_list_length(list);
+      }
+      else if(flags & DW_CRA_CURSORED)
+      {
+         GtkTreePath *path;
+
+         _dw_tree_view_get_cursor(GTK_TREE_VIEW(cont), &path, NULL);
+         if(path)
+         {
+            list = g_list_append(NULL, path);
+            rows = 1;
+         }
+      }
+      else
+      {
+         rows = gtk_tree_model_iter_n_children(model, NULL);
+         valid = gtk_tree_model_get_iter_first(model, &iter);
+      }
+
+      if(rows > 0 && (retval = calloc(rows, sizeof(void *))))
+      {
+         for(item=list,z=0;z<rows;z++)
+         {
+            int index = z;
+
+            if(list)
+            {
+               if(!item || !gtk_tree_model_get_iter(model, &iter, (GtkTreePath *)item->data))
+                  break;
+               index = gtk_tree_path_get_indices((GtkTreePath *)item->data)[0];
+               item = item->next;
+            }
+            else if(!valid)
+               break;
+            if(flags & DW_CR_RETINDEX)
+               retval[z] = DW_INT_TO_POINTER(index);
+            else
+               gtk_tree_model_get(model, &iter, type, &retval[z], -1);
+            if(retval[z] && type == _DW_DATA_TYPE_STRING)
+               size += strlen((char *)retval[z]) + 1;
+            if(!list)
+               valid = gtk_tree_model_iter_next(model, &iter);
+         }
+         rows = z;
+      }
+      else
+         rows = 0;
+      g_list_foreach(list, (GFunc) gtk_tree_path_free, NULL);
+      g_list_free(list);
+   }
+   /* Pack the titles after the array so one dw_free() releases everything */
+   if(retval && type == _DW_DATA_TYPE_STRING)
+   {
+      void **titles = rows > 0 ? malloc((sizeof(void *) * rows) + size) : NULL;
+      char *buf = titles ? (char *)&titles[rows] : NULL;
+
+      for(z=0;z<rows;z++)
+      {
+         if(retval[z] && buf)
+         {
+            size_t len = strlen((char *)retval[z]) + 1;
+
+            memcpy(buf, retval[z], len);
+            titles[z] = buf;
+            buf += len;
+         }
+         else if(titles)
+            titles[z] = NULL;
+         g_free(retval[z]);
+      }
+      free(retval);
+      retval = titles;
+   }
+   if(!rows && retval)
+   {
+      free(retval);
+      retval = NULL;
+   }
+   if(count)
+      *count = retval ? rows : 0;
+   DW_FUNCTION_RETURN_THIS(retval);
+}
+
+/* Container iterator state, the title fetched from the model is kept
+ * here until the next step instead of being duplicated for the caller.
+ */
+typedef struct _dwcontiter {
+   GtkTreeModel *model;
+   GtkTreeIter iter;
+   GList *list, *item;
+   int valid, started;
+   gchar *title;
+} DWContIter;
+
+/*
+ * Starts iterating the rows of a container without copying them.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       flags: DW_CRA_SELECTED or DW_CRA_CURSORED to limit the rows
+ *              returned, otherwise all rows are returned.
+ * Returns:
+ *       An iterator handle to pass to dw_container_iter_next() and
+ *       dw_container_iter_end(), or NULL on error.
+ */
+DW_FUNCTION_DEFINITION(dw_container_iter_begin, HCONTITER, HWND handle, unsigned long flags)
+DW_FUNCTION_ADD_PARAM2(handle, flags)
+DW_FUNCTION_RETURN(dw_container_iter_begin, HCONTITER)
+DW_FUNCTION_RESTORE_PARAM2(handle, HWND, flags, unsigned long)
+{
+   GtkWidget *cont;
+   GtkListStore *store = NULL;
+   DWContIter *retval = NULL;
+
+   cont = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user");
+
+   /* Make sure it is the correct tree type */
+   if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(cont));
+
+   if(store && (retval = calloc(1, sizeof(DWContIter))))
+   {
+      retval->model = GTK_TREE_MODEL(store);
+      g_object_ref(G_OBJECT(store));
+
+      if(flags & DW_CRA_SELECTED)
+         retval->list = _dw_tree_selection_get_selected_rows(gtk_tree_view_get_selection(GTK_TREE_VIEW(cont)), NULL);
       else if(flags & DW_CRA_CURSORED)
       {
-         /* There will only be one item cursored,
-          * retrieve it with dw_container_query_start()
-          */
-         retval = NULL;
+         GtkTreePath *path;
+
+         _dw_tree_view_get_cursor(GTK_TREE_VIEW(cont), &path, NULL);
+         if(path)
+            retval->list = g_list_append(NULL, path);
       }
       else
+         retval->valid = gtk_tree_model_get_iter_first(retval->model, &retval->iter);
+      /* Selection queries walk the saved paths instead of the model */
+      if(retval->list)
+         retval->valid = TRUE;
+   }
+   DW_FUNCTION_RETURN_THIS(retval);
+}
+
+/*
+ * Moves a container iterator to the next row.  The title and data are
+ * borrowed from the container and are valid until the next call.
+ * Parameters:
+ *       iter: Iterator handle returned by dw_container_iter_begin().
+ *       title: Pointer to receive the row title or NULL.
+ *       data: Pointer to receive the row data or NULL.
+ * Returns:
+ *       TRUE if a row was returned, FALSE at the end of the rows.
+ */
+DW_FUNCTION_DEFINITION(dw_container_iter_next, int, HCONTITER iter, const char **title, void **data)
+DW_FUNCTION_ADD_PARAM3(iter, title, data)
+DW_FUNCTION_RETURN(dw_container_iter_next, int)
+DW_FUNCTION_RESTORE_PARAM3(iter, HCONTITER, title, const char **, data, void **)
+{
+   DWContIter *it = (DWContIter *)iter;
+   int retval = FALSE;
+
+   if(it)
+   {
+      g_free(it->title);
+      it->title = NULL;
+
+      if(it->list)
       {
-         GtkTreeIter iter;
+         it->item = it->started ? (it->item ? it->item->next : NULL) : it->list;
+         it->valid = it->item && gtk_tree_model_get_iter(it->model, &it->iter, (GtkTreePath *)it->item->data);
+      }
+      else if(it->started && it->valid)
+         it->valid = gtk_tree_model_iter_next(it->model, &it->iter);
+      it->started = TRUE;
 
-         if(pos < count && gtk_tree_model_iter_nth_child(GTK_TREE_MODEL(store), &iter, NULL, pos))
+      if(it->valid)
+      {
+         if(title)
          {
-            gtk_tree_model_get(GTK_TREE_MODEL(store), &iter, type, &retval, -1);
-            g_object_set_data(G_OBJECT(cont), "_dw_querypos", GINT_TO_POINTER(pos+1));
+            gtk_tree_model_get(it->model, &it->iter, _DW_DATA_TYPE_STRING, &it->title, -1);
+            *title = it->title;
          }
+         if(data)
+            gtk_tree_model_get(it->model, &it->iter, _DW_DATA_TYPE_POINTER, data, -1);
+         retval = TRUE;
       }
    }
-   /* If there is a title, duplicate it and free the temporary copy */
-   if(retval && type == _DW_DATA_TYPE_STRING)
+   DW_FUNCTION_RETURN_THIS(retval);
+}
+
+/*
+ * Finishes a container iteration and frees the iterator.
+ * Parameters:
+ *       iter: Iterator handle returned by dw_container_iter_begin().
+ */
+DW_FUNCTION_DEFINITION(dw_container_iter_end, void, HCONTITER iter)
+DW_FUNCTION_ADD_PARAM1(iter)
+DW_FUNCTION_NO_RETURN(dw_container_iter_end)
+DW_FUNCTION_RESTORE_PARAM1(iter, HCONTITER)
+{
+   DWContIter *it = (DWContIter *)iter;
+
+   if(it)
    {
-      char *temp = retval;
-      retval = strdup(temp);
-      g_free(temp);
+      g_free(it->title);
+      g_list_foreach(it->list, (GFunc) gtk_tree_path_free, NULL);
+      g_list_free(it->list);
+      g_object_unref(G_OBJECT(it->model));
+      free(it);
    }
-   DW_FUNCTION_RETURN_THIS(retval);
+   DW_FUNCTION_RETURN_NOTHING;
 }
 
 int _dw_find_iter(GtkListStore *store, GtkTreeIter *iter, void *data, int textcomp)
@@ -6530,7 +9151,7 @@ void _dw_container_cursor_int(HWND handle, void *data, int textcomp)
 
    /* Make sure it is the correct tree type */
    if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(cont));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(cont));
 
    if(store)
    {
@@ -6538,7 +9159,7 @@ void _dw_container_cursor_int(HWND handle, void *data, int textcomp)
 
       if(_dw_find_iter(store, &iter, data, textcomp))
       {
-         GtkTreePath *path = gtk_tree_model_get_path(GTK_TREE_MODEL(store), &iter);
+         GtkTreePath *path = _dw_tree_view_path_from_store(GTK_TREE_VIEW(cont), gtk_tree_model_get_path(GTK_TREE_MODEL(store), &iter));
 
          if(path)
          {
@@ -6588,7 +9209,7 @@ void _dw_container_delete_row_int(HWND handle, void *data, int textcomp)
 
    /* Make sure it is the correct tree type */
    if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(cont));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(cont));
 
    if(store)
    {
@@ -6655,6 +9276,108 @@ DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
    DW_FUNCTION_RETURN_NOTHING;
 }
 
+/*
+ * Sorts the rows of a container by the contents of a column,
+ * rows with equal values keep their order.  Rows added later
+ * are not sorted.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based column to sort by.
+ *          order: DW_SORT_ASCENDING or DW_SORT_DESCENDING.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+DW_FUNCTION_DEFINITION(dw_container_sort, int, HWND handle, int column, int order)
+DW_FUNCTION_ADD_PARAM3(handle, column, order)
+DW_FUNCTION_RETURN(dw_container_sort, int)
+DW_FUNCTION_RESTORE_PARAM3(handle, HWND, column, int, order, int)
+{
+   GtkWidget *cont = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user");
+   int retval = DW_ERROR_GENERAL;
+
+   /* Make sure it is the correct tree type */
+   if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
+      retval = _dw_container_sort(cont, column, order);
+   DW_FUNCTION_RETURN_THIS(retval);
+}
+
+/*
+ * Sets whether clicking a column heading sorts the container by
+ * that column, clicking the same heading again reverses the order.
+ * The column click signal handler is called after the rows are sorted.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          sortable: TRUE to sort on heading clicks, FALSE to leave it to the application.
+ */
+DW_FUNCTION_DEFINITION(dw_container_set_sortable, void, HWND handle, int sortable)
+DW_FUNCTION_ADD_PARAM2(handle, sortable)
+DW_FUNCTION_NO_RETURN(dw_container_set_sortable)
+DW_FUNCTION_RESTORE_PARAM2(handle, HWND, sortable, int)
+{
+   GtkWidget *cont = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user");
+
+   /* Make sure it is the correct tree type */
+   if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
+      g_object_set_data(G_OBJECT(cont), "_dw_sortable", GINT_TO_POINTER(sortable));
+   DW_FUNCTION_RETURN_NOTHING;
+}
+
+/*
+ * Shows only the rows of a container whose text in a column contains
+ * the filter text, ignoring case unless DW_FILTER_CASESENSITIVE is set.
+ * Rows hidden by the filter are still returned by queries of all rows,
+ * and row numbers passed to other functions count hidden rows.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based string column to filter on.
+ *          text: Text the column must contain, NULL or "" shows all rows.
+ *          flags: DW_FILTER_CASESENSITIVE or 0.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+DW_FUNCTION_DEFINITION(dw_container_set_filter, int, HWND handle, int column, const char *text, unsigned long flags)
+DW_FUNCTION_ADD_PARAM4(handle, column, text, flags)
+DW_FUNCTION_RETURN(dw_container_set_filter, int)
+DW_FUNCTION_RESTORE_PARAM4(handle, HWND, column, int, text, const char *, flags, unsigned long)
+{
+   GtkWidget *cont = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user");
+   int retval = DW_ERROR_GENERAL;
+
+   /* Make sure it is the correct tree type */
+   if(cont && GTK_IS_TREE_VIEW(cont) && g_object_get_data(G_OBJECT(cont), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_CONTAINER))
+      retval = _dw_container_filter(cont, column, text, flags);
+   DW_FUNCTION_RETURN_THIS(retval);
+}
+
+/*
+ * Stops the container from updating while many rows are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the container to freeze.
+ */
+DW_FUNCTION_DEFINITION(dw_container_freeze, void, HWND handle)
+DW_FUNCTION_ADD_PARAM1(handle)
+DW_FUNCTION_NO_RETURN(dw_container_freeze)
+DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
+{
+   _dw_tree_view_freeze(handle, _DW_TREE_TYPE_CONTAINER, TRUE);
+   DW_FUNCTION_RETURN_NOTHING;
+}
+
+/*
+ * Resumes updating of a frozen container, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the container to thaw.
+ */
+DW_FUNCTION_DEFINITION(dw_container_thaw, void, HWND handle)
+DW_FUNCTION_ADD_PARAM1(handle)
+DW_FUNCTION_NO_RETURN(dw_container_thaw)
+DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
+{
+   _dw_tree_view_freeze(handle, _DW_TREE_TYPE_CONTAINER, FALSE);
+   DW_FUNCTION_RETURN_NOTHING;
+}
+
 /*
  * Inserts an icon into the taskbar.
  * Parameters:
@@ -7141,7 +9864,7 @@ DW_FUNCTION_RESTORE_PARAM5(handle, HWND, pixmap, HPIXMAP, x, int, y, int, text,
    if(text)
    {
       cairo_t *cr = NULL;
-      PangoFontDescription *font;
+      DWFontCache *fc;
       char *tmpname, *fontname = "monospace 10";
       int cached = FALSE;
 
@@ -7166,49 +9889,34 @@ DW_FUNCTION_RESTORE_PARAM5(handle, HWND, pixmap, HPIXMAP, x, int, y, int, text,
       }
       if(cr)
       {
-         font = pango_font_description_from_string(fontname);
-         if(font)
+         fc = _dw_font_cache_get(fontname);
+         if(fc)
          {
-            PangoContext *context = pango_cairo_create_context(cr);
-
-            if(context)
-            {
-               PangoLayout *layout = pango_layout_new(context);
-
-               if(layout)
-               {
 #ifdef _DW_SINGLE_THREADED
-                  GdkRGBA *_dw_fg_color = pthread_getspecific(_dw_fg_color_key);
-                  GdkRGBA *_dw_bg_color = pthread_getspecific(_dw_bg_color_key);
+            GdkRGBA *_dw_fg_color = pthread_getspecific(_dw_fg_color_key);
+            GdkRGBA *_dw_bg_color = pthread_getspecific(_dw_bg_color_key);
 #endif
+            PangoLayout *layout;
 
-                  pango_layout_set_font_description(layout, font);
-                  pango_layout_set_text(layout, text, strlen(text));
-
-                  gdk_cairo_set_source_rgba(cr, _dw_fg_color);
-                  /* Create a background color attribute if required */
-                  if(_dw_bg_color)
-                  {
-                     PangoAttrList *list = pango_layout_get_attributes(layout);
-                     PangoAttribute *attr = pango_attr_background_new((guint16)(_dw_bg_color->red * 65535),
-                                                                      (guint16)(_dw_bg_color->green * 65535),
-                                                                      (guint16)(_dw_bg_color->blue* 65535));
-                     if(!list)
-                     {
-                        list = pango_attr_list_new();
-                     }
-                     pango_attr_list_change(list, attr);
-                     pango_layout_set_attributes(layout, list);
-                  }
-                  /* Do the drawing */
-                  cairo_move_to(cr, x, y);
-                  pango_cairo_show_layout (cr, layout);
+            /* Try for an already shaped layout first, if the text cache is enabled */
+            if(!(layout = _dw_text_cache_get(fc, cr, text, _dw_bg_color)) &&
+               (layout = _dw_font_cache_layout(fc, cr)))
+            {
+               PangoAttrList *list = _dw_text_attributes(_dw_bg_color);
 
-                  g_object_unref(layout);
-               }
-               g_object_unref(context);
+               pango_layout_set_text(layout, text, strlen(text));
+               /* The layout is reused so always reset the attributes */
+               pango_layout_set_attributes(layout, list);
+               if(list)
+                  pango_attr_list_unref(list);
+            }
+            if(layout)
+            {
+               gdk_cairo_set_source_rgba(cr, _dw_fg_color);
+               /* Do the drawing */
+               cairo_move_to(cr, x, y);
+               pango_cairo_show_layout (cr, layout);
             }
-            pango_font_description_free(font);
          }
          /* If we are using a drawing context...
           * we don't own the cairo context so don't destroy it.
@@ -7220,6 +9928,33 @@ DW_FUNCTION_RESTORE_PARAM5(handle, HWND, pixmap, HPIXMAP, x, int, y, int, text,
    DW_FUNCTION_RETURN_NOTHING;
 }
 
+/* Internal function to find the font name used to measure text,
+ * *free_fontname is set if the returned string needs to be freed.
+ */
+static char *_dw_text_extents_font(HWND handle, HPIXMAP pixmap, int *free_fontname)
+{
+   char *fontname = NULL;
+
+   *free_fontname = FALSE;
+   if(handle)
+   {
+      fontname = (char *)g_object_get_data(G_OBJECT(handle), "_dw_fontname");
+      if(fontname == NULL)
+      {
+         fontname = dw_window_get_font(handle);
+         *free_fontname = TRUE;
+      }
+   }
+   else if(pixmap)
+   {
+      if(pixmap->font)
+         fontname = pixmap->font;
+      else if(pixmap->handle)
+         fontname = (char *)g_object_get_data(G_OBJECT(pixmap->handle), "_dw_fontname");
+   }
+   return fontname;
+}
+
 /* Query the width and height of a text string.
  * Parameters:
  *       handle: Handle to the window.
@@ -7233,55 +9968,52 @@ DW_FUNCTION_ADD_PARAM5(handle, pixmap, text, width, height)
 DW_FUNCTION_NO_RETURN(dw_font_text_extents_get)
 DW_FUNCTION_RESTORE_PARAM5(handle, HWND, pixmap, HPIXMAP, text, const char *, width, int *, height, int *)
 {
-   PangoFontDescription *font;
-   char *fontname = NULL;
-   int free_fontname = FALSE;
-
    if(text)
    {
-      if(handle)
-      {
-         fontname = (char *)g_object_get_data(G_OBJECT(handle), "_dw_fontname");
-         if(fontname == NULL)
-         {
-            fontname = dw_window_get_font(handle);
-            free_fontname = TRUE;
-         }
-      }
-      else if(pixmap)
-      {
-         if(pixmap->font)
-            fontname = pixmap->font;
-         else if(pixmap->handle)
-            fontname = (char *)g_object_get_data(G_OBJECT(pixmap->handle), "_dw_fontname");
-      }
-
-      font = pango_font_description_from_string(fontname ? fontname : "monospace 10");
-      if(font)
-      {
-         PangoContext *context = gtk_widget_get_pango_context(pixmap ? pixmap->handle : handle);
-
-         if(context)
-         {
-            PangoLayout *layout = pango_layout_new(context);
-
-            if(layout)
-            {
-               PangoRectangle rect;
+      int free_fontname;
+      char *fontname = _dw_text_extents_font(handle, pixmap, &free_fontname);
 
-               pango_layout_set_font_description(layout, font);
-               pango_layout_set_text(layout, text, -1);
-               pango_layout_get_pixel_extents(layout, NULL, &rect);
+      _dw_text_extents(gtk_widget_get_pango_context(pixmap ? pixmap->handle : handle),
+                       fontname ? fontname : "monospace 10", text, width, height);
+      if(free_fontname)
+         free(fontname);
+   }
+   DW_FUNCTION_RETURN_NOTHING;
+}
 
-               if(width)
-                  *width = rect.width;
-               if(height)
-                  *height = rect.height;
+/* Query the width and height of multiple text strings at once.
+ * Parameters:
+ *       handle: Handle to the window.
+ *       pixmap: Handle to the pixmap. (choose only one of these)
+ *       count: Number of strings in the texts array.
+ *       texts: Array of text strings to be queried, NULL entries
+ *              get a width and height of 0.
+ *       widths: Array of count integers to be filled in with the widths, or NULL.
+ *       heights: Array of count integers to be filled in with the heights, or NULL.
+ */
+DW_FUNCTION_DEFINITION(dw_font_text_extents_get_many, void, HWND handle, HPIXMAP pixmap, int count, char **texts, int *widths, int *heights)
+DW_FUNCTION_ADD_PARAM6(handle, pixmap, count, texts, widths, heights)
+DW_FUNCTION_NO_RETURN(dw_font_text_extents_get_many)
+DW_FUNCTION_RESTORE_PARAM6(handle, HWND, pixmap, HPIXMAP, count, int, texts, char **, widths, int *, heights, int *)
+{
+   if(texts && count > 0)
+   {
+      PangoContext *context = gtk_widget_get_pango_context(pixmap ? pixmap->handle : handle);
+      int free_fontname, z;
+      char *fontname = _dw_text_extents_font(handle, pixmap, &free_fontname);
 
-               g_object_unref(layout);
-            }
+      for(z=0;z<count;z++)
+      {
+         if(texts[z])
+            _dw_text_extents(context, fontname ? fontname : "monospace 10", texts[z],
+                             widths ? &widths[z] : NULL, heights ? &heights[z] : NULL);
+         else
+         {
+            if(widths)
+               widths[z] = 0;
+            if(heights)
+               heights[z] = 0;
          }
-         pango_font_description_free(font);
       }
       if(free_fontname)
          free(fontname);
@@ -7379,6 +10111,27 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, filename, const char *)
    DW_FUNCTION_RETURN_THIS(pixmap);
 }
 
+/*
+ * Creates a pixmap from a file without blocking the caller.
+ * The file is located and decoded on a worker thread and the
+ * callback is then run on the main thread with the result.
+ * Parameters:
+ *       handle: Window handle the pixmap is associated with.
+ *       filename: Name of the file, omit extention to have
+ *                 DW pick the appropriate file extension.
+ *                 (BMP on OS/2 or Windows, XPM on Unix)
+ *       callback: Function of the form int func(HPIXMAP pixmap, void *data)
+ *                 pixmap will be NULL if the file could not be loaded.
+ *       data: User data to be passed to the callback.
+ * Returns:
+ *       DW_ERROR_NONE if the load was queued, DW_ERROR_GENERAL on error
+ *       in which case the callback will not be called.
+ */
+int API dw_pixmap_new_from_file_async(HWND handle, const char *filename, void *callback, void *data)
+{
+   return _dw_image_load_start(handle, filename, callback, data, FALSE);
+}
+
 /*
  * Creates a pixmap from data
  * Parameters:
@@ -7496,8 +10249,13 @@ DW_FUNCTION_NO_RETURN(dw_flush)
  * Returns:
  *       DW_ERROR_NONE on success and DW_ERROR_GENERAL on failure.
  */
-int API dw_pixmap_set_font(HPIXMAP pixmap, const char *fontname)
+DW_FUNCTION_DEFINITION(dw_pixmap_set_font, int, HPIXMAP pixmap, const char *fontname)
+DW_FUNCTION_ADD_PARAM2(pixmap, fontname)
+DW_FUNCTION_RETURN(dw_pixmap_set_font, int)
+DW_FUNCTION_RESTORE_PARAM2(pixmap, HPIXMAP, fontname, const char *)
 {
+    int retval = DW_ERROR_GENERAL;
+
     if(pixmap)
     {
          char *oldfont = pixmap->font;
@@ -7505,10 +10263,13 @@ int API dw_pixmap_set_font(HPIXMAP pixmap, const char *fontname)
          pixmap->font = _dw_convert_font(fontname);
 
          if(oldfont)
+         {
+             _dw_font_cache_invalidate(oldfont);
              free(oldfont);
-         return DW_ERROR_NONE;
+         }
+         retval = DW_ERROR_NONE;
     }
-    return DW_ERROR_GENERAL;
+    DW_FUNCTION_RETURN_THIS(retval);
 }
 
 /*
@@ -8627,6 +11388,7 @@ void _dw_box_pack(HWND box, HWND item, int index, int width, int height, int hsi
    {
       int boxcount = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(box), "_dw_boxcount"));
       int boxtype = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(box), "_dw_boxtype"));
+      int append = FALSE;
 
       /* If the item being packed is a box, then we use it's padding
        * instead of the padding specified on the pack line, this is
@@ -8646,6 +11408,10 @@ void _dw_box_pack(HWND box, HWND item, int index, int width, int height, int hsi
          index = 0;
       if(index > boxcount)
          index = boxcount;
+      /* Removing rows and columns keeps the grid packed, so the
+       * next free cell is always at the item count.
+       */
+      append = (index == boxcount);
 
       g_object_set_data(G_OBJECT(item), "_dw_table", box);
       /* Set the expand attribute on the widgets now instead of the container */
@@ -8661,15 +11427,19 @@ void _dw_box_pack(HWND box, HWND item, int index, int width, int height, int hsi
       _dw_widget_set_pad(item, pad);
       /* Add to the grid using insert...
        * rows for vertical boxes and columns for horizontal.
+       * Inserting moves every following child, so only do it
+       * when the item goes in front of existing ones.
        */
       if(boxtype == DW_VERT)
       {
-         gtk_grid_insert_row(GTK_GRID(box), index);
+         if(!append)
+            gtk_grid_insert_row(GTK_GRID(box), index);
          gtk_grid_attach(GTK_GRID(box), item, 0, index, 1, 1);
       }
       else
       {
-         gtk_grid_insert_column(GTK_GRID(box), index);
+         if(!append)
+            gtk_grid_insert_column(GTK_GRID(box), index);
          gtk_grid_attach(GTK_GRID(box), item, index, 0, 1, 1);
       }
       g_object_set_data(G_OBJECT(box), "_dw_boxcount", GINT_TO_POINTER(boxcount + 1));
@@ -8756,13 +11526,15 @@ DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
             g_object_ref(G_OBJECT(handle2));
             g_object_set_data(G_OBJECT(handle2), "_dw_refed", GINT_TO_POINTER(1));
          }
-         /* Remove the widget from the box */
+         /* Remove the widget from the box, the count was already
+          * decremented so the last item is at the new count.
+          */
          /* Figure out where in the grid this widget is and remove that row/column */
          if(boxtype == DW_VERT)
          {
             int z;
 
-            for(z=0;z<boxcount;z++)
+            for(z=0;z<=boxcount;z++)
             {
                if(gtk_grid_get_child_at(GTK_GRID(box), 0, z) == handle2)
                {
@@ -8775,7 +11547,7 @@ DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
          {
             int z;
 
-            for(z=0;z<boxcount;z++)
+            for(z=0;z<=boxcount;z++)
             {
                if(gtk_grid_get_child_at(GTK_GRID(box), z, 0) == handle2)
                {
@@ -9516,11 +12288,11 @@ DW_FUNCTION_RESTORE_PARAM3(handle, HWND, text, const char *, pos, int)
 
       /* Make sure it is the correct tree type */
       if(GTK_IS_TREE_VIEW(handle2) && g_object_get_data(G_OBJECT(handle2), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_LISTBOX))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(handle2));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(handle2));
       else if(GTK_IS_COMBO_BOX(handle2))
          store = (GtkListStore *)gtk_combo_box_get_model(GTK_COMBO_BOX(handle2));
 
-      if(store)
+      if(store && GTK_IS_LIST_STORE(store))
       {
          if(pos < 0)
          {
@@ -9567,11 +12339,11 @@ DW_FUNCTION_RESTORE_PARAM3(handle, HWND, text, char **, count, int)
 
       /* Make sure it is the correct tree type */
       if(GTK_IS_TREE_VIEW(handle2) && g_object_get_data(G_OBJECT(handle2), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_LISTBOX))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(handle2));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(handle2));
       else if(GTK_IS_COMBO_BOX(handle2))
          store = (GtkListStore *)gtk_combo_box_get_model(GTK_COMBO_BOX(handle2));
 
-      if(store)
+      if(store && GTK_IS_LIST_STORE(store))
       {
          /* Insert entries at the end */
          for(z=0;z<count;z++)
@@ -9584,6 +12356,80 @@ DW_FUNCTION_RESTORE_PARAM3(handle, HWND, text, char **, count, int)
    DW_FUNCTION_RETURN_NOTHING;
 }
 
+/*
+ * Makes a listbox or combobox virtual, the application supplies the
+ * text of each entry on demand instead of appending it.  Functions
+ * that add, change or delete single entries are ignored on virtual
+ * lists, call this again when the number of entries changes.
+ * Parameters:
+ *          handle: Handle to the listbox to be made virtual.
+ *          count: Number of entries in the list.
+ *          textfunc: Function returning the text of an entry, with the
+ *                    prototype char *textfunc(HWND handle, int index, void *data).
+ *                    The text only needs to remain valid until the next
+ *                    call.  NULL returns the list to normal with no entries.
+ *          data: Pointer passed to the text function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+DW_FUNCTION_DEFINITION(dw_listbox_set_virtual, int, HWND handle, int count, void *textfunc, void *data)
+DW_FUNCTION_ADD_PARAM4(handle, count, textfunc, data)
+DW_FUNCTION_RETURN(dw_listbox_set_virtual, int)
+DW_FUNCTION_RESTORE_PARAM4(handle, HWND, count, int, textfunc, void *, data, void *)
+{
+   GtkWidget *handle2 = handle;
+   int retval = DW_ERROR_GENERAL;
+
+   /* Get the inner handle for scrolled controls */
+   if(GTK_IS_SCROLLED_WINDOW(handle))
+   {
+      GtkWidget *tmp = (GtkWidget *)g_object_get_data(G_OBJECT(handle), "_dw_user");
+      if(tmp)
+         handle2 = tmp;
+   }
+   if(handle2 && count >= 0 &&
+      ((GTK_IS_TREE_VIEW(handle2) && g_object_get_data(G_OBJECT(handle2), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_LISTBOX)) ||
+       GTK_IS_COMBO_BOX(handle2)))
+   {
+      /* The view only asks for the rows it shows, so the count costs nothing */
+      if(textfunc)
+         _dw_listbox_set_model(handle2, _dw_virtual_list_new(handle, count, textfunc, data), TRUE);
+      else
+         _dw_listbox_set_model(handle2, GTK_TREE_MODEL(gtk_list_store_new(1, G_TYPE_STRING)), FALSE);
+      retval = DW_ERROR_NONE;
+   }
+   DW_FUNCTION_RETURN_THIS(retval);
+}
+
+/*
+ * Stops the listbox from updating while many items are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the listbox to freeze.
+ */
+DW_FUNCTION_DEFINITION(dw_listbox_freeze, void, HWND handle)
+DW_FUNCTION_ADD_PARAM1(handle)
+DW_FUNCTION_NO_RETURN(dw_listbox_freeze)
+DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
+{
+   _dw_tree_view_freeze(handle, _DW_TREE_TYPE_LISTBOX, TRUE);
+   DW_FUNCTION_RETURN_NOTHING;
+}
+
+/*
+ * Resumes updating of a frozen listbox, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the listbox to thaw.
+ */
+DW_FUNCTION_DEFINITION(dw_listbox_thaw, void, HWND handle)
+DW_FUNCTION_ADD_PARAM1(handle)
+DW_FUNCTION_NO_RETURN(dw_listbox_thaw)
+DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
+{
+   _dw_tree_view_freeze(handle, _DW_TREE_TYPE_LISTBOX, FALSE);
+   DW_FUNCTION_RETURN_NOTHING;
+}
+
 /*
  * Clears the listbox's (or combobox) list of all entries.
  * Parameters:
@@ -9609,11 +12455,18 @@ DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
    {
       /* Make sure it is the correct tree type */
       if(GTK_IS_TREE_VIEW(handle2) && g_object_get_data(G_OBJECT(handle2), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_LISTBOX))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(handle2));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(handle2));
       else if(GTK_IS_COMBO_BOX(handle2))
          store = (GtkListStore *)gtk_combo_box_get_model(GTK_COMBO_BOX(handle2));
 
-      if(store)
+      /* Virtual lists are replaced with an empty one */
+      if(store && _DW_IS_VIRTUAL_LIST(store))
+      {
+         DWVirtualList *list = (DWVirtualList *)store;
+
+         _dw_listbox_set_model(handle2, _dw_virtual_list_new(list->handle, 0, list->textfunc, list->data), TRUE);
+      }
+      else if(store)
       {
          /* Clear the list */
          gtk_list_store_clear(store);
@@ -9647,7 +12500,7 @@ DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
    {
       /* Make sure it is the correct tree type */
       if(GTK_IS_TREE_VIEW(handle2) && g_object_get_data(G_OBJECT(handle2), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_LISTBOX))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(handle2));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(handle2));
       else if(GTK_IS_COMBO_BOX(handle2))
          store = (GtkListStore *)gtk_combo_box_get_model(GTK_COMBO_BOX(handle2));
 
@@ -9684,7 +12537,7 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, top, int)
    if(handle2 && GTK_IS_TREE_VIEW(handle2) && g_object_get_data(G_OBJECT(handle2), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_LISTBOX))
    {
       GtkAdjustment *adjust = gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(handle));
-      GtkListStore *store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(handle2));
+      GtkListStore *store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(handle2));
 
       if(store && adjust)
       {
@@ -9740,7 +12593,7 @@ DW_FUNCTION_RESTORE_PARAM4(handle, HWND, index, unsigned int, buffer, char *, le
    {
       /* Make sure it is the correct tree type */
       if(GTK_IS_TREE_VIEW(handle2) && g_object_get_data(G_OBJECT(handle2), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_LISTBOX))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(handle2));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(handle2));
       else if(GTK_IS_COMBO_BOX(handle2))
          store = (GtkListStore *)gtk_combo_box_get_model(GTK_COMBO_BOX(handle2));
 
@@ -9792,11 +12645,11 @@ DW_FUNCTION_RESTORE_PARAM3(handle, HWND, index, unsigned int, buffer, char *)
    {
       /* Make sure it is the correct tree type */
       if(GTK_IS_TREE_VIEW(handle2) && g_object_get_data(G_OBJECT(handle2), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_LISTBOX))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(handle2));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(handle2));
       else if(GTK_IS_COMBO_BOX(handle2))
          store = (GtkListStore *)gtk_combo_box_get_model(GTK_COMBO_BOX(handle2));
 
-      if(store && index < gtk_tree_model_iter_n_children(GTK_TREE_MODEL(store), NULL))
+      if(store && GTK_IS_LIST_STORE(store) && index < gtk_tree_model_iter_n_children(GTK_TREE_MODEL(store), NULL))
       {
          GtkTreeIter iter;
 
@@ -9830,12 +12683,12 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, where, int)
 
    /* Make sure it is the correct tree type */
    if(handle2 && GTK_IS_TREE_VIEW(handle2) && g_object_get_data(G_OBJECT(handle2), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_LISTBOX))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(handle2));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(handle2));
 
    if(store)
    {
       GtkTreeSelection *sel = gtk_tree_view_get_selection(GTK_TREE_VIEW(handle2));
-      GList *list = gtk_tree_selection_get_selected_rows(sel, NULL);
+      GList *list = _dw_tree_selection_get_selected_rows(sel, NULL);
 
       if(list)
       {
@@ -9888,7 +12741,7 @@ DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
    {
       /* Make sure it is the correct tree type */
       if(GTK_IS_TREE_VIEW(handle2) && g_object_get_data(G_OBJECT(handle2), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_LISTBOX))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(handle2));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(handle2));
       else if(GTK_IS_COMBO_BOX(handle2))
          store = (GtkListStore *)gtk_combo_box_get_model(GTK_COMBO_BOX(handle2));
 
@@ -9897,7 +12750,7 @@ DW_FUNCTION_RESTORE_PARAM1(handle, HWND)
          if(GTK_IS_TREE_VIEW(handle2))
          {
             GtkTreeSelection *sel = gtk_tree_view_get_selection(GTK_TREE_VIEW(handle2));
-            GList *list = gtk_tree_selection_get_selected_rows(sel, NULL);
+            GList *list = _dw_tree_selection_get_selected_rows(sel, NULL);
             if(list)
             {
                GtkTreePath *path = g_list_nth_data(list, 0);
@@ -9963,7 +12816,7 @@ DW_FUNCTION_RESTORE_PARAM3(handle, HWND, index, int, state, int)
    {
       /* Make sure it is the correct tree type */
       if(GTK_IS_TREE_VIEW(handle2) && g_object_get_data(G_OBJECT(handle2), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_LISTBOX))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(handle2));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(handle2));
       else if(GTK_IS_COMBO_BOX(handle2))
          store = (GtkListStore *)gtk_combo_box_get_model(GTK_COMBO_BOX(handle2));
 
@@ -10023,11 +12876,11 @@ DW_FUNCTION_RESTORE_PARAM2(handle, HWND, index, int)
    {
       /* Make sure it is the correct tree type */
       if(GTK_IS_TREE_VIEW(handle2) && g_object_get_data(G_OBJECT(handle2), "_dw_tree_type") == GINT_TO_POINTER(_DW_TREE_TYPE_LISTBOX))
-         store = (GtkListStore *)gtk_tree_view_get_model(GTK_TREE_VIEW(handle2));
+         store = (GtkListStore *)_dw_tree_view_get_model(GTK_TREE_VIEW(handle2));
       else if(GTK_IS_COMBO_BOX(handle2))
          store = (GtkListStore *)gtk_combo_box_get_model(GTK_COMBO_BOX(handle2));
 
-      if(store)
+      if(store && GTK_IS_LIST_STORE(store))
       {
          GtkTreeIter iter;
 
@@ -11201,7 +14054,7 @@ gboolean _dw_timer_func(gpointer data)
          free(tag);
       return FALSE;
    }
-   sigfunc(sdata);
+   _DW_SIGNAL_TIMED("timer", 0, sigfunc(sdata));
    return TRUE;
 }
 
@@ -11306,7 +14159,7 @@ GObject *_dw_key_setup(struct _dw_signal_list *signal, GObject *object, void *si
    {
       GtkGesture *gesture = gtk_gesture_click_new();
       gtk_widget_add_controller(GTK_WIDGET(object), GTK_EVENT_CONTROLLER(gesture));
-      int cid, sigid = _dw_set_signal_handler(G_OBJECT(object), (HWND)object, sigfunc, data, (gpointer)_dw_container_enter_mouse, discfunc);
+      int cid, sigid = _dw_set_signal_handler(G_OBJECT(object), (HWND)object, sigfunc, data, (gpointer)_dw_container_enter_mouse, discfunc, signal->name);
       void **newparams = calloc(sizeof(void *), 3);
 
       newparams[0] = DW_INT_TO_POINTER(sigid);
@@ -11345,7 +14198,7 @@ GObject *_dw_button_setup(struct _dw_signal_list *signal, GObject *object, void
       
       if(action)
       {
-         int cid, sigid = _dw_set_signal_handler(G_OBJECT(object), (HWND)object, sigfunc, data, (gpointer)_dw_menu_handler, discfunc);
+         int cid, sigid = _dw_set_signal_handler(G_OBJECT(object), (HWND)object, sigfunc, data, (gpointer)_dw_menu_handler, discfunc, signal->name);
          void **newparams = calloc(sizeof(void *), 3);
 
          newparams[0] = DW_INT_TO_POINTER(sigid);
@@ -11402,7 +14255,7 @@ GObject *_dw_tree_setup(struct _dw_signal_list *signal, GObject *object, void *s
          /* We don't actually need a signal handler here... just need to assign the handler ID
           * Since the handlers for the columns were already created in _dw_container_setup()
           */
-         int sigid = _dw_set_signal_handler(object, (HWND)object, sigfunc, data, signal->func, discfunc);
+         int sigid = _dw_set_signal_handler(object, (HWND)object, sigfunc, data, signal->func, discfunc, signal->name);
          g_object_set_data(object, "_dw_column_click_id", GINT_TO_POINTER(sigid+1));
          return NULL;
       }
@@ -11448,7 +14301,7 @@ GObject *_dw_html_setup(struct _dw_signal_list *signal, GObject *object, void *s
           /* We don't actually need a signal handler here... just need to assign the handler ID
            * Since the handler is created in dw_html_javasript_run()
            */
-          int sigid = _dw_set_signal_handler(object, (HWND)object, sigfunc, data, signal->func, discfunc);
+          int sigid = _dw_set_signal_handler(object, (HWND)object, sigfunc, data, signal->func, discfunc, signal->name);
           g_object_set_data(object, "_dw_html_result_id", GINT_TO_POINTER(sigid+1));
           return NULL;
        }
@@ -11457,7 +14310,7 @@ GObject *_dw_html_setup(struct _dw_signal_list *signal, GObject *object, void *s
           /* We don't actually need a signal handler here... just need to assign the handler ID
            * Since the handler is created in dw_html_javasript_add()
            */
-          int sigid = _dw_set_signal_handler(object, (HWND)object, sigfunc, data, signal->func, discfunc);
+          int sigid = _dw_set_signal_handler(object, (HWND)object, sigfunc, data, signal->func, discfunc, signal->name);
           g_object_set_data(object, "_dw_html_message_id", GINT_TO_POINTER(sigid+1));
           return NULL;
       }
@@ -11505,7 +14358,7 @@ void API dw_signal_connect_data(HWND window, const char *signame, void *sigfunc,
          return;
 
       params = calloc(_DW_INTERNAL_CALLBACK_PARAMS, sizeof(void *));
-      sigid = _dw_set_signal_handler(object, window, sigfunc, data, signal.func, discfunc);
+      sigid = _dw_set_signal_handler(object, window, sigfunc, data, signal.func, discfunc, signal.name);
       params[0] = DW_INT_TO_POINTER(sigid);
       /* Save the disconnect function pointer */
       params[1] = discfunc;
@@ -11681,6 +14534,14 @@ int API dw_feature_get(DWFEATURE feature)
             return DW_FEATURE_ENABLED;
         case DW_FEATURE_WINDOW_PLACEMENT:
             return dw_x11_check(DW_FEATURE_ENABLED, DW_FEATURE_UNSUPPORTED);
+        case DW_FEATURE_TEXT_CACHE:
+            return _dw_text_cache_max;
+#ifndef _DW_SINGLE_THREADED
+        case DW_FEATURE_TRACE:
+            return _dw_trace_enabled;
+#endif
+        case DW_FEATURE_SIGNAL_PROFILE:
+            return _dw_signal_profile;
         default:
             return DW_FEATURE_UNSUPPORTED;
     }
@@ -11718,6 +14579,46 @@ int API dw_feature_set(DWFEATURE feature, int state)
         case DW_FEATURE_WINDOW_PLACEMENT:
             return dw_x11_check(DW_ERROR_GENERAL, DW_FEATURE_UNSUPPORTED);
         /* These features are supported and configurable */
+        /* State is the number of layouts to keep, DW_FEATURE_ENABLED for the default */
+        case DW_FEATURE_TEXT_CACHE:
+        {
+            if(state < DW_FEATURE_DISABLED)
+                return DW_ERROR_GENERAL;
+            /* The cache itself is trimmed the next time text is drawn */
+            _dw_text_cache_max = (state == DW_FEATURE_ENABLED) ? _DW_TEXT_CACHE_DEFAULT : state;
+            return DW_ERROR_NONE;
+        }
+#ifndef _DW_SINGLE_THREADED
+        /* Calls are only traced through the DW_FUNCTION macros */
+        case DW_FEATURE_TRACE:
+        {
+            if(state == DW_FEATURE_ENABLED || state == DW_FEATURE_DISABLED)
+            {
+                /* Trace event times are relative to when tracing first started */
+                if(state && !_dw_trace_epoch)
+                    _dw_trace_epoch = _dw_trace_now();
+                _dw_trace_enabled = state;
+                return DW_ERROR_NONE;
+            }
+            return DW_ERROR_GENERAL;
+        }
+#endif
+        /* State is the threshold in milliseconds, DW_FEATURE_ENABLED for the default */
+        case DW_FEATURE_SIGNAL_PROFILE:
+        {
+            if(state < DW_FEATURE_DISABLED)
+                return DW_ERROR_GENERAL;
+            /* Start counting again when turned on */
+            if(state && !_dw_signal_profile)
+            {
+                pthread_mutex_lock(&_dw_trace_mutex);
+                if(_dw_signal_stats)
+                    g_hash_table_remove_all(_dw_signal_stats);
+                pthread_mutex_unlock(&_dw_trace_mutex);
+            }
+            _dw_signal_profile = (state == DW_FEATURE_ENABLED) ? _DW_SIGNAL_PROFILE_DEFAULT : state;
+            return DW_ERROR_NONE;
+        }
         default:
             return DW_FEATURE_UNSUPPORTED;
     }
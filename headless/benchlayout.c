@@ -0,0 +1,329 @@
+/*
+ * Dynamic Windows:
+ *          A GTK like GUI implementation.
+ *
+ * Box packing and layout microbenchmark for the headless backend.
+ *
+ * Packs and unpacks a large number of items into a vertical and a
+ * horizontal box, measures a very wide box and a large tree with and
+ * without worker threads, then lays out deep, wide and mixed
+ * trees of widgets, and reports the time taken by each phase.
+ * This is a benchmark not a test and prints numbers rather than
+ * checking them. Run it with "make bench-layout".
+ *
+ * Built without __HEADLESS__ it links against the platform library
+ * and only runs the packing phases, "make bench-pack" does this.
+ *
+ * Usage: benchlayout [items] [threads]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "dw.h"
+
+#define BENCH_ITEMS 10000
+#define BENCH_ROWS 100
+#define BENCH_COLUMNS 30
+#define BENCH_PASSES 100
+#define BENCH_DEPTH 200
+#define BENCH_WIDE_TREE 10000
+#define BENCH_WIDE_ITEMS 100000
+#define BENCH_MEASURES 20
+/* 8 columns of 50 rows of 125 items is 50k items */
+#define BENCH_COLUMNS_LARGE 8
+#define BENCH_ROWS_LARGE 50
+#define BENCH_ROW_ITEMS 125
+
+/* Returns a monotonic timestamp in milliseconds */
+static double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000.0) + (ts.tv_nsec / 1000000.0);
+}
+
+static void bench_report(const char *phase, int count, double start)
+{
+    double elapsed = bench_now() - start;
+
+    printf("%-32s %8d items %10.3f ms %10.1f ns/item\n", phase, count, elapsed,
+           count ? (elapsed * 1000000.0) / count : 0.0);
+}
+
+/* Packs and unpacks the given items into a single box of the given
+ * orientation, appending with dw_box_pack_start() and inserting at
+ * the front with dw_box_pack_end().
+ */
+static void bench_pack(HWND *items, int count, int type)
+{
+    HWND window = dw_window_new(HWND_DESKTOP, "Box packing benchmark", DW_FCF_SIZEBORDER);
+    HWND box = dw_box_new(type, 0);
+    const char *name = (type == DW_VERT) ? "vert" : "horz";
+    char phase[100];
+    double start;
+    int z;
+
+    dw_box_pack_start(window, box, 0, 0, TRUE, TRUE, 0);
+
+    start = bench_now();
+    for(z=0;z<count;z++)
+        dw_box_pack_start(box, items[z], 100, 20, TRUE, FALSE, 0);
+    snprintf(phase, sizeof(phase), "dw_box_pack_start() %s", name);
+    bench_report(phase, count, start);
+
+    start = bench_now();
+    for(z=0;z<count;z++)
+        dw_box_unpack_at_index(box, 0);
+    snprintf(phase, sizeof(phase), "dw_box_unpack_at_index(0) %s", name);
+    bench_report(phase, count, start);
+
+    start = bench_now();
+    for(z=0;z<count;z++)
+        dw_box_pack_end(box, items[z], 100, 20, TRUE, FALSE, 0);
+    snprintf(phase, sizeof(phase), "dw_box_pack_end() %s", name);
+    bench_report(phase, count, start);
+
+    start = bench_now();
+    for(z=0;z<count;z++)
+        dw_box_pack_at_index(box, 0, z, 0, 0, FALSE, FALSE, 1);
+    snprintf(phase, sizeof(phase), "dw_box_pack_at_index() %s", name);
+    bench_report(phase, count, start);
+
+    start = bench_now();
+    for(z=0;z<count;z++)
+        dw_box_unpack(items[z]);
+    snprintf(phase, sizeof(phase), "dw_box_unpack() %s", name);
+    bench_report(phase, count, start);
+
+    dw_window_destroy(window);
+}
+
+#ifdef __HEADLESS__
+/* Measures a single box holding BENCH_WIDE_ITEMS items, the box is
+ * invalidated before each pass so every item is summed again.
+ */
+static void bench_measure(void)
+{
+    HWND box = dw_box_new(DW_HORZ, 0);
+    double start;
+    int z, width, height;
+
+    for(z=0;z<BENCH_WIDE_ITEMS;z++)
+        dw_box_pack_start(box, dw_text_new("Item", 0), 10 + (z % 7), 20, z % 3, z % 2, z % 4);
+
+    start = bench_now();
+    for(z=0;z<BENCH_MEASURES;z++)
+    {
+        dw_window_redraw(box);
+        dw_window_get_preferred_size(box, &width, &height);
+    }
+    bench_report("Wide box measure", BENCH_WIDE_ITEMS * BENCH_MEASURES, start);
+
+    dw_window_destroy(box);
+}
+
+/* Measures BENCH_COLUMNS_LARGE independent columns of rows holding
+ * 50k items in total, after every row has changed, first serially
+ * and then with DW_FEATURE_PARALLEL_LAYOUT set to the given state.
+ */
+static void bench_parallel(int setting)
+{
+    HWND box = dw_box_new(DW_HORZ, 0);
+    HWND rows[BENCH_COLUMNS_LARGE * BENCH_ROWS_LARGE];
+    char phase[100];
+    double start;
+    int z, x, pass, threads, width, height;
+
+    for(z=0;z<BENCH_COLUMNS_LARGE;z++)
+    {
+        HWND column = dw_box_new(DW_VERT, 0);
+
+        dw_box_pack_start(box, column, 0, 0, TRUE, TRUE, 0);
+        for(x=0;x<BENCH_ROWS_LARGE;x++)
+        {
+            HWND row = rows[(z * BENCH_ROWS_LARGE) + x] = dw_box_new(DW_HORZ, 0);
+            int y;
+
+            dw_box_pack_start(column, row, 0, 0, TRUE, FALSE, 0);
+            for(y=0;y<BENCH_ROW_ITEMS;y++)
+                dw_box_pack_start(row, dw_text_new("Item", 0), 10 + (y % 7), 20, y % 3, y % 2, y % 4);
+        }
+    }
+
+    for(pass=0;pass<2;pass++)
+    {
+        dw_feature_set(DW_FEATURE_PARALLEL_LAYOUT, pass ? setting : DW_FEATURE_DISABLED);
+        start = bench_now();
+        for(z=0;z<BENCH_MEASURES;z++)
+        {
+            for(x=0;x<BENCH_COLUMNS_LARGE * BENCH_ROWS_LARGE;x++)
+                dw_window_redraw(rows[x]);
+            dw_window_get_preferred_size(box, &width, &height);
+        }
+        threads = dw_feature_get(DW_FEATURE_PARALLEL_LAYOUT);
+        snprintf(phase, sizeof(phase), "%s measure (%d threads)", pass ? "Parallel" : "Serial", threads > 1 ? threads : 1);
+        bench_report(phase, BENCH_COLUMNS_LARGE * BENCH_ROWS_LARGE * BENCH_ROW_ITEMS * BENCH_MEASURES, start);
+    }
+    dw_feature_set(DW_FEATURE_PARALLEL_LAYOUT, DW_FEATURE_DISABLED);
+    dw_window_destroy(box);
+}
+
+/* Shows a window and lays it out repeatedly, first while resizing it
+ * and then after changing the first item in one of the given boxes
+ * between each layout.
+ */
+static void bench_tree(const char *name, HWND window, HWND *boxes, int count)
+{
+    char phase[100];
+    double start;
+    int z;
+
+    dw_window_set_size(window, 1024, 768);
+    dw_window_show(window);
+    dw_main_sleep(0);
+
+    start = bench_now();
+    for(z=0;z<BENCH_PASSES;z++)
+    {
+        dw_window_set_size(window, 1024 + ((z % 2) * 100), 768 + ((z % 2) * 100));
+        dw_main_sleep(0);
+    }
+    snprintf(phase, sizeof(phase), "%s resize", name);
+    bench_report(phase, BENCH_PASSES, start);
+
+    start = bench_now();
+    for(z=0;z<BENCH_PASSES;z++)
+    {
+        HWND box = boxes[z % count];
+        HWND item = dw_box_unpack_at_index(box, 0);
+
+        dw_box_pack_at_index(box, item, 0, 2 + (z % 2), 2, FALSE, FALSE, 0);
+        dw_main_sleep(0);
+    }
+    snprintf(phase, sizeof(phase), "%s single change", name);
+    bench_report(phase, BENCH_PASSES, start);
+
+    dw_window_destroy(window);
+}
+
+/* A chain of BENCH_DEPTH boxes each nested in the previous one,
+ * alternating between horizontal and vertical.
+ */
+static void bench_deep(void)
+{
+    HWND window = dw_window_new(HWND_DESKTOP, "Deep layout benchmark", DW_FCF_SIZEBORDER);
+    HWND boxes[BENCH_DEPTH], parent = window;
+    int z;
+
+    for(z=0;z<BENCH_DEPTH;z++)
+    {
+        /* Small items so the innermost boxes still have room */
+        boxes[z] = dw_box_new((z % 2) ? DW_VERT : DW_HORZ, 0);
+        dw_box_pack_start(boxes[z], dw_text_new("Item", 0), 2, 2, FALSE, FALSE, 0);
+        dw_box_pack_start(parent, boxes[z], 0, 0, TRUE, TRUE, 0);
+        dw_box_pack_start(boxes[z], dw_text_new("Item", 0), 2, 2, TRUE, TRUE, 0);
+        parent = boxes[z];
+    }
+    bench_tree("Deep tree", window, boxes, BENCH_DEPTH);
+}
+
+/* A single box holding BENCH_WIDE_TREE items */
+static void bench_wide(void)
+{
+    HWND window = dw_window_new(HWND_DESKTOP, "Wide layout benchmark", DW_FCF_SIZEBORDER);
+    HWND box = dw_box_new(DW_HORZ, 0);
+    int z;
+
+    dw_box_pack_start(window, box, 0, 0, TRUE, TRUE, 0);
+    for(z=0;z<BENCH_WIDE_TREE;z++)
+        dw_box_pack_start(box, dw_text_new("Item", 0), 10 + (z % 7), 20, z % 2, FALSE, 0);
+    bench_tree("Wide tree", window, &box, 1);
+}
+
+/* A form of BENCH_ROWS boxes holding BENCH_COLUMNS widgets each,
+ * with groupboxes, nested boxes and a splitbar and notebook below.
+ */
+static void bench_mixed(void)
+{
+    HWND window = dw_window_new(HWND_DESKTOP, "Mixed layout benchmark", DW_FCF_SIZEBORDER);
+    HWND vbox = dw_box_new(DW_VERT, 2), rows[BENCH_ROWS];
+    HWND left = dw_box_new(DW_VERT, 0), right = dw_box_new(DW_VERT, 0);
+    HWND notebook = dw_notebook_new(0, TRUE), page = dw_box_new(DW_VERT, 0);
+    int z, x;
+
+    dw_box_pack_start(window, vbox, 0, 0, TRUE, TRUE, 0);
+    for(z=0;z<BENCH_ROWS;z++)
+    {
+        rows[z] = (z % 10) ? dw_box_new(DW_HORZ, 1) : dw_groupbox_new(DW_HORZ, 1, "Group");
+        dw_box_pack_start(vbox, rows[z], 0, 0, TRUE, FALSE, 0);
+        for(x=0;x<BENCH_COLUMNS;x++)
+        {
+            if(x % 10 == 9)
+            {
+                HWND nested = dw_box_new(DW_VERT, 0);
+
+                dw_box_pack_start(nested, dw_text_new("Item", 0), 20, 10, TRUE, FALSE, 0);
+                dw_box_pack_start(nested, dw_text_new("Item", 0), 20, 10, TRUE, FALSE, 0);
+                dw_box_pack_start(rows[z], nested, 0, 0, TRUE, TRUE, 1);
+            }
+            else
+                dw_box_pack_start(rows[z], dw_text_new("Item", 0), 20, 20, x % 2, FALSE, 1);
+        }
+    }
+    for(z=0;z<BENCH_COLUMNS;z++)
+    {
+        dw_box_pack_start(left, dw_text_new("Item", 0), 20, 20, TRUE, FALSE, 0);
+        dw_box_pack_start(right, dw_text_new("Item", 0), 20, 20, TRUE, FALSE, 0);
+        dw_box_pack_start(page, dw_text_new("Item", 0), 20, 20, TRUE, FALSE, 0);
+    }
+    dw_box_pack_start(vbox, dw_splitbar_new(DW_HORZ, left, right, 0), 0, 200, TRUE, FALSE, 0);
+    dw_notebook_pack(notebook, dw_notebook_page_new(notebook, 0, TRUE), page);
+    dw_box_pack_start(vbox, notebook, 0, 200, TRUE, FALSE, 0);
+    bench_tree("Mixed tree", window, rows, BENCH_ROWS);
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+    int count = argc > 1 ? atoi(argv[1]) : BENCH_ITEMS;
+#ifdef __HEADLESS__
+    /* Threads for the parallel measure, one per processor by default */
+    int threads = argc > 2 ? atoi(argv[2]) : DW_FEATURE_ENABLED;
+#endif
+    HWND *items;
+    int z;
+
+    if(count < 1)
+        count = BENCH_ITEMS;
+
+    if(dw_init(TRUE, argc, argv) != DW_ERROR_NONE)
+    {
+        fprintf(stderr, "Unable to initialize Dynamic Windows\n");
+        return 1;
+    }
+
+    if(!(items = malloc(sizeof(HWND) * count)))
+        return 1;
+
+    /* Create the widgets up front so only the packing is timed */
+    for(z=0;z<count;z++)
+        items[z] = dw_text_new("Item", 0);
+
+    bench_pack(items, count, DW_VERT);
+    bench_pack(items, count, DW_HORZ);
+
+    for(z=0;z<count;z++)
+        dw_window_destroy(items[z]);
+    free(items);
+
+#ifdef __HEADLESS__
+    bench_measure();
+    bench_parallel(threads);
+    bench_deep();
+    bench_wide();
+    bench_mixed();
+#endif
+    dw_shutdown();
+    return 0;
+}
@@ -0,0 +1,8495 @@
+/*
+ * Dynamic Windows:
+ *          A GTK like GUI implementation, headless in-memory version.
+ *
+ * (C) 2011-2023 Brian Smith <brian@dbsoft.org>
+ * (C) 2011-2022 Mark Hessling <mark@rexx.org>
+ *
+ * Compile with $CC -I. -D__TEMPLATE__ -D__HEADLESS__ headless/dw.c
+ *
+ * Derived from the template, this backend needs no display.
+ * Widgets are plain structures, listboxes, containers and trees
+ * keep their contents in memory, pixmaps are raw ARGB buffers
+ * and the message loop runs on a virtual clock so timers and
+ * queued events are delivered in a deterministic order.
+ * Intended for benchmarking and automated testing.
+ */
+
+#include "dw.h"
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <wchar.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/utsname.h>
+
+/* Widget types, every HWND in this backend points to a DWWidget */
+#define _DW_WIDGET_WINDOW       1
+#define _DW_WIDGET_BOX          2
+#define _DW_WIDGET_GROUPBOX     3
+#define _DW_WIDGET_SCROLLBOX    4
+#define _DW_WIDGET_BUTTON       5
+#define _DW_WIDGET_ENTRYFIELD   6
+#define _DW_WIDGET_SPINBUTTON   7
+#define _DW_WIDGET_RADIOBUTTON  8
+#define _DW_WIDGET_CHECKBOX     9
+#define _DW_WIDGET_SLIDER       10
+#define _DW_WIDGET_SCROLLBAR    11
+#define _DW_WIDGET_PERCENT      12
+#define _DW_WIDGET_LISTBOX      13
+#define _DW_WIDGET_COMBOBOX     14
+#define _DW_WIDGET_MLE          15
+#define _DW_WIDGET_TEXT         16
+#define _DW_WIDGET_RENDER       17
+#define _DW_WIDGET_BITMAP       18
+#define _DW_WIDGET_TREE         19
+#define _DW_WIDGET_CONTAINER    20
+#define _DW_WIDGET_SPLITBAR     21
+#define _DW_WIDGET_NOTEBOOK     22
+#define _DW_WIDGET_CALENDAR     23
+#define _DW_WIDGET_MENU         24
+#define _DW_WIDGET_MENUITEM     25
+#define _DW_WIDGET_MDI          26
+
+/* Flags kept in Box itemflags */
+#define _DW_ITEM_BOX            1
+#define _DW_ITEM_HEXPAND        (1 << 1)
+#define _DW_ITEM_VEXPAND        (1 << 2)
+
+/* Fake screen and widget metrics */
+#define _DW_SCREEN_WIDTH        1920
+#define _DW_SCREEN_HEIGHT       1080
+#define _DW_NOTEBOOK_TAB_HEIGHT 24
+#define _DW_DEFAULT_FONT        "10.Sans"
+
+typedef struct _dwsignalhandler
+{
+    struct _dwsignalhandler *next;
+    char *signame;
+    void *func, *discfunc, *data;
+} DWSignalHandler;
+
+typedef struct _dwwidget
+{
+    int type;
+    unsigned long id;
+    struct _dwwidget *parent;
+    /* Title, label, entry or MLE contents */
+    char *text, *font, *tooltip;
+    int x, y, width, height;
+    int visible, enabled, dirty;
+    /* Nested layout freezes on top-level windows */
+    int freeze;
+    unsigned long style, fore, back;
+    UserData *root;
+    DWSignalHandler *handlers;
+    /* Layout box for windows, boxes, groupboxes and scrollboxes */
+    Box *box;
+    /* Storage for ranged and toggle widgets */
+    long value, lower, upper, range;
+    float percent;
+    HICN icon;
+    /* Splitbar panes */
+    struct _dwwidget *topleft, *bottomright;
+    /* Backing store for render and bitmap widgets */
+    HPIXMAP pixmap;
+    /* Type specific in-memory model and its current position */
+    void *model, *current;
+    /* Menu items */
+    struct _dwwidget *next, *children;
+} DWWidget;
+
+/* Listbox and combobox contents */
+typedef struct _dwlistmodel
+{
+    char **items;
+    char *selected;
+    int count, alloc;
+    /* Virtual lists have no items, the text comes from the application */
+    char *(*textfunc)(HWND, int, void *);
+    void *data;
+} DWListModel;
+
+/* One container cell, strings are copies owned by the row */
+typedef union _dwcell
+{
+    char *string;
+    HICN icon;
+    ULONG ulong;
+    CDATE date;
+    CTIME time;
+} DWCell;
+
+typedef struct _dwcontrow
+{
+    char *title;
+    HICN icon;
+    void *data;
+    DWCell *cells;
+    int selected, hidden;
+} DWContRow;
+
+/* Trigram index entry, kept sorted by trigram then row */
+typedef struct _dwtrigram
+{
+    unsigned int trigram;
+    int row;
+} DWTrigram;
+
+/* Filter state of a container, the folded text of each row and the
+ * trigram index are reused until the rows change.
+ */
+typedef struct _dwcontfilter
+{
+    int column, dirty, count, ntrigrams;
+    unsigned long flags;
+    char *text;
+    char **rows;
+    DWTrigram *trigrams;
+} DWContFilter;
+
+typedef struct _dwcontainer
+{
+    int columns, filesystem;
+    unsigned long *flags;
+    char **titles;
+    int *widths;
+    char *fstitle;
+    DWContRow *rows;
+    int count, alloc, cursor, query, sortable;
+    unsigned long oddcolor, evencolor;
+    DWContFilter filter;
+} DWContainer;
+
+/* Handle returned from dw_container_alloc() */
+typedef struct _dwcontalloc
+{
+    DWWidget *widget;
+    int start;
+} DWContAlloc;
+
+typedef struct _dwtreeitem
+{
+    struct _dwtreeitem *parent, *child, *lastchild, *prev, *next;
+    char *title;
+    HICN icon;
+    void *data;
+    int expanded, lazy;
+} DWTreeItem;
+
+typedef struct _dwnotebookpage
+{
+    struct _dwnotebookpage *next;
+    unsigned long id;
+    char *text, *status;
+    DWWidget *page;
+} DWNotebookPage;
+
+/* Work queued for the message loop */
+typedef struct _dwqueuedcall
+{
+    struct _dwqueuedcall *next;
+    DWWidget *widget;
+    void (*func)(DWWidget *, void *);
+    void *data;
+} DWQueuedCall;
+
+typedef struct _dwtimer
+{
+    struct _dwtimer *next;
+    HTIMER id;
+    int interval;
+    unsigned long long due;
+    void *func, *data;
+} DWTimer;
+
+typedef struct _dwevent
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t event;
+    int posted;
+} DWEvent;
+
+typedef struct _dwshm
+{
+    int fd;
+    long size;
+    pid_t sid;
+    char *path;
+} DWShm;
+
+typedef struct _dwprint
+{
+    char *jobname;
+    unsigned int pages;
+    int (*drawfunc)(HPRINT, HPIXMAP, int, void *);
+    void *drawdata;
+    int cancel;
+} DWPrint;
+
+/* The queue, timers, clipboard and thread IDs are protected by _dw_mutex */
+static pthread_mutex_t _dw_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _dw_cond = PTHREAD_COND_INITIALIZER;
+static DWQueuedCall *_dw_queue = NULL, *_dw_queue_tail = NULL;
+static DWTimer *_dw_timers = NULL;
+static HTIMER _dw_timer_id = 0;
+/* Virtual time in milliseconds, only advanced by the message loop */
+static unsigned long long _dw_clock = 0;
+static int _dw_quit = FALSE;
+static pthread_key_t _dw_tid_key;
+static DWTID _dw_tid_next = 1, _dw_main_tid = 0;
+static char *_dw_clipboard = NULL;
+static char *_dw_default_font = NULL;
+static unsigned long _dw_fg_color = DW_CLR_BLACK, _dw_bg_color = DW_CLR_DEFAULT;
+static long _dw_pointer_x = 0, _dw_pointer_y = 0;
+static unsigned long _dw_menu_id = 30000;
+static char _dw_app_id[257] = {0};
+static char _dw_exec_dir[MAX_PATH+1] = {0};
+
+/* Same palette the GTK backends use for the 16 basic colors */
+static unsigned int _dw_colors[] =
+{
+    0xFF000000, 0xFFBB0000, 0xFF00BB00, 0xFFAAAA00,
+    0xFF0000CC, 0xFFBB00BB, 0xFF00BBBB, 0xFFBBBBBB,
+    0xFF777777, 0xFFFF0000, 0xFF00FF00, 0xFFEEEE00,
+    0xFF0000FF, 0xFFFF00FF, 0xFF00EEEE, 0xFFFFFFFF
+};
+
+/* Translate a DW color value to 32bit ARGB */
+static unsigned int _dw_argb(unsigned long value, unsigned int def)
+{
+    if(value & DW_RGB_COLOR)
+        return 0xFF000000 | (DW_RED_VALUE(value) << 16) | (DW_GREEN_VALUE(value) << 8) | DW_BLUE_VALUE(value);
+    if(value < 16)
+        return _dw_colors[value];
+    return def;
+}
+
+/* Implement these to get and set the Box* pointer on the widget handle */
+void *_dw_window_pointer_get(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    return widget ? widget->box : NULL;
+}
+
+void _dw_window_pointer_set(HWND handle, Box *box)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget)
+        widget->box = box;
+}
+
+/* Allocate a widget with the common fields filled in */
+static DWWidget *_dw_widget_new(int type, const char *text, unsigned long id)
+{
+    DWWidget *widget = calloc(1, sizeof(DWWidget));
+
+    if(widget)
+    {
+        widget->type = type;
+        widget->id = id;
+        widget->text = strdup(text ? text : "");
+        widget->visible = widget->enabled = TRUE;
+        widget->fore = widget->back = DW_CLR_DEFAULT;
+    }
+    return widget;
+}
+
+/* Allocate a widget that holds a layout box */
+static DWWidget *_dw_box_widget_new(int widgettype, int type, int pad, const char *title)
+{
+    DWWidget *widget = _dw_widget_new(widgettype, title, 0);
+
+    if(widget && !(widget->box = calloc(1, sizeof(Box))))
+    {
+        free(widget->text);
+        free(widget);
+        return NULL;
+    }
+    if(widget)
+    {
+        widget->box->type = type;
+        widget->box->pad = pad;
+    }
+    return widget;
+}
+
+/* Returns the thread's DW ID, assigning one if it has none yet */
+static DWTID _dw_tid(void)
+{
+    DWTID tid = (DWTID)(long)pthread_getspecific(_dw_tid_key);
+
+    if(!tid)
+    {
+        pthread_mutex_lock(&_dw_mutex);
+        tid = _dw_tid_next++;
+        pthread_mutex_unlock(&_dw_mutex);
+        pthread_setspecific(_dw_tid_key, (void *)(long)tid);
+    }
+    return tid;
+}
+
+/* Queue a call to be run from the message loop */
+static void _dw_queue_call(DWWidget *widget, void (*func)(DWWidget *, void *), void *data)
+{
+    DWQueuedCall *call = calloc(1, sizeof(DWQueuedCall));
+
+    if(call)
+    {
+        call->widget = widget;
+        call->func = func;
+        call->data = data;
+        pthread_mutex_lock(&_dw_mutex);
+        if(_dw_queue_tail)
+            _dw_queue_tail->next = call;
+        else
+            _dw_queue = call;
+        _dw_queue_tail = call;
+        pthread_cond_broadcast(&_dw_cond);
+        pthread_mutex_unlock(&_dw_mutex);
+    }
+}
+
+/* Drop any queued calls for a widget that is being destroyed */
+static void _dw_queue_purge(DWWidget *widget)
+{
+    DWQueuedCall *call, *prev = NULL, *next;
+
+    pthread_mutex_lock(&_dw_mutex);
+    for(call = _dw_queue; call; call = next)
+    {
+        next = call->next;
+        if(call->widget == widget)
+        {
+            if(prev)
+                prev->next = next;
+            else
+                _dw_queue = next;
+            if(_dw_queue_tail == call)
+                _dw_queue_tail = prev;
+            free(call);
+        }
+        else
+            prev = call;
+    }
+    pthread_mutex_unlock(&_dw_mutex);
+}
+
+/* Returns the next handler for signame after the handler passed in */
+static DWSignalHandler *_dw_signal_next(DWWidget *widget, DWSignalHandler *handler, const char *signame)
+{
+    handler = handler ? handler->next : (widget ? widget->handlers : NULL);
+
+    while(handler && strcmp(handler->signame, signame))
+        handler = handler->next;
+    return handler;
+}
+
+/* Signal emitters, the return value of the last handler is returned */
+static int _dw_emit(DWWidget *widget, const char *signame)
+{
+    DWSignalHandler *handler = NULL;
+    int retval = FALSE;
+
+    while((handler = _dw_signal_next(widget, handler, signame)))
+    {
+        int (*sigfunc)(HWND, void *) = handler->func;
+
+        retval = sigfunc((HWND)widget, handler->data);
+    }
+    return retval;
+}
+
+static int _dw_emit_int(DWWidget *widget, const char *signame, int value)
+{
+    DWSignalHandler *handler = NULL;
+    int retval = FALSE;
+
+    while((handler = _dw_signal_next(widget, handler, signame)))
+    {
+        int (*sigfunc)(HWND, int, void *) = handler->func;
+
+        retval = sigfunc((HWND)widget, value, handler->data);
+    }
+    return retval;
+}
+
+static int _dw_emit_configure(DWWidget *widget, int width, int height)
+{
+    DWSignalHandler *handler = NULL;
+    int retval = FALSE;
+
+    while((handler = _dw_signal_next(widget, handler, DW_SIGNAL_CONFIGURE)))
+    {
+        int (*sigfunc)(HWND, int, int, void *) = handler->func;
+
+        retval = sigfunc((HWND)widget, width, height, handler->data);
+    }
+    return retval;
+}
+
+static int _dw_emit_expose(DWWidget *widget, DWExpose *exp)
+{
+    DWSignalHandler *handler = NULL;
+    int retval = FALSE;
+
+    while((handler = _dw_signal_next(widget, handler, DW_SIGNAL_EXPOSE)))
+    {
+        int (*sigfunc)(HWND, DWExpose *, void *) = handler->func;
+
+        retval = sigfunc((HWND)widget, exp, handler->data);
+    }
+    return retval;
+}
+
+static int _dw_emit_tree_select(DWWidget *widget, DWTreeItem *item)
+{
+    DWSignalHandler *handler = NULL;
+    int retval = FALSE;
+
+    while((handler = _dw_signal_next(widget, handler, DW_SIGNAL_ITEM_SELECT)))
+    {
+        int (*sigfunc)(HWND, HTREEITEM, char *, void *, void *) = handler->func;
+
+        retval = sigfunc((HWND)widget, (HTREEITEM)item, item->title, handler->data, item->data);
+    }
+    return retval;
+}
+
+static int _dw_emit_tree_expand(DWWidget *widget, DWTreeItem *item)
+{
+    DWSignalHandler *handler = NULL;
+    int retval = FALSE;
+
+    while((handler = _dw_signal_next(widget, handler, DW_SIGNAL_TREE_EXPAND)))
+    {
+        int (*sigfunc)(HWND, HTREEITEM, void *) = handler->func;
+
+        retval = sigfunc((HWND)widget, (HTREEITEM)item, handler->data);
+    }
+    return retval;
+}
+
+static int _dw_emit_container_select(DWWidget *widget, DWContRow *row)
+{
+    DWSignalHandler *handler = NULL;
+    int retval = FALSE;
+
+    while((handler = _dw_signal_next(widget, handler, DW_SIGNAL_ITEM_SELECT)))
+    {
+        int (*sigfunc)(HWND, HTREEITEM, char *, void *, void *) = handler->func;
+
+        retval = sigfunc((HWND)widget, NULL, row->title, handler->data, row->data);
+    }
+    return retval;
+}
+
+/* Font metrics, each character occupies a fixed cell based
+ * on the point size at the start of the font name.
+ */
+static int _dw_font_size(const char *fontname)
+{
+    int size = fontname ? atoi(fontname) : 0;
+
+    if(size < 1)
+        size = _dw_default_font ? atoi(_dw_default_font) : 0;
+    return size > 0 ? size : 10;
+}
+
+static void _dw_text_size(const char *fontname, const char *text, int *width, int *height)
+{
+    int size = _dw_font_size(fontname), chars = 0;
+
+    /* Count UTF-8 code points rather than bytes */
+    while(text && *text)
+    {
+        if((*text & 0xC0) != 0x80)
+            chars++;
+        text++;
+    }
+    if(width)
+        *width = chars * ((size * 3 + 4) / 5);
+    if(height)
+        *height = (size * 3 + 1) / 2;
+}
+
+static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int pass);
+
+/* Returns the preferred size of a widget, these are fixed
+ * approximations so layouts are the same on every machine.
+ */
+static void _dw_widget_preferred_size(DWWidget *widget, int *width, int *height)
+{
+    int thiswidth = 0, thisheight = 0;
+
+    _dw_text_size(widget->font, widget->text, &thiswidth, &thisheight);
+
+    switch(widget->type)
+    {
+        case _DW_WIDGET_BOX:
+        case _DW_WIDGET_GROUPBOX:
+        case _DW_WIDGET_WINDOW:
+        case _DW_WIDGET_MDI:
+            if(widget->box)
+            {
+                int depth = 0;
+
+                /* The first pass of the layout computes the minimum size */
+                _dw_resize_box(widget->box, &depth, 0, 0, 1);
+                thiswidth = widget->box->minwidth;
+                thisheight = widget->box->minheight;
+            }
+            break;
+        case _DW_WIDGET_BUTTON:
+            thiswidth += 16;
+            thisheight += 8;
+            break;
+        case _DW_WIDGET_CHECKBOX:
+        case _DW_WIDGET_RADIOBUTTON:
+            thiswidth += 24;
+            thisheight += 4;
+            break;
+        case _DW_WIDGET_ENTRYFIELD:
+        case _DW_WIDGET_COMBOBOX:
+            thiswidth = 150;
+            thisheight += 8;
+            break;
+        case _DW_WIDGET_SPINBUTTON:
+            thiswidth = 100;
+            thisheight += 8;
+            break;
+        case _DW_WIDGET_SLIDER:
+        case _DW_WIDGET_SCROLLBAR:
+        case _DW_WIDGET_PERCENT:
+            thiswidth = widget->style ? 20 : 100;
+            thisheight = widget->style ? 100 : 20;
+            break;
+        case _DW_WIDGET_BITMAP:
+            thiswidth = widget->pixmap ? (int)widget->pixmap->width : 0;
+            thisheight = widget->pixmap ? (int)widget->pixmap->height : 0;
+            break;
+        case _DW_WIDGET_CALENDAR:
+            thiswidth = 200;
+            thisheight = 180;
+            break;
+        case _DW_WIDGET_TEXT:
+            break;
+        default:
+            thiswidth = thisheight = 150;
+            break;
+    }
+    if(width)
+        *width = thiswidth;
+    if(height)
+        *height = thisheight;
+}
+
+/* Resizes the backing store of a render widget, preserving the contents */
+static void _dw_render_resize(DWWidget *widget, int width, int height)
+{
+    HPIXMAP old = widget->pixmap;
+
+    if(old && (int)old->width == width && (int)old->height == height)
+        return;
+
+    widget->pixmap = dw_pixmap_new((HWND)widget, width, height, 32);
+    if(old)
+    {
+        if(widget->pixmap)
+            dw_pixmap_bitblt(DW_NOHWND, widget->pixmap, 0, 0, (int)old->width, (int)old->height, DW_NOHWND, old, 0, 0);
+        dw_pixmap_destroy(old);
+    }
+}
+
+/* Queued from the layout and dw_render_redraw() */
+static void _dw_render_configure(DWWidget *widget, void *data)
+{
+    _dw_emit_configure(widget, widget->width, widget->height);
+}
+
+static void _dw_render_expose(DWWidget *widget, void *data)
+{
+    DWExpose exp = { 0, 0, widget->width, widget->height };
+
+    widget->dirty = FALSE;
+    _dw_emit_expose(widget, &exp);
+}
+
+void _dw_do_resize(Box *thisbox, int x, int y);
+
+/* Set the position and size of a widget during layout */
+static void _dw_widget_place(DWWidget *widget, int x, int y, int width, int height)
+{
+    int resized = (widget->width != width || widget->height != height);
+
+    widget->x = x;
+    widget->y = y;
+    widget->width = width;
+    widget->height = height;
+
+    if(resized && widget->type == _DW_WIDGET_RENDER)
+    {
+        _dw_render_resize(widget, width, height);
+        _dw_queue_call(widget, _dw_render_configure, NULL);
+        if(!widget->dirty)
+        {
+            widget->dirty = TRUE;
+            _dw_queue_call(widget, _dw_render_expose, NULL);
+        }
+    }
+
+    /* Controls with sub-layouts place their contents */
+    switch(widget->type)
+    {
+        case _DW_WIDGET_BOX:
+        case _DW_WIDGET_GROUPBOX:
+            /* Only boxes which changed or were resized need placing */
+            if(!(widget->box->layout & _DW_LAYOUT_PLACED) ||
+               widget->box->placedwidth != width || widget->box->placedheight != height)
+                _dw_do_resize(widget->box, width, height);
+            break;
+        case _DW_WIDGET_SCROLLBOX:
+        {
+            int depth = 0;
+
+            /* The contents are never smaller than their minimum size */
+            _dw_resize_box(widget->box, &depth, 0, 0, 1);
+            widget->box->width = widget->box->minwidth > width ? widget->box->minwidth : width;
+            widget->box->height = widget->box->minheight > height ? widget->box->minheight : height;
+            _dw_do_resize(widget->box, widget->box->width, widget->box->height);
+            break;
+        }
+        case _DW_WIDGET_SPLITBAR:
+        {
+            int size = widget->style == DW_HORZ ? width : height;
+            int first = (int)((size - _DW_SPLITBAR_WIDTH) * widget->percent / 100.0);
+            int second = size - _DW_SPLITBAR_WIDTH - first;
+
+            if(widget->style == DW_HORZ)
+            {
+                if(widget->topleft)
+                    _dw_widget_place(widget->topleft, 0, 0, first, height);
+                if(widget->bottomright)
+                    _dw_widget_place(widget->bottomright, first + _DW_SPLITBAR_WIDTH, 0, second, height);
+            }
+            else
+            {
+                if(widget->topleft)
+                    _dw_widget_place(widget->topleft, 0, 0, width, first);
+                if(widget->bottomright)
+                    _dw_widget_place(widget->bottomright, 0, first + _DW_SPLITBAR_WIDTH, width, second);
+            }
+            break;
+        }
+        case _DW_WIDGET_NOTEBOOK:
+        {
+            DWNotebookPage *page;
+
+            /* Pages share the area below the tabs */
+            for(page = (DWNotebookPage *)widget->model;page;page = page->next)
+            {
+                if(page->page)
+                    _dw_widget_place(page->page, 0, _DW_NOTEBOOK_TAB_HEIGHT, width, height - _DW_NOTEBOOK_TAB_HEIGHT);
+            }
+            break;
+        }
+    }
+}
+
+/* Returns the top-level window containing a widget */
+static DWWidget *_dw_toplevel(DWWidget *widget)
+{
+    while(widget && widget->parent)
+        widget = widget->parent;
+    return widget;
+}
+
+/* Queued relayout of a top-level window, frozen windows
+ * stay dirty and are queued again when thawed.
+ */
+static void _dw_window_layout(DWWidget *window, void *data)
+{
+    if(window->freeze)
+        return;
+    window->dirty = FALSE;
+    if(window->box && window->visible)
+        _dw_do_resize(window->box, window->width, window->height);
+}
+
+/* Called when the contents of a box change, the top-level
+ * window will be laid out again from the message loop.
+ * Any number of changes before then result in one layout.
+ */
+static void _dw_layout_queue(DWWidget *widget)
+{
+    DWWidget *window = _dw_toplevel(widget);
+
+    if(window && window->type == _DW_WIDGET_WINDOW && window->visible && !window->dirty)
+    {
+        window->dirty = TRUE;
+        if(!window->freeze)
+            _dw_queue_call(window, _dw_window_layout, NULL);
+    }
+}
+
+/* Insert a timer in due order, timers due at the same
+ * time fire in the order they were scheduled.
+ */
+static void _dw_timer_insert(DWTimer *timer)
+{
+    DWTimer **prev = &_dw_timers;
+
+    while(*prev && (*prev)->due <= timer->due)
+        prev = &(*prev)->next;
+    timer->next = *prev;
+    *prev = timer;
+}
+
+/* The timer whose handler is currently running */
+static HTIMER _dw_timer_running = 0;
+static int _dw_timer_cancelled = FALSE;
+
+/* Runs one queued call or one due timer,
+ * returns FALSE if there was nothing to do.
+ */
+static int _dw_main_iteration(void)
+{
+    DWQueuedCall *call;
+    DWTimer *timer;
+
+    pthread_mutex_lock(&_dw_mutex);
+    if((call = _dw_queue))
+    {
+        if(!(_dw_queue = call->next))
+            _dw_queue_tail = NULL;
+        pthread_mutex_unlock(&_dw_mutex);
+        call->func(call->widget, call->data);
+        free(call);
+        return TRUE;
+    }
+    if((timer = _dw_timers) && timer->due <= _dw_clock)
+    {
+        int (*sigfunc)(void *) = timer->func;
+        int again;
+
+        /* Take it off the list while the handler runs */
+        _dw_timers = timer->next;
+        _dw_timer_running = timer->id;
+        _dw_timer_cancelled = FALSE;
+        pthread_mutex_unlock(&_dw_mutex);
+
+        again = sigfunc(timer->data);
+
+        pthread_mutex_lock(&_dw_mutex);
+        if(again && !_dw_timer_cancelled)
+        {
+            timer->due += timer->interval > 0 ? timer->interval : 1;
+            _dw_timer_insert(timer);
+        }
+        else
+            free(timer);
+        _dw_timer_running = 0;
+        pthread_mutex_unlock(&_dw_mutex);
+        return TRUE;
+    }
+    pthread_mutex_unlock(&_dw_mutex);
+    return FALSE;
+}
+
+/* Clear the cached layout of a widget's box and every box above
+ * it, so the next layout pass measures and places them again.
+ */
+static void _dw_box_invalidate(DWWidget *widget)
+{
+    for(;widget;widget = widget->parent)
+    {
+        if(widget->box)
+            widget->box->layout = 0;
+    }
+}
+
+/* Add the items packed into or removed from a box to the item
+ * totals of the box and the boxes it is measured as part of.
+ */
+static void _dw_box_total(DWWidget *widget, int delta)
+{
+    for(;widget && widget->box;widget = widget->parent)
+    {
+        widget->box->itemtotal += delta;
+        if(widget->type != _DW_WIDGET_BOX && widget->type != _DW_WIDGET_GROUPBOX)
+            break;
+    }
+}
+
+/* Make room for an item at index in the box's item array,
+ * doubling the allocation when it is full so packing many
+ * items does not reallocate and copy on every call.
+ * Returns the item array or NULL on allocation failure.
+ */
+static Item *_dw_box_item_insert(Box *thisbox, int index)
+{
+    int move = thisbox->count - index;
+
+    if(thisbox->count >= thisbox->alloc)
+    {
+        int alloc = thisbox->alloc ? thisbox->alloc * 2 : 4;
+        Item *items;
+        int *itemwidth, *itemheight, *itempad;
+        unsigned char *itemflags;
+
+        if(!(items = realloc(thisbox->items, sizeof(Item) * alloc)))
+            return NULL;
+        thisbox->items = items;
+        if(!(itemwidth = realloc(thisbox->itemwidth, sizeof(int) * alloc)))
+            return NULL;
+        thisbox->itemwidth = itemwidth;
+        if(!(itemheight = realloc(thisbox->itemheight, sizeof(int) * alloc)))
+            return NULL;
+        thisbox->itemheight = itemheight;
+        if(!(itempad = realloc(thisbox->itempad, sizeof(int) * alloc)))
+            return NULL;
+        thisbox->itempad = itempad;
+        if(!(itemflags = realloc(thisbox->itemflags, alloc)))
+            return NULL;
+        thisbox->itemflags = itemflags;
+        thisbox->alloc = alloc;
+    }
+    memmove(&thisbox->items[index+1], &thisbox->items[index], sizeof(Item) * move);
+    memmove(&thisbox->itemwidth[index+1], &thisbox->itemwidth[index], sizeof(int) * move);
+    memmove(&thisbox->itemheight[index+1], &thisbox->itemheight[index], sizeof(int) * move);
+    memmove(&thisbox->itempad[index+1], &thisbox->itempad[index], sizeof(int) * move);
+    memmove(&thisbox->itemflags[index+1], &thisbox->itemflags[index], move);
+    memset(&thisbox->items[index], 0, sizeof(Item));
+    return thisbox->items;
+}
+
+/* Copy an item's sizes into the box's size arrays */
+static void _dw_box_item_sizes(Box *thisbox, int index)
+{
+    Item *item = &thisbox->items[index];
+
+    thisbox->itemwidth[index] = item->width;
+    thisbox->itemheight[index] = item->height;
+    thisbox->itempad[index] = item->pad;
+    thisbox->itemflags[index] = (item->type == _DW_TYPE_BOX ? _DW_ITEM_BOX : 0) |
+                                (item->hsize == _DW_SIZE_EXPAND ? _DW_ITEM_HEXPAND : 0) |
+                                (item->vsize == _DW_SIZE_EXPAND ? _DW_ITEM_VEXPAND : 0);
+}
+
+/* Remove an item from a box, returns the removed handle.
+ * The item array is kept for reuse until the box is freed.
+ */
+static HWND _dw_box_remove(DWWidget *parent, int index)
+{
+    Box *thisbox = parent->box;
+    DWWidget *child;
+    int move;
+
+    if(!thisbox || index < 0 || index >= thisbox->count)
+        return 0;
+
+    child = (DWWidget *)thisbox->items[index].hwnd;
+    _dw_box_total(parent, -(1 + ((thisbox->itemflags[index] & _DW_ITEM_BOX) && child->box ? child->box->itemtotal : 0)));
+    thisbox->count--;
+    move = thisbox->count - index;
+    memmove(&thisbox->items[index], &thisbox->items[index+1], sizeof(Item) * move);
+    memmove(&thisbox->itemwidth[index], &thisbox->itemwidth[index+1], sizeof(int) * move);
+    memmove(&thisbox->itemheight[index], &thisbox->itemheight[index+1], sizeof(int) * move);
+    memmove(&thisbox->itempad[index], &thisbox->itempad[index+1], sizeof(int) * move);
+    memmove(&thisbox->itemflags[index], &thisbox->itemflags[index+1], move);
+    if(child)
+        child->parent = NULL;
+    _dw_box_invalidate(parent);
+    _dw_layout_queue(parent);
+    return (HWND)child;
+}
+
+/* Returns the list model of a listbox or combobox */
+static DWListModel *_dw_list_model(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && (widget->type == _DW_WIDGET_LISTBOX || widget->type == _DW_WIDGET_COMBOBOX))
+        return (DWListModel *)widget->model;
+    return NULL;
+}
+
+/* Make room for more entries, doubling so appends stay cheap */
+static int _dw_list_grow(DWListModel *list, int extra)
+{
+    if(list->textfunc)
+        return FALSE;
+    if(list->count + extra > list->alloc)
+    {
+        int alloc = list->alloc ? list->alloc : 16;
+        char **items, *selected;
+
+        while(alloc < list->count + extra)
+            alloc *= 2;
+        if(!(items = realloc(list->items, sizeof(char *) * alloc)))
+            return FALSE;
+        list->items = items;
+        if(!(selected = realloc(list->selected, alloc)))
+            return FALSE;
+        list->selected = selected;
+        list->alloc = alloc;
+    }
+    return TRUE;
+}
+
+static void _dw_list_insert(DWListModel *list, const char *text, int pos)
+{
+    if(!_dw_list_grow(list, 1))
+        return;
+    if(pos < 0 || pos > list->count)
+        pos = list->count;
+    memmove(&list->items[pos+1], &list->items[pos], sizeof(char *) * (list->count - pos));
+    memmove(&list->selected[pos+1], &list->selected[pos], list->count - pos);
+    list->items[pos] = strdup(text ? text : "");
+    list->selected[pos] = FALSE;
+    list->count++;
+}
+
+/* Returns the text of an entry, virtual lists ask the application */
+static const char *_dw_list_text(HWND handle, DWListModel *list, int index)
+{
+    if(list->textfunc)
+    {
+        const char *text = list->textfunc(handle, index, list->data);
+
+        return text ? text : "";
+    }
+    return list->items[index];
+}
+
+static DWWidget *_dw_mle(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    return (widget && widget->type == _DW_WIDGET_MLE) ? widget : NULL;
+}
+
+static DWWidget *_dw_tree(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    return (widget && widget->type == _DW_WIDGET_TREE) ? widget : NULL;
+}
+
+/* Unlink a tree item and free it along with its children */
+static void _dw_tree_item_free(DWTreeItem *item)
+{
+    while(item->child)
+        _dw_tree_item_free(item->child);
+
+    if(item->prev)
+        item->prev->next = item->next;
+    else if(item->parent)
+        item->parent->child = item->next;
+    if(item->next)
+        item->next->prev = item->prev;
+    else if(item->parent)
+        item->parent->lastchild = item->prev;
+    free(item->title);
+    free(item);
+}
+
+static DWWidget *_dw_container(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    return (widget && widget->type == _DW_WIDGET_CONTAINER) ? widget : NULL;
+}
+
+/* Returns a copy of the text to compare, only ASCII letters are folded */
+static char *_dw_filter_fold(const char *text, unsigned long flags)
+{
+    char *fold = strdup(text ? text : ""), *p;
+
+    if(fold && !(flags & DW_FILTER_CASESENSITIVE))
+    {
+        for(p=fold;*p;p++)
+        {
+            if(*p >= 'A' && *p <= 'Z')
+                *p += 'a' - 'A';
+        }
+    }
+    return fold;
+}
+
+/* Applies an active filter to a single added or changed row,
+ * the index is left dirty and rebuilt by the next filter change.
+ */
+static void _dw_container_filter_row(DWContainer *cont, int row)
+{
+    DWContFilter *filter = &cont->filter;
+    DWContRow *thisrow = &cont->rows[row];
+    char *fold;
+
+    if(!filter->text)
+        return;
+    fold = _dw_filter_fold(thisrow->cells ? thisrow->cells[filter->column].string : NULL, filter->flags);
+    thisrow->hidden = !fold || !strstr(fold, filter->text);
+    if(thisrow->hidden)
+        thisrow->selected = FALSE;
+    free(fold);
+}
+
+/* Store a cell, data points to a value of the column's type */
+static void _dw_container_set_cell(DWWidget *widget, int column, int row, void *data)
+{
+    DWContainer *cont = widget ? (DWContainer *)widget->model : NULL;
+    unsigned long flags;
+    DWCell *cell;
+
+    if(!cont || column < 0 || column >= cont->columns || row < 0 || row >= cont->count || !cont->rows[row].cells)
+        return;
+
+    flags = cont->flags[column];
+    cell = &cont->rows[row].cells[column];
+    cont->filter.dirty = TRUE;
+    if(flags & (DW_CFA_STRING | DW_CFA_STRINGANDICON))
+    {
+        free(cell->string);
+        cell->string = (data && *((char **)data)) ? strdup(*((char **)data)) : NULL;
+    }
+    else if(flags & DW_CFA_BITMAPORICON)
+        cell->icon = data ? *((HICN *)data) : 0;
+    else if(flags & DW_CFA_ULONG)
+        cell->ulong = data ? *((ULONG *)data) : 0;
+    else if(flags & DW_CFA_DATE)
+    {
+        if(data)
+            cell->date = *((CDATE *)data);
+    }
+    else if(flags & DW_CFA_TIME)
+    {
+        if(data)
+            cell->time = *((CTIME *)data);
+    }
+    if(column == cont->filter.column)
+        _dw_container_filter_row(cont, row);
+}
+
+/* The filename goes in the first column, the icon with the row */
+static void _dw_container_set_file(DWContRow *row, const char *filename, HICN icon)
+{
+    if(row->cells)
+    {
+        free(row->cells[0].string);
+        row->cells[0].string = filename ? strdup(filename) : NULL;
+    }
+    row->icon = icon;
+}
+
+/* Returns the text of a cell, buf is used for the numeric types */
+static char *_dw_container_cell_text(DWContainer *cont, DWContRow *row, int column, char *buf, int len)
+{
+    unsigned long flags = cont->flags[column];
+    DWCell *cell;
+
+    if(!row->cells)
+        return "";
+    cell = &row->cells[column];
+    if(flags & (DW_CFA_STRING | DW_CFA_STRINGANDICON))
+        return cell->string ? cell->string : "";
+    if(flags & DW_CFA_ULONG)
+        snprintf(buf, len, "%lu", (unsigned long)cell->ulong);
+    else if(flags & DW_CFA_DATE)
+        snprintf(buf, len, "%04d/%02d/%02d", (int)cell->date.year, (int)cell->date.month, (int)cell->date.day);
+    else if(flags & DW_CFA_TIME)
+        snprintf(buf, len, "%02d:%02d:%02d", (int)cell->time.hours, (int)cell->time.minutes, (int)cell->time.seconds);
+    else
+        buf[0] = '\0';
+    return buf;
+}
+
+/* Sort key for one row, the original index breaks ties so sorts are stable */
+typedef struct _dwsortkey
+{
+    union {
+        const char *text;
+        unsigned long long value;
+    } key;
+    int index;
+} DWSortKey;
+
+static int _dw_sort_text_compare(const void *a, const void *b)
+{
+    const DWSortKey *ka = a, *kb = b;
+    int rc = strcmp(ka->key.text, kb->key.text);
+
+    return rc ? rc : ka->index - kb->index;
+}
+
+static int _dw_sort_text_compare_desc(const void *a, const void *b)
+{
+    const DWSortKey *ka = a, *kb = b;
+    int rc = strcmp(kb->key.text, ka->key.text);
+
+    return rc ? rc : ka->index - kb->index;
+}
+
+static int _dw_sort_value_compare(const void *a, const void *b)
+{
+    const DWSortKey *ka = a, *kb = b;
+
+    if(ka->key.value != kb->key.value)
+        return ka->key.value < kb->key.value ? -1 : 1;
+    return ka->index - kb->index;
+}
+
+static int _dw_sort_value_compare_desc(const void *a, const void *b)
+{
+    const DWSortKey *ka = a, *kb = b;
+
+    if(ka->key.value != kb->key.value)
+        return ka->key.value > kb->key.value ? -1 : 1;
+    return ka->index - kb->index;
+}
+
+static int _dw_trigram_compare(const void *a, const void *b)
+{
+    const DWTrigram *ta = a, *tb = b;
+
+    if(ta->trigram != tb->trigram)
+        return ta->trigram < tb->trigram ? -1 : 1;
+    return ta->row - tb->row;
+}
+
+#define _DW_TRIGRAM(s) (((unsigned int)(unsigned char)(s)[0] << 16) | ((unsigned int)(unsigned char)(s)[1] << 8) | (unsigned int)(unsigned char)(s)[2])
+
+static void _dw_container_filter_free(DWContFilter *filter)
+{
+    int z;
+
+    if(filter->rows)
+    {
+        for(z=0;z<filter->count;z++)
+            free(filter->rows[z]);
+        free(filter->rows);
+        filter->rows = NULL;
+    }
+    free(filter->trigrams);
+    filter->trigrams = NULL;
+    filter->count = filter->ntrigrams = 0;
+}
+
+/* Index the filtered column, sorting the trigram and row pairs lets
+ * the rows holding a trigram be found with a binary search.
+ */
+static void _dw_container_filter_index(DWContainer *cont)
+{
+    DWContFilter *filter = &cont->filter;
+    size_t total = 0, x;
+    int z, n = 0;
+
+    _dw_container_filter_free(filter);
+    if(!(filter->rows = calloc(cont->count + 1, sizeof(char *))))
+        return;
+    filter->count = cont->count;
+    for(z=0;z<cont->count;z++)
+    {
+        DWContRow *row = &cont->rows[z];
+        size_t len;
+
+        filter->rows[z] = _dw_filter_fold(row->cells ? row->cells[filter->column].string : NULL, filter->flags);
+        if(filter->rows[z] && (len = strlen(filter->rows[z])) > 2)
+            total += len - 2;
+    }
+    if(total && !(filter->trigrams = malloc(sizeof(DWTrigram) * total)))
+    {
+        _dw_container_filter_free(filter);
+        return;
+    }
+    for(z=0;z<cont->count;z++)
+    {
+        const char *text = filter->rows[z];
+
+        for(x=0;text && text[x] && text[x+1] && text[x+2];x++)
+        {
+            filter->trigrams[n].trigram = _DW_TRIGRAM(&text[x]);
+            filter->trigrams[n].row = z;
+            n++;
+        }
+    }
+    if(n)
+        qsort(filter->trigrams, n, sizeof(DWTrigram), _dw_trigram_compare);
+    /* Drop repeats of a trigram within a row */
+    for(z=0, x=0;z<n;z++)
+    {
+        if(!x || filter->trigrams[x-1].trigram != filter->trigrams[z].trigram || filter->trigrams[x-1].row != filter->trigrams[z].row)
+            filter->trigrams[x++] = filter->trigrams[z];
+    }
+    filter->ntrigrams = (int)x;
+    filter->dirty = FALSE;
+}
+
+/* Returns the index entries for a trigram, count is set to the number of rows */
+static DWTrigram *_dw_container_filter_lookup(DWContFilter *filter, unsigned int trigram, int *count)
+{
+    int low = 0, high = filter->ntrigrams, start;
+
+    while(low < high)
+    {
+        int mid = (low + high) / 2;
+
+        if(filter->trigrams[mid].trigram < trigram)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    start = low;
+    high = filter->ntrigrams;
+    while(low < high)
+    {
+        int mid = (low + high) / 2;
+
+        if(filter->trigrams[mid].trigram <= trigram)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    *count = low - start;
+    return &filter->trigrams[start];
+}
+
+static void _dw_container_row_free(DWContainer *cont, DWContRow *row)
+{
+    int z;
+
+    if(row->cells)
+    {
+        for(z=0;z<cont->columns;z++)
+        {
+            if(cont->flags[z] & (DW_CFA_STRING | DW_CFA_STRINGANDICON))
+                free(row->cells[z].string);
+        }
+        free(row->cells);
+    }
+    free(row->title);
+}
+
+/* Remove a single row, keeping the cursor on the same row */
+static void _dw_container_remove(DWContainer *cont, int index)
+{
+    cont->filter.dirty = TRUE;
+    _dw_container_row_free(cont, &cont->rows[index]);
+    cont->count--;
+    memmove(&cont->rows[index], &cont->rows[index+1], sizeof(DWContRow) * (cont->count - index));
+    if(cont->cursor == index)
+        cont->cursor = -1;
+    else if(cont->cursor > index)
+        cont->cursor--;
+    if(cont->query >= index)
+        cont->query--;
+}
+
+/* Move the cursor to a row and select it */
+static void _dw_container_select(DWWidget *widget, int index)
+{
+    DWContainer *cont = (DWContainer *)widget->model;
+    int z;
+
+    if(!widget->style)
+    {
+        for(z=0;z<cont->count;z++)
+            cont->rows[z].selected = FALSE;
+    }
+    cont->cursor = index;
+    cont->rows[index].selected = TRUE;
+    _dw_emit_container_select(widget, &cont->rows[index]);
+}
+
+/* Free a menu or menu item along with its items and submenus */
+static void _dw_menu_free(DWWidget *menu)
+{
+    DWWidget *item = menu->children;
+
+    while(item)
+    {
+        DWWidget *next = item->next;
+
+        _dw_menu_free(item);
+        item = next;
+    }
+    free(menu->text);
+    free(menu);
+}
+
+/* Search a menu and its submenus for an item ID */
+static DWWidget *_dw_menu_item_find(DWWidget *menu, unsigned long itemid)
+{
+    DWWidget *item;
+
+    for(item = menu ? menu->children : NULL;item;item = item->next)
+    {
+        DWWidget *found;
+
+        if(item->id == itemid)
+            return item;
+        if(item->children && (found = _dw_menu_item_find(item->children, itemid)))
+            return found;
+    }
+    return NULL;
+}
+
+static DWWidget *_dw_notebook(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    return (widget && widget->type == _DW_WIDGET_NOTEBOOK) ? widget : NULL;
+}
+
+static DWNotebookPage *_dw_notebook_page(DWWidget *widget, unsigned long pageid)
+{
+    DWNotebookPage *page;
+
+    for(page = widget ? (DWNotebookPage *)widget->model : NULL;page;page = page->next)
+    {
+        if(page->id == pageid)
+            return page;
+    }
+    return NULL;
+}
+
+/* Functions for managing the user data lists that are associated with
+ * a given window handle.  Used in dw_window_set_data() and
+ * dw_window_get_data().
+ */
+static UserData *_dw_find_userdata(UserData **root, const char *varname)
+{
+    UserData *tmp = *root;
+
+    while(tmp)
+    {
+        if(strcasecmp(tmp->varname, varname) == 0)
+            return tmp;
+        tmp = tmp->next;
+    }
+    return NULL;
+}
+
+static int _dw_new_userdata(UserData **root, const char *varname, void *data)
+{
+    UserData *new = _dw_find_userdata(root, varname);
+
+    if(new)
+        new->data = data;
+    else
+    {
+        UserData **prev = root;
+
+        if(!(new = calloc(1, sizeof(UserData))))
+            return FALSE;
+        new->varname = strdup(varname);
+        new->data = data;
+        while(*prev)
+            prev = &(*prev)->next;
+        *prev = new;
+    }
+    return TRUE;
+}
+
+static void _dw_remove_userdata(UserData **root, const char *varname, int all)
+{
+    while(*root)
+    {
+        UserData *tmp = *root;
+
+        if(all || strcasecmp(tmp->varname, varname) == 0)
+        {
+            *root = tmp->next;
+            free(tmp->varname);
+            free(tmp);
+            if(!all)
+                return;
+        }
+        else
+            root = &tmp->next;
+    }
+}
+
+/* Remove signal handlers matching a name and/or data,
+ * calling the discfunc of each one like the other backends.
+ */
+static void _dw_signal_remove(DWWidget *widget, const char *signame, int anydata, void *data)
+{
+    DWSignalHandler **prev = &widget->handlers;
+
+    while(*prev)
+    {
+        DWSignalHandler *handler = *prev;
+
+        if((!signame || !strcmp(handler->signame, signame)) && (anydata || handler->data == data))
+        {
+            *prev = handler->next;
+            if(handler->discfunc)
+            {
+                void (*discfunc)(HWND, void *) = handler->discfunc;
+
+                discfunc((HWND)widget, handler->data);
+            }
+            free(handler->signame);
+            free(handler);
+        }
+        else
+            prev = &handler->next;
+    }
+}
+
+/* Free a widget, its contents and everything packed inside it */
+static void _dw_widget_free(DWWidget *widget)
+{
+    if(widget->box)
+    {
+        int z;
+
+        for(z=0;z<widget->box->count;z++)
+        {
+            DWWidget *child = (DWWidget *)widget->box->items[z].hwnd;
+
+            if(child)
+                _dw_widget_free(child);
+        }
+        free(widget->box->items);
+        free(widget->box->itemwidth);
+        free(widget->box->itemheight);
+        free(widget->box->itempad);
+        free(widget->box->itemflags);
+        free(widget->box);
+    }
+
+    switch(widget->type)
+    {
+        case _DW_WIDGET_WINDOW:
+            if(widget->children)
+                _dw_menu_free(widget->children);
+            break;
+        case _DW_WIDGET_BUTTON:
+        case _DW_WIDGET_BITMAP:
+            dw_icon_free(widget->icon);
+            break;
+        case _DW_WIDGET_RENDER:
+            dw_pixmap_destroy(widget->pixmap);
+            break;
+        case _DW_WIDGET_SPLITBAR:
+            if(widget->topleft)
+                _dw_widget_free(widget->topleft);
+            if(widget->bottomright)
+                _dw_widget_free(widget->bottomright);
+            break;
+        case _DW_WIDGET_LISTBOX:
+        case _DW_WIDGET_COMBOBOX:
+        {
+            DWListModel *list = (DWListModel *)widget->model;
+            int z;
+
+            for(z=0;!list->textfunc && z<list->count;z++)
+                free(list->items[z]);
+            free(list->items);
+            free(list->selected);
+            free(list);
+            break;
+        }
+        case _DW_WIDGET_TREE:
+            dw_tree_clear((HWND)widget);
+            free(widget->model);
+            break;
+        case _DW_WIDGET_CONTAINER:
+        {
+            DWContainer *cont = (DWContainer *)widget->model;
+            int z;
+
+            dw_container_clear((HWND)widget, FALSE);
+            for(z=0;z<cont->columns;z++)
+                free(cont->titles[z]);
+            free(cont->titles);
+            free(cont->flags);
+            free(cont->widths);
+            free(cont->fstitle);
+            free(cont->rows);
+            _dw_container_filter_free(&cont->filter);
+            free(cont->filter.text);
+            free(cont);
+            break;
+        }
+        case _DW_WIDGET_NOTEBOOK:
+        {
+            DWNotebookPage *page = (DWNotebookPage *)widget->model;
+
+            while(page)
+            {
+                DWNotebookPage *next = page->next;
+
+                if(page->page)
+                    _dw_widget_free(page->page);
+                free(page->text);
+                free(page->status);
+                free(page);
+                page = next;
+            }
+            break;
+        }
+    }
+
+    _dw_signal_remove(widget, NULL, TRUE, NULL);
+    _dw_remove_userdata(&widget->root, NULL, TRUE);
+    _dw_queue_purge(widget);
+    free(widget->text);
+    free(widget->font);
+    free(widget->tooltip);
+    free(widget);
+}
+
+/* Search a widget and everything packed inside it for an ID */
+static DWWidget *_dw_widget_find(DWWidget *widget, unsigned long id)
+{
+    DWWidget *found = NULL;
+
+    if(!widget)
+        return NULL;
+    if(widget->id == id && widget->type != _DW_WIDGET_MENUITEM)
+        return widget;
+
+    if(widget->box)
+    {
+        int z;
+
+        for(z=0;z<widget->box->count && !found;z++)
+            found = _dw_widget_find((DWWidget *)widget->box->items[z].hwnd, id);
+    }
+    else if(widget->type == _DW_WIDGET_SPLITBAR)
+    {
+        if(!(found = _dw_widget_find(widget->topleft, id)))
+            found = _dw_widget_find(widget->bottomright, id);
+    }
+    else if(widget->type == _DW_WIDGET_NOTEBOOK)
+    {
+        DWNotebookPage *page;
+
+        for(page = (DWNotebookPage *)widget->model;page && !found;page = page->next)
+            found = _dw_widget_find(page->page, id);
+    }
+    return found;
+}
+
+/* Page size in points used by dw_print_run() */
+#define _DW_PRINT_WIDTH  612
+#define _DW_PRINT_HEIGHT 792
+
+/* Thread start, assigns the DW thread ID before calling the function */
+static void *_dw_thread_start(void *data)
+{
+    void (*threadfunc)(void *) = ((void **)data)[0];
+    void *threaddata = ((void **)data)[1];
+
+    pthread_setspecific(_dw_tid_key, ((void **)data)[2]);
+    free(data);
+
+    _dw_init_thread();
+    threadfunc(threaddata);
+    _dw_deinit_thread();
+    return NULL;
+}
+
+/* Drawing primitives on the ARGB buffers */
+#define _DW_ARC_SEGMENTS 64
+
+/* Returns the buffer to draw on, either the pixmap
+ * or the backing store of a render widget.
+ */
+static HPIXMAP _dw_draw_target(HWND handle, HPIXMAP pixmap)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(pixmap)
+        return pixmap->pixels ? pixmap : NULL;
+    if(widget && (widget->type == _DW_WIDGET_RENDER || widget->type == _DW_WIDGET_BITMAP))
+        return widget->pixmap;
+    return NULL;
+}
+
+static void _dw_draw_pixel(HPIXMAP pixmap, int x, int y, unsigned int color)
+{
+    if(x >= 0 && y >= 0 && x < (int)pixmap->width && y < (int)pixmap->height)
+        pixmap->pixels[(y * pixmap->width) + x] = color;
+}
+
+static void _dw_fill_rect(HPIXMAP pixmap, int x, int y, int width, int height, unsigned int color)
+{
+    int x2 = x + width, y2 = y + height, z;
+
+    if(x < 0)
+        x = 0;
+    if(y < 0)
+        y = 0;
+    if(x2 > (int)pixmap->width)
+        x2 = (int)pixmap->width;
+    if(y2 > (int)pixmap->height)
+        y2 = (int)pixmap->height;
+
+    for(;y<y2;y++)
+    {
+        unsigned int *row = &pixmap->pixels[y * pixmap->width];
+
+        for(z=x;z<x2;z++)
+            row[z] = color;
+    }
+}
+
+/* Bresenham line */
+static void _dw_draw_segment(HPIXMAP pixmap, int x1, int y1, int x2, int y2, unsigned int color)
+{
+    int dx = abs(x2 - x1), dy = -abs(y2 - y1);
+    int sx = x1 < x2 ? 1 : -1, sy = y1 < y2 ? 1 : -1;
+    int err = dx + dy;
+
+    for(;;)
+    {
+        int e2 = err * 2;
+
+        _dw_draw_pixel(pixmap, x1, y1, color);
+        if(x1 == x2 && y1 == y2)
+            break;
+        if(e2 >= dy)
+        {
+            err += dy;
+            x1 += sx;
+        }
+        if(e2 <= dx)
+        {
+            err += dx;
+            y1 += sy;
+        }
+    }
+}
+
+static int _dw_int_compare(const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+/* Outline or even-odd scanline fill of a polygon */
+static void _dw_draw_shape(HPIXMAP pixmap, int fill, int close, int npoints, int *x, int *y, unsigned int color)
+{
+    int z;
+
+    if(fill)
+    {
+        int miny = y[0], maxy = y[0], *nodes = malloc(sizeof(int) * npoints), row;
+
+        if(!nodes)
+            return;
+        for(z=1;z<npoints;z++)
+        {
+            if(y[z] < miny)
+                miny = y[z];
+            if(y[z] > maxy)
+                maxy = y[z];
+        }
+        if(miny < 0)
+            miny = 0;
+        if(maxy >= (int)pixmap->height)
+            maxy = (int)pixmap->height - 1;
+
+        for(row=miny;row<=maxy;row++)
+        {
+            int count = 0, j = npoints - 1;
+
+            for(z=0;z<npoints;z++)
+            {
+                if((y[z] <= row && y[j] > row) || (y[j] <= row && y[z] > row))
+                    nodes[count++] = x[z] + (int)((double)(row - y[z]) / (y[j] - y[z]) * (x[j] - x[z]));
+                j = z;
+            }
+            qsort(nodes, count, sizeof(int), _dw_int_compare);
+            for(z=0;z+1<count;z+=2)
+                _dw_fill_rect(pixmap, nodes[z], row, nodes[z+1] - nodes[z] + 1, 1, color);
+        }
+        free(nodes);
+    }
+    for(z=0;z+1<npoints;z++)
+        _dw_draw_segment(pixmap, x[z], y[z], x[z+1], y[z+1], color);
+    if(close && npoints > 2)
+        _dw_draw_segment(pixmap, x[npoints-1], y[npoints-1], x[0], y[0], color);
+}
+
+/* Parallel measure pass, when DW_FEATURE_PARALLEL_LAYOUT is enabled
+ * boxes holding at least _DW_LAYOUT_THRESHOLD items which need to be
+ * measured are handed out to a pool of worker threads. The calling
+ * thread measures boxes from the same list, then continues serially
+ * once they are all done. Placement is always done serially.
+ */
+#define _DW_LAYOUT_THRESHOLD 4096
+#define _DW_LAYOUT_MAX_THREADS 64
+
+static pthread_mutex_t _dw_layout_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _dw_layout_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t _dw_layout_done = PTHREAD_COND_INITIALIZER;
+static pthread_t _dw_layout_workers[_DW_LAYOUT_MAX_THREADS];
+/* Threads used to measure including the caller, 0 or 1 is serial */
+static int _dw_layout_threads = 0, _dw_layout_started = 0, _dw_layout_stop = FALSE;
+static Box **_dw_layout_jobs = NULL;
+static int _dw_layout_jobcount = 0, _dw_layout_jobnext = 0, _dw_layout_jobbusy = 0, _dw_layout_joballoc = 0;
+/* Set while boxes are being measured in parallel, so they are not split again */
+static int _dw_layout_parallel = FALSE;
+
+static void _dw_measure_box(Box *thisbox, int *depth);
+
+/* Takes boxes off the job list until it is empty,
+ * must be called with _dw_layout_mutex locked.
+ */
+static void _dw_layout_run_jobs(void)
+{
+    while(_dw_layout_jobnext < _dw_layout_jobcount)
+    {
+        Box *box = _dw_layout_jobs[_dw_layout_jobnext++];
+        int depth = 0;
+
+        _dw_layout_jobbusy++;
+        pthread_mutex_unlock(&_dw_layout_mutex);
+        _dw_measure_box(box, &depth);
+        pthread_mutex_lock(&_dw_layout_mutex);
+        if(!--_dw_layout_jobbusy && _dw_layout_jobnext >= _dw_layout_jobcount)
+            pthread_cond_signal(&_dw_layout_done);
+    }
+}
+
+static void *_dw_layout_worker(void *data)
+{
+    int index = DW_POINTER_TO_INT(data);
+
+    pthread_mutex_lock(&_dw_layout_mutex);
+    while(!_dw_layout_stop)
+    {
+        /* Workers above the current thread count stay idle */
+        if(index < _dw_layout_threads - 1)
+            _dw_layout_run_jobs();
+        pthread_cond_wait(&_dw_layout_cond, &_dw_layout_mutex);
+    }
+    pthread_mutex_unlock(&_dw_layout_mutex);
+    return NULL;
+}
+
+/* Stops and joins the worker threads */
+static void _dw_layout_workers_stop(void)
+{
+    int z;
+
+    pthread_mutex_lock(&_dw_layout_mutex);
+    _dw_layout_stop = TRUE;
+    pthread_cond_broadcast(&_dw_layout_cond);
+    pthread_mutex_unlock(&_dw_layout_mutex);
+    for(z=0;z<_dw_layout_started;z++)
+        pthread_join(_dw_layout_workers[z], NULL);
+    _dw_layout_started = 0;
+    _dw_layout_stop = FALSE;
+    free(_dw_layout_jobs);
+    _dw_layout_jobs = NULL;
+    _dw_layout_joballoc = 0;
+}
+
+/* Measures the large unmeasured boxes packed in thisbox on the
+ * worker threads, if there is more than one of them.
+ */
+static void _dw_measure_parallel(Box *thisbox)
+{
+    int z, count = 0;
+
+    for(z=0;z<thisbox->count;z++)
+    {
+        if(thisbox->itemflags[z] & _DW_ITEM_BOX)
+        {
+            Box *tmp = (Box *)_dw_window_pointer_get(thisbox->items[z].hwnd);
+
+            if(tmp && !(tmp->layout & _DW_LAYOUT_MEASURED) && tmp->itemtotal >= _DW_LAYOUT_THRESHOLD)
+            {
+                if(count >= _dw_layout_joballoc)
+                {
+                    int alloc = _dw_layout_joballoc ? _dw_layout_joballoc * 2 : 16;
+                    Box **jobs = realloc(_dw_layout_jobs, sizeof(Box *) * alloc);
+
+                    if(!jobs)
+                        return;
+                    _dw_layout_jobs = jobs;
+                    _dw_layout_joballoc = alloc;
+                }
+                _dw_layout_jobs[count++] = tmp;
+            }
+        }
+    }
+    /* A single box is measured faster on this thread */
+    if(count < 2)
+        return;
+
+    pthread_mutex_lock(&_dw_layout_mutex);
+    /* Start any workers that are not running yet */
+    while(_dw_layout_started < _dw_layout_threads - 1 &&
+          pthread_create(&_dw_layout_workers[_dw_layout_started], NULL, _dw_layout_worker,
+                         DW_INT_TO_POINTER(_dw_layout_started)) == 0)
+        _dw_layout_started++;
+    _dw_layout_parallel = TRUE;
+    _dw_layout_jobcount = count;
+    _dw_layout_jobnext = 0;
+    pthread_cond_broadcast(&_dw_layout_cond);
+    _dw_layout_run_jobs();
+    while(_dw_layout_jobbusy)
+        pthread_cond_wait(&_dw_layout_done, &_dw_layout_mutex);
+    _dw_layout_jobcount = _dw_layout_jobnext = 0;
+    _dw_layout_parallel = FALSE;
+    pthread_mutex_unlock(&_dw_layout_mutex);
+}
+
+/* Sums the item sizes along a box and finds the largest across it,
+ * with and without the expandable items. This streams over the
+ * box's size arrays and the loop body has no branches or calls,
+ * so the compiler can keep it in vector registers.
+ */
+static void _dw_layout_reduce(int count, const int *along, const int *across, const int *pad, const unsigned char *flags,
+                              int alongexpand, int acrossexpand, int *total, int *totalused, int *largest, int *largestused)
+{
+    int z, sum = 0, sumused = 0, max = 0, maxused = 0;
+
+    for(z=0;z<count;z++)
+    {
+        int itempad = pad[z] * 2;
+        int itemalong = along[z] + itempad;
+        int itemacross = across[z] + itempad;
+        int itemused = (flags[z] & acrossexpand) ? itempad : itemacross;
+
+        sum += itemalong;
+        sumused += (flags[z] & alongexpand) ? itempad : itemalong;
+        max = itemacross > max ? itemacross : max;
+        maxused = itemused > maxused ? itemused : maxused;
+    }
+    *total = sum;
+    *totalused = sumused;
+    *largest = max;
+    *largestused = maxused;
+}
+
+/* Calculates the space required by a box and the boxes packed in it,
+ * boxes that have not changed since they were last measured keep
+ * their cached sizes and are not walked again.
+ */
+static void _dw_measure_box(Box *thisbox, int *depth)
+{
+   int z;
+   /* Totals along the box and maximums across it...
+    * These will be used to find the widest or
+    * tallest items in a box.
+    */
+   int total = 0, totalused = 0, largest = 0, largestused = 0;
+    
+   /* Reset the box sizes */
+   thisbox->minwidth = thisbox->minheight = thisbox->usedpadx = thisbox->usedpady = thisbox->pad * 2;
+
+   /* If there are containers which have built-in padding like
+    * groupboxes.. calculate the padding size and add it to the layout.
+    */
+   if(thisbox->grouphwnd)
+   {
+      char *text = dw_window_get_text(thisbox->grouphwnd);
+
+      thisbox->grouppady = 0;
+
+      if(text)
+      {
+         dw_font_text_extents_get(thisbox->grouphwnd, 0, text, NULL, &thisbox->grouppady);
+         dw_free(text);
+      }
+
+      if(thisbox->grouppady)
+         thisbox->grouppady += 3;
+      else
+         thisbox->grouppady = 6;
+
+      thisbox->grouppadx = 6;
+
+      thisbox->minwidth += thisbox->grouppadx;
+      thisbox->usedpadx += thisbox->grouppadx;
+      thisbox->minheight += thisbox->grouppady;
+      thisbox->usedpady += thisbox->grouppady;
+   }
+
+   /* Large boxes packed in this one may be measured on other threads */
+   if(_dw_layout_threads > 1 && !_dw_layout_parallel && thisbox->itemtotal >= _DW_LAYOUT_THRESHOLD * 2)
+      _dw_measure_parallel(thisbox);
+
+   /* Get the sizes of any boxes packed in this one */
+   for(z=0;z<thisbox->count;z++)
+   {
+      if(thisbox->itemflags[z] & _DW_ITEM_BOX)
+      {
+         Box *tmp = (Box *)_dw_window_pointer_get(thisbox->items[z].hwnd);
+
+         if(tmp)
+         {
+            /* Only boxes which changed need to calculate their contents */
+            if(!(tmp->layout & _DW_LAYOUT_MEASURED))
+            {
+               (*depth)++;
+
+               /* Save the newly calculated values on the box */
+               _dw_measure_box(tmp, depth);
+
+               (*depth)--;
+            }
+
+            /* Duplicate the values in the item list for use below */
+            thisbox->itemwidth[z] = thisbox->items[z].width = tmp->minwidth;
+            thisbox->itemheight[z] = thisbox->items[z].height = tmp->minheight;
+         }
+      }
+   }
+
+   /* Count up all the space for all items in the box */
+   if(thisbox->type == DW_VERT)
+   {
+      _dw_layout_reduce(thisbox->count, thisbox->itemheight, thisbox->itemwidth, thisbox->itempad, thisbox->itemflags,
+                        _DW_ITEM_VEXPAND, _DW_ITEM_HEXPAND, &total, &totalused, &largest, &largestused);
+      thisbox->minheight += total;
+      thisbox->usedpady += totalused;
+      thisbox->minwidth += largest;
+      thisbox->usedpadx += largestused;
+   }
+   else
+   {
+      _dw_layout_reduce(thisbox->count, thisbox->itemwidth, thisbox->itemheight, thisbox->itempad, thisbox->itemflags,
+                        _DW_ITEM_HEXPAND, _DW_ITEM_VEXPAND, &total, &totalused, &largest, &largestused);
+      thisbox->minwidth += total;
+      thisbox->usedpadx += totalused;
+      thisbox->minheight += largest;
+      thisbox->usedpady += largestused;
+   }
+
+   /* The cached sizes are valid until the box is invalidated,
+    * the contents need to be placed again using the new sizes.
+    */
+   thisbox->layout = _DW_LAYOUT_MEASURED;
+}
+
+/* This function calculates how much space the widgets and boxes require
+ * and does expansion as necessary.
+ */
+static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int pass)
+{
+   /* Current item position */
+   int z, currentx = thisbox->pad, currenty = thisbox->pad;
+
+   /* Only calculate the space requirements if something changed */
+   if(!(thisbox->layout & _DW_LAYOUT_MEASURED))
+      _dw_measure_box(thisbox, depth);
+
+   /* Move the groupbox start past the group border */
+   if(thisbox->grouphwnd)
+   {
+      currentx += 3;
+      currenty += thisbox->grouppady - 3;
+   }
+
+   /* The second pass is for actual placement. */
+   if(pass > 1)
+   {
+      for(z=0;z<(thisbox->count);z++)
+      {
+         int height = thisbox->items[z].height;
+         int width = thisbox->items[z].width;
+         int itempad = thisbox->items[z].pad * 2;
+         int thispad = thisbox->pad * 2;
+
+         /* Calculate the new sizes */
+         if(thisbox->items[z].hsize == _DW_SIZE_EXPAND)
+         {
+            if(thisbox->type == DW_HORZ)
+            {
+               int expandablex = thisbox->minwidth - thisbox->usedpadx;
+                
+               if(expandablex)
+                  width = (int)(((float)width / (float)expandablex) * (float)(x - thisbox->usedpadx));
+            }
+            else
+               width = x - (itempad + thispad + thisbox->grouppadx);
+         }
+         if(thisbox->items[z].vsize == _DW_SIZE_EXPAND)
+         {
+            if(thisbox->type == DW_VERT)
+            {
+               int expandabley = thisbox->minheight - thisbox->usedpady;
+                
+               if(expandabley)
+                  height = (int)(((float)height / (float)expandabley) * (float)(y - thisbox->usedpady));
+            }
+            else
+               height = y - (itempad + thispad + thisbox->grouppady);
+         }
+            
+         /* If the calculated size is valid... */
+         if(width > 0 && height > 0)
+         {
+            int pad = thisbox->items[z].pad;
+            DWWidget *handle = (DWWidget *)thisbox->items[z].hwnd;
+
+            /* Place the widget, boxes notebooks and splitbars
+             * lay out their contents from _dw_widget_place().
+             */
+            if(handle)
+               _dw_widget_place(handle, currentx + pad, currenty + pad, width, height);
+
+            /* Advance the current position in the box */
+            if(thisbox->type == DW_HORZ)
+               currentx += width + (pad * 2);
+            if(thisbox->type == DW_VERT)
+               currenty += height + (pad * 2);
+         }
+      }
+      /* Remember the size the contents were placed at */
+      thisbox->layout |= _DW_LAYOUT_PLACED;
+      thisbox->placedwidth = x;
+      thisbox->placedheight = y;
+   }
+}
+
+/* This is a convenience function used in the window's resize event
+ * to relayout the controls in the window.
+ */
+void _dw_do_resize(Box *thisbox, int x, int y)
+{
+   if(x != 0 && y != 0)
+   {
+      if(thisbox)
+      {
+         int depth = 0;
+            
+         /* Calculate space requirements */
+         _dw_resize_box(thisbox, &depth, x, y, 1);
+            
+         /* Finally place all the boxes and controls */
+         _dw_resize_box(thisbox, &depth, x, y, 2);
+      }
+   }
+}
+
+/*
+ * Runs a message loop for Dynamic Windows.
+ */
+void API dw_main(void)
+{
+    _dw_quit = FALSE;
+
+    while(!_dw_quit)
+    {
+        if(!_dw_main_iteration())
+        {
+            pthread_mutex_lock(&_dw_mutex);
+            /* Nothing to do... jump the clock ahead to the next timer,
+             * or wait for another thread to queue something.
+             */
+            if(!_dw_queue && !_dw_quit)
+            {
+                if(_dw_timers)
+                    _dw_clock = _dw_timers->due;
+                else
+                    pthread_cond_wait(&_dw_cond, &_dw_mutex);
+            }
+            pthread_mutex_unlock(&_dw_mutex);
+        }
+    }
+}
+
+/*
+ * Causes running dw_main() to return.
+ */
+void API dw_main_quit(void)
+{
+    pthread_mutex_lock(&_dw_mutex);
+    _dw_quit = TRUE;
+    pthread_cond_broadcast(&_dw_cond);
+    pthread_mutex_unlock(&_dw_mutex);
+}
+
+/*
+ * Runs a message loop for Dynamic Windows, for a period of milliseconds.
+ * Parameters:
+ *           milliseconds: Number of milliseconds to run the loop for.
+ */
+void API dw_main_sleep(int milliseconds)
+{
+    unsigned long long until;
+
+    pthread_mutex_lock(&_dw_mutex);
+    until = _dw_clock + (milliseconds > 0 ? milliseconds : 0);
+    pthread_mutex_unlock(&_dw_mutex);
+
+    for(;;)
+    {
+        /* Drain everything due at the current virtual time */
+        while(_dw_main_iteration())
+        {
+        }
+        pthread_mutex_lock(&_dw_mutex);
+        if(_dw_clock >= until)
+        {
+            pthread_mutex_unlock(&_dw_mutex);
+            break;
+        }
+        /* Then advance to the next timer or the end of the sleep */
+        _dw_clock = (_dw_timers && _dw_timers->due < until) ? _dw_timers->due : until;
+        pthread_mutex_unlock(&_dw_mutex);
+    }
+}
+
+/*
+ * Processes a single message iteration and returns.
+ */
+void API dw_main_iteration(void)
+{
+    _dw_main_iteration();
+}
+
+/*
+ * Cleanly terminates a DW session, should be signal handler safe.
+ * Parameters:
+ *       exitcode: Exit code reported to the operating system.
+ */
+void API dw_exit(int exitcode)
+{
+    dw_shutdown();
+    exit(exitcode);
+}
+
+/*
+ * Free's memory allocated by dynamic windows.
+ * Parameters:
+ *           ptr: Pointer to dynamic windows allocated
+ *                memory to be free()'d.
+ */
+void API dw_free(void *ptr)
+{
+   free(ptr);
+}
+
+/*
+ * Returns a pointer to a static buffer which contains the
+ * current user directory.  Or the root directory if it could
+ * not be determined.
+ */
+char * API dw_user_dir(void)
+{
+   static char _dw_user_dir[MAX_PATH+1] = {0};
+
+   if(!_dw_user_dir[0])
+   {
+      char *home = getenv("HOME");
+
+      if(home)
+         strcpy(_dw_user_dir, home);
+      else
+         strcpy(_dw_user_dir, "/");
+   }
+   return _dw_user_dir;
+}
+
+/*
+ * Returns a pointer to a static buffer which containes the
+ * private application data directory.
+ */
+char * API dw_app_dir(void)
+{
+    return _dw_exec_dir;
+}
+
+/*
+ * Sets the application ID used by this Dynamic Windows application instance.
+ * Parameters:
+ *         appid: A string typically in the form: com.company.division.application
+ *         appname: The application name used on Windows or NULL.
+ * Returns:
+ *         DW_ERROR_NONE after successfully setting the application ID.
+ *         DW_ERROR_UNKNOWN if unsupported on this system.
+ *         DW_ERROR_GENERAL if the application ID is not allowed.
+ * Remarks:
+ *          This must be called before dw_init().  If dw_init() is called first
+ *          it will create a unique ID in the form: org.dbsoft.dwindows.application
+ *          or if the application name cannot be detected: org.dbsoft.dwindows.pid.#
+ *          The appname is only required on Windows.  If NULL is passed the detected
+ *          application name will be used, but a prettier name may be desired.
+ */
+int API dw_app_id_set(const char *appid, const char *appname)
+{
+    if(!appid || !*appid || strlen(appid) >= sizeof(_dw_app_id))
+        return DW_ERROR_GENERAL;
+    strcpy(_dw_app_id, appid);
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Displays a debug message on the console...
+ * Parameters:
+ *           format: printf style format string.
+ *           ...: Additional variables for use in the format.
+ */
+void API dw_debug(const char *format, ...)
+{
+   va_list args;
+
+   va_start(args, format);
+   dw_vdebug(format, args);
+   va_end(args);
+}
+
+void API dw_vdebug(const char *format, va_list args)
+{
+   /* Output to stderr, if there is another way to send it
+    * on the implementation platform, change this.
+    */
+   vfprintf(stderr, format, args);
+}
+
+/*
+ * Displays a Message Box with given text and title..
+ * Parameters:
+ *           title: The title of the message box.
+ *           flags: flags to indicate buttons and icon
+ *           format: printf style format string.
+ *           ...: Additional variables for use in the format.
+ * Returns:
+ *       DW_MB_RETURN_YES, DW_MB_RETURN_NO, DW_MB_RETURN_OK,
+ *       or DW_MB_RETURN_CANCEL based on flags and user response.
+ */
+int API dw_messagebox(const char *title, int flags, const char *format, ...)
+{
+   va_list args;
+   int rc;
+
+   va_start(args, format);
+   rc = dw_vmessagebox(title, flags, format, args);
+   va_end(args);
+   return rc;
+}
+
+int API dw_vmessagebox(const char *title, int flags, const char *format, va_list args)
+{
+    /* Nobody to answer, report it and take the affirmative choice */
+    fprintf(stderr, "%s: ", title ? title : "");
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+
+    if(flags & (DW_MB_YESNO | DW_MB_YESNOCANCEL))
+        return DW_MB_RETURN_YES;
+    return DW_MB_RETURN_OK;
+}
+
+/*
+ * Opens a file dialog and queries user selection.
+ * Parameters:
+ *       title: Title bar text for dialog.
+ *       defpath: The default path of the open dialog.
+ *       ext: Default file extention.
+ *       flags: DW_FILE_OPEN or DW_FILE_SAVE.
+ * Returns:
+ *       NULL on error. A malloced buffer containing
+ *       the file path on success.
+ *
+ */
+char * API dw_file_browse(const char *title, const char *defpath, const char *ext, int flags)
+{
+    return NULL;
+}
+
+/*
+ * Gets the contents of the default clipboard as text.
+ * Parameters:
+ *       None.
+ * Returns:
+ *       Pointer to an allocated string of text or NULL if clipboard empty or contents could not
+ *       be converted to text.
+ */
+char * API dw_clipboard_get_text()
+{
+    char *retval = NULL;
+
+    pthread_mutex_lock(&_dw_mutex);
+    if(_dw_clipboard)
+        retval = strdup(_dw_clipboard);
+    pthread_mutex_unlock(&_dw_mutex);
+    return retval;
+}
+
+/*
+ * Sets the contents of the default clipboard to the supplied text.
+ * Parameters:
+ *       str: Text to put on the clipboard.
+ *       len: Length of the text.
+ */
+void API dw_clipboard_set_text(const char *str, int len)
+{
+    char *text = NULL;
+
+    if(str && len > 0 && (text = malloc(len + 1)))
+    {
+        memcpy(text, str, len);
+        text[len] = '\0';
+    }
+    pthread_mutex_lock(&_dw_mutex);
+    if(_dw_clipboard)
+        free(_dw_clipboard);
+    _dw_clipboard = text;
+    pthread_mutex_unlock(&_dw_mutex);
+}
+
+
+/*
+ * Allocates and initializes a dialog struct.
+ * Parameters:
+ *           data: User defined data to be passed to functions.
+ * Returns:
+ *       A handle to a dialog or NULL on failure.
+ */
+DWDialog * API dw_dialog_new(void *data)
+{
+    DWDialog *tmp = malloc(sizeof(DWDialog));
+
+    if(tmp)
+    {
+        tmp->eve = dw_event_new();
+        dw_event_reset(tmp->eve);
+        tmp->data = data;
+        tmp->done = FALSE;
+        tmp->result = NULL;
+    }
+    return tmp;
+}
+
+/*
+ * Accepts a dialog struct and returns the given data to the
+ * initial called of dw_dialog_wait().
+ * Parameters:
+ *           dialog: Pointer to a dialog struct aquired by dw_dialog_new).
+ *           result: Data to be returned by dw_dialog_wait().
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_dialog_dismiss(DWDialog *dialog, void *result)
+{
+    if(!dialog)
+        return DW_ERROR_GENERAL;
+    dialog->result = result;
+    dw_event_post(dialog->eve);
+    dialog->done = TRUE;
+    /* Wake up the loop in case it is waiting */
+    pthread_mutex_lock(&_dw_mutex);
+    pthread_cond_broadcast(&_dw_cond);
+    pthread_mutex_unlock(&_dw_mutex);
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Accepts a dialog struct waits for dw_dialog_dismiss() to be
+ * called by a signal handler with the given dialog struct.
+ * Parameters:
+ *           dialog: Pointer to a dialog struct aquired by dw_dialog_new).
+ * Returns:
+ *       The data passed to dw_dialog_dismiss().
+ */
+void * API dw_dialog_wait(DWDialog *dialog)
+{
+    void *tmp = NULL;
+
+    if(!dialog)
+        return NULL;
+
+    if(_dw_tid() == _dw_main_tid)
+    {
+        while(!dialog->done)
+        {
+            if(!_dw_main_iteration())
+            {
+                pthread_mutex_lock(&_dw_mutex);
+                if(!_dw_queue && !dialog->done)
+                {
+                    if(_dw_timers)
+                        _dw_clock = _dw_timers->due;
+                    else
+                        pthread_cond_wait(&_dw_cond, &_dw_mutex);
+                }
+                pthread_mutex_unlock(&_dw_mutex);
+            }
+        }
+    }
+    else
+        dw_event_wait(dialog->eve, DW_TIMEOUT_INFINITE);
+    dw_event_close(&dialog->eve);
+    tmp = dialog->result;
+    free(dialog);
+    return tmp;
+}
+
+/*
+ * Create a new Box to be packed.
+ * Parameters:
+ *       type: Either DW_VERT (vertical) or DW_HORZ (horizontal).
+ *       pad: Number of pixels to pad around the box.
+ * Returns:
+ *       A handle to a box or NULL on failure.
+ */
+HWND API dw_box_new(int type, int pad)
+{
+    return (HWND)_dw_box_widget_new(_DW_WIDGET_BOX, type, pad, NULL);
+}
+
+/*
+ * Create a new Group Box to be packed.
+ * Parameters:
+ *       type: Either DW_VERT (vertical) or DW_HORZ (horizontal).
+ *       pad: Number of pixels to pad around the box.
+ *       title: Text to be displayined in the group outline.
+ * Returns:
+ *       A handle to a groupbox window or NULL on failure.
+ */
+HWND API dw_groupbox_new(int type, int pad, const char *title)
+{
+    DWWidget *widget = _dw_box_widget_new(_DW_WIDGET_GROUPBOX, type, pad, title);
+
+    if(widget)
+        widget->box->grouphwnd = (HWND)widget;
+    return (HWND)widget;
+}
+
+/*
+ * Create a new scrollable Box to be packed.
+ * Parameters:
+ *       type: Either DW_VERT (vertical) or DW_HORZ (horizontal).
+ *       pad: Number of pixels to pad around the box.
+ * Returns:
+ *       A handle to a scrollbox or NULL on failure.
+ */
+HWND API dw_scrollbox_new( int type, int pad )
+{
+    return (HWND)_dw_box_widget_new(_DW_WIDGET_SCROLLBOX, type, pad, NULL);
+}
+
+/*
+ * Returns the position of the scrollbar in the scrollbox.
+ * Parameters:
+ *          handle: Handle to the scrollbox to be queried.
+ *          orient: The vertical or horizontal scrollbar.
+ * Returns:
+ *       The vertical or horizontal position in the scrollbox.
+ */
+int API dw_scrollbox_get_pos(HWND handle, int orient)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(!widget || widget->type != _DW_WIDGET_SCROLLBOX)
+        return -1;
+    return (int)(orient == DW_VERT ? widget->value : widget->lower);
+}
+
+/*
+ * Gets the range for the scrollbar in the scrollbox.
+ * Parameters:
+ *          handle: Handle to the scrollbox to be queried.
+ *          orient: The vertical or horizontal scrollbar.
+ * Returns:
+ *       The vertical or horizontal range of the scrollbox.
+ */
+int API dw_scrollbox_get_range(HWND handle, int orient)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(!widget || widget->type != _DW_WIDGET_SCROLLBOX || !widget->box)
+        return -1;
+    return orient == DW_VERT ? widget->box->height : widget->box->width;
+}
+
+/* Internal box packing function called by the other 3 functions */
+void _dw_box_pack(HWND box, HWND item, int index, int width, int height, int hsize, int vsize, int pad, char *funcname)
+{
+    DWWidget *parent = (DWWidget *)box, *child = (DWWidget *)item;
+    Box *thisbox;
+    Item *tmpitem;
+
+    /* Sanity checks */
+    if(!box || box == item || !(thisbox = _dw_window_pointer_get(box)))
+        return;
+
+    /* Do some sanity bounds checking */
+    if(index < 0)
+       index = 0;
+    if(index > thisbox->count)
+       index = thisbox->count;
+
+    /* Make room for the new item */
+    if(!(tmpitem = _dw_box_item_insert(thisbox, index)))
+       return;
+
+    /* Sanity checks */
+    if(vsize && !height)
+       height = 1;
+    if(hsize && !width)
+       width = 1;
+
+    /* Fill in the item data appropriately */
+    if(child && (child->type == _DW_WIDGET_BOX || child->type == _DW_WIDGET_GROUPBOX))
+       tmpitem[index].type = _DW_TYPE_BOX;
+    else
+       tmpitem[index].type = _DW_TYPE_ITEM;
+
+    tmpitem[index].hwnd = item;
+    tmpitem[index].origwidth = tmpitem[index].width = width;
+    tmpitem[index].origheight = tmpitem[index].height = height;
+    tmpitem[index].pad = pad;
+    if(hsize)
+       tmpitem[index].hsize = _DW_SIZE_EXPAND;
+    else
+       tmpitem[index].hsize = _DW_SIZE_STATIC;
+
+    if(vsize)
+       tmpitem[index].vsize = _DW_SIZE_EXPAND;
+    else
+       tmpitem[index].vsize = _DW_SIZE_STATIC;
+
+    /* If either of the parameters are -1 ... calculate the size */
+    if(child && (width == DW_SIZE_AUTO || height == DW_SIZE_AUTO))
+       _dw_widget_preferred_size(child, width == DW_SIZE_AUTO ? &tmpitem[index].width : NULL,
+                                 height == DW_SIZE_AUTO ? &tmpitem[index].height : NULL);
+
+    _dw_box_item_sizes(thisbox, index);
+
+    /* Update the item count */
+    thisbox->count++;
+    _dw_box_total(parent, 1 + (tmpitem[index].type == _DW_TYPE_BOX && child->box ? child->box->itemtotal : 0));
+
+    /* Add the item to the box */
+    if(child)
+       child->parent = parent;
+    _dw_box_invalidate(parent);
+    _dw_layout_queue(parent);
+}
+
+/*
+ * Remove windows (widgets) from the box they are packed into.
+ * Parameters:
+ *       handle: Window handle of the packed item to be removed.
+ * Returns:
+ *       DW_ERROR_NONE on success and DW_ERROR_GENERAL on failure.
+ */
+int API dw_box_unpack(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+    Box *thisbox;
+    int z;
+
+    if(!widget || !widget->parent || !(thisbox = widget->parent->box))
+        return DW_ERROR_GENERAL;
+
+    for(z=0;z<thisbox->count;z++)
+    {
+        if(thisbox->items[z].hwnd == handle)
+        {
+            _dw_box_remove(widget->parent, z);
+            return DW_ERROR_NONE;
+        }
+    }
+    return DW_ERROR_GENERAL;
+}
+
+/*
+ * Remove windows (widgets) from a box at an arbitrary location.
+ * Parameters:
+ *       box: Window handle of the box to be removed from.
+ *       index: 0 based index of packed items.
+ * Returns:
+ *       Handle to the removed item on success, 0 on failure or padding.
+ */
+HWND API dw_box_unpack_at_index(HWND box, int index)
+{
+    DWWidget *widget = (DWWidget *)box;
+
+    if(!widget || !widget->box)
+        return 0;
+    return _dw_box_remove(widget, index);
+}
+
+/*
+ * Pack windows (widgets) into a box at an arbitrary location.
+ * Parameters:
+ *       box: Window handle of the box to be packed into.
+ *       item: Window handle of the item to pack.
+ *       index: 0 based index of packed items. 
+ *       width: Width in pixels of the item or -1 to be self determined.
+ *       height: Height in pixels of the item or -1 to be self determined.
+ *       hsize: TRUE if the window (widget) should expand horizontally to fill space given.
+ *       vsize: TRUE if the window (widget) should expand vertically to fill space given.
+ *       pad: Number of pixels of padding around the item.
+ */
+void API dw_box_pack_at_index(HWND box, HWND item, int index, int width, int height, int hsize, int vsize, int pad)
+{
+    _dw_box_pack(box, item, index, width, height, hsize, vsize, pad, "dw_box_pack_at_index()");
+}
+
+/*
+ * Pack windows (widgets) into a box from the start (or top).
+ * Parameters:
+ *       box: Window handle of the box to be packed into.
+ *       item: Window handle of the item to pack.
+ *       width: Width in pixels of the item or -1 to be self determined.
+ *       height: Height in pixels of the item or -1 to be self determined.
+ *       hsize: TRUE if the window (widget) should expand horizontally to fill space given.
+ *       vsize: TRUE if the window (widget) should expand vertically to fill space given.
+ *       pad: Number of pixels of padding around the item.
+ */
+void API dw_box_pack_start(HWND box, HWND item, int width, int height, int hsize, int vsize, int pad)
+{
+    /* 65536 is the table limit on GTK... 
+     * seems like a high enough value we will never hit it here either.
+     */
+    _dw_box_pack(box, item, 65536, width, height, hsize, vsize, pad, "dw_box_pack_start()");
+}
+
+/*
+ * Pack windows (widgets) into a box from the end (or bottom).
+ * Parameters:
+ *       box: Window handle of the box to be packed into.
+ *       item: Window handle of the item to pack.
+ *       width: Width in pixels of the item or -1 to be self determined.
+ *       height: Height in pixels of the item or -1 to be self determined.
+ *       hsize: TRUE if the window (widget) should expand horizontally to fill space given.
+ *       vsize: TRUE if the window (widget) should expand vertically to fill space given.
+ *       pad: Number of pixels of padding around the item.
+ */
+void API dw_box_pack_end(HWND box, HWND item, int width, int height, int hsize, int vsize, int pad)
+{
+    _dw_box_pack(box, item, 0, width, height, hsize, vsize, pad, "dw_box_pack_end()");
+}
+
+/*
+ * Create a new button window (widget) to be packed.
+ * Parameters:
+ *       text: The text to be display by the static text widget.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       A handle to a button window or NULL on failure.
+ */
+HWND API dw_button_new(const char *text, ULONG cid)
+{
+    return (HWND)_dw_widget_new(_DW_WIDGET_BUTTON, text, cid);
+}
+
+/*
+ * Create a new Entryfield window (widget) to be packed.
+ * Parameters:
+ *       text: The default text to be in the entryfield widget.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       A handle to an entryfield window or NULL on failure.
+ */
+HWND API dw_entryfield_new(const char *text, ULONG cid)
+{
+    return (HWND)_dw_widget_new(_DW_WIDGET_ENTRYFIELD, text, cid);
+}
+
+/*
+ * Create a new Entryfield (password) window (widget) to be packed.
+ * Parameters:
+ *       text: The default text to be in the entryfield widget.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       A handle to an entryfield password window or NULL on failure.
+ */
+HWND API dw_entryfield_password_new(const char *text, ULONG cid)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_ENTRYFIELD, text, cid);
+
+    if(widget)
+        widget->style = TRUE;
+    return (HWND)widget;
+}
+
+/*
+ * Sets the entryfield character limit.
+ * Parameters:
+ *          handle: Handle to the spinbutton to be set.
+ *          limit: Number of characters the entryfield will take.
+ */
+void API dw_entryfield_set_limit(HWND handle, ULONG limit)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_ENTRYFIELD)
+        widget->range = (long)limit;
+}
+
+/*
+ * Create a new bitmap button window (widget) to be packed.
+ * Parameters:
+ *       text: Bubble help text to be displayed.
+ *       id: An ID of a bitmap in the resource file.
+ * Returns:
+ *       A handle to a bitmap button window or NULL on failure.
+ */
+HWND API dw_bitmapbutton_new(const char *text, ULONG resid)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_BUTTON, NULL, resid);
+
+    /* The text is used as the bubble help on bitmap buttons */
+    if(widget)
+    {
+        widget->tooltip = text ? strdup(text) : NULL;
+        widget->icon = dw_icon_load(0, resid);
+    }
+    return (HWND)widget;
+}
+
+/*
+ * Create a new bitmap button window (widget) to be packed from a file.
+ * Parameters:
+ *       text: Bubble help text to be displayed.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ *       filename: Name of the file, omit extention to have
+ *                 DW pick the appropriate file extension.
+ *                 (BMP on OS/2 or Windows, XPM on Unix)
+ * Returns:
+ *       A handle to a bitmap button window or NULL on failure.
+ */
+HWND API dw_bitmapbutton_new_from_file(const char *text, unsigned long cid, const char *filename)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_BUTTON, NULL, cid);
+
+    if(widget)
+    {
+        widget->tooltip = text ? strdup(text) : NULL;
+        widget->icon = dw_icon_load_from_file(filename);
+    }
+    return (HWND)widget;
+}
+
+/*
+ * Create a new bitmap button window (widget) to be packed from data.
+ * Parameters:
+ *       text: Bubble help text to be displayed.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ *       data: The contents of the image
+ *            (BMP or ICO on OS/2 or Windows, XPM on Unix)
+ *       len: length of str
+ * Returns:
+ *       A handle to a bitmap button window or NULL on failure.
+ */
+HWND API dw_bitmapbutton_new_from_data(const char *text, unsigned long cid, const char *data, int len)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_BUTTON, NULL, cid);
+
+    if(widget)
+    {
+        widget->tooltip = text ? strdup(text) : NULL;
+        widget->icon = dw_icon_load_from_data(data, len);
+    }
+    return (HWND)widget;
+}
+
+/*
+ * Create a new spinbutton window (widget) to be packed.
+ * Parameters:
+ *       text: The text to be display by the static text widget.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       A handle to a spinbutton window or NULL on failure.
+ */
+HWND API dw_spinbutton_new(const char *text, ULONG cid)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_SPINBUTTON, text, cid);
+
+    if(widget)
+    {
+        widget->value = text ? atol(text) : 0;
+        widget->lower = -65536;
+        widget->upper = 65536;
+    }
+    return (HWND)widget;
+}
+
+/*
+ * Sets the spinbutton value.
+ * Parameters:
+ *          handle: Handle to the spinbutton to be set.
+ *          position: Current value of the spinbutton.
+ */
+void API dw_spinbutton_set_pos(HWND handle, long position)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_SPINBUTTON)
+    {
+        char buf[30];
+
+        if(position < widget->lower)
+            position = widget->lower;
+        if(position > widget->upper)
+            position = widget->upper;
+        snprintf(buf, sizeof(buf), "%ld", position);
+        free(widget->text);
+        widget->text = strdup(buf);
+        if(widget->value != position)
+        {
+            widget->value = position;
+            _dw_emit_int(widget, DW_SIGNAL_VALUE_CHANGED, (int)position);
+        }
+    }
+}
+
+/*
+ * Sets the spinbutton limits.
+ * Parameters:
+ *          handle: Handle to the spinbutton to be set.
+ *          upper: Upper limit.
+ *          lower: Lower limit.
+ */
+void API dw_spinbutton_set_limits(HWND handle, long upper, long lower)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_SPINBUTTON)
+    {
+        widget->upper = upper;
+        widget->lower = lower;
+        if(widget->value > upper || widget->value < lower)
+            dw_spinbutton_set_pos(handle, widget->value > upper ? upper : lower);
+    }
+}
+
+/*
+ * Returns the current value of the spinbutton.
+ * Parameters:
+ *          handle: Handle to the spinbutton to be queried.
+ * Returns:
+ *       Number value displayed in the spinbutton.
+ */
+long API dw_spinbutton_get_pos(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_SPINBUTTON)
+        return widget->value;
+    return 0;
+}
+
+/*
+ * Create a new radiobutton window (widget) to be packed.
+ * Parameters:
+ *       text: The text to be display by the static text widget.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       A handle to a radio button window or NULL on failure.
+ */
+HWND API dw_radiobutton_new(const char *text, ULONG cid)
+{
+    return (HWND)_dw_widget_new(_DW_WIDGET_RADIOBUTTON, text, cid);
+}
+
+/*
+ * Create a new slider window (widget) to be packed.
+ * Parameters:
+ *       vertical: TRUE or FALSE if slider is vertical.
+ *       increments: Number of increments available.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       A handle to a slider window or NULL on failure.
+ */
+HWND API dw_slider_new(int vertical, int increments, ULONG cid)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_SLIDER, NULL, cid);
+
+    if(widget)
+    {
+        widget->style = vertical;
+        widget->range = increments > 0 ? increments : 1;
+    }
+    return (HWND)widget;
+}
+
+/*
+ * Returns the position of the slider.
+ * Parameters:
+ *          handle: Handle to the slider to be queried.
+ * Returns:
+ *       Position of the slider in the set range.
+ */
+unsigned int API dw_slider_get_pos(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_SLIDER)
+        return (unsigned int)widget->value;
+    return 0;
+}
+
+/*
+ * Sets the slider position.
+ * Parameters:
+ *          handle: Handle to the slider to be set.
+ *          position: Position of the slider withing the range.
+ */
+void API dw_slider_set_pos(HWND handle, unsigned int position)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_SLIDER)
+    {
+        if(position >= (unsigned int)widget->range)
+            position = (unsigned int)widget->range - 1;
+        if(widget->value != (long)position)
+        {
+            widget->value = (long)position;
+            _dw_emit_int(widget, DW_SIGNAL_VALUE_CHANGED, (int)position);
+        }
+    }
+}
+
+/*
+ * Create a new scrollbar window (widget) to be packed.
+ * Parameters:
+ *       vertical: TRUE or FALSE if scrollbar is vertical.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       A handle to a scrollbar window or NULL on failure.
+ */
+HWND API dw_scrollbar_new(int vertical, ULONG cid)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_SCROLLBAR, NULL, cid);
+
+    if(widget)
+        widget->style = vertical;
+    return (HWND)widget;
+}
+
+/*
+ * Returns the position of the scrollbar.
+ * Parameters:
+ *          handle: Handle to the scrollbar to be queried.
+ * Returns:
+ *       Position of the scrollbar in the set range.
+ */
+unsigned int API dw_scrollbar_get_pos(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_SCROLLBAR)
+        return (unsigned int)widget->value;
+    return 0;
+}
+
+/*
+ * Sets the scrollbar position.
+ * Parameters:
+ *          handle: Handle to the scrollbar to be set.
+ *          position: Position of the scrollbar withing the range.
+ */
+void API dw_scrollbar_set_pos(HWND handle, unsigned int position)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_SCROLLBAR)
+    {
+        long maximum = widget->range - widget->upper;
+
+        if((long)position > maximum)
+            position = maximum > 0 ? (unsigned int)maximum : 0;
+        if(widget->value != (long)position)
+        {
+            widget->value = (long)position;
+            _dw_emit_int(widget, DW_SIGNAL_VALUE_CHANGED, (int)position);
+        }
+    }
+}
+
+/*
+ * Sets the scrollbar range.
+ * Parameters:
+ *          handle: Handle to the scrollbar to be set.
+ *          range: Maximum range value.
+ *          visible: Visible area relative to the range.
+ */
+void API dw_scrollbar_set_range(HWND handle, unsigned int range, unsigned int visible)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    /* The visible portion is kept in upper */
+    if(widget && widget->type == _DW_WIDGET_SCROLLBAR)
+    {
+        widget->range = (long)range;
+        widget->upper = (long)visible;
+        dw_scrollbar_set_pos(handle, (unsigned int)widget->value);
+    }
+}
+
+/*
+ * Create a new percent bar window (widget) to be packed.
+ * Parameters:
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       A handle to a percent bar window or NULL on failure.
+ */
+HWND API dw_percent_new(ULONG cid)
+{
+    return (HWND)_dw_widget_new(_DW_WIDGET_PERCENT, NULL, cid);
+}
+
+/*
+ * Sets the percent bar position.
+ * Parameters:
+ *          handle: Handle to the percent bar to be set.
+ *          position: Position of the percent bar withing the range.
+ */
+void API dw_percent_set_pos(HWND handle, unsigned int position)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_PERCENT)
+    {
+        if(position != DW_PERCENT_INDETERMINATE && position > 100)
+            position = 100;
+        widget->value = (long)position;
+    }
+}
+
+/*
+ * Create a new checkbox window (widget) to be packed.
+ * Parameters:
+ *       text: The text to be display by the static text widget.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       A handle to a checkbox window or NULL on failure.
+ */
+HWND API dw_checkbox_new(const char *text, ULONG cid)
+{
+    return (HWND)_dw_widget_new(_DW_WIDGET_CHECKBOX, text, cid);
+}
+
+/*
+ * Returns the state of the checkbox.
+ * Parameters:
+ *          handle: Handle to the checkbox to be queried.
+ * Returns:
+ *       State of checkbox (TRUE or FALSE).
+ */
+int API dw_checkbox_get(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && (widget->type == _DW_WIDGET_CHECKBOX || widget->type == _DW_WIDGET_RADIOBUTTON))
+        return widget->value ? TRUE : FALSE;
+    return FALSE;
+}
+
+/*
+ * Sets the state of the checkbox.
+ * Parameters:
+ *          handle: Handle to the checkbox to be queried.
+ *          value: TRUE for checked, FALSE for unchecked.
+ */
+void API dw_checkbox_set(HWND handle, int value)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && (widget->type == _DW_WIDGET_CHECKBOX || widget->type == _DW_WIDGET_RADIOBUTTON))
+    {
+        value = value ? TRUE : FALSE;
+
+        /* Radio buttons packed in the same box form a group */
+        if(value && widget->type == _DW_WIDGET_RADIOBUTTON && widget->parent && widget->parent->box)
+        {
+            Box *thisbox = widget->parent->box;
+            int z;
+
+            for(z=0;z<thisbox->count;z++)
+            {
+                DWWidget *item = (DWWidget *)thisbox->items[z].hwnd;
+
+                if(item && item != widget && item->type == _DW_WIDGET_RADIOBUTTON)
+                    item->value = FALSE;
+            }
+        }
+        if(widget->value != value)
+        {
+            widget->value = value;
+            _dw_emit(widget, DW_SIGNAL_CLICKED);
+        }
+    }
+}
+
+/*
+ * Create a new listbox window (widget) to be packed.
+ * Parameters:
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ *       multi: Multiple select TRUE or FALSE.
+ * Returns:
+ *       A handle to a listbox window or NULL on failure.
+ */
+HWND API dw_listbox_new(ULONG cid, int multi)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_LISTBOX, NULL, cid);
+
+    if(widget)
+    {
+        widget->style = multi;
+        if(!(widget->model = calloc(1, sizeof(DWListModel))))
+        {
+            free(widget->text);
+            free(widget);
+            return 0;
+        }
+    }
+    return (HWND)widget;
+}
+
+/*
+ * Appends the specified text to the listbox's (or combobox) entry list.
+ * Parameters:
+ *          handle: Handle to the listbox to be appended to.
+ *          text: Text to append into listbox.
+ */
+void API dw_listbox_append(HWND handle, const char *text)
+{
+    DWListModel *list = _dw_list_model(handle);
+
+    if(list)
+        _dw_list_insert(list, text, list->count);
+}
+
+/*
+ * Inserts the specified text into the listbox's (or combobox) entry list.
+ * Parameters:
+ *          handle: Handle to the listbox to be inserted into.
+ *          text: Text to insert into listbox.
+ *          pos: 0-based position to insert text
+ */
+void API dw_listbox_insert(HWND handle, const char *text, int pos)
+{
+    DWListModel *list = _dw_list_model(handle);
+
+    if(list)
+        _dw_list_insert(list, text, pos);
+}
+
+/*
+ * Appends the specified text items to the listbox's (or combobox) entry list.
+ * Parameters:
+ *          handle: Handle to the listbox to be appended to.
+ *          text: Text strings to append into listbox.
+ *          count: Number of text strings to append
+ */
+void API dw_listbox_list_append(HWND handle, char **text, int count)
+{
+    DWListModel *list = _dw_list_model(handle);
+    int z;
+
+    if(list && text && count > 0 && _dw_list_grow(list, count))
+    {
+        for(z=0;z<count;z++)
+            _dw_list_insert(list, text[z], list->count);
+    }
+}
+
+/*
+ * Makes a listbox or combobox virtual, the application supplies the
+ * text of each entry on demand instead of appending it.  Functions
+ * that add, change or delete single entries are ignored on virtual
+ * lists, call this again when the number of entries changes.
+ * Parameters:
+ *          handle: Handle to the listbox to be made virtual.
+ *          count: Number of entries in the list.
+ *          textfunc: Function returning the text of an entry, with the
+ *                    prototype char *textfunc(HWND handle, int index, void *data).
+ *                    The text only needs to remain valid until the next
+ *                    call.  NULL returns the list to normal with no entries.
+ *          data: Pointer passed to the text function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_listbox_set_virtual(HWND handle, int count, void *textfunc, void *data)
+{
+    DWListModel *list = _dw_list_model(handle);
+    char *selected = NULL;
+
+    if(!list || count < 0 || (textfunc && count && !(selected = calloc(1, count))))
+        return DW_ERROR_GENERAL;
+
+    dw_listbox_clear(handle);
+    free(list->items);
+    free(list->selected);
+    list->items = NULL;
+    list->selected = selected;
+    list->alloc = 0;
+    list->textfunc = (char *(*)(HWND, int, void *))textfunc;
+    list->data = data;
+    list->count = textfunc ? count : 0;
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Stops the listbox from updating while many items are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the listbox to freeze.
+ */
+void API dw_listbox_freeze(HWND handle)
+{
+}
+
+/*
+ * Resumes updating of a frozen listbox, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the listbox to thaw.
+ */
+void API dw_listbox_thaw(HWND handle)
+{
+}
+
+/*
+ * Clears the listbox's (or combobox) list of all entries.
+ * Parameters:
+ *          handle: Handle to the listbox to be cleared.
+ */
+void API dw_listbox_clear(HWND handle)
+{
+    DWListModel *list = _dw_list_model(handle);
+    int z;
+
+    if(list)
+    {
+        for(z=0;!list->textfunc && z<list->count;z++)
+            free(list->items[z]);
+        list->count = 0;
+    }
+}
+
+/*
+ * Returns the listbox's item count.
+ * Parameters:
+ *          handle: Handle to the listbox to be counted.
+ * Returns:
+ *       The number of items in the listbox.
+ */
+int API dw_listbox_count(HWND handle)
+{
+    DWListModel *list = _dw_list_model(handle);
+
+    return list ? list->count : 0;
+}
+
+/*
+ * Sets the topmost item in the viewport.
+ * Parameters:
+ *          handle: Handle to the listbox to be cleared.
+ *          top: Index to the top item.
+ */
+void API dw_listbox_set_top(HWND handle, int top)
+{
+    DWListModel *list = _dw_list_model(handle);
+
+    if(list && top >= 0 && top < list->count)
+        ((DWWidget *)handle)->lower = top;
+}
+
+/*
+ * Copies the given index item's text into buffer.
+ * Parameters:
+ *          handle: Handle to the listbox to be queried.
+ *          index: Index into the list to be queried.
+ *          buffer: Buffer where text will be copied.
+ *          length: Length of the buffer (including NULL).
+ */
+void API dw_listbox_get_text(HWND handle, unsigned int index, char *buffer, unsigned int length)
+{
+    DWListModel *list = _dw_list_model(handle);
+
+    if(buffer && length)
+    {
+        buffer[0] = '\0';
+        if(list && index < (unsigned int)list->count)
+        {
+            strncpy(buffer, _dw_list_text(handle, list, (int)index), length - 1);
+            buffer[length - 1] = '\0';
+        }
+    }
+}
+
+/*
+ * Sets the text of a given listbox entry.
+ * Parameters:
+ *          handle: Handle to the listbox to be queried.
+ *          index: Index into the list to be queried.
+ *          buffer: Buffer where text will be copied.
+ */
+void API dw_listbox_set_text(HWND handle, unsigned int index, const char *buffer)
+{
+    DWListModel *list = _dw_list_model(handle);
+
+    if(list && !list->textfunc && index < (unsigned int)list->count)
+    {
+        free(list->items[index]);
+        list->items[index] = strdup(buffer ? buffer : "");
+    }
+}
+
+/*
+ * Returns the index to the item in the list currently selected.
+ * Parameters:
+ *          handle: Handle to the listbox to be queried.
+ * Returns:
+ *       The selected item index or DW_ERROR_UNKNOWN (-1) on error.
+ */
+int API dw_listbox_selected(HWND handle)
+{
+    DWListModel *list = _dw_list_model(handle);
+    int z;
+
+    if(list)
+    {
+        for(z=0;z<list->count;z++)
+        {
+            if(list->selected[z])
+                return z;
+        }
+    }
+    return DW_LIT_NONE;
+}
+
+/*
+ * Returns the index to the current selected item or -1 when done.
+ * Parameters:
+ *          handle: Handle to the listbox to be queried.
+ *          where: Either the previous return or -1 to restart.
+ * Returns:
+ *       The next selected item or DW_ERROR_UNKNOWN (-1) on error.
+ */
+int API dw_listbox_selected_multi(HWND handle, int where)
+{
+    DWListModel *list = _dw_list_model(handle);
+    int z;
+
+    if(list)
+    {
+        for(z=where+1;z<list->count;z++)
+        {
+            if(z >= 0 && list->selected[z])
+                return z;
+        }
+    }
+    return DW_LIT_NONE;
+}
+
+/*
+ * Sets the selection state of a given index.
+ * Parameters:
+ *          handle: Handle to the listbox to be set.
+ *          index: Item index.
+ *          state: TRUE if selected FALSE if unselected.
+ */
+void API dw_listbox_select(HWND handle, int index, int state)
+{
+    DWWidget *widget = (DWWidget *)handle;
+    DWListModel *list = _dw_list_model(handle);
+
+    if(list && index >= 0 && index < list->count)
+    {
+        /* Single selection lists and comboboxes only have one selected item */
+        if(state && !(widget->type == _DW_WIDGET_LISTBOX && widget->style))
+            memset(list->selected, 0, list->count);
+        list->selected[index] = state ? TRUE : FALSE;
+        if(state && widget->type == _DW_WIDGET_COMBOBOX)
+        {
+            free(widget->text);
+            widget->text = strdup(_dw_list_text(handle, list, index));
+        }
+        if(state)
+            _dw_emit_int(widget, DW_SIGNAL_LIST_SELECT, index);
+    }
+}
+
+/*
+ * Deletes the item with given index from the list.
+ * Parameters:
+ *          handle: Handle to the listbox to be set.
+ *          index: Item index.
+ */
+void API dw_listbox_delete(HWND handle, int index)
+{
+    DWListModel *list = _dw_list_model(handle);
+
+    if(list && !list->textfunc && index >= 0 && index < list->count)
+    {
+        free(list->items[index]);
+        list->count--;
+        memmove(&list->items[index], &list->items[index+1], sizeof(char *) * (list->count - index));
+        memmove(&list->selected[index], &list->selected[index+1], list->count - index);
+    }
+}
+
+/*
+ * Create a new Combobox window (widget) to be packed.
+ * Parameters:
+ *       text: The default text to be in the combpbox widget.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       A handle to a combobox window or NULL on failure.
+ */
+HWND API dw_combobox_new(const char *text, ULONG cid)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_COMBOBOX, text, cid);
+
+    if(widget && !(widget->model = calloc(1, sizeof(DWListModel))))
+    {
+        free(widget->text);
+        free(widget);
+        return 0;
+    }
+    return (HWND)widget;
+}
+
+/*
+ * Create a new Multiline Editbox window (widget) to be packed.
+ * Parameters:
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       A handle to a MLE window or NULL on failure.
+ */
+HWND API dw_mle_new(ULONG cid)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_MLE, NULL, cid);
+
+    /* MLEs start out editable */
+    if(widget)
+        widget->style = TRUE;
+    return (HWND)widget;
+}
+
+/*
+ * Adds text to an MLE box and returns the current point.
+ * Parameters:
+ *          handle: Handle to the MLE to be queried.
+ *          buffer: Text buffer to be imported.
+ *          startpoint: Point to start entering text.
+ * Returns:
+ *       Current position in the buffer.
+ */
+unsigned int API dw_mle_import(HWND handle, const char *buffer, int startpoint)
+{
+    DWWidget *widget = _dw_mle(handle);
+    int len, importlen;
+    char *text;
+
+    if(!widget || !buffer)
+        return startpoint;
+
+    len = (int)strlen(widget->text);
+    importlen = (int)strlen(buffer);
+    if(startpoint < 0 || startpoint > len)
+        startpoint = len;
+    if(!(text = malloc(len + importlen + 1)))
+        return startpoint;
+    memcpy(text, widget->text, startpoint);
+    memcpy(&text[startpoint], buffer, importlen);
+    memcpy(&text[startpoint + importlen], &widget->text[startpoint], len - startpoint + 1);
+    free(widget->text);
+    widget->text = text;
+    return startpoint + importlen;
+}
+
+/*
+ * Grabs text from an MLE box.
+ * Parameters:
+ *          handle: Handle to the MLE to be queried.
+ *          buffer: Text buffer to be exported.
+ *          startpoint: Point to start grabbing text.
+ *          length: Amount of text to be grabbed.
+ */
+void API dw_mle_export(HWND handle, char *buffer, int startpoint, int length)
+{
+    DWWidget *widget = _dw_mle(handle);
+
+    if(widget && buffer && length > 0)
+    {
+        int len = (int)strlen(widget->text);
+
+        if(startpoint < 0)
+            startpoint = 0;
+        if(startpoint > len)
+            startpoint = len;
+        strncpy(buffer, &widget->text[startpoint], length);
+    }
+}
+
+#define _DW_MLE_CHUNK 65536
+
+/*
+ * Appends text to an MLE box in chunks read by a callback, so large
+ * files do not need to be loaded into memory first.  The callback is
+ * called while the MLE is being updated, so it must not use the MLE.
+ * Parameters:
+ *          handle: Handle to the MLE to be inserted into.
+ *          readfunc: Function that fills in the next chunk of UTF-8 text,
+ *                    with the prototype int readfunc(HWND handle, char *buffer, int length, void *data).
+ *                    It returns the number of bytes read, 0 at the end or -1 on error.
+ *          data: Pointer passed to the read function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_mle_import_stream(HWND handle, void *readfunc, void *data)
+{
+    DWWidget *widget = _dw_mle(handle);
+    int (*func)(HWND, char *, int, void *) = (int (*)(HWND, char *, int, void *))readfunc;
+    size_t len, alloc;
+    char *text;
+    int length;
+
+    if(!widget || !func)
+        return DW_ERROR_GENERAL;
+
+    /* Read straight into the text, doubling the allocation as it grows */
+    len = strlen(widget->text);
+    alloc = len + _DW_MLE_CHUNK + 1;
+    if(!(text = realloc(widget->text, alloc)))
+        return DW_ERROR_NO_MEM;
+    widget->text = text;
+    for(;;)
+    {
+        if(alloc - len < _DW_MLE_CHUNK + 1)
+        {
+            if(!(text = realloc(widget->text, alloc * 2)))
+                return DW_ERROR_NO_MEM;
+            widget->text = text;
+            alloc *= 2;
+        }
+        if((length = func(handle, &widget->text[len], _DW_MLE_CHUNK, data)) <= 0)
+            break;
+        len += length;
+        widget->text[len] = '\0';
+    }
+    widget->text[len] = '\0';
+    if((text = realloc(widget->text, len + 1)))
+        widget->text = text;
+    return length < 0 ? DW_ERROR_GENERAL : DW_ERROR_NONE;
+}
+
+/*
+ * Passes the text of an MLE box to a callback in chunks, so large
+ * contents do not need a buffer big enough for all the text.
+ * Parameters:
+ *          handle: Handle to the MLE to be queried.
+ *          writefunc: Function that receives each chunk of UTF-8 text,
+ *                     with the prototype int writefunc(HWND handle, const char *buffer, int length, void *data).
+ *                     It returns the number of bytes written, less than length stops the export.
+ *          data: Pointer passed to the write function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_mle_export_stream(HWND handle, void *writefunc, void *data)
+{
+    DWWidget *widget = _dw_mle(handle);
+    int (*func)(HWND, const char *, int, void *) = (int (*)(HWND, const char *, int, void *))writefunc;
+    size_t len, pos;
+
+    if(!widget || !func)
+        return DW_ERROR_GENERAL;
+
+    len = strlen(widget->text);
+    for(pos=0;pos<len;)
+    {
+        int length = (int)(len - pos > _DW_MLE_CHUNK ? _DW_MLE_CHUNK : len - pos);
+
+        /* Keep characters whole, chunks end before a continuation byte */
+        while(length > 1 && pos + length < len && (widget->text[pos + length] & 0xC0) == 0x80)
+            length--;
+        if(func(handle, &widget->text[pos], length, data) < length)
+            return DW_ERROR_GENERAL;
+        pos += length;
+    }
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Obtains information about an MLE box.
+ * Parameters:
+ *          handle: Handle to the MLE to be queried.
+ *          bytes: A pointer to a variable to return the total bytes.
+ *          lines: A pointer to a variable to return the number of lines.
+ */
+void API dw_mle_get_size(HWND handle, unsigned long *bytes, unsigned long *lines)
+{
+    DWWidget *widget = _dw_mle(handle);
+    unsigned long count = 0, linecount = 1;
+
+    if(widget)
+    {
+        char *text = widget->text;
+
+        for(;text[count];count++)
+        {
+            if(text[count] == '\n')
+                linecount++;
+        }
+    }
+    if(bytes)
+        *bytes = count;
+    if(lines)
+        *lines = widget ? linecount : 0;
+}
+
+/*
+ * Deletes text from an MLE box.
+ * Parameters:
+ *          handle: Handle to the MLE to be deleted from.
+ *          startpoint: Point to start deleting text.
+ *          length: Amount of text to be deleted.
+ */
+void API dw_mle_delete(HWND handle, int startpoint, int length)
+{
+    DWWidget *widget = _dw_mle(handle);
+
+    if(widget && length > 0)
+    {
+        int len = (int)strlen(widget->text);
+
+        if(startpoint < 0)
+            startpoint = 0;
+        if(startpoint < len)
+        {
+            if(startpoint + length > len)
+                length = len - startpoint;
+            memmove(&widget->text[startpoint], &widget->text[startpoint + length], len - startpoint - length + 1);
+        }
+    }
+}
+
+/*
+ * Clears all text from an MLE box.
+ * Parameters:
+ *          handle: Handle to the MLE to be cleared.
+ */
+void API dw_mle_clear(HWND handle)
+{
+    DWWidget *widget = _dw_mle(handle);
+
+    if(widget)
+        widget->text[0] = '\0';
+}
+
+/*
+ * Sets the visible line of an MLE box.
+ * Parameters:
+ *          handle: Handle to the MLE to be positioned.
+ *          line: Line to be visible.
+ */
+void API dw_mle_set_visible(HWND handle, int line)
+{
+    DWWidget *widget = _dw_mle(handle);
+
+    if(widget)
+        widget->lower = line;
+}
+
+/*
+ * Sets the editablity of an MLE box.
+ * Parameters:
+ *          handle: Handle to the MLE.
+ *          state: TRUE if it can be edited, FALSE for readonly.
+ */
+void API dw_mle_set_editable(HWND handle, int state)
+{
+    DWWidget *widget = _dw_mle(handle);
+
+    if(widget)
+        widget->style = state;
+}
+
+/*
+ * Sets the word wrap state of an MLE box.
+ * Parameters:
+ *          handle: Handle to the MLE.
+ *          state: TRUE if it wraps, FALSE if it doesn't.
+ */
+void API dw_mle_set_word_wrap(HWND handle, int state)
+{
+    DWWidget *widget = _dw_mle(handle);
+
+    if(widget)
+        widget->range = state;
+}
+
+/*
+ * Sets the current cursor position of an MLE box.
+ * Parameters:
+ *          handle: Handle to the MLE to be positioned.
+ *          point: Point to position cursor.
+ */
+void API dw_mle_set_cursor(HWND handle, int point)
+{
+    DWWidget *widget = _dw_mle(handle);
+
+    if(widget)
+    {
+        int len = (int)strlen(widget->text);
+
+        widget->value = (point < 0 || point > len) ? len : point;
+    }
+}
+
+/*
+ * Sets the word auto complete state of an MLE box.
+ * Parameters:
+ *          handle: Handle to the MLE.
+ *          state: Bitwise combination of DW_MLE_COMPLETE_TEXT/DASH/QUOTE
+ */
+void API dw_mle_set_auto_complete(HWND handle, int state)
+{
+}
+
+/*
+ * Finds text in an MLE box.
+ * Parameters:
+ *          handle: Handle to the MLE to be cleared.
+ *          text: Text to search for.
+ *          point: Start point of search.
+ *          flags: Search specific flags.
+ * Returns:
+ *       Position in buffer or DW_ERROR_UNKNOWN (-1) on error.
+ */
+int API dw_mle_search(HWND handle, const char *text, int point, unsigned long flags)
+{
+    DWWidget *widget = _dw_mle(handle);
+    int len, textlen, z;
+
+    if(!widget || !text || !(textlen = (int)strlen(text)))
+        return 0;
+
+    len = (int)strlen(widget->text);
+    for(z=(point > 0 ? point : 0);z + textlen <= len;z++)
+    {
+        if((flags & DW_MLE_CASESENSITIVE) ? !strncmp(&widget->text[z], text, textlen) :
+                                            !strncasecmp(&widget->text[z], text, textlen))
+        {
+            widget->value = z + textlen;
+            return z + textlen;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Stops redrawing of an MLE box.
+ * Parameters:
+ *          handle: Handle to the MLE to freeze.
+ */
+void API dw_mle_freeze(HWND handle)
+{
+}
+
+/*
+ * Resumes redrawing of an MLE box.
+ * Parameters:
+ *          handle: Handle to the MLE to thaw.
+ */
+void API dw_mle_thaw(HWND handle)
+{
+}
+
+/*
+ * Create a new status text window (widget) to be packed.
+ * Parameters:
+ *       text: The text to be display by the static text widget.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       A handle to a status text window or NULL on failure.
+ */
+HWND API dw_status_text_new(const char *text, ULONG cid)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_TEXT, text, cid);
+
+    if(widget)
+        widget->style = TRUE;
+    return (HWND)widget;
+}
+
+/*
+ * Create a new static text window (widget) to be packed.
+ * Parameters:
+ *       text: The text to be display by the static text widget.
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       A handle to a text window or NULL on failure.
+ */
+HWND API dw_text_new(const char *text, ULONG cid)
+{
+    return (HWND)_dw_widget_new(_DW_WIDGET_TEXT, text, cid);
+}
+
+/*
+ * Creates a rendering context widget (window) to be packed.
+ * Parameters:
+ *       id: An id to be used with dw_window_from_id.
+ * Returns:
+ *       A handle to the widget or NULL on failure.
+ */
+HWND API dw_render_new(unsigned long cid)
+{
+    return (HWND)_dw_widget_new(_DW_WIDGET_RENDER, NULL, cid);
+}
+
+/*
+ * Invalidate the render widget triggering an expose event.
+ * Parameters:
+ *       handle: A handle to a render widget to be redrawn.
+ */
+void API dw_render_redraw(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    /* Multiple requests before the loop runs result in one expose */
+    if(widget && widget->type == _DW_WIDGET_RENDER && !widget->dirty)
+    {
+        widget->dirty = TRUE;
+        _dw_queue_call(widget, _dw_render_expose, NULL);
+    }
+}
+
+/* Sets the current foreground drawing color.
+ * Parameters:
+ *       red: red value.
+ *       green: green value.
+ *       blue: blue value.
+ */
+void API dw_color_foreground_set(unsigned long value)
+{
+    _dw_fg_color = value;
+}
+
+/* Sets the current background drawing color.
+ * Parameters:
+ *       red: red value.
+ *       green: green value.
+ *       blue: blue value.
+ */
+void API dw_color_background_set(unsigned long value)
+{
+    _dw_bg_color = value;
+}
+
+/* Allows the user to choose a color using the system's color chooser dialog.
+ * Parameters:
+ *       value: current color
+ * Returns:
+ *       The selected color or the current color if cancelled.
+ */
+unsigned long API dw_color_choose(unsigned long value)
+{
+    return value;
+}
+
+/* Draw a point on a window (preferably a render window).
+ * Parameters:
+ *       handle: Handle to the window.
+ *       pixmap: Handle to the pixmap. (choose only one of these)
+ *       x: X coordinate.
+ *       y: Y coordinate.
+ */
+void API dw_draw_point(HWND handle, HPIXMAP pixmap, int x, int y)
+{
+    HPIXMAP target = _dw_draw_target(handle, pixmap);
+
+    if(target)
+        _dw_draw_pixel(target, x, y, _dw_argb(_dw_fg_color, 0xFF000000));
+}
+
+/* Draw a line on a window (preferably a render window).
+ * Parameters:
+ *       handle: Handle to the window.
+ *       pixmap: Handle to the pixmap. (choose only one of these)
+ *       x1: First X coordinate.
+ *       y1: First Y coordinate.
+ *       x2: Second X coordinate.
+ *       y2: Second Y coordinate.
+ */
+void API dw_draw_line(HWND handle, HPIXMAP pixmap, int x1, int y1, int x2, int y2)
+{
+    HPIXMAP target = _dw_draw_target(handle, pixmap);
+
+    if(target)
+        _dw_draw_segment(target, x1, y1, x2, y2, _dw_argb(_dw_fg_color, 0xFF000000));
+}
+
+/* Draw text on a window (preferably a render window).
+ * Parameters:
+ *       handle: Handle to the window.
+ *       pixmap: Handle to the pixmap. (choose only one of these)
+ *       x: X coordinate.
+ *       y: Y coordinate.
+ *       text: Text to be displayed.
+ */
+void API dw_draw_text(HWND handle, HPIXMAP pixmap, int x, int y, const char *text)
+{
+    HPIXMAP target = _dw_draw_target(handle, pixmap);
+
+    if(target && text)
+    {
+        char *fontname = pixmap ? pixmap->font : (handle ? ((DWWidget *)handle)->font : NULL);
+        unsigned int color = _dw_argb(_dw_fg_color, 0xFF000000);
+        int size = _dw_font_size(fontname), cellwidth, cellheight;
+
+        _dw_text_size(fontname, "M", &cellwidth, &cellheight);
+
+        if(_dw_bg_color != DW_CLR_DEFAULT)
+        {
+            int width;
+
+            _dw_text_size(fontname, text, &width, NULL);
+            _dw_fill_rect(target, x, y, width, cellheight, _dw_argb(_dw_bg_color, 0xFFFFFFFF));
+        }
+        /* There are no glyphs, each visible character is drawn as a
+         * block so the amount of work scales with the text.
+         */
+        for(;*text;text++)
+        {
+            if((*text & 0xC0) == 0x80)
+                continue;
+            if(*text != ' ')
+                _dw_fill_rect(target, x + 1, y + (size / 4), cellwidth - 2, cellheight - (size / 2), color);
+            x += cellwidth;
+        }
+    }
+}
+
+/* Query the width and height of a text string.
+ * Parameters:
+ *       handle: Handle to the window.
+ *       pixmap: Handle to the pixmap. (choose only one of these)
+ *       text: Text to be queried.
+ *       width: Pointer to a variable to be filled in with the width.
+ *       height: Pointer to a variable to be filled in with the height.
+ */
+void API dw_font_text_extents_get(HWND handle, HPIXMAP pixmap, const char *text, int *width, int *height)
+{
+    char *fontname = pixmap ? pixmap->font : (handle ? ((DWWidget *)handle)->font : NULL);
+
+    _dw_text_size(fontname, text, width, height);
+}
+
+/* Query the width and height of multiple text strings at once.
+ * Parameters:
+ *       handle: Handle to the window.
+ *       pixmap: Handle to the pixmap. (choose only one of these)
+ *       count: Number of strings in the texts array.
+ *       texts: Array of text strings to be queried, NULL entries
+ *              get a width and height of 0.
+ *       widths: Array of count integers to be filled in with the widths, or NULL.
+ *       heights: Array of count integers to be filled in with the heights, or NULL.
+ */
+void API dw_font_text_extents_get_many(HWND handle, HPIXMAP pixmap, int count, char **texts, int *widths, int *heights)
+{
+    int z;
+
+    for(z=0;texts && z<count;z++)
+    {
+        if(texts[z])
+            dw_font_text_extents_get(handle, pixmap, texts[z], widths ? &widths[z] : NULL, heights ? &heights[z] : NULL);
+        else
+        {
+            if(widths)
+                widths[z] = 0;
+            if(heights)
+                heights[z] = 0;
+        }
+    }
+}
+
+/* Draw a polygon on a window (preferably a render window).
+ * Parameters:
+ *       handle: Handle to the window.
+ *       pixmap: Handle to the pixmap. (choose only one of these)
+ *       flags: DW_DRAW_FILL (1) to fill the polygon or DW_DRAW_DEFAULT (0).
+ *       npoints: Number of points passed in.
+ *       x: Pointer to array of X coordinates.
+ *       y: Pointer to array of Y coordinates.
+ */
+void API dw_draw_polygon( HWND handle, HPIXMAP pixmap, int flags, int npoints, int *x, int *y )
+{
+    HPIXMAP target = _dw_draw_target(handle, pixmap);
+
+    if(target && npoints > 1 && x && y)
+        _dw_draw_shape(target, flags & DW_DRAW_FILL, TRUE, npoints, x, y, _dw_argb(_dw_fg_color, 0xFF000000));
+}
+
+/* Draw a rectangle on a window (preferably a render window).
+ * Parameters:
+ *       handle: Handle to the window.
+ *       pixmap: Handle to the pixmap. (choose only one of these)
+ *       flags: DW_DRAW_FILL (1) to fill the box or DW_DRAW_DEFAULT (0).
+ *       x: X coordinate.
+ *       y: Y coordinate.
+ *       width: Width of rectangle.
+ *       height: Height of rectangle.
+ */
+void API dw_draw_rect(HWND handle, HPIXMAP pixmap, int flags, int x, int y, int width, int height)
+{
+    HPIXMAP target = _dw_draw_target(handle, pixmap);
+
+    if(target && width > 0 && height > 0)
+    {
+        unsigned int color = _dw_argb(_dw_fg_color, 0xFF000000);
+
+        if(flags & DW_DRAW_FILL)
+            _dw_fill_rect(target, x, y, width, height, color);
+        else
+        {
+            _dw_fill_rect(target, x, y, width, 1, color);
+            _dw_fill_rect(target, x, y + height - 1, width, 1, color);
+            _dw_fill_rect(target, x, y, 1, height, color);
+            _dw_fill_rect(target, x + width - 1, y, 1, height, color);
+        }
+    }
+}
+
+/* Draw an arc on a window (preferably a render window).
+ * Parameters:
+ *       handle: Handle to the window.
+ *       pixmap: Handle to the pixmap. (choose only one of these)
+ *       flags: DW_DRAW_FILL (1) to fill the arc or DW_DRAW_DEFAULT (0).
+ *              DW_DRAW_FULL will draw a complete circle/elipse.
+ *       xorigin: X coordinate of center of arc.
+ *       yorigin: Y coordinate of center of arc.
+ *       x1: X coordinate of first segment of arc.
+ *       y1: Y coordinate of first segment of arc.
+ *       x2: X coordinate of second segment of arc.
+ *       y2: Y coordinate of second segment of arc.
+ */
+void API dw_draw_arc(HWND handle, HPIXMAP pixmap, int flags, int xorigin, int yorigin, int x1, int y1, int x2, int y2)
+{
+    HPIXMAP target = _dw_draw_target(handle, pixmap);
+    int x[_DW_ARC_SEGMENTS + 2], y[_DW_ARC_SEGMENTS + 2], npoints = 0, z;
+    double rx, ry, a1, a2;
+
+    if(!target)
+        return;
+
+    /* Approximate the curve with line segments */
+    if(flags & DW_DRAW_FULL)
+    {
+        rx = abs(x2 - x1) / 2.0;
+        ry = abs(y2 - y1) / 2.0;
+        a1 = 0;
+        a2 = M_PI * 2;
+    }
+    else
+    {
+        double dx = xorigin - x1;
+        double dy = yorigin - y1;
+
+        rx = ry = sqrt(dx*dx + dy*dy);
+        a1 = atan2((y1-yorigin), (x1-xorigin));
+        a2 = atan2((y2-yorigin), (x2-xorigin));
+        while(a2 <= a1)
+            a2 += M_PI * 2;
+    }
+    for(z=0;z<=_DW_ARC_SEGMENTS;z++)
+    {
+        double angle = a1 + ((a2 - a1) * z / _DW_ARC_SEGMENTS);
+
+        x[npoints] = xorigin + (int)lround(cos(angle) * rx);
+        y[npoints] = yorigin + (int)lround(sin(angle) * ry);
+        npoints++;
+    }
+    /* Filled arcs are pie slices */
+    if((flags & DW_DRAW_FILL) && !(flags & DW_DRAW_FULL))
+    {
+        x[npoints] = xorigin;
+        y[npoints] = yorigin;
+        npoints++;
+    }
+    _dw_draw_shape(target, flags & DW_DRAW_FILL, flags & (DW_DRAW_FILL | DW_DRAW_FULL), npoints, x, y, _dw_argb(_dw_fg_color, 0xFF000000));
+}
+
+/*
+ * Create a tree object to be packed.
+ * Parameters:
+ *       id: An ID to be used for getting the resource from the
+ *           resource file.
+ * Returns:
+ *       A handle to a tree window or NULL on failure.
+ */
+HWND API dw_tree_new(ULONG cid)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_TREE, NULL, cid);
+
+    /* The model is a hidden root item holding the top level items */
+    if(widget && !(widget->model = calloc(1, sizeof(DWTreeItem))))
+    {
+        free(widget->text);
+        free(widget);
+        return 0;
+    }
+    return (HWND)widget;
+}
+
+/*
+ * Inserts an item into a tree window (widget) after another item.
+ * Parameters:
+ *          handle: Handle to the tree to be inserted.
+ *          item: Handle to the item to be positioned after.
+ *          title: The text title of the entry.
+ *          icon: Handle to coresponding icon.
+ *          parent: Parent handle or 0 if root.
+ *          itemdata: Item specific data.
+ * Returns:
+ *       A handle to a tree item or NULL on failure.
+ */
+HTREEITEM API dw_tree_insert_after(HWND handle, HTREEITEM item, const char *title, HICN icon, HTREEITEM parent, void *itemdata)
+{
+    DWWidget *widget = _dw_tree(handle);
+    DWTreeItem *newitem, *after = (DWTreeItem *)item;
+
+    if(!widget || !(newitem = calloc(1, sizeof(DWTreeItem))))
+        return 0;
+
+    newitem->parent = parent ? (DWTreeItem *)parent : (DWTreeItem *)widget->model;
+    newitem->title = strdup(title ? title : "");
+    newitem->icon = icon;
+    newitem->data = itemdata;
+
+    /* No item to insert after means insert at the front */
+    if(after && after->parent != newitem->parent)
+        after = newitem->parent->lastchild;
+    if(after)
+    {
+        newitem->prev = after;
+        newitem->next = after->next;
+        after->next = newitem;
+    }
+    else
+    {
+        newitem->next = newitem->parent->child;
+        newitem->parent->child = newitem;
+    }
+    if(newitem->next)
+        newitem->next->prev = newitem;
+    else
+        newitem->parent->lastchild = newitem;
+    return (HTREEITEM)newitem;
+}
+
+/*
+ * Inserts an item into a tree window (widget).
+ * Parameters:
+ *          handle: Handle to the tree to be inserted.
+ *          title: The text title of the entry.
+ *          icon: Handle to coresponding icon.
+ *          parent: Parent handle or 0 if root.
+ *          itemdata: Item specific data.
+ * Returns:
+ *       A handle to a tree item or NULL on failure.
+ */
+HTREEITEM API dw_tree_insert(HWND handle, const char *title, HICN icon, HTREEITEM parent, void *itemdata)
+{
+    DWWidget *widget = _dw_tree(handle);
+    DWTreeItem *parentitem;
+
+    if(!widget)
+        return 0;
+    parentitem = parent ? (DWTreeItem *)parent : (DWTreeItem *)widget->model;
+    /* Append after the last child, or at the front if there are none */
+    return dw_tree_insert_after(handle, (HTREEITEM)parentitem->lastchild, title, icon, parent, itemdata);
+}
+
+/*
+ * Gets the text an item in a tree window (widget).
+ * Parameters:
+ *          handle: Handle to the tree containing the item.
+ *          item: Handle of the item to be modified.
+ * Returns:
+ *       A malloc()ed buffer of item text to be dw_free()ed or NULL on error.
+ */
+char * API dw_tree_get_title(HWND handle, HTREEITEM item)
+{
+    DWTreeItem *treeitem = (DWTreeItem *)item;
+
+    if(_dw_tree(handle) && treeitem)
+        return strdup(treeitem->title);
+    return NULL;
+}
+
+/*
+ * Gets the text an item in a tree window (widget).
+ * Parameters:
+ *          handle: Handle to the tree containing the item.
+ *          item: Handle of the item to be modified.
+ * Returns:
+ *       A handle to a tree item or NULL on failure.
+ */
+HTREEITEM API dw_tree_get_parent(HWND handle, HTREEITEM item)
+{
+    DWWidget *widget = _dw_tree(handle);
+    DWTreeItem *treeitem = (DWTreeItem *)item;
+
+    if(widget && treeitem && treeitem->parent != (DWTreeItem *)widget->model)
+        return (HTREEITEM)treeitem->parent;
+    return 0;
+}
+
+/*
+ * Inserts many items into a tree window (widget) under one parent.
+ * Parameters:
+ *          handle: Handle to the tree to be inserted.
+ *          parent: Parent handle or 0 if root.
+ *          count: Number of items to insert.
+ *          titles: Array of count text titles.
+ *          icons: Array of count icon handles or NULL for no icons.
+ *          itemdata: Array of count item data pointers or NULL.
+ *          items: Array to receive the count new item handles or NULL.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_tree_insert_many(HWND handle, HTREEITEM parent, int count, char **titles, HICN *icons, void **itemdata, HTREEITEM *items)
+{
+    int retval = DW_ERROR_NONE, z;
+
+    if(!_dw_tree(handle) || !titles || count < 0)
+        return DW_ERROR_GENERAL;
+
+    /* There is no view to detach, each insert is already constant time */
+    for(z=0;z<count;z++)
+    {
+        HTREEITEM item = dw_tree_insert(handle, titles[z], icons ? icons[z] : 0, parent, itemdata ? itemdata[z] : NULL);
+
+        if(!item)
+            retval = DW_ERROR_NO_MEM;
+        if(items)
+            items[z] = item;
+    }
+    return retval;
+}
+
+/*
+ * Sets the text and icon of an item in a tree window (widget).
+ * Parameters:
+ *          handle: Handle to the tree containing the item.
+ *          item: Handle of the item to be modified.
+ *          title: The text title of the entry.
+ *          icon: Handle to coresponding icon.
+ */
+void API dw_tree_item_change(HWND handle, HTREEITEM item, const char *title, HICN icon)
+{
+    DWTreeItem *treeitem = (DWTreeItem *)item;
+
+    if(_dw_tree(handle) && treeitem)
+    {
+        free(treeitem->title);
+        treeitem->title = strdup(title ? title : "");
+        treeitem->icon = icon;
+    }
+}
+
+/*
+ * Sets the item data of a tree item.
+ * Parameters:
+ *          handle: Handle to the tree containing the item.
+ *          item: Handle of the item to be modified.
+ *          itemdata: User defined data to be associated with item.
+ */
+void API dw_tree_item_set_data(HWND handle, HTREEITEM item, void *itemdata)
+{
+    DWTreeItem *treeitem = (DWTreeItem *)item;
+
+    if(_dw_tree(handle) && treeitem)
+        treeitem->data = itemdata;
+}
+
+/*
+ * Gets the item data of a tree item.
+ * Parameters:
+ *          handle: Handle to the tree containing the item.
+ *          item: Handle of the item to be modified.
+ * Returns:
+ *       A pointer to tree item data or NULL on failure.
+ */
+void * API dw_tree_item_get_data(HWND handle, HTREEITEM item)
+{
+    DWTreeItem *treeitem = (DWTreeItem *)item;
+
+    if(_dw_tree(handle) && treeitem)
+        return treeitem->data;
+    return NULL;
+}
+
+/*
+ * Sets this item as the active selection.
+ * Parameters:
+ *       handle: Handle to the tree window (widget) to be selected.
+ *       item: Handle to the item to be selected.
+ */
+void API dw_tree_item_select(HWND handle, HTREEITEM item)
+{
+    DWWidget *widget = _dw_tree(handle);
+
+    if(widget && item && widget->current != item)
+    {
+        widget->current = item;
+        _dw_emit_tree_select(widget, (DWTreeItem *)item);
+    }
+}
+
+/*
+ * Removes all nodes from a tree.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be cleared.
+ */
+void API dw_tree_clear(HWND handle)
+{
+    DWWidget *widget = _dw_tree(handle);
+
+    if(widget)
+    {
+        DWTreeItem *root = (DWTreeItem *)widget->model;
+
+        while(root->child)
+            _dw_tree_item_free(root->child);
+        widget->current = NULL;
+    }
+}
+
+/*
+ * Stops the tree from updating while many items are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the tree to freeze.
+ */
+void API dw_tree_freeze(HWND handle)
+{
+}
+
+/*
+ * Resumes updating of a frozen tree, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the tree to thaw.
+ */
+void API dw_tree_thaw(HWND handle)
+{
+}
+
+/*
+ * Expands a node on a tree.
+ * Parameters:
+ *       handle: Handle to the tree window (widget).
+ *       item: Handle to node to be expanded.
+ */
+void API dw_tree_item_expand(HWND handle, HTREEITEM item)
+{
+    DWWidget *widget = _dw_tree(handle);
+    DWTreeItem *treeitem = (DWTreeItem *)item;
+
+    if(widget && treeitem && !treeitem->expanded)
+    {
+        treeitem->expanded = TRUE;
+        _dw_emit_tree_expand(widget, treeitem);
+    }
+}
+
+/*
+ * Collapses a node on a tree.
+ * Parameters:
+ *       handle: Handle to the tree window (widget).
+ *       item: Handle to node to be collapsed.
+ */
+void API dw_tree_item_collapse(HWND handle, HTREEITEM item)
+{
+    DWWidget *widget = _dw_tree(handle);
+    DWTreeItem *treeitem = (DWTreeItem *)item;
+
+    if(widget && treeitem)
+    {
+        /* Lazy items may drop their children, they are inserted again on expand */
+        if(treeitem->expanded && (treeitem->lazy & DW_TREE_LAZY_DROP) && treeitem->child)
+        {
+            DWTreeItem *current;
+
+            /* The selection moves up to the collapsed item */
+            for(current = widget->current;current;current = current->parent)
+            {
+                if(current->parent == treeitem)
+                {
+                    widget->current = treeitem;
+                    break;
+                }
+            }
+            while(treeitem->child)
+                _dw_tree_item_free(treeitem->child);
+        }
+        treeitem->expanded = FALSE;
+    }
+}
+
+/*
+ * Marks a tree item as having children that are inserted on demand.
+ * The item shows an expander, and the DW_SIGNAL_TREE_EXPAND handler
+ * inserts the children when the item is expanded the first time.
+ * The handler is also called on later expands, even if the children exist.
+ * Parameters:
+ *       handle: Handle to the tree window (widget).
+ *       item: Handle to the node to be marked.
+ *       flags: DW_TREE_LAZY, DW_TREE_LAZY_DROP to also delete the children
+ *              when the node is collapsed, or 0 to turn it off.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_tree_item_set_lazy(HWND handle, HTREEITEM item, int flags)
+{
+    DWTreeItem *treeitem = (DWTreeItem *)item;
+
+    if(!_dw_tree(handle) || !treeitem)
+        return DW_ERROR_GENERAL;
+    /* There is no expander to show, only the collapse behavior changes */
+    if(flags & DW_TREE_LAZY_DROP)
+        flags |= DW_TREE_LAZY;
+    treeitem->lazy = flags;
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Removes a node from a tree.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be cleared.
+ *       item: Handle to node to be deleted.
+ */
+void API dw_tree_item_delete(HWND handle, HTREEITEM item)
+{
+    DWWidget *widget = _dw_tree(handle);
+    DWTreeItem *treeitem = (DWTreeItem *)item;
+
+    if(widget && treeitem)
+    {
+        DWTreeItem *current;
+
+        /* Clear the selection if it is going away */
+        for(current = widget->current;current;current = current->parent)
+        {
+            if(current == treeitem)
+            {
+                widget->current = NULL;
+                break;
+            }
+        }
+        _dw_tree_item_free(treeitem);
+    }
+}
+
+/*
+ * Create a container object to be packed.
+ * Parameters:
+ *       id: An ID to be used for getting the resource from the
+ *           resource file.
+ * Returns:
+ *       A handle to a container window or NULL on failure.
+ */
+HWND API dw_container_new(ULONG cid, int multi)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_CONTAINER, NULL, cid);
+
+    if(widget)
+    {
+        DWContainer *cont = calloc(1, sizeof(DWContainer));
+
+        if(!cont)
+        {
+            free(widget->text);
+            free(widget);
+            return 0;
+        }
+        cont->cursor = cont->query = -1;
+        cont->oddcolor = cont->evencolor = DW_CLR_DEFAULT;
+        widget->style = multi;
+        widget->model = cont;
+    }
+    return (HWND)widget;
+}
+
+/*
+ * Sets up the container columns.
+ * Parameters:
+ *          handle: Handle to the container to be configured.
+ *          flags: An array of unsigned longs with column flags.
+ *          titles: An array of strings with column text titles.
+ *          count: The number of columns (this should match the arrays).
+ *          separator: The column number that contains the main separator.
+ *                     (this item may only be used in OS/2)
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_container_setup(HWND handle, unsigned long *flags, char **titles, int count, int separator)
+{
+    DWWidget *widget = _dw_container(handle);
+    DWContainer *cont;
+    int z;
+
+    if(!widget || count < 1 || !flags)
+        return DW_ERROR_GENERAL;
+
+    cont = (DWContainer *)widget->model;
+    dw_container_clear(handle, FALSE);
+    for(z=0;z<cont->columns;z++)
+        free(cont->titles[z]);
+    free(cont->titles);
+    free(cont->flags);
+    free(cont->widths);
+
+    cont->flags = calloc(count, sizeof(unsigned long));
+    cont->titles = calloc(count, sizeof(char *));
+    cont->widths = calloc(count, sizeof(int));
+    if(!cont->flags || !cont->titles || !cont->widths)
+    {
+        cont->columns = 0;
+        return DW_ERROR_NO_MEM;
+    }
+    for(z=0;z<count;z++)
+    {
+        cont->flags[z] = flags[z];
+        cont->titles[z] = strdup((titles && titles[z]) ? titles[z] : "");
+        _dw_text_size(widget->font, cont->titles[z], &cont->widths[z], NULL);
+    }
+    cont->columns = count;
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Configures the main filesystem column title for localization.
+ * Parameters:
+ *          handle: Handle to the container to be configured.
+ *          title: The title to be displayed in the main column.
+ */
+void API dw_filesystem_set_column_title(HWND handle, const char *title)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+
+        free(cont->fstitle);
+        cont->fstitle = title ? strdup(title) : NULL;
+    }
+}
+
+/*
+ * Sets up the filesystem columns, note: filesystem always has an icon/filename field.
+ * Parameters:
+ *          handle: Handle to the container to be configured.
+ *          flags: An array of unsigned longs with column flags.
+ *          titles: An array of strings with column text titles.
+ *          count: The number of columns (this should match the arrays).
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_filesystem_setup(HWND handle, unsigned long *flags, char **titles, int count)
+{
+    DWWidget *widget = _dw_container(handle);
+    unsigned long *newflags;
+    char **newtitles;
+    int retval;
+
+    if(!widget || count < 0)
+        return DW_ERROR_GENERAL;
+
+    /* The icon and filename form the first column */
+    newflags = calloc(count + 1, sizeof(unsigned long));
+    newtitles = calloc(count + 1, sizeof(char *));
+    if(!newflags || !newtitles)
+    {
+        free(newflags);
+        free(newtitles);
+        return DW_ERROR_NO_MEM;
+    }
+    newflags[0] = DW_CFA_STRINGANDICON | DW_CFA_LEFT | DW_CFA_HORZSEPARATOR;
+    newtitles[0] = ((DWContainer *)widget->model)->fstitle ? ((DWContainer *)widget->model)->fstitle : "Filename";
+    if(count)
+    {
+        memcpy(&newflags[1], flags, sizeof(unsigned long) * count);
+        memcpy(&newtitles[1], titles, sizeof(char *) * count);
+    }
+    retval = dw_container_setup(handle, newflags, newtitles, count + 1, 0);
+    if(retval == DW_ERROR_NONE)
+        ((DWContainer *)widget->model)->filesystem = TRUE;
+    free(newflags);
+    free(newtitles);
+    return retval;
+}
+
+/*
+ * Allocates memory used to populate a container.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          rowcount: The number of items to be populated.
+ * Returns:
+ *       Handle to container items allocated or NULL on error.
+ */
+void * API dw_container_alloc(HWND handle, int rowcount)
+{
+    DWWidget *widget = _dw_container(handle);
+    DWContainer *cont;
+    DWContAlloc *alloc;
+    int z;
+
+    if(!widget || rowcount < 1 || !(alloc = calloc(1, sizeof(DWContAlloc))))
+        return NULL;
+
+    cont = (DWContainer *)widget->model;
+    /* Rows are added right away, filled in by the set functions */
+    if(cont->count + rowcount > cont->alloc)
+    {
+        int newalloc = cont->alloc ? cont->alloc : 16;
+        DWContRow *rows;
+
+        while(newalloc < cont->count + rowcount)
+            newalloc *= 2;
+        if(!(rows = realloc(cont->rows, sizeof(DWContRow) * newalloc)))
+        {
+            free(alloc);
+            return NULL;
+        }
+        cont->rows = rows;
+        cont->alloc = newalloc;
+    }
+    for(z=0;z<rowcount;z++)
+    {
+        DWContRow *row = &cont->rows[cont->count + z];
+
+        memset(row, 0, sizeof(DWContRow));
+        if(cont->columns)
+            row->cells = calloc(cont->columns, sizeof(DWCell));
+    }
+    alloc->widget = widget;
+    alloc->start = cont->count;
+    cont->count += rowcount;
+    cont->filter.dirty = TRUE;
+    /* New rows stay hidden under a filter until their text matches */
+    for(z=alloc->start;z<cont->count;z++)
+        _dw_container_filter_row(cont, z);
+    return alloc;
+}
+
+/*
+ * Sets an item in specified row and column to the given data.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          pointer: Pointer to the allocated memory in dw_container_alloc().
+ *          column: Zero based column of data being set.
+ *          row: Zero based row of data being set.
+ *          data: Pointer to the data to be added.
+ */
+void API dw_container_set_item(HWND handle, void *pointer, int column, int row, void *data)
+{
+    DWContAlloc *alloc = (DWContAlloc *)pointer;
+
+    if(alloc)
+        _dw_container_set_cell(alloc->widget, column, alloc->start + row, data);
+}
+
+/*
+ * Changes an existing item in specified row and column to the given data.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based column of data being set.
+ *          row: Zero based row of data being set.
+ *          data: Pointer to the data to be added.
+ */
+void API dw_container_change_item(HWND handle, int column, int row, void *data)
+{
+    _dw_container_set_cell(_dw_container(handle), column, row, data);
+}
+
+/*
+ * Changes an existing item in specified row and column to the given data.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based column of data being set.
+ *          row: Zero based row of data being set.
+ *          data: Pointer to the data to be added.
+ */
+void API dw_filesystem_change_item(HWND handle, int column, int row, void *data)
+{
+    dw_container_change_item(handle, column + 1, row, data);
+}
+
+/*
+ * Changes an item in specified row and column to the given data.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          pointer: Pointer to the allocated memory in dw_container_alloc().
+ *          column: Zero based column of data being set.
+ *          row: Zero based row of data being set.
+ *          data: Pointer to the data to be added.
+ */
+void API dw_filesystem_change_file(HWND handle, int row, const char *filename, HICN icon)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+
+        if(row >= 0 && row < cont->count)
+        {
+            _dw_container_set_file(&cont->rows[row], filename, icon);
+            cont->filter.dirty = TRUE;
+            if(cont->filter.column == 0)
+                _dw_container_filter_row(cont, row);
+        }
+    }
+}
+
+/*
+ * Sets an item in specified row and column to the given data.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          pointer: Pointer to the allocated memory in dw_container_alloc().
+ *          column: Zero based column of data being set.
+ *          row: Zero based row of data being set.
+ *          data: Pointer to the data to be added.
+ */
+void API dw_filesystem_set_file(HWND handle, void *pointer, int row, const char *filename, HICN icon)
+{
+    DWContAlloc *alloc = (DWContAlloc *)pointer;
+
+    if(alloc)
+        dw_filesystem_change_file((HWND)alloc->widget, alloc->start + row, filename, icon);
+}
+
+/*
+ * Sets an item in specified row and column to the given data.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          pointer: Pointer to the allocated memory in dw_container_alloc().
+ *          column: Zero based column of data being set.
+ *          row: Zero based row of data being set.
+ *          data: Pointer to the data to be added.
+ */
+void API dw_filesystem_set_item(HWND handle, void *pointer, int column, int row, void *data)
+{
+    dw_container_set_item(handle, pointer, column + 1, row, data);
+}
+
+/*
+ * Sets the data of a row in the container.
+ * Parameters:
+ *          pointer: Pointer to the allocated memory in dw_container_alloc().
+ *          row: Zero based row of data being set.
+ *          data: Data pointer.
+ */
+void API dw_container_set_row_data(void *pointer, int row, void *data)
+{
+    DWContAlloc *alloc = (DWContAlloc *)pointer;
+
+    if(alloc)
+        dw_container_change_row_data((HWND)alloc->widget, alloc->start + row, data);
+}
+
+/*
+ * Changes the data of a row already inserted in the container.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          row: Zero based row of data being set.
+ *          data: Data pointer.
+ */
+void API dw_container_change_row_data(HWND handle, int row, void *data)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+
+        if(row >= 0 && row < cont->count)
+            cont->rows[row].data = data;
+    }
+}
+
+/*
+ * Gets column type for a container column.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based column.
+ * Returns:
+ *       Constant identifying the the column type.
+ */
+int API dw_container_get_column_type(HWND handle, int column)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+
+        if(column >= 0 && column < cont->columns)
+            return (int)(cont->flags[column] & (DW_CFA_BITMAPORICON | DW_CFA_STRING | DW_CFA_ULONG | DW_CFA_TIME | DW_CFA_DATE));
+    }
+    return 0;
+}
+
+/*
+ * Gets column type for a filesystem container column.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based column.
+ * Returns:
+ *       Constant identifying the the column type.
+ */
+int API dw_filesystem_get_column_type(HWND handle, int column)
+{
+    return dw_container_get_column_type(handle, column + 1);
+}
+
+/*
+ * Sets the alternating row colors for container window (widget) handle.
+ * Parameters:
+ *          handle: The window (widget) handle.
+ *          oddcolor: Odd row background color in DW_RGB format or a default color index.
+ *          evencolor: Even row background color in DW_RGB format or a default color index.
+ *                    DW_RGB_TRANSPARENT will disable coloring rows.
+ *                    DW_CLR_DEFAULT will use the system default alternating row colors.
+ */
+void API dw_container_set_stripe(HWND handle, unsigned long oddcolor, unsigned long evencolor)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget)
+    {
+        ((DWContainer *)widget->model)->oddcolor = oddcolor;
+        ((DWContainer *)widget->model)->evencolor = evencolor;
+    }
+}
+
+/*
+ * Sets the width of a column in the container.
+ * Parameters:
+ *          handle: Handle to window (widget) of container.
+ *          column: Zero based column of width being set.
+ *          width: Width of column in pixels.
+ */
+void API dw_container_set_column_width(HWND handle, int column, int width)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+
+        if(column >= 0 && column < cont->columns)
+            cont->widths[column] = width;
+    }
+}
+
+/*
+ * Sets the title of a row in the container.
+ * Parameters:
+ *          pointer: Pointer to the allocated memory in dw_container_alloc().
+ *          row: Zero based row of data being set.
+ *          title: String title of the item.
+ */
+void API dw_container_set_row_title(void *pointer, int row, const char *title)
+{
+    DWContAlloc *alloc = (DWContAlloc *)pointer;
+
+    if(alloc)
+        dw_container_change_row_title((HWND)alloc->widget, alloc->start + row, title);
+}
+
+
+/*
+ * Sets the title of a row in the container.
+ * Parameters:
+ *          handle: Handle to window (widget) of container.
+ *          row: Zero based row of data being set.
+ *          title: String title of the item.
+ */
+void API dw_container_change_row_title(HWND handle, int row, const char *title)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+
+        if(row >= 0 && row < cont->count)
+        {
+            free(cont->rows[row].title);
+            cont->rows[row].title = title ? strdup(title) : NULL;
+        }
+    }
+}
+
+/*
+ * Sets the title of a row in the container.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          pointer: Pointer to the allocated memory in dw_container_alloc().
+ *          rowcount: The number of rows to be inserted.
+ */
+void API dw_container_insert(HWND handle, void *pointer, int rowcount)
+{
+    /* The rows were added by dw_container_alloc() */
+    free(pointer);
+}
+
+/*
+ * Removes all rows from a container.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be cleared.
+ *       redraw: TRUE to cause the container to redraw immediately.
+ */
+void API dw_container_clear(HWND handle, int redraw)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+        int z;
+
+        for(z=0;z<cont->count;z++)
+            _dw_container_row_free(cont, &cont->rows[z]);
+        cont->count = 0;
+        cont->cursor = cont->query = -1;
+        cont->filter.dirty = TRUE;
+    }
+}
+
+/*
+ * Removes the first x rows from a container.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be deleted from.
+ *       rowcount: The number of rows to be deleted.
+ */
+void API dw_container_delete(HWND handle, int rowcount)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget && rowcount > 0)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+        int z;
+
+        if(rowcount > cont->count)
+            rowcount = cont->count;
+        for(z=0;z<rowcount;z++)
+            _dw_container_row_free(cont, &cont->rows[z]);
+        cont->count -= rowcount;
+        memmove(cont->rows, &cont->rows[rowcount], sizeof(DWContRow) * cont->count);
+        cont->cursor = cont->query = -1;
+        cont->filter.dirty = TRUE;
+    }
+}
+
+/*
+ * Scrolls container up or down.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be scrolled.
+ *       direction: DW_SCROLL_UP, DW_SCROLL_DOWN, DW_SCROLL_TOP or
+ *                  DW_SCROLL_BOTTOM. (rows is ignored for last two)
+ *       rows: The number of rows to be scrolled.
+ */
+void API dw_container_scroll(HWND handle, int direction, long rows)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    /* The top visible row is kept in value */
+    if(widget)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+
+        switch(direction)
+        {
+            case DW_SCROLL_TOP:
+                widget->value = 0;
+                break;
+            case DW_SCROLL_BOTTOM:
+                widget->value = cont->count > 0 ? cont->count - 1 : 0;
+                break;
+            case DW_SCROLL_UP:
+                widget->value = widget->value > rows ? widget->value - rows : 0;
+                break;
+            case DW_SCROLL_DOWN:
+                widget->value += rows;
+                if(widget->value >= cont->count)
+                    widget->value = cont->count > 0 ? cont->count - 1 : 0;
+                break;
+        }
+    }
+}
+
+/* Internal function to check if a row is part of a query,
+ * DW_CRA_CURSORED on its own only matches the cursor row.
+ */
+static int _dw_container_query_match(DWContainer *cont, int row, unsigned long flags)
+{
+    if((flags & DW_CRA_CURSORED) && row == cont->cursor)
+        return TRUE;
+    if(flags & DW_CRA_SELECTED)
+        return cont->rows[row].selected;
+    return !(flags & DW_CRA_CURSORED);
+}
+
+/*
+ * Starts a new query of a container.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       flags: If this parameter is DW_CRA_SELECTED it will only
+ *              return items that are currently selected.  Otherwise
+ *              it will return all records in the container.
+ * Returns:
+ *       Pointer to data associated with first entry or NULL on error.
+ */
+char * API dw_container_query_start(HWND handle, unsigned long flags)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget)
+    {
+        ((DWContainer *)widget->model)->query = -1;
+        return dw_container_query_next(handle, flags);
+    }
+    return NULL;
+}
+
+/*
+ * Continues an existing query of a container.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       flags: If this parameter is DW_CRA_SELECTED it will only
+ *              return items that are currently selected.  Otherwise
+ *              it will return all records in the container.
+ * Returns:
+ *       Pointer to data associated with next entry or NULL on error or completion.
+ */
+char * API dw_container_query_next(HWND handle, unsigned long flags)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+
+        while(++cont->query < cont->count)
+        {
+            DWContRow *row = &cont->rows[cont->query];
+
+            if(_dw_container_query_match(cont, cont->query, flags))
+            {
+                if(flags & DW_CR_RETDATA)
+                    return (char *)row->data;
+                return row->title ? strdup(row->title) : NULL;
+            }
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Returns all matching rows of a container in one call.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       flags: DW_CRA_SELECTED or DW_CRA_CURSORED to limit the rows
+ *              returned, otherwise all rows are returned.
+ *              DW_CR_RETDATA to return the row data instead of titles.
+ *              DW_CR_RETINDEX to return zero based row indexes instead,
+ *              read each one with DW_POINTER_TO_INT().
+ *       count: Pointer to an integer to receive the number of rows.
+ * Returns:
+ *       An array of titles, data pointers or row indexes which must be
+ *       freed with dw_free(), or NULL if there are no matching rows.
+ *       Titles are copied into the same block as the array.
+ */
+void ** API dw_container_query_selected(HWND handle, unsigned long flags, int *count)
+{
+    DWWidget *widget = _dw_container(handle);
+    void **retval = NULL;
+    int rows = 0, z;
+
+    if(widget)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+        size_t size = 0;
+        char *buf;
+
+        /* Count the rows and the space for their titles first */
+        for(z=0;z<cont->count;z++)
+        {
+            DWContRow *row = &cont->rows[z];
+
+            if(_dw_container_query_match(cont, z, flags))
+            {
+                if(!(flags & (DW_CR_RETDATA | DW_CR_RETINDEX)) && row->title)
+                    size += strlen(row->title) + 1;
+                rows++;
+            }
+        }
+        /* The titles are packed after the array so one dw_free() releases everything */
+        if(rows && (retval = malloc((sizeof(void *) * rows) + size)))
+        {
+            buf = (char *)&retval[rows];
+            rows = 0;
+            for(z=0;z<cont->count;z++)
+            {
+                DWContRow *row = &cont->rows[z];
+
+                if(_dw_container_query_match(cont, z, flags))
+                {
+                    if(flags & DW_CR_RETINDEX)
+                        retval[rows] = DW_INT_TO_POINTER(z);
+                    else if(flags & DW_CR_RETDATA)
+                        retval[rows] = row->data;
+                    else if(row->title)
+                    {
+                        size_t len = strlen(row->title) + 1;
+
+                        memcpy(buf, row->title, len);
+                        retval[rows] = buf;
+                        buf += len;
+                    }
+                    else
+                        retval[rows] = NULL;
+                    rows++;
+                }
+            }
+        }
+    }
+    if(count)
+        *count = retval ? rows : 0;
+    return retval;
+}
+
+/* Container iterator state, the rows are read in place */
+typedef struct _dwcontiter {
+    DWWidget *widget;
+    unsigned long flags;
+    int row;
+} DWContIter;
+
+/*
+ * Starts iterating the rows of a container without copying them.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       flags: DW_CRA_SELECTED or DW_CRA_CURSORED to limit the rows
+ *              returned, otherwise all rows are returned.
+ * Returns:
+ *       An iterator handle to pass to dw_container_iter_next() and
+ *       dw_container_iter_end(), or NULL on error.
+ */
+HCONTITER API dw_container_iter_begin(HWND handle, unsigned long flags)
+{
+    DWWidget *widget = _dw_container(handle);
+    DWContIter *it = NULL;
+
+    if(widget && (it = calloc(1, sizeof(DWContIter))))
+    {
+        it->widget = widget;
+        it->flags = flags;
+        it->row = -1;
+    }
+    return (HCONTITER)it;
+}
+
+/*
+ * Moves a container iterator to the next row.  The title and data are
+ * borrowed from the container and are valid until the next call.
+ * Parameters:
+ *       iter: Iterator handle returned by dw_container_iter_begin().
+ *       title: Pointer to receive the row title or NULL.
+ *       data: Pointer to receive the row data or NULL.
+ * Returns:
+ *       TRUE if a row was returned, FALSE at the end of the rows.
+ */
+int API dw_container_iter_next(HCONTITER iter, const char **title, void **data)
+{
+    DWContIter *it = (DWContIter *)iter;
+
+    if(it)
+    {
+        DWContainer *cont = (DWContainer *)it->widget->model;
+
+        while(++it->row < cont->count)
+        {
+            if(_dw_container_query_match(cont, it->row, it->flags))
+            {
+                if(title)
+                    *title = cont->rows[it->row].title;
+                if(data)
+                    *data = cont->rows[it->row].data;
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
+
+/*
+ * Finishes a container iteration and frees the iterator.
+ * Parameters:
+ *       iter: Iterator handle returned by dw_container_iter_begin().
+ */
+void API dw_container_iter_end(HCONTITER iter)
+{
+    free(iter);
+}
+
+
+/*
+ * Cursors the item with the text speficied, and scrolls to that item.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       text:  Text usually returned by dw_container_query().
+ */
+void API dw_container_cursor(HWND handle, const char *text)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget && text)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+        int z;
+
+        for(z=0;z<cont->count;z++)
+        {
+            if(cont->rows[z].title && !strcmp(cont->rows[z].title, text))
+            {
+                _dw_container_select(widget, z);
+                return;
+            }
+        }
+    }
+}
+
+/*
+ * Cursors the item with the data speficied, and scrolls to that item.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       data:  Data usually returned by dw_container_query().
+ */
+void API dw_container_cursor_by_data(HWND handle, void *data)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+        int z;
+
+        for(z=0;z<cont->count;z++)
+        {
+            if(cont->rows[z].data == data)
+            {
+                _dw_container_select(widget, z);
+                return;
+            }
+        }
+    }
+}
+
+/*
+ * Deletes the item with the text speficied.
+ * Parameters:
+ *       handle: Handle to the window (widget).
+ *       text:  Text usually returned by dw_container_query().
+ */
+void API dw_container_delete_row(HWND handle, const char *text)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget && text)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+        int z;
+
+        for(z=0;z<cont->count;z++)
+        {
+            if(cont->rows[z].title && !strcmp(cont->rows[z].title, text))
+            {
+                _dw_container_remove(cont, z);
+                return;
+            }
+        }
+    }
+}
+
+/*
+ * Deletes the item with the data speficied.
+ * Parameters:
+ *       handle: Handle to the window (widget).
+ *       data:  Data usually returned by dw_container_query().
+ */
+void API dw_container_delete_row_by_data(HWND handle, void *data)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+        int z;
+
+        for(z=0;z<cont->count;z++)
+        {
+            if(cont->rows[z].data == data)
+            {
+                _dw_container_remove(cont, z);
+                return;
+            }
+        }
+    }
+}
+
+/*
+ * Optimizes the column widths so that all data is visible.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be optimized.
+ */
+void API dw_container_optimize(HWND handle)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    if(widget)
+    {
+        DWContainer *cont = (DWContainer *)widget->model;
+        int x, z;
+
+        /* Size each column to fit the title and the widest cell */
+        for(x=0;x<cont->columns;x++)
+        {
+            int width = 0;
+
+            _dw_text_size(widget->font, cont->titles[x], &width, NULL);
+            for(z=0;z<cont->count;z++)
+            {
+                char buf[101], *text = _dw_container_cell_text(cont, &cont->rows[z], x, buf, sizeof(buf));
+                int thiswidth = 0;
+
+                _dw_text_size(widget->font, text, &thiswidth, NULL);
+                if(cont->flags[x] & DW_CFA_BITMAPORICON)
+                    thiswidth += 16;
+                if(thiswidth > width)
+                    width = thiswidth;
+            }
+            cont->widths[x] = width + 8;
+        }
+    }
+}
+
+/*
+ * Sorts the rows of a container by the contents of a column,
+ * rows with equal values keep their order.  Rows added later
+ * are not sorted.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based column to sort by.
+ *          order: DW_SORT_ASCENDING or DW_SORT_DESCENDING.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_container_sort(HWND handle, int column, int order)
+{
+    DWWidget *widget = _dw_container(handle);
+    DWContainer *cont;
+    unsigned long flags;
+    DWSortKey *keys;
+    DWContRow *rows;
+    int z, cursor = -1, query = -1;
+
+    if(!widget || column < 0 || column >= (cont = (DWContainer *)widget->model)->columns)
+        return DW_ERROR_GENERAL;
+    flags = cont->flags[column];
+    if(!(flags & (DW_CFA_STRING | DW_CFA_STRINGANDICON | DW_CFA_ULONG | DW_CFA_DATE | DW_CFA_TIME)))
+        return DW_ERROR_GENERAL;
+    if(cont->count < 2)
+        return DW_ERROR_NONE;
+    if(!(keys = malloc(sizeof(DWSortKey) * cont->count)) || !(rows = malloc(sizeof(DWContRow) * cont->alloc)))
+    {
+        free(keys);
+        return DW_ERROR_NO_MEM;
+    }
+
+    /* Sort an array of keys, then move the rows in one pass */
+    for(z=0;z<cont->count;z++)
+    {
+        DWCell *cell = cont->rows[z].cells ? &cont->rows[z].cells[column] : NULL;
+
+        keys[z].index = z;
+        if(flags & (DW_CFA_STRING | DW_CFA_STRINGANDICON))
+            keys[z].key.text = (cell && cell->string) ? cell->string : "";
+        else if(!cell)
+            keys[z].key.value = 0;
+        else if(flags & DW_CFA_ULONG)
+            keys[z].key.value = cell->ulong;
+        else if(flags & DW_CFA_DATE)
+            keys[z].key.value = (cell->date.year * 10000) + (cell->date.month * 100) + cell->date.day;
+        else
+            keys[z].key.value = (cell->time.hours * 3600) + (cell->time.minutes * 60) + cell->time.seconds;
+    }
+    if(flags & (DW_CFA_STRING | DW_CFA_STRINGANDICON))
+        qsort(keys, cont->count, sizeof(DWSortKey), order == DW_SORT_DESCENDING ? _dw_sort_text_compare_desc : _dw_sort_text_compare);
+    else
+        qsort(keys, cont->count, sizeof(DWSortKey), order == DW_SORT_DESCENDING ? _dw_sort_value_compare_desc : _dw_sort_value_compare);
+
+    for(z=0;z<cont->count;z++)
+    {
+        rows[z] = cont->rows[keys[z].index];
+        if(keys[z].index == cont->cursor)
+            cursor = z;
+        if(keys[z].index == cont->query)
+            query = z;
+    }
+    free(cont->rows);
+    cont->rows = rows;
+    cont->cursor = cursor;
+    cont->query = query;
+    cont->filter.dirty = TRUE;
+    free(keys);
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Sets whether clicking a column heading sorts the container by
+ * that column, clicking the same heading again reverses the order.
+ * The column click signal handler is called after the rows are sorted.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          sortable: TRUE to sort on heading clicks, FALSE to leave it to the application.
+ */
+void API dw_container_set_sortable(HWND handle, int sortable)
+{
+    DWWidget *widget = _dw_container(handle);
+
+    /* There are no column headings to click, this is only remembered */
+    if(widget)
+        ((DWContainer *)widget->model)->sortable = sortable;
+}
+
+/*
+ * Shows only the rows of a container whose text in a column contains
+ * the filter text, ignoring case unless DW_FILTER_CASESENSITIVE is set.
+ * Rows added or changed while the filter is set are filtered too.
+ * Rows hidden by the filter are still returned by queries of all rows,
+ * and row numbers passed to other functions count hidden rows.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based string column to filter on.
+ *          text: Text the column must contain, NULL or "" shows all rows.
+ *          flags: DW_FILTER_CASESENSITIVE or 0.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_container_set_filter(HWND handle, int column, const char *text, unsigned long flags)
+{
+    DWWidget *widget = _dw_container(handle);
+    DWContainer *cont;
+    DWContFilter *filter;
+    size_t len, x;
+    int z;
+
+    if(!widget)
+        return DW_ERROR_GENERAL;
+    cont = (DWContainer *)widget->model;
+    filter = &cont->filter;
+
+    /* An empty filter shows all the rows again */
+    if(!text || !*text)
+    {
+        for(z=0;z<cont->count;z++)
+            cont->rows[z].hidden = FALSE;
+        free(filter->text);
+        filter->text = NULL;
+        return DW_ERROR_NONE;
+    }
+    if(column < 0 || column >= cont->columns || !(cont->flags[column] & (DW_CFA_STRING | DW_CFA_STRINGANDICON)))
+        return DW_ERROR_GENERAL;
+
+    /* The index is only rebuilt when the rows or the column changed */
+    if(filter->dirty || !filter->rows || filter->column != column ||
+       (filter->flags & DW_FILTER_CASESENSITIVE) != (flags & DW_FILTER_CASESENSITIVE))
+    {
+        filter->column = column;
+        filter->flags = flags;
+        _dw_container_filter_index(cont);
+        if(!filter->rows)
+            return DW_ERROR_NO_MEM;
+    }
+    free(filter->text);
+    if(!(filter->text = _dw_filter_fold(text, flags)))
+        return DW_ERROR_NO_MEM;
+    len = strlen(filter->text);
+
+    /* There is no view, so the visibility of every row is set here */
+    for(z=0;z<cont->count;z++)
+        cont->rows[z].hidden = TRUE;
+    if(len < 3)
+    {
+        for(z=0;z<cont->count;z++)
+        {
+            if(filter->rows[z] && strstr(filter->rows[z], filter->text))
+                cont->rows[z].hidden = FALSE;
+        }
+    }
+    else
+    {
+        DWTrigram *rarest = NULL;
+        int rarecount = 0;
+
+        /* Only rows holding the rarest trigram of the text can match */
+        for(x=0;x+3<=len;x++)
+        {
+            int count;
+            DWTrigram *rows = _dw_container_filter_lookup(filter, _DW_TRIGRAM(&filter->text[x]), &count);
+
+            if(!rarest || count < rarecount)
+            {
+                rarest = rows;
+                rarecount = count;
+            }
+        }
+        for(z=0;z<rarecount;z++)
+        {
+            int row = rarest[z].row;
+
+            if(filter->rows[row] && strstr(filter->rows[row], filter->text))
+                cont->rows[row].hidden = FALSE;
+        }
+    }
+    /* Hidden rows can not stay selected */
+    for(z=0;z<cont->count;z++)
+    {
+        if(cont->rows[z].hidden)
+            cont->rows[z].selected = FALSE;
+    }
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Stops the container from updating while many rows are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the container to freeze.
+ */
+void API dw_container_freeze(HWND handle)
+{
+}
+
+/*
+ * Resumes updating of a frozen container, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the container to thaw.
+ */
+void API dw_container_thaw(HWND handle)
+{
+}
+
+/*
+ * Inserts an icon into the taskbar.
+ * Parameters:
+ *       handle: Window handle that will handle taskbar icon messages.
+ *       icon: Icon handle to display in the taskbar.
+ *       bubbletext: Text to show when the mouse is above the icon.
+ */
+void API dw_taskbar_insert(HWND handle, HICN icon, const char *bubbletext)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget)
+    {
+        widget->icon = icon;
+        free(widget->tooltip);
+        widget->tooltip = bubbletext ? strdup(bubbletext) : NULL;
+    }
+}
+
+/*
+ * Deletes an icon from the taskbar.
+ * Parameters:
+ *       handle: Window handle that was used with dw_taskbar_insert().
+ *       icon: Icon handle that was used with dw_taskbar_insert().
+ */
+void API dw_taskbar_delete(HWND handle, HICN icon)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->icon == icon)
+        widget->icon = 0;
+}
+
+/*
+ * Obtains an icon from a module (or header in GTK).
+ * Parameters:
+ *          module: Handle to module (DLL) in OS/2 and Windows.
+ *          id: A unsigned long id int the resources on OS/2 and
+ *              Windows, on GTK this is converted to a pointer
+ *              to an embedded XPM.
+ * Returns:
+ *       Handle to the created icon or NULL on error.
+ */
+HICN API dw_icon_load(unsigned long module, unsigned long resid)
+{
+    /* There are no resources, the ID serves as the handle */
+    return (HICN)resid;
+}
+
+/*
+ * Obtains an icon from a file.
+ * Parameters:
+ *       filename: Name of the file, omit extention to have
+ *                 DW pick the appropriate file extension.
+ *                 (ICO on OS/2 or Windows, XPM on Unix)
+ * Returns:
+ *       Handle to the created icon or NULL on error.
+ */
+HICN API dw_icon_load_from_file(const char *filename)
+{
+    char *path;
+
+    /* Without decoders the handle is the path of a readable file */
+    if(!filename || !*filename || access(filename, R_OK) || !(path = strdup(filename)))
+        return 0;
+    return (HICN)path;
+}
+
+/*
+ * Obtains an icon from a file and passes it to a callback.
+ * There is no background loader on this platform, so the file
+ * is loaded and the callback run on the calling thread before
+ * this function returns.
+ * Parameters:
+ *       filename: Name of the file, omit extention to have
+ *                 DW pick the appropriate file extension.
+ *                 (ICO on OS/2 or Windows, XPM on Unix)
+ *       callback: Function of the form int func(HICN icon, void *data)
+ *                 icon will be NULL if the file could not be loaded.
+ *       data: User data to be passed to the callback.
+ * Returns:
+ *       DW_ERROR_NONE once the callback has run, DW_ERROR_GENERAL on error
+ *       in which case the callback will not be called.
+ */
+int API dw_icon_load_from_file_async(const char *filename, void *callback, void *data)
+{
+    int (*iconfunc)(HICN, void *) = (int (*)(HICN, void *))callback;
+
+    if(!filename || !*filename || !callback)
+        return DW_ERROR_GENERAL;
+
+    /* No background loader on this platform, load it immediately */
+    iconfunc(dw_icon_load_from_file(filename), data);
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Obtains an icon from data.
+ * Parameters:
+ *       data: Data for the icon (ICO on OS/2 or Windows, XPM on Unix, PNG on Mac)
+ *       len: Length of the passed in data.
+ * Returns:
+ *       Handle to the created icon or NULL on error.
+ */
+HICN API dw_icon_load_from_data(const char *data, int len)
+{
+    char *copy;
+
+    if(!data || len < 1 || !(copy = malloc(len)))
+        return 0;
+    memcpy(copy, data, len);
+    return (HICN)copy;
+}
+
+/*
+ * Frees a loaded icon resource.
+ * Parameters:
+ *          handle: Handle to icon returned by dw_icon_load().
+ */
+void API dw_icon_free(HICN handle)
+{
+    /* Values in the resource ID range were not allocated */
+    if(handle > 65535)
+        free((void *)handle);
+}
+
+/*
+ * Create a new MDI Frame to be packed.
+ * Parameters:
+ *       id: An ID to be used with dw_window_from_id or 0L.
+ * Returns:
+ *       Handle to the created MDI widget or NULL on error.
+ */
+HWND API dw_mdi_new(unsigned long cid)
+{
+    DWWidget *widget = _dw_box_widget_new(_DW_WIDGET_MDI, DW_VERT, 0, NULL);
+
+    if(widget)
+        widget->id = cid;
+    return (HWND)widget;
+}
+
+/*
+ * Creates a splitbar window (widget) with given parameters.
+ * Parameters:
+ *       type: Value can be DW_VERT or DW_HORZ.
+ *       topleft: Handle to the window to be top or left.
+ *       bottomright:  Handle to the window to be bottom or right.
+ * Returns:
+ *       A handle to a splitbar window or NULL on failure.
+ */
+HWND API dw_splitbar_new(int type, HWND topleft, HWND bottomright, unsigned long cid)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_SPLITBAR, NULL, cid);
+
+    if(widget)
+    {
+        widget->style = type;
+        widget->percent = 50.0;
+        if((widget->topleft = (DWWidget *)topleft))
+            widget->topleft->parent = widget;
+        if((widget->bottomright = (DWWidget *)bottomright))
+            widget->bottomright->parent = widget;
+    }
+    return (HWND)widget;
+}
+
+/*
+ * Sets the position of a splitbar (pecentage).
+ * Parameters:
+ *       handle: The handle to the splitbar returned by dw_splitbar_new().
+ *       percent: The position of the splitbar.
+ */
+void API dw_splitbar_set(HWND handle, float percent)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_SPLITBAR && percent >= 0.0 && percent <= 100.0)
+    {
+        widget->percent = percent;
+        /* Place the panes again at the new position */
+        if(widget->width && widget->height)
+        {
+            int width = widget->width, height = widget->height;
+
+            widget->width = widget->height = 0;
+            _dw_widget_place(widget, widget->x, widget->y, width, height);
+        }
+    }
+}
+
+/*
+ * Gets the position of a splitbar (pecentage).
+ * Parameters:
+ *       handle: The handle to the splitbar returned by dw_splitbar_new().
+ * Returns:
+ *       Position of the splitbar (percentage).
+ */
+float API dw_splitbar_get(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_SPLITBAR)
+        return widget->percent;
+    return 0.0;
+}
+
+/*
+ * Create a bitmap object to be packed.
+ * Parameters:
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       Handle to the created bitmap widget or NULL on error.
+ */
+HWND API dw_bitmap_new(ULONG cid)
+{
+    return (HWND)_dw_widget_new(_DW_WIDGET_BITMAP, NULL, cid);
+}
+
+/*
+ * Creates a pixmap with given parameters.
+ * Parameters:
+ *       handle: Window handle the pixmap is associated with.
+ *       width: Width of the pixmap in pixels.
+ *       height: Height of the pixmap in pixels.
+ *       depth: Color depth of the pixmap.
+ * Returns:
+ *       A handle to a pixmap or NULL on failure.
+ */
+HPIXMAP API dw_pixmap_new(HWND handle, unsigned long width, unsigned long height, int depth)
+{
+    HPIXMAP pixmap;
+
+    if(!width || !height || !(pixmap = calloc(1, sizeof(struct _hpixmap))))
+        return NULL;
+
+    if(!(pixmap->pixels = calloc(width * height, sizeof(unsigned int))))
+    {
+        free(pixmap);
+        return NULL;
+    }
+    pixmap->width = width;
+    pixmap->height = height;
+    pixmap->handle = handle;
+    pixmap->transcolor = DW_CLR_DEFAULT;
+    return pixmap;
+}
+
+/*
+ * Creates a pixmap from a file.
+ * Parameters:
+ *       handle: Window handle the pixmap is associated with.
+ *       filename: Name of the file, omit extention to have
+ *                 DW pick the appropriate file extension.
+ *                 (BMP on OS/2 or Windows, XPM on Unix)
+ * Returns:
+ *       A handle to a pixmap or NULL on failure.
+ */
+HPIXMAP API dw_pixmap_new_from_file(HWND handle, const char *filename)
+{
+    /* No image decoders in this backend */
+    return NULL;
+}
+
+/*
+ * Creates a pixmap from a file and passes it to a callback.
+ * There is no background loader on this platform, so the file
+ * is loaded and the callback run on the calling thread before
+ * this function returns.
+ * Parameters:
+ *       handle: Window handle the pixmap is associated with.
+ *       filename: Name of the file, omit extention to have
+ *                 DW pick the appropriate file extension.
+ *                 (BMP on OS/2 or Windows, XPM on Unix)
+ *       callback: Function of the form int func(HPIXMAP pixmap, void *data)
+ *                 pixmap will be NULL if the file could not be loaded.
+ *       data: User data to be passed to the callback.
+ * Returns:
+ *       DW_ERROR_NONE once the callback has run, DW_ERROR_GENERAL on error
+ *       in which case the callback will not be called.
+ */
+int API dw_pixmap_new_from_file_async(HWND handle, const char *filename, void *callback, void *data)
+{
+    int (*pixmapfunc)(HPIXMAP, void *) = (int (*)(HPIXMAP, void *))callback;
+
+    if(!filename || !*filename || !callback)
+        return DW_ERROR_GENERAL;
+
+    /* No background loader on this platform, load it immediately */
+    pixmapfunc(dw_pixmap_new_from_file(handle, filename), data);
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Creates a pixmap from data in memory.
+ * Parameters:
+ *       handle: Window handle the pixmap is associated with.
+ *       data: Source of the image data
+ *                 (BMP on OS/2 or Windows, XPM on Unix)
+ *       len: Length of data
+ * Returns:
+ *       A handle to a pixmap or NULL on failure.
+ */
+HPIXMAP API dw_pixmap_new_from_data(HWND handle, const char *data, int len)
+{
+    return NULL;
+}
+
+/*
+ * Sets the transparent color for a pixmap.
+ * Parameters:
+ *       pixmap: Handle to a pixmap returned by
+ *               dw_pixmap_new..
+ *       color:  Transparent RGB color
+ * Note: This is only necessary on platforms that
+ *       don't handle transparency automatically
+ */
+void API dw_pixmap_set_transparent_color( HPIXMAP pixmap, ULONG color )
+{
+    if(pixmap)
+        pixmap->transcolor = color;
+}
+
+/*
+ * Creates a pixmap from internal resource graphic specified by id.
+ * Parameters:
+ *       handle: Window handle the pixmap is associated with.
+ *       id: Resource ID associated with requested pixmap.
+ * Returns:
+ *       A handle to a pixmap or NULL on failure.
+ */
+HPIXMAP API dw_pixmap_grab(HWND handle, ULONG resid)
+{
+    return NULL;
+}
+
+/*
+ * Sets the font used by a specified pixmap.
+ * Normally the pixmap font is obtained from the associated window handle.
+ * However this can be used to override that, or for pixmaps with no window.
+ * Parameters:
+ *          pixmap: Handle to a pixmap returned by dw_pixmap_new() or
+ *                  passed to the application via a callback.
+ *          fontname: Name and size of the font in the form "size.fontname"
+ * Returns:
+ *       DW_ERROR_NONE on success and DW_ERROR_GENERAL on failure.
+*/
+int API dw_pixmap_set_font(HPIXMAP pixmap, const char *fontname)
+{
+    if(!pixmap)
+        return DW_ERROR_GENERAL;
+    free(pixmap->font);
+    pixmap->font = fontname ? strdup(fontname) : NULL;
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Destroys an allocated pixmap.
+ * Parameters:
+ *       pixmap: Handle to a pixmap returned by
+ *               dw_pixmap_new..
+ */
+void API dw_pixmap_destroy(HPIXMAP pixmap)
+{
+    if(pixmap)
+    {
+        free(pixmap->pixels);
+        free(pixmap->font);
+        free(pixmap);
+    }
+}
+
+/*
+ * Returns the width of the pixmap, same as the DW_PIXMAP_WIDTH() macro,
+ * but exported as an API, for non-C language bindings.
+ */
+unsigned long API dw_pixmap_get_width(HPIXMAP pixmap)
+{
+    return pixmap ? pixmap->width : 0;
+}
+
+/*
+ * Returns the height of the pixmap, same as the DW_PIXMAP_HEIGHT() macro,
+ * but exported as an API, for non-C language bindings.
+ */
+unsigned long API dw_pixmap_get_height(HPIXMAP pixmap)
+{
+    return pixmap ? pixmap->height : 0;
+}
+
+/*
+ * Copies from one item to another.
+ * Parameters:
+ *       dest: Destination window handle.
+ *       destp: Destination pixmap. (choose only one).
+ *       xdest: X coordinate of destination.
+ *       ydest: Y coordinate of destination.
+ *       width: Width of area to copy.
+ *       height: Height of area to copy.
+ *       src: Source window handle.
+ *       srcp: Source pixmap. (choose only one).
+ *       xsrc: X coordinate of source.
+ *       ysrc: Y coordinate of source.
+ */
+void API dw_pixmap_bitblt(HWND dest, HPIXMAP destp, int xdest, int ydest, int width, int height, HWND src, HPIXMAP srcp, int xsrc, int ysrc)
+{
+    dw_pixmap_stretch_bitblt(dest, destp, xdest, ydest, width, height, src, srcp, xsrc, ysrc, -1, -1);
+}
+
+/*
+ * Copies from one surface to another allowing for stretching.
+ * Parameters:
+ *       dest: Destination window handle.
+ *       destp: Destination pixmap. (choose only one).
+ *       xdest: X coordinate of destination.
+ *       ydest: Y coordinate of destination.
+ *       width: Width of the target area.
+ *       height: Height of the target area.
+ *       src: Source window handle.
+ *       srcp: Source pixmap. (choose only one).
+ *       xsrc: X coordinate of source.
+ *       ysrc: Y coordinate of source.
+ *       srcwidth: Width of area to copy.
+ *       srcheight: Height of area to copy.
+ * Returns:
+ *       DW_ERROR_NONE on success and DW_ERROR_GENERAL on failure.
+ */
+int API dw_pixmap_stretch_bitblt(HWND dest, HPIXMAP destp, int xdest, int ydest, int width, int height, HWND src, HPIXMAP srcp, int xsrc, int ysrc, int srcwidth, int srcheight)
+{
+    HPIXMAP target = _dw_draw_target(dest, destp), source = _dw_draw_target(src, srcp);
+    unsigned int transcolor = 0;
+    int x, y, trans = FALSE;
+
+    if(!target || !source || width < 1 || height < 1)
+        return DW_ERROR_GENERAL;
+
+    if(srcwidth == -1)
+        srcwidth = width;
+    if(srcheight == -1)
+        srcheight = height;
+    if(srcwidth < 1 || srcheight < 1)
+        return DW_ERROR_GENERAL;
+
+    if(srcp && srcp->transcolor != DW_CLR_DEFAULT)
+    {
+        transcolor = _dw_argb(srcp->transcolor, 0);
+        trans = TRUE;
+    }
+
+    /* Nearest neighbor scaling, clipped to both buffers */
+    for(y=0;y<height;y++)
+    {
+        int ty = ydest + y, sy = ysrc + (int)(((long long)y * srcheight) / height);
+
+        if(ty < 0 || ty >= (int)target->height || sy < 0 || sy >= (int)source->height)
+            continue;
+        for(x=0;x<width;x++)
+        {
+            int tx = xdest + x, sx = xsrc + (int)(((long long)x * srcwidth) / width);
+            unsigned int pixel;
+
+            if(tx < 0 || tx >= (int)target->width || sx < 0 || sx >= (int)source->width)
+                continue;
+            pixel = source->pixels[(sy * source->width) + sx];
+            if(!trans || pixel != transcolor)
+                target->pixels[(ty * target->width) + tx] = pixel;
+        }
+    }
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Create a new calendar window (widget) to be packed.
+ * Parameters:
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       Handle to the created calendar or NULL on error.
+ */
+HWND API dw_calendar_new(ULONG cid)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_CALENDAR, NULL, cid);
+
+    /* Start out on the current date like the other backends */
+    if(widget)
+    {
+        time_t now = time(NULL);
+        struct tm *tmp = localtime(&now);
+
+        dw_calendar_set_date((HWND)widget, tmp->tm_year + 1900, tmp->tm_mon + 1, tmp->tm_mday);
+    }
+    return (HWND)widget;
+}
+
+/*
+ * Sets the current date of a calendar.
+ * Parameters:
+ *       handle: The handle to the calendar returned by dw_calendar_new().
+ *       year, month, day: To set the calendar to display.
+ */
+void API dw_calendar_set_date(HWND handle, unsigned int year, unsigned int month, unsigned int day)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    /* Year, month and day are kept in lower, upper and range */
+    if(widget && widget->type == _DW_WIDGET_CALENDAR)
+    {
+        widget->lower = year;
+        widget->upper = month;
+        widget->range = day;
+    }
+}
+
+/*
+ * Gets the year, month and day set in the calendar widget.
+ * Parameters:
+ *       handle: The handle to the calendar returned by dw_calendar_new().
+ *       year: Variable to store the year or NULL.
+ *       month: Variable to store the month or NULL.
+ *       day: Variable to store the day or NULL.
+ */
+void API dw_calendar_get_date(HWND handle, unsigned int *year, unsigned int *month, unsigned int *day)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_CALENDAR)
+    {
+        if(year)
+            *year = (unsigned int)widget->lower;
+        if(month)
+            *month = (unsigned int)widget->upper;
+        if(day)
+            *day = (unsigned int)widget->range;
+    }
+}
+
+/*
+ * Causes the embedded HTML widget to take action.
+ * Parameters:
+ *       handle: Handle to the window.
+ *       action: One of the DW_HTML_* constants.
+ */
+void API dw_html_action(HWND handle, int action)
+{
+}
+
+/*
+ * Render raw HTML code in the embedded HTML widget..
+ * Parameters:
+ *       handle: Handle to the window.
+ *       string: String buffer containt HTML code to
+ *               be rendered.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_html_raw(HWND handle, const char *string)
+{
+    return DW_ERROR_GENERAL;
+}
+
+/*
+ * Render file or web page in the embedded HTML widget..
+ * Parameters:
+ *       handle: Handle to the window.
+ *       url: Universal Resource Locator of the web or
+ *               file object to be rendered.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_html_url(HWND handle, const char *url)
+{
+    return DW_ERROR_GENERAL;
+}
+
+/*
+ * Executes the javascript contained in "script" in the HTML window.
+ * Parameters:
+ *       handle: Handle to the HTML window.
+ *       script: Javascript code to execute.
+ *       scriptdata: Data passed to the signal handler.
+ * Notes: A DW_SIGNAL_HTML_RESULT event will be raised with scriptdata.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_html_javascript_run(HWND handle, const char *script, void *scriptdata)
+{
+   return DW_ERROR_UNKNOWN;
+}
+
+/*
+ * Install a javascript function with name that can call native code.
+ * Parameters:
+ *       handle: Handle to the HTML window.
+ *       name: Javascript function name.
+ * Notes: A DW_SIGNAL_HTML_MESSAGE event will be raised with scriptdata.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_html_javascript_add(HWND handle, const char *name)
+{
+    return DW_ERROR_UNKNOWN;
+}
+
+/*
+ * Create a new HTML window (widget) to be packed.
+ * Parameters:
+ *       id: An ID to be used with dw_window_from_id() or 0L.
+ * Returns:
+ *       Handle to the created html widget or NULL on error.
+ */
+HWND API dw_html_new(unsigned long cid)
+{
+    return 0;
+}
+
+/*
+ * Returns the current X and Y coordinates of the mouse pointer.
+ * Parameters:
+ *       x: Pointer to variable to store X coordinate or NULL.
+ *       y: Pointer to variable to store Y coordinate or NULL.
+ */
+void API dw_pointer_query_pos(long *x, long *y)
+{
+    if(x)
+        *x = _dw_pointer_x;
+    if(y)
+        *y = _dw_pointer_y;
+}
+
+/*
+ * Sets the X and Y coordinates of the mouse pointer.
+ * Parameters:
+ *       x: X coordinate.
+ *       y: Y coordinate.
+ */
+void API dw_pointer_set_pos(long x, long y)
+{
+    _dw_pointer_x = x;
+    _dw_pointer_y = y;
+}
+
+/*
+ * Create a menu object to be popped up.
+ * Parameters:
+ *       id: An ID to be used associated with this menu.
+ * Returns:
+ *       Handle to the created menu or NULL on error.
+ */
+HMENUI API dw_menu_new(ULONG cid)
+{
+    return (HMENUI)_dw_widget_new(_DW_WIDGET_MENU, NULL, cid);
+}
+
+/*
+ * Create a menubar on a window.
+ * Parameters:
+ *       location: Handle of a window frame to be attached to.
+ * Returns:
+ *       Handle to the created menu bar or NULL on error.
+ */
+HMENUI API dw_menubar_new(HWND location)
+{
+    DWWidget *window = (DWWidget *)location, *menubar;
+
+    if(!window || window->type != _DW_WIDGET_WINDOW)
+        return 0;
+
+    /* A window's menubar is kept in its children */
+    if(!window->children && (menubar = _dw_widget_new(_DW_WIDGET_MENU, NULL, 0)))
+    {
+        menubar->parent = window;
+        window->children = menubar;
+    }
+    return (HMENUI)window->children;
+}
+
+/*
+ * Destroys a menu created with dw_menubar_new or dw_menu_new.
+ * Parameters:
+ *       menu: Handle of a menu.
+ */
+void API dw_menu_destroy(HMENUI *menu)
+{
+    if(menu && *menu)
+    {
+        DWWidget *widget = (DWWidget *)*menu;
+
+        if(widget->parent && widget->parent->children == widget)
+            widget->parent->children = NULL;
+        _dw_menu_free(widget);
+        *menu = 0;
+    }
+}
+
+/*
+ * Deletes the menu item specified.
+ * Parameters:
+ *       menu: The handle to the  menu in which the item was appended.
+ *       id: Menuitem id.
+ * Returns: 
+ *       DW_ERROR_NONE (0) on success or DW_ERROR_UNKNOWN on failure.
+ */
+int API dw_menu_delete_item(HMENUI menux, unsigned long id)
+{
+    DWWidget *menu = (DWWidget *)menux, **prev;
+
+    if(!menu)
+        return DW_ERROR_UNKNOWN;
+
+    for(prev = &menu->children;*prev;prev = &(*prev)->next)
+    {
+        if((*prev)->id == id)
+        {
+            DWWidget *item = *prev;
+
+            *prev = item->next;
+            item->next = NULL;
+            _dw_menu_free(item);
+            return DW_ERROR_NONE;
+        }
+    }
+    return DW_ERROR_UNKNOWN;
+}
+
+/*
+ * Pops up a context menu at given x and y coordinates.
+ * Parameters:
+ *       menu: The handle the the existing menu.
+ *       parent: Handle to the window initiating the popup.
+ *       x: X coordinate.
+ *       y: Y coordinate.
+ */
+void API dw_menu_popup(HMENUI *menu, HWND parent, int x, int y)
+{
+    /* Nobody picks an item, popup menus go away after use */
+    dw_menu_destroy(menu);
+}
+
+/*
+ * Adds a menuitem or submenu to an existing menu.
+ * Parameters:
+ *       menu: The handle the the existing menu.
+ *       title: The title text on the menu item to be added.
+ *       id: An ID to be used for message passing.
+ *       flags: Extended attributes to set on the menu.
+ *       end: If TRUE memu is positioned at the end of the menu.
+ *       check: If TRUE menu is "check"able.
+ *       submenu: Handle to an existing menu to be a submenu or NULL.
+ * Returns:
+ *       Handle to the created menu item or NULL on error.
+ */
+HWND API dw_menu_append_item(HMENUI menux, const char *title, ULONG itemid, ULONG flags, int end, int check, HMENUI submenux)
+{
+    DWWidget *menu = (DWWidget *)menux, *item, **prev;
+
+    if(!menu || !(item = _dw_widget_new(_DW_WIDGET_MENUITEM, title, itemid == DW_MENU_AUTO ? 0 : itemid)))
+        return 0;
+
+    if(itemid == DW_MENU_AUTO || itemid == DW_MENU_POPUP)
+    {
+        pthread_mutex_lock(&_dw_mutex);
+        item->id = _dw_menu_id++;
+        pthread_mutex_unlock(&_dw_mutex);
+    }
+    item->parent = menu;
+    item->style = check;
+    item->value = (flags & DW_MIS_CHECKED) ? TRUE : FALSE;
+    item->enabled = (flags & DW_MIS_DISABLED) ? FALSE : TRUE;
+    /* A menu item's children is its submenu */
+    if((item->children = (DWWidget *)submenux))
+        item->children->parent = item;
+
+    if(end)
+    {
+        for(prev = &menu->children;*prev;prev = &(*prev)->next)
+        {
+        }
+        *prev = item;
+    }
+    else
+    {
+        item->next = menu->children;
+        menu->children = item;
+    }
+    return (HWND)item;
+}
+
+/*
+ * Sets the state of a menu item check.
+ * Deprecated; use dw_menu_item_set_state()
+ * Parameters:
+ *       menu: The handle the the existing menu.
+ *       id: Menuitem id.
+ *       check: TRUE for checked FALSE for not checked.
+ */
+void API dw_menu_item_set_check(HMENUI menux, unsigned long itemid, int check)
+{
+    DWWidget *item = _dw_menu_item_find((DWWidget *)menux, itemid);
+
+    if(item)
+        item->value = check ? TRUE : FALSE;
+}
+
+/*
+ * Sets the state of a menu item.
+ * Parameters:
+ *       menu: The handle to the existing menu.
+ *       id: Menuitem id.
+ *       flags: DW_MIS_ENABLED/DW_MIS_DISABLED
+ *              DW_MIS_CHECKED/DW_MIS_UNCHECKED
+ */
+void API dw_menu_item_set_state(HMENUI menux, unsigned long itemid, unsigned long state)
+{
+    DWWidget *item = _dw_menu_item_find((DWWidget *)menux, itemid);
+
+    if(item)
+    {
+        if(state & DW_MIS_CHECKED)
+            item->value = TRUE;
+        else if(state & DW_MIS_UNCHECKED)
+            item->value = FALSE;
+        if(state & DW_MIS_ENABLED)
+            item->enabled = TRUE;
+        else if(state & DW_MIS_DISABLED)
+            item->enabled = FALSE;
+    }
+}
+
+/*
+ * Create a notebook object to be packed.
+ * Parameters:
+ *       id: An ID to be used for getting the resource from the
+ *           resource file.
+ * Returns:
+ *       Handle to the created notebook or NULL on error.
+ */
+HWND API dw_notebook_new(ULONG cid, int top)
+{
+    DWWidget *widget = _dw_widget_new(_DW_WIDGET_NOTEBOOK, NULL, cid);
+
+    if(widget)
+        widget->style = top;
+    return (HWND)widget;
+}
+
+/*
+ * Adds a new page to specified notebook.
+ * Parameters:
+ *          handle: Window (widget) handle.
+ *          flags: Any additional page creation flags.
+ *          front: If TRUE page is added at the beginning.
+ * Returns:
+ *       ID of newly created notebook page.
+ */
+unsigned long API dw_notebook_page_new(HWND handle, ULONG flags, int front)
+{
+    DWWidget *widget = _dw_notebook(handle);
+    DWNotebookPage *page, **prev;
+
+    if(!widget || !(page = calloc(1, sizeof(DWNotebookPage))))
+        return 0;
+
+    /* Page IDs count up from 1 in range */
+    page->id = (unsigned long)++widget->range;
+    if(front)
+    {
+        page->next = (DWNotebookPage *)widget->model;
+        widget->model = page;
+    }
+    else
+    {
+        for(prev = (DWNotebookPage **)&widget->model;*prev;prev = &(*prev)->next)
+        {
+        }
+        *prev = page;
+    }
+    if(!widget->current)
+        widget->current = page;
+    return page->id;
+}
+
+/*
+ * Remove a page from a notebook.
+ * Parameters:
+ *          handle: Handle to the notebook widget.
+ *          pageid: ID of the page to be destroyed.
+ */
+void API dw_notebook_page_destroy(HWND handle, unsigned long pageid)
+{
+    DWWidget *widget = _dw_notebook(handle);
+    DWNotebookPage **prev;
+
+    if(!widget)
+        return;
+
+    for(prev = (DWNotebookPage **)&widget->model;*prev;prev = &(*prev)->next)
+    {
+        DWNotebookPage *page = *prev;
+
+        if(page->id == pageid)
+        {
+            *prev = page->next;
+            if(widget->current == page)
+                widget->current = widget->model;
+            if(page->page)
+            {
+                page->page->parent = NULL;
+                dw_window_destroy((HWND)page->page);
+            }
+            free(page->text);
+            free(page->status);
+            free(page);
+            return;
+        }
+    }
+}
+
+/*
+ * Queries the currently visible page ID.
+ * Parameters:
+ *          handle: Handle to the notebook widget.
+ * Returns:
+ *       ID of visible notebook page.
+ */
+unsigned long API dw_notebook_page_get(HWND handle)
+{
+    DWWidget *widget = _dw_notebook(handle);
+
+    if(widget && widget->current)
+        return ((DWNotebookPage *)widget->current)->id;
+    return 0;
+}
+
+/*
+ * Sets the currently visible page ID.
+ * Parameters:
+ *          handle: Handle to the notebook widget.
+ *          pageid: ID of the page to be made visible.
+ */
+void API dw_notebook_page_set(HWND handle, unsigned long pageid)
+{
+    DWWidget *widget = _dw_notebook(handle);
+    DWNotebookPage *page = _dw_notebook_page(widget, pageid);
+
+    if(page && widget->current != page)
+    {
+        DWSignalHandler *handler = NULL;
+
+        widget->current = page;
+        while((handler = _dw_signal_next(widget, handler, DW_SIGNAL_SWITCH_PAGE)))
+        {
+            int (*sigfunc)(HWND, unsigned long, void *) = handler->func;
+
+            sigfunc((HWND)widget, pageid, handler->data);
+        }
+    }
+}
+
+/*
+ * Sets the text on the specified notebook tab.
+ * Parameters:
+ *          handle: Notebook handle.
+ *          pageid: Page ID of the tab to set.
+ *          text: Pointer to the text to set.
+ */
+void API dw_notebook_page_set_text(HWND handle, ULONG pageid, const char *text)
+{
+    DWNotebookPage *page = _dw_notebook_page(_dw_notebook(handle), pageid);
+
+    if(page)
+    {
+        free(page->text);
+        page->text = text ? strdup(text) : NULL;
+    }
+}
+
+/*
+ * Sets the text on the specified notebook tab status area.
+ * Parameters:
+ *          handle: Notebook handle.
+ *          pageid: Page ID of the tab to set.
+ *          text: Pointer to the text to set.
+ */
+void API dw_notebook_page_set_status_text(HWND handle, ULONG pageid, const char *text)
+{
+    DWNotebookPage *page = _dw_notebook_page(_dw_notebook(handle), pageid);
+
+    if(page)
+    {
+        free(page->status);
+        page->status = text ? strdup(text) : NULL;
+    }
+}
+
+/*
+ * Packs the specified box into the notebook page.
+ * Parameters:
+ *          handle: Handle to the notebook to be packed.
+ *          pageid: Page ID in the notebook which is being packed.
+ *          page: Box handle to be packed.
+ */
+void API dw_notebook_pack(HWND handle, ULONG pageid, HWND page)
+{
+    DWWidget *widget = _dw_notebook(handle);
+    DWNotebookPage *thispage = _dw_notebook_page(widget, pageid);
+
+    if(thispage && page)
+    {
+        thispage->page = (DWWidget *)page;
+        thispage->page->parent = widget;
+        _dw_box_invalidate(widget);
+        _dw_layout_queue(widget);
+    }
+}
+
+/*
+ * Create a new Window Frame.
+ * Parameters:
+ *       owner: The Owner's window handle or HWND_DESKTOP.
+ *       title: The Window title.
+ *       flStyle: Style flags.
+ * Returns:
+ *       Handle to the created window or NULL on error.
+ */
+HWND API dw_window_new(HWND hwndOwner, const char *title, ULONG flStyle)
+{
+    DWWidget *widget = _dw_box_widget_new(_DW_WIDGET_WINDOW, DW_VERT, 0, title);
+
+    /* Windows start out hidden until dw_window_show() */
+    if(widget)
+    {
+        widget->style = flStyle;
+        widget->visible = FALSE;
+    }
+    return (HWND)widget;
+}
+
+/*
+ * Call a function from the window (widget)'s context (typically the message loop thread).
+ * Parameters:
+ *       handle: Window handle of the widget.
+ *       function: Function pointer to be called.
+ *       data: Pointer to the data to be passed to the function.
+ */
+void API dw_window_function(HWND handle, void *function, void *data)
+{
+    void (*windowfunc)(void *) = function;
+
+    if(windowfunc)
+        windowfunc(data);
+}
+
+
+/*
+ * Changes the appearance of the mouse pointer.
+ * Parameters:
+ *       handle: Handle to widget for which to change.
+ *       cursortype: ID of the pointer you want.
+ */
+void API dw_window_set_pointer(HWND handle, int pointertype)
+{
+}
+
+/*
+ * Makes the window visible.
+ * Parameters:
+ *           handle: The window handle to make visible.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_window_show(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(!widget)
+        return DW_ERROR_GENERAL;
+
+    if(widget->type == _DW_WIDGET_WINDOW && !widget->visible)
+    {
+        /* Windows without a size get their preferred size */
+        if(!widget->width || !widget->height)
+        {
+            int width, height;
+
+            _dw_widget_preferred_size(widget, &width, &height);
+            widget->width = width > 0 ? width : 1;
+            widget->height = height > 0 ? height : 1;
+        }
+        widget->visible = TRUE;
+        _dw_layout_queue(widget);
+        _dw_queue_call(widget, _dw_render_configure, NULL);
+    }
+    else if(!widget->visible)
+    {
+        widget->visible = TRUE;
+        _dw_layout_queue(widget);
+    }
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Makes the window invisible.
+ * Parameters:
+ *           handle: The window handle to hide.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_window_hide(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(!widget)
+        return DW_ERROR_GENERAL;
+    widget->visible = FALSE;
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Sets the colors used by a specified window (widget) handle.
+ * Parameters:
+ *          handle: The window (widget) handle.
+ *          fore: Foreground color in DW_RGB format or a default color index.
+ *          back: Background color in DW_RGB format or a default color index.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_window_set_color(HWND handle, ULONG fore, ULONG back)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(!widget)
+        return DW_ERROR_GENERAL;
+    widget->fore = fore;
+    widget->back = back;
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Sets the border size of a specified window (widget) handle.
+ * Parameters:
+ *          handle: The window (widget) handle.
+ *          border: Size of the window border in pixels.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_window_set_border(HWND handle, int border)
+{
+    return DW_ERROR_GENERAL;
+}
+
+/*
+ * Sets the style of a given window (widget).
+ * Parameters:
+ *          handle: Window (widget) handle.
+ *          style: Style features enabled or disabled.
+ *          mask: Corresponding bitmask of features to be changed.
+ */
+void API dw_window_set_style(HWND handle, ULONG style, ULONG mask)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    /* Other widgets use style for their own state */
+    if(widget && (widget->type == _DW_WIDGET_WINDOW || widget->type == _DW_WIDGET_TEXT))
+        widget->style = (widget->style & ~mask) | (style & mask);
+}
+
+/*
+ * Sets the current focus item for a window/dialog.
+ * Parameters:
+ *         handle: Handle to the dialog item to be focused.
+ * Remarks:
+ *          This is for use after showing the window/dialog.
+ */
+void API dw_window_set_focus(HWND handle)
+{
+}
+
+/*
+ * Sets the default focus item for a window/dialog.
+ * Parameters:
+ *         window: Toplevel window or dialog.
+ *         defaultitem: Handle to the dialog item to be default.
+ * Remarks:
+ *          This is for use before showing the window/dialog.
+ */
+void API dw_window_default(HWND handle, HWND defaultitem)
+{
+}
+
+/*
+ * Sets window to click the default dialog item when an ENTER is pressed.
+ * Parameters:
+ *         window: Window (widget) to look for the ENTER press.
+ *         next: Window (widget) to move to next (or click)
+ */
+void API dw_window_click_default(HWND handle, HWND next)
+{
+}
+
+/*
+ * Captures the mouse input to this window even if it is outside the bounds.
+ * Parameters:
+ *       handle: Handle to receive mouse input.
+ */
+void API dw_window_capture(HWND handle)
+{
+}
+
+/*
+ * Releases previous mouse capture.
+ */
+void API dw_window_release(void)
+{
+}
+
+/*
+ * Changes a window's parent to newparent.
+ * Parameters:
+ *           handle: The window handle to destroy.
+ *           newparent: The window's new parent window.
+ */
+void API dw_window_reparent(HWND handle, HWND newparent)
+{
+}
+
+/*
+ * Sets the font used by a specified window (widget) handle.
+ * Parameters:
+ *          handle: The window (widget) handle.
+ *          fontname: Name and size of the font in the form "size.fontname"
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_window_set_font(HWND handle, const char *fontname)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(!widget)
+        return DW_ERROR_GENERAL;
+    free(widget->font);
+    widget->font = (fontname && *fontname) ? strdup(fontname) : NULL;
+    _dw_box_invalidate(widget);
+    _dw_layout_queue(widget);
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Returns the current font for the specified window.
+ * Parameters:
+ *           handle: The window handle from which to obtain the font.
+ * Returns:
+ *       A malloc()ed font name string to be dw_free()ed or NULL on error.
+ */
+char * API dw_window_get_font(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(!widget)
+        return NULL;
+    if(widget->font)
+        return strdup(widget->font);
+    return strdup(_dw_default_font ? _dw_default_font : _DW_DEFAULT_FONT);
+}
+
+/* Allows the user to choose a font using the system's font chooser dialog.
+ * Parameters:
+ *       currfont: current font
+ * Returns:
+ *       A malloced buffer with the selected font or NULL on error.
+ */
+char * API dw_font_choose(const char *currfont)
+{
+    return currfont ? strdup(currfont) : NULL;
+}
+
+/*
+ * Sets the default font used on text based widgets.
+ * Parameters:
+ *           fontname: Font name in Dynamic Windows format.
+ */
+void API dw_font_set_default(const char *fontname)
+{
+    char *oldfont = _dw_default_font;
+
+    _dw_default_font = (fontname && *fontname) ? strdup(fontname) : NULL;
+    free(oldfont);
+}
+
+/*
+ * Destroys a window and all of it's children.
+ * Parameters:
+ *           handle: The window handle to destroy.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_window_destroy(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle, *parent;
+
+    if(!widget)
+        return DW_ERROR_GENERAL;
+
+    /* Menus are destroyed with their own functions */
+    if(widget->type == _DW_WIDGET_MENU || widget->type == _DW_WIDGET_MENUITEM)
+    {
+        if((parent = widget->parent) && widget->type == _DW_WIDGET_MENUITEM)
+            dw_menu_delete_item((HMENUI)parent, widget->id);
+        else
+            dw_menu_destroy((HMENUI *)&widget);
+        return DW_ERROR_NONE;
+    }
+
+    /* Remove it from whatever it is packed in */
+    if((parent = widget->parent))
+    {
+        if(parent->box)
+            dw_box_unpack(handle);
+        else if(parent->type == _DW_WIDGET_SPLITBAR)
+        {
+            if(parent->topleft == widget)
+                parent->topleft = NULL;
+            if(parent->bottomright == widget)
+                parent->bottomright = NULL;
+        }
+        else if(parent->type == _DW_WIDGET_NOTEBOOK)
+        {
+            DWNotebookPage *page;
+
+            for(page = (DWNotebookPage *)parent->model;page;page = page->next)
+            {
+                if(page->page == widget)
+                    page->page = NULL;
+            }
+        }
+    }
+    _dw_widget_free(widget);
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Gets the text used for a given window.
+ * Parameters:
+ *       handle: Handle to the window.
+ * Returns:
+ *       The text associsated with a given window or NULL on error.
+ */
+char * API dw_window_get_text(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->text)
+        return strdup(widget->text);
+    return NULL;
+}
+
+/*
+ * Sets the text used for a given window.
+ * Parameters:
+ *       handle: Handle to the window.
+ *       text: The text associsated with a given window.
+ */
+void API dw_window_set_text(HWND handle, const char *text)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget)
+    {
+        free(widget->text);
+        widget->text = strdup(text ? text : "");
+        if(widget->type == _DW_WIDGET_SPINBUTTON)
+            widget->value = atol(widget->text);
+        /* Groupbox titles are part of the box layout */
+        if(widget->type == _DW_WIDGET_GROUPBOX)
+        {
+            _dw_box_invalidate(widget);
+            _dw_layout_queue(widget);
+        }
+    }
+}
+
+/*
+ * Sets the text used for a given window's floating bubble help.
+ * Parameters:
+ *       handle: Handle to the window (widget).
+ *       bubbletext: The text in the floating bubble tooltip.
+ */
+void API dw_window_set_tooltip(HWND handle, const char *bubbletext)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget)
+    {
+        free(widget->tooltip);
+        widget->tooltip = (bubbletext && *bubbletext) ? strdup(bubbletext) : NULL;
+    }
+}
+
+/*
+ * Disables given window (widget).
+ * Parameters:
+ *       handle: Handle to the window.
+ */
+void API dw_window_disable(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget)
+        widget->enabled = FALSE;
+}
+
+/*
+ * Enables given window (widget).
+ * Parameters:
+ *       handle: Handle to the window.
+ */
+void API dw_window_enable(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget)
+        widget->enabled = TRUE;
+}
+
+/*
+ * Sets the bitmap used for a given static window.
+ * Parameters:
+ *       handle: Handle to the window.
+ *       id: An ID to be used to specify the icon,
+ *           (pass 0 if you use the filename param)
+ *       data: memory buffer containing image (Bitmap on OS/2 or
+ *                 Windows and a pixmap on Unix, pass
+ *                 NULL if you use the id param)
+ *       len: Length of data passed
+ * Returns:
+ *        DW_ERROR_NONE on success.
+ *        DW_ERROR_UNKNOWN if the parameters were invalid.
+ *        DW_ERROR_GENERAL if the bitmap was unable to be loaded.
+ */
+int API dw_window_set_bitmap_from_data(HWND handle, unsigned long cid, const char *data, int len)
+{
+    DWWidget *widget = (DWWidget *)handle;
+    HICN icon = cid ? (HICN)cid : dw_icon_load_from_data(data, len);
+
+    if(!widget || !icon || (widget->type != _DW_WIDGET_BUTTON && widget->type != _DW_WIDGET_BITMAP))
+    {
+        if(!cid)
+            dw_icon_free(icon);
+        return DW_ERROR_GENERAL;
+    }
+    dw_icon_free(widget->icon);
+    widget->icon = icon;
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Sets the bitmap used for a given static window.
+ * Parameters:
+ *       handle: Handle to the window.
+ *       id: An ID to be used to specify the icon,
+ *           (pass 0 if you use the filename param)
+ *       filename: a path to a file (Bitmap on OS/2 or
+ *                 Windows and a pixmap on Unix, pass
+ *                 NULL if you use the id param)
+ * Returns:
+ *        DW_ERROR_NONE on success.
+ *        DW_ERROR_UNKNOWN if the parameters were invalid.
+ *        DW_ERROR_GENERAL if the bitmap was unable to be loaded.
+ */
+int API dw_window_set_bitmap(HWND handle, unsigned long resid, const char *filename)
+{
+    DWWidget *widget = (DWWidget *)handle;
+    HICN icon = resid ? (HICN)resid : dw_icon_load_from_file(filename);
+
+    if(!widget || !icon || (widget->type != _DW_WIDGET_BUTTON && widget->type != _DW_WIDGET_BITMAP))
+    {
+        if(!resid)
+            dw_icon_free(icon);
+        return DW_ERROR_GENERAL;
+    }
+    dw_icon_free(widget->icon);
+    widget->icon = icon;
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Sets the icon used for a given window.
+ * Parameters:
+ *       handle: Handle to the window.
+ *       icon: Handle to icon to be used.
+ */
+void API dw_window_set_icon(HWND handle, HICN icon)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_WINDOW)
+        widget->icon = icon;
+}
+
+/*
+ * Gets the child window handle with specified ID.
+ * Parameters:
+ *       handle: Handle to the parent window.
+ *       id: Integer ID of the child.
+ * Returns:
+ *       HWND of window with ID or NULL on error.
+ */
+HWND API dw_window_from_id(HWND handle, int id)
+{
+    DWWidget *widget = (DWWidget *)handle, *found = NULL;
+
+    if(widget && widget->box)
+    {
+        int z;
+
+        for(z=0;z<widget->box->count && !found;z++)
+            found = _dw_widget_find((DWWidget *)widget->box->items[z].hwnd, (unsigned long)id);
+    }
+    return (HWND)found;
+}
+
+/*
+ * Minimizes or Iconifies a top-level window.
+ * Parameters:
+ *           handle: The window handle to minimize.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_window_minimize(HWND handle)
+{
+    return dw_window_hide(handle);
+}
+
+/* Causes entire window to be invalidated and redrawn.
+ * Parameters:
+ *           handle: Toplevel window handle to be redrawn.
+ */
+void API dw_window_redraw(HWND handle)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget)
+    {
+        if(widget->type == _DW_WIDGET_RENDER)
+            dw_render_redraw(handle);
+        else
+        {
+            _dw_box_invalidate(widget);
+            _dw_layout_queue(widget);
+        }
+    }
+}
+
+/*
+ * Suspends automatic layout of a top-level window, used
+ * when packing a large number of widgets at once.
+ * Calls may be nested, each must be matched by a thaw.
+ * Parameters:
+ *           handle: Toplevel window handle.
+ * Returns:
+ *       DW_ERROR_NONE on success or DW_ERROR_GENERAL on error.
+ */
+int API dw_window_layout_freeze(HWND handle)
+{
+    DWWidget *window = _dw_toplevel((DWWidget *)handle);
+
+    if(!window || window->type != _DW_WIDGET_WINDOW)
+        return DW_ERROR_GENERAL;
+    window->freeze++;
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Resumes automatic layout of a top-level window, the layout
+ * is queued when the last freeze is removed.
+ * Parameters:
+ *           handle: Toplevel window handle.
+ * Returns:
+ *       DW_ERROR_NONE on success or DW_ERROR_GENERAL on error.
+ */
+int API dw_window_layout_thaw(HWND handle)
+{
+    DWWidget *window = _dw_toplevel((DWWidget *)handle);
+
+    if(!window || window->type != _DW_WIDGET_WINDOW || window->freeze < 1)
+        return DW_ERROR_GENERAL;
+    /* Run any layout requested while frozen */
+    if(!--window->freeze && window->dirty)
+        _dw_queue_call(window, _dw_window_layout, NULL);
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Makes the window topmost.
+ * Parameters:
+ *           handle: The window handle to make topmost.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_window_raise(HWND handle)
+{
+    return handle ? DW_ERROR_NONE : DW_ERROR_GENERAL;
+}
+
+/*
+ * Makes the window bottommost.
+ * Parameters:
+ *           handle: The window handle to make bottommost.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_window_lower(HWND handle)
+{
+    return handle ? DW_ERROR_NONE : DW_ERROR_GENERAL;
+}
+
+/*
+ * Sets the size of a given window (widget).
+ * Parameters:
+ *          handle: Window (widget) handle.
+ *          width: New width in pixels.
+ *          height: New height in pixels.
+ */
+void API dw_window_set_size(HWND handle, ULONG width, ULONG height)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_WINDOW &&
+       (widget->width != (int)width || widget->height != (int)height))
+    {
+        widget->width = (int)width;
+        widget->height = (int)height;
+        if(widget->visible)
+        {
+            _dw_layout_queue(widget);
+            _dw_queue_call(widget, _dw_render_configure, NULL);
+        }
+    }
+}
+
+/*
+ * Gets the size the system thinks the widget should be.
+ * Parameters:
+ *       handle: Window (widget) handle of the item to query.
+ *       width: Width in pixels of the item or NULL if not needed.
+ *       height: Height in pixels of the item or NULL if not needed.
+ */
+void API dw_window_get_preferred_size(HWND handle, int *width, int *height)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget)
+        _dw_widget_preferred_size(widget, width, height);
+}
+
+/*
+ * Sets the gravity of a given window (widget).
+ * Gravity controls which corner of the screen and window the position is relative to.
+ * Parameters:
+ *          handle: Window (widget) handle.
+ *          horz: DW_GRAV_LEFT (default), DW_GRAV_RIGHT or DW_GRAV_CENTER.
+ *          vert: DW_GRAV_TOP (default), DW_GRAV_BOTTOM or DW_GRAV_CENTER.
+ */
+void API dw_window_set_gravity(HWND handle, int horz, int vert)
+{
+}
+
+/*
+ * Sets the position of a given window (widget).
+ * Parameters:
+ *          handle: Window (widget) handle.
+ *          x: X location from the bottom left.
+ *          y: Y location from the bottom left.
+ */
+void API dw_window_set_pos(HWND handle, LONG x, LONG y)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(widget && widget->type == _DW_WIDGET_WINDOW)
+    {
+        widget->x = (int)x;
+        widget->y = (int)y;
+    }
+}
+
+/*
+ * Sets the position and size of a given window (widget).
+ * Parameters:
+ *          handle: Window (widget) handle.
+ *          x: X location from the bottom left.
+ *          y: Y location from the bottom left.
+ *          width: Width of the widget.
+ *          height: Height of the widget.
+ */
+void API dw_window_set_pos_size(HWND handle, LONG x, LONG y, ULONG width, ULONG height)
+{
+    dw_window_set_pos(handle, x, y);
+    dw_window_set_size(handle, width, height);
+}
+
+/*
+ * Gets the position and size of a given window (widget).
+ * Parameters:
+ *          handle: Window (widget) handle.
+ *          x: X location from the bottom left or NULL.
+ *          y: Y location from the bottom left or NULL.
+ *          width: Width of the widget or NULL.
+ *          height: Height of the widget or NULL.
+ */
+void API dw_window_get_pos_size(HWND handle, LONG *x, LONG *y, ULONG *width, ULONG *height)
+{
+    DWWidget *widget = (DWWidget *)handle;
+
+    if(x)
+        *x = widget ? widget->x : 0;
+    if(y)
+        *y = widget ? widget->y : 0;
+    if(width)
+        *width = widget ? widget->width : 0;
+    if(height)
+        *height = widget ? widget->height : 0;
+}
+
+/*
+ * Returns the width of the screen.
+ */
+int API dw_screen_width(void)
+{
+    return _DW_SCREEN_WIDTH;
+}
+
+/*
+ * Returns the height of the screen.
+ */
+int API dw_screen_height(void)
+{
+    return _DW_SCREEN_HEIGHT;
+}
+
+/* This should return the current color depth. */
+unsigned long API dw_color_depth_get(void)
+{
+    return 32;
+}
+
+/*
+ * Returns some information about the current operating environment.
+ * Parameters:
+ *       env: Pointer to a DWEnv struct.
+ */
+void API dw_environment_query(DWEnv *env)
+{
+    struct utsname name;
+    char tempbuf[_DW_ENV_STRING_SIZE] = { 0 }, *dot;
+
+    uname(&name);
+    memset(env, '\0', sizeof(DWEnv));
+    strncpy(env->osName, name.sysname, sizeof(env->osName)-1);
+    strncpy(tempbuf, name.release, sizeof(tempbuf)-1);
+
+    strcpy(env->buildDate, __DATE__);
+    strcpy(env->buildTime, __TIME__);
+    strcpy(env->htmlEngine, "N/A");
+    env->DWMajorVersion = DW_MAJOR_VERSION;
+    env->DWMinorVersion = DW_MINOR_VERSION;
+    env->DWSubVersion = DW_SUB_VERSION;
+
+    /* Operating system major and minor from the release string */
+    if((dot = strchr(tempbuf, '.')))
+    {
+        *dot = '\0';
+        env->MinorVersion = atoi(dot + 1);
+    }
+    env->MajorVersion = atoi(tempbuf);
+}
+
+/*
+ * Emits a beep.
+ * Parameters:
+ *       freq: Frequency.
+ *       dur: Duration.
+ */
+void API dw_beep(int freq, int dur)
+{
+}
+
+/* Call this after drawing to the screen to make sure
+ * anything you have drawn is visible.
+ */
+void API dw_flush(void)
+{
+}
+
+/*
+ * Add a named user data item to a window handle.
+ * Parameters:
+ *       window: Window handle to save data to.
+ *       dataname: A string pointer identifying which data to be saved.
+ *       data: User data to be saved to the window handle.
+ */
+void API dw_window_set_data(HWND window, const char *dataname, void *data)
+{
+    DWWidget *widget = (DWWidget *)window;
+
+    if(!widget)
+        return;
+
+    if(data && dataname)
+        _dw_new_userdata(&widget->root, dataname, data);
+    else if(dataname)
+        _dw_remove_userdata(&widget->root, dataname, FALSE);
+    else
+        _dw_remove_userdata(&widget->root, NULL, TRUE);
+}
+
+/*
+ * Gets a named user data item from a window handle.
+ * Parameters:
+ *       window: Window handle to get data from.
+ *       dataname: A string pointer identifying which data to get.
+ * Returns:
+ *       Pointer to data or NULL if no data is available.
+ */
+void * API dw_window_get_data(HWND window, const char *dataname)
+{
+    DWWidget *widget = (DWWidget *)window;
+
+    if(widget && dataname)
+    {
+        UserData *ud = _dw_find_userdata(&widget->root, dataname);
+
+        if(ud)
+            return ud->data;
+    }
+    return NULL;
+}
+
+/*
+ * Compare two window handles.
+ * Parameters:
+ *       window1: First window handle to compare.
+ *       window2: Second window handle to compare.
+ * Returns:
+ *       TRUE if the windows are the same object, FALSE if not.
+ */
+int API dw_window_compare(HWND window1, HWND window2)
+{
+    /* If anything special is require to compare... do it
+     * here otherwise just compare the handles.
+     */
+    if(window1 && window2 && window1 == window2)
+        return TRUE;
+    return FALSE;
+}
+
+/*
+ * Add a callback to a timer event.
+ * Parameters:
+ *       interval: Milliseconds to delay between calls.
+ *       sigfunc: The pointer to the function to be used as the callback.
+ *       data: User data to be passed to the handler function.
+ * Returns:
+ *       Timer ID for use with dw_timer_disconnect(), 0 on error.
+ */
+HTIMER API dw_timer_connect(int interval, void *sigfunc, void *data)
+{
+    DWTimer *timer;
+    HTIMER retval;
+
+    if(!sigfunc || !(timer = calloc(1, sizeof(DWTimer))))
+        return 0;
+
+    timer->interval = interval;
+    timer->func = sigfunc;
+    timer->data = data;
+
+    pthread_mutex_lock(&_dw_mutex);
+    retval = timer->id = ++_dw_timer_id;
+    timer->due = _dw_clock + (interval > 0 ? interval : 0);
+    _dw_timer_insert(timer);
+    pthread_cond_broadcast(&_dw_cond);
+    pthread_mutex_unlock(&_dw_mutex);
+    return retval;
+}
+
+/*
+ * Removes timer callback.
+ * Parameters:
+ *       id: Timer ID returned by dw_timer_connect().
+ */
+void API dw_timer_disconnect(HTIMER timerid)
+{
+    DWTimer **prev;
+
+    pthread_mutex_lock(&_dw_mutex);
+    /* A running timer is off the list, flag it instead */
+    if(timerid && timerid == _dw_timer_running)
+        _dw_timer_cancelled = TRUE;
+    for(prev = &_dw_timers;*prev;prev = &(*prev)->next)
+    {
+        if((*prev)->id == timerid)
+        {
+            DWTimer *timer = *prev;
+
+            *prev = timer->next;
+            free(timer);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&_dw_mutex);
+}
+
+/*
+ * Add a callback to a window event.
+ * Parameters:
+ *       window: Window handle of signal to be called back.
+ *       signame: A string pointer identifying which signal to be hooked.
+ *       sigfunc: The pointer to the function to be used as the callback.
+ *       data: User data to be passed to the handler function.
+ */
+void API dw_signal_connect(HWND window, const char *signame, void *sigfunc, void *data)
+{
+    dw_signal_connect_data(window, signame, sigfunc, NULL, data);
+}
+
+/*
+ * Add a callback to a window event with a closure callback.
+ * Parameters:
+ *       window: Window handle of signal to be called back.
+ *       signame: A string pointer identifying which signal to be hooked.
+ *       sigfunc: The pointer to the function to be used as the callback.
+ *       discfunc: The pointer to the function called when this handler is removed.
+ *       data: User data to be passed to the handler function.
+ */
+void API dw_signal_connect_data(HWND window, const char *signame, void *sigfunc, void *discfunc, void *data)
+{
+    DWWidget *widget = (DWWidget *)window;
+    DWSignalHandler *handler, **prev;
+
+    if(!widget || !signame || !sigfunc || !(handler = calloc(1, sizeof(DWSignalHandler))))
+        return;
+
+    handler->signame = strdup(signame);
+    handler->func = sigfunc;
+    handler->discfunc = discfunc;
+    handler->data = data;
+
+    /* Handlers run in the order they were connected */
+    for(prev = &widget->handlers;*prev;prev = &(*prev)->next)
+    {
+    }
+    *prev = handler;
+}
+
+/*
+ * Removes callbacks for a given window with given name.
+ * Parameters:
+ *       window: Window handle of callback to be removed.
+ *       signame: Signal name to be matched on window.
+ */
+void API dw_signal_disconnect_by_name(HWND window, const char *signame)
+{
+    if(window && signame)
+        _dw_signal_remove((DWWidget *)window, signame, TRUE, NULL);
+}
+
+/*
+ * Removes all callbacks for a given window.
+ * Parameters:
+ *       window: Window handle of callback to be removed.
+ */
+void API dw_signal_disconnect_by_window(HWND window)
+{
+    if(window)
+        _dw_signal_remove((DWWidget *)window, NULL, TRUE, NULL);
+}
+
+/*
+ * Removes all callbacks for a given window with specified data.
+ * Parameters:
+ *       window: Window handle of callback to be removed.
+ *       data: Pointer to the data to be compared against.
+ */
+void API dw_signal_disconnect_by_data(HWND window, void *data)
+{
+    if(window)
+        _dw_signal_remove((DWWidget *)window, NULL, FALSE, data);
+}
+
+/* Open a shared library and return a handle.
+ * Parameters:
+ *         name: Base name of the shared library.
+ *         handle: Pointer to a module handle,
+ *                 will be filled in with the handle.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+*/
+int API dw_module_load(const char *name, HMOD *handle)
+{
+    char *newname;
+    int len;
+
+    if(!handle || !name || !(len = (int)strlen(name)))
+        return DW_ERROR_UNKNOWN;
+
+    /* Length + "lib" + ".so" + NULL */
+    if(!(newname = malloc(len + 7)))
+        return DW_ERROR_UNKNOWN;
+
+    sprintf(newname, "lib%s.so", name);
+    *handle = dlopen(newname, RTLD_NOW);
+    free(newname);
+    return *handle ? DW_ERROR_NONE : DW_ERROR_UNKNOWN;
+}
+
+/* Queries the address of a symbol within open handle.
+ * Parameters:
+ *         handle: Module handle returned by dw_module_load()
+ *         name: Name of the symbol you want the address of.
+ *         func: A pointer to a function pointer, to obtain
+ *               the address.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_module_symbol(HMOD handle, const char *name, void**func)
+{
+    if(!func || !name || !*name)
+        return DW_ERROR_UNKNOWN;
+
+    *func = dlsym(handle, name);
+    return *func ? DW_ERROR_NONE : DW_ERROR_GENERAL;
+}
+
+/* Frees the shared library previously opened.
+ * Parameters:
+ *         handle: Module handle returned by dw_module_load()
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_module_close(HMOD handle)
+{
+    if(handle)
+        return dlclose(handle);
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Returns the handle to an unnamed mutex semaphore or NULL on error.
+ */
+HMTX API dw_mutex_new(void)
+{
+    pthread_mutex_t *mutex = malloc(sizeof(pthread_mutex_t));
+
+    if(mutex)
+        pthread_mutex_init(mutex, NULL);
+    return (HMTX)mutex;
+}
+
+/*
+ * Closes a semaphore created by dw_mutex_new().
+ * Parameters:
+ *       mutex: The handle to the mutex returned by dw_mutex_new().
+ */
+void API dw_mutex_close(HMTX mutex)
+{
+    if(mutex)
+    {
+        pthread_mutex_destroy((pthread_mutex_t *)mutex);
+        free(mutex);
+    }
+}
+
+/*
+ * Tries to gain access to the semaphore, if it can't it blocks.
+ * Parameters:
+ *       mutex: The handle to the mutex returned by dw_mutex_new().
+ */
+void API dw_mutex_lock(HMTX mutex)
+{
+    /* The main thread keeps the loop running while it waits */
+    if(_dw_tid() == _dw_main_tid)
+    {
+        while(pthread_mutex_trylock((pthread_mutex_t *)mutex) == EBUSY)
+        {
+            if(!_dw_main_iteration())
+                sched_yield();
+        }
+    }
+    else
+        pthread_mutex_lock((pthread_mutex_t *)mutex);
+}
+
+/*
+ * Tries to gain access to the semaphore.
+ * Parameters:
+ *       mutex: The handle to the mutex returned by dw_mutex_new().
+ * Returns:
+ *       DW_ERROR_NONE on success, DW_ERROR_TIMEOUT if it is already locked.
+ */
+int API dw_mutex_trylock(HMTX mutex)
+{
+    if(pthread_mutex_trylock((pthread_mutex_t *)mutex) == 0)
+        return DW_ERROR_NONE;
+    return DW_ERROR_TIMEOUT;
+}
+
+/*
+ * Reliquishes the access to the semaphore.
+ * Parameters:
+ *       mutex: The handle to the mutex returned by dw_mutex_new().
+ */
+void API dw_mutex_unlock(HMTX mutex)
+{
+    pthread_mutex_unlock((pthread_mutex_t *)mutex);
+}
+
+/*
+ * Returns the handle to an unnamed event semaphore or NULL on error.
+ */
+HEV API dw_event_new(void)
+{
+    DWEvent *eve = calloc(1, sizeof(DWEvent));
+
+    if(!eve)
+        return NULL;
+
+    /* We need to be careful here, mutexes on Linux are
+     * FAST by default but are error checking on other
+     * systems such as FreeBSD and OS/2, perhaps others.
+     */
+    pthread_mutex_init(&eve->mutex, NULL);
+    pthread_cond_init(&eve->event, NULL);
+    return (HEV)eve;
+}
+
+/*
+ * Resets a semaphore created by dw_event_new().
+ * Parameters:
+ *       eve: The handle to the event returned by dw_event_new().
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_event_reset (HEV eve)
+{
+    DWEvent *event = (DWEvent *)eve;
+
+    if(!event)
+        return DW_ERROR_NON_INIT;
+
+    pthread_mutex_lock(&event->mutex);
+    pthread_cond_broadcast(&event->event);
+    pthread_cond_init(&event->event, NULL);
+    event->posted = 0;
+    pthread_mutex_unlock(&event->mutex);
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Posts a semaphore created by dw_event_new(). Causing all threads
+ * waiting on this event in dw_event_wait to continue.
+ * Parameters:
+ *       eve: The handle to the event returned by dw_event_new().
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_event_post (HEV eve)
+{
+    DWEvent *event = (DWEvent *)eve;
+
+    if(!event)
+        return DW_ERROR_NON_INIT;
+
+    pthread_mutex_lock(&event->mutex);
+    pthread_cond_broadcast(&event->event);
+    event->posted = 1;
+    pthread_mutex_unlock(&event->mutex);
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Waits on a semaphore created by dw_event_new(), until the
+ * event gets posted or until the timeout expires.
+ * Parameters:
+ *       eve: The handle to the event returned by dw_event_new().
+ *   timeout: Number of milliseconds before timing out
+ *                  or -1 if indefinite.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ *       DW_ERROR_TIMEOUT (2) if the timeout has expired.
+ *       Other values on other error.
+ */
+int API dw_event_wait(HEV eve, unsigned long timeout)
+{
+    DWEvent *event = (DWEvent *)eve;
+    int rc;
+
+    if(!event)
+        return DW_ERROR_NON_INIT;
+
+    pthread_mutex_lock(&event->mutex);
+
+    if(event->posted)
+    {
+        pthread_mutex_unlock(&event->mutex);
+        return DW_ERROR_NONE;
+    }
+
+    if(timeout != DW_TIMEOUT_INFINITE)
+    {
+        struct timeval now;
+        struct timespec timeo;
+
+        gettimeofday(&now, 0);
+        timeo.tv_sec = now.tv_sec + (timeout / 1000);
+        timeo.tv_nsec = (now.tv_usec * 1000) + ((timeout % 1000) * 1000000);
+        if(timeo.tv_nsec >= 1000000000)
+        {
+            timeo.tv_sec++;
+            timeo.tv_nsec -= 1000000000;
+        }
+        rc = pthread_cond_timedwait(&event->event, &event->mutex, &timeo);
+    }
+    else
+        rc = pthread_cond_wait(&event->event, &event->mutex);
+
+    pthread_mutex_unlock(&event->mutex);
+    if(!rc)
+        return DW_ERROR_NONE;
+    if(rc == ETIMEDOUT)
+        return DW_ERROR_TIMEOUT;
+    return DW_ERROR_GENERAL;
+}
+
+/*
+ * Closes a semaphore created by dw_event_new().
+ * Parameters:
+ *       eve: The handle to the event returned by dw_event_new().
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_event_close(HEV *eve)
+{
+    DWEvent *event;
+
+    if(!eve || !(event = (DWEvent *)*eve))
+        return DW_ERROR_NON_INIT;
+
+    pthread_mutex_lock(&event->mutex);
+    pthread_cond_destroy(&event->event);
+    pthread_mutex_unlock(&event->mutex);
+    pthread_mutex_destroy(&event->mutex);
+    free(event);
+    *eve = NULL;
+    return DW_ERROR_NONE;
+}
+
+/* Create a named event semaphore which can be
+ * opened from other processes.
+ * Parameters:
+ *         name: Name given to semaphore which can be opened
+ *               by other processes.
+ * Returns:
+ *       Handle to event semaphore or NULL on error.
+ */
+HEV API dw_named_event_new(const char *name)
+{
+    return NULL;
+}
+
+/* Open an already existing named event semaphore.
+ * Parameters:
+ *         name: Name given to semaphore which can be opened
+ *               by other processes.
+ * Returns:
+ *       Handle to event semaphore or NULL on error.
+ */
+HEV API dw_named_event_get(const char *name)
+{
+    return NULL;
+}
+
+/* Resets the event semaphore so threads who call wait
+ * on this semaphore will block.
+ * Parameters:
+ *         eve: Handle to the semaphore obtained by
+ *              an get or new call.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_named_event_reset(HEV eve)
+{
+   return DW_ERROR_GENERAL;
+}
+
+/* Sets the posted state of an event semaphore, any threads
+ * waiting on the semaphore will no longer block.
+ * Parameters:
+ *         eve: Handle to the semaphore obtained by
+ *              an get or new call.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_named_event_post(HEV eve)
+{
+   return DW_ERROR_GENERAL;
+}
+
+/* Waits on the specified semaphore until it becomes
+ * posted, or returns immediately if it already is posted.
+ * Parameters:
+ *         eve: Handle to the semaphore obtained by
+ *              an get or new call.
+ *         timeout: Number of milliseconds before timing out
+ *                  or -1 if indefinite.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_named_event_wait(HEV eve, unsigned long timeout)
+{
+   return DW_ERROR_UNKNOWN;
+}
+
+/* Release this semaphore, if there are no more open
+ * handles on this semaphore the semaphore will be destroyed.
+ * Parameters:
+ *         eve: Handle to the semaphore obtained by
+ *              an get or new call.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_named_event_close(HEV eve)
+{
+    return DW_ERROR_UNKNOWN;
+}
+
+/*
+ * Initializes the Dynamic Windows engine.
+ * Parameters:
+ *           newthread: True if this is the only thread.
+ *                      False if there is already a message loop running.
+ *           argc: Passed in from main()
+ *           argv: Passed in from main()
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_init(int newthread, int argc, char *argv[])
+{
+    char *slash;
+
+    pthread_key_create(&_dw_tid_key, NULL);
+    _dw_main_tid = _dw_tid();
+
+    /* Use the directory the program was started from */
+    if(argc > 0 && argv && argv[0] && (slash = strrchr(argv[0], '/')) &&
+       (slash - argv[0]) < MAX_PATH)
+    {
+        strncpy(_dw_exec_dir, argv[0], slash - argv[0]);
+        _dw_exec_dir[slash - argv[0]] = '\0';
+    }
+    else if(!getcwd(_dw_exec_dir, MAX_PATH))
+        strcpy(_dw_exec_dir, "/");
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Allocates a shared memory region with a name.
+ * Parameters:
+ *         dest: A pointer to a pointer to receive the memory address.
+ *         size: Size in bytes of the shared memory region to allocate.
+ *         name: A string pointer to a unique memory name.
+ * Returns:
+ *       Handle to shared memory or NULL on error.
+ */
+HSHM API dw_named_memory_new(void **dest, int size, const char *name)
+{
+    char namebuf[1025];
+    DWShm *handle;
+
+    if(!dest || !name || !(handle = calloc(1, sizeof(DWShm))))
+        return NULL;
+
+    mkdir("/tmp/.dw", S_IWGRP|S_IWOTH);
+    snprintf(namebuf, 1024, "/tmp/.dw/%s", name);
+
+    if((handle->fd = open(namebuf, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR)) < 0)
+    {
+        free(handle);
+        return NULL;
+    }
+
+    if(ftruncate(handle->fd, size))
+    {
+        close(handle->fd);
+        free(handle);
+        return NULL;
+    }
+
+    /* attach the shared memory segment to our process's address space. */
+    *dest = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, handle->fd, 0);
+
+    if(*dest == MAP_FAILED)
+    {
+        close(handle->fd);
+        *dest = NULL;
+        free(handle);
+        return NULL;
+    }
+
+    handle->size = size;
+    handle->sid = getsid(0);
+    handle->path = strdup(namebuf);
+    return (HSHM)handle;
+}
+
+/*
+ * Aquires shared memory region with a name.
+ * Parameters:
+ *       dest: A pointer to a pointer to receive the memory address.
+ *       size: Size in bytes of the shared memory region to requested.
+ *       name: A string pointer to a unique memory name.
+ * Returns:
+ *       Handle to shared memory or NULL on error.
+ */
+HSHM API dw_named_memory_get(void **dest, int size, const char *name)
+{
+    char namebuf[1025];
+    DWShm *handle;
+
+    if(!dest || !name || !(handle = calloc(1, sizeof(DWShm))))
+        return NULL;
+
+    snprintf(namebuf, 1024, "/tmp/.dw/%s", name);
+
+    if((handle->fd = open(namebuf, O_RDWR)) < 0)
+    {
+        free(handle);
+        return NULL;
+    }
+
+    /* attach the shared memory segment to our process's address space. */
+    *dest = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, handle->fd, 0);
+
+    if(*dest == MAP_FAILED)
+    {
+        close(handle->fd);
+        *dest = NULL;
+        free(handle);
+        return NULL;
+    }
+
+    handle->size = size;
+    handle->sid = -1;
+    return (HSHM)handle;
+}
+
+/*
+ * Frees a shared memory region previously allocated.
+ * Parameters:
+ *       handle: Handle obtained from dw_named_memory_new().
+ *       ptr: The memory address aquired with dw_named_memory_new().
+ * Returns:
+ *       DW_ERROR_NONE (0) on success or DW_ERROR_UNKNOWN (-1) on error.
+ */
+int API dw_named_memory_free(HSHM handle, void *ptr)
+{
+    DWShm *h = (DWShm *)handle;
+    int rc;
+
+    if(!h)
+        return DW_ERROR_GENERAL;
+
+    rc = munmap(ptr, h->size);
+    close(h->fd);
+    if(h->path)
+    {
+        /* Only remove the actual file if we are the
+         * creator of the file.
+         */
+        if(h->sid != -1 && h->sid == getsid(0))
+            remove(h->path);
+        free(h->path);
+    }
+    free(h);
+    return rc;
+}
+
+/*
+ * Generally an internal function called from a newly created
+ * thread to setup the Dynamic Windows environment for the thread.
+ * However it is exported so language bindings can call it when
+ * they create threads that require access to Dynamic Windows.
+ */
+void API _dw_init_thread(void)
+{
+}
+
+/*
+ * Generally an internal function called from a terminating
+ * thread to cleanup the Dynamic Windows environment for the thread.
+ * However it is exported so language bindings can call it when
+ * they exit threads that require access to Dynamic Windows.
+ */
+void API _dw_deinit_thread(void)
+{
+}
+
+/*
+ * Creates a new thread with a starting point of func.
+ * Parameters:
+ *       func: Function which will be run in the new thread.
+ *       data: Parameter(s) passed to the function.
+ *       stack: Stack size of new thread (OS/2 and Windows only).
+ * Returns:
+ *       Thread ID on success or DW_ERROR_UNKNOWN (-1) on error.
+ */
+DWTID API dw_thread_new(void *func, void *data, int stack)
+{
+    void **tmp = malloc(sizeof(void *) * 3);
+    pthread_t thread;
+    DWTID tid;
+
+    if(!tmp)
+        return (DWTID)DW_ERROR_UNKNOWN;
+
+    /* Assign the ID here so it can be returned right away */
+    pthread_mutex_lock(&_dw_mutex);
+    tid = _dw_tid_next++;
+    pthread_mutex_unlock(&_dw_mutex);
+
+    tmp[0] = func;
+    tmp[1] = data;
+    tmp[2] = (void *)(long)tid;
+
+    if(pthread_create(&thread, NULL, _dw_thread_start, tmp) == 0)
+    {
+        pthread_detach(thread);
+        return tid;
+    }
+    free(tmp);
+    return (DWTID)DW_ERROR_UNKNOWN;
+}
+
+/*
+ * Ends execution of current thread immediately.
+ */
+void API dw_thread_end(void)
+{
+    pthread_exit(NULL);
+}
+
+/*
+ * Returns the current thread's ID.
+ */
+DWTID API dw_thread_id(void)
+{
+    return _dw_tid();
+}
+
+/*
+ * Cleanly terminates a DW session, should be signal handler safe.
+ */
+void API dw_shutdown(void)
+{
+    _dw_layout_workers_stop();
+}
+
+/*
+ * Execute and external program in a seperate session.
+ * Parameters:
+ *       program: Program name with optional path.
+ *       type: Either DW_EXEC_CON or DW_EXEC_GUI.
+ *       params: An array of pointers to string arguements.
+ * Returns:
+ *       Process ID on success or DW_ERROR_UNKNOWN (-1) on error.
+ */
+int API dw_exec(const char *program, int type, char **params)
+{
+    int ret = DW_ERROR_UNKNOWN;
+
+    if(!program)
+        return ret;
+
+    /* There is no terminal to open, GUI or not it runs the same */
+    if((ret = fork()) == 0)
+    {
+        execvp(program, params);
+        _exit(-1);
+    }
+    return ret;
+}
+
+/*
+ * Loads a web browser pointed at the given URL.
+ * Parameters:
+ *       url: Uniform resource locator.
+ * Returns:
+ *       DW_ERROR_UNKNOWN (-1) on error; DW_ERROR_NONE (0) or a positive Process ID on success.
+ */
+int API dw_browse(const char *url)
+{
+    return DW_ERROR_UNKNOWN;
+}
+
+/*
+ * Creates a new print object.
+ * Parameters:
+ *       jobname: Name of the print job to show in the queue.
+ *       flags: Flags to initially configure the print object.
+ *       pages: Number of pages to print.
+ *       drawfunc: The pointer to the function to be used as the callback.
+ *       drawdata: User data to be passed to the handler function.
+ * Returns:
+ *       A handle to the print object or NULL on failure.
+ */
+HPRINT API dw_print_new(const char *jobname, unsigned long flags, unsigned int pages, void *drawfunc, void *drawdata)
+{
+    DWPrint *print;
+
+    if(!drawfunc || !pages || !(print = calloc(1, sizeof(DWPrint))))
+        return NULL;
+
+    print->jobname = strdup(jobname ? jobname : "");
+    print->pages = pages;
+    print->drawfunc = (int (*)(HPRINT, HPIXMAP, int, void *))drawfunc;
+    print->drawdata = drawdata;
+    return (HPRINT)print;
+}
+
+/*
+ * Runs the print job, causing the draw page callbacks to fire.
+ * Parameters:
+ *       print: Handle to the print object returned by dw_print_new().
+ *       flags: Flags to run the print job.
+ * Returns:
+ *       DW_ERROR_UNKNOWN on error or DW_ERROR_NONE on success.
+ */
+int API dw_print_run(HPRINT print, unsigned long flags)
+{
+    DWPrint *p = (DWPrint *)print;
+    unsigned int page;
+
+    if(!p)
+        return DW_ERROR_UNKNOWN;
+
+    /* Each page is rendered to a letter sized pixmap and discarded */
+    for(page=0;page<p->pages && !p->cancel;page++)
+    {
+        HPIXMAP pixmap = dw_pixmap_new(DW_NOHWND, _DW_PRINT_WIDTH, _DW_PRINT_HEIGHT, 32);
+
+        if(pixmap)
+        {
+            p->drawfunc(print, pixmap, (int)page, p->drawdata);
+            dw_pixmap_destroy(pixmap);
+        }
+    }
+    free(p->jobname);
+    free(p);
+    return DW_ERROR_NONE;
+}
+
+/*
+ * Cancels the print job, typically called from a draw page callback.
+ * Parameters:
+ *       print: Handle to the print object returned by dw_print_new().
+ */
+void API dw_print_cancel(HPRINT print)
+{
+    DWPrint *p = (DWPrint *)print;
+
+    if(p)
+        p->cancel = TRUE;
+}
+
+/*
+ * Creates a new system notification if possible.
+ * Parameters:
+ *         title: The short title of the notification.
+ *         imagepath: Path to an image to display or NULL if none.
+ *         description: A longer description of the notification,
+ *                      or NULL if none is necessary.
+ * Returns:
+ *         A handle to the notification which can be used to attach a "clicked" event if desired,
+ *         or NULL if it fails or notifications are not supported by the system.
+ * Remarks:
+ *          This will create a system notification that will show in the notifaction panel
+ *          on supported systems, which may be clicked to perform another task.
+ */
+HWND API dw_notification_new(const char *title, const char *imagepath, const char *description, ...)
+{
+   return 0;
+}
+
+/*
+ * Sends a notification created by dw_notification_new() after attaching signal handler.
+ * Parameters:
+ *         notification: The handle to the notification returned by dw_notification_new().
+ * Returns:
+ *         DW_ERROR_NONE on success, DW_ERROR_UNKNOWN on error or not supported.
+ */
+int API dw_notification_send(HWND notification)
+{
+   return DW_ERROR_UNKNOWN;
+}
+
+/*
+ * Converts a UTF-8 encoded string into a wide string.
+ * Parameters:
+ *       utf8string: UTF-8 encoded source string.
+ * Returns:
+ *       Wide string that needs to be freed with dw_free()
+ *       or NULL on failure.
+ */
+wchar_t * API dw_utf8_to_wchar(const char *utf8string)
+{
+    size_t len, z = 0;
+    wchar_t *retval;
+
+    if(!utf8string || !(retval = malloc(sizeof(wchar_t) * ((len = strlen(utf8string)) + 1))))
+        return NULL;
+
+    while(*utf8string)
+    {
+        const unsigned char *s = (const unsigned char *)utf8string;
+        int extra = (*s >= 0xF0) ? 3 : (*s >= 0xE0) ? 2 : (*s >= 0xC0) ? 1 : 0;
+        wchar_t ch = extra ? (*s & (0x3F >> extra)) : *s;
+        int x;
+
+        for(x=1;x<=extra;x++)
+        {
+            if((s[x] & 0xC0) != 0x80)
+            {
+                free(retval);
+                return NULL;
+            }
+            ch = (ch << 6) | (s[x] & 0x3F);
+        }
+        retval[z++] = ch;
+        utf8string += extra + 1;
+    }
+    retval[z] = 0;
+    return retval;
+}
+
+/*
+ * Converts a wide string into a UTF-8 encoded string.
+ * Parameters:
+ *       wstring: Wide source string.
+ * Returns:
+ *       UTF-8 encoded string that needs to be freed with dw_free()
+ *       or NULL on failure.
+ */
+char * API dw_wchar_to_utf8(const wchar_t *wstring)
+{
+    char *retval, *out;
+
+    if(!wstring || !(retval = out = malloc((wcslen(wstring) * 4) + 1)))
+        return NULL;
+
+    for(;*wstring;wstring++)
+    {
+        unsigned long ch = (unsigned long)*wstring;
+
+        if(ch < 0x80)
+            *out++ = (char)ch;
+        else if(ch < 0x800)
+        {
+            *out++ = (char)(0xC0 | (ch >> 6));
+            *out++ = (char)(0x80 | (ch & 0x3F));
+        }
+        else if(ch < 0x10000)
+        {
+            *out++ = (char)(0xE0 | (ch >> 12));
+            *out++ = (char)(0x80 | ((ch >> 6) & 0x3F));
+            *out++ = (char)(0x80 | (ch & 0x3F));
+        }
+        else
+        {
+            *out++ = (char)(0xF0 | (ch >> 18));
+            *out++ = (char)(0x80 | ((ch >> 12) & 0x3F));
+            *out++ = (char)(0x80 | ((ch >> 6) & 0x3F));
+            *out++ = (char)(0x80 | (ch & 0x3F));
+        }
+    }
+    *out = '\0';
+    return retval;
+}
+
+/*
+ * Gets the state of the requested library feature.
+ * Parameters:
+ *       feature: The requested feature for example DW_FEATURE_DARK_MODE
+ * Returns:
+ *       DW_FEATURE_UNSUPPORTED if the library or OS does not support the feature.
+ *       DW_FEATURE_DISABLED if the feature is supported but disabled.
+ *       DW_FEATURE_ENABLED if the feature is supported and enabled.
+ *       Other value greater than 1, same as enabled but with extra info.
+ */
+int API dw_feature_get(DWFEATURE feature)
+{
+    switch(feature)
+    {
+        case DW_FEATURE_MLE_WORD_WRAP:           /* Supports word wrapping in Multi-line Edit boxes */
+        case DW_FEATURE_CONTAINER_STRIPE:        /* Supports striped line display in container widgets */
+        case DW_FEATURE_MDI:                     /* Supports Multiple Document Interface window frame */
+        case DW_FEATURE_NOTEBOOK_STATUS_TEXT:    /* Supports status text area on notebook/tabbed controls */
+        case DW_FEATURE_UTF8_UNICODE:            /* Supports UTF8 encoded Unicode text */
+        case DW_FEATURE_TASK_BAR:                /* Supports icons in the taskbar or similar system widget */
+        case DW_FEATURE_TREE:                    /* Supports the Tree Widget */
+        case DW_FEATURE_WINDOW_PLACEMENT:        /* Supports arbitrary window placement */
+            return DW_FEATURE_ENABLED;
+        /* Returns the number of threads used to measure, if more than one */
+        case DW_FEATURE_PARALLEL_LAYOUT:         /* Supports measuring large box layouts on worker threads */
+            return _dw_layout_threads > 1 ? _dw_layout_threads : DW_FEATURE_DISABLED;
+        default:
+            return DW_FEATURE_UNSUPPORTED;
+    }
+}
+
+/*
+ * Sets the state of the requested library feature.
+ * Parameters:
+ *       feature: The requested feature for example DW_FEATURE_DARK_MODE
+ *       state: DW_FEATURE_DISABLED, DW_FEATURE_ENABLED or any value greater than 1.
+ * Returns:
+ *       DW_FEATURE_UNSUPPORTED if the library or OS does not support the feature.
+ *       DW_ERROR_NONE if the feature is supported and successfully configured.
+ *       DW_ERROR_GENERAL if the feature is supported but could not be configured.
+ * Remarks: 
+ *       These settings are typically used during dw_init() so issue before 
+ *       setting up the library with dw_init().
+ */
+int API dw_feature_set(DWFEATURE feature, int state)
+{
+    switch(feature)
+    {
+        /* These features are supported but not configurable */
+        case DW_FEATURE_MLE_WORD_WRAP:           /* Supports word wrapping in Multi-line Edit boxes */
+        case DW_FEATURE_CONTAINER_STRIPE:        /* Supports striped line display in container widgets */
+        case DW_FEATURE_MDI:                     /* Supports Multiple Document Interface window frame */
+        case DW_FEATURE_NOTEBOOK_STATUS_TEXT:    /* Supports status text area on notebook/tabbed controls */
+        case DW_FEATURE_UTF8_UNICODE:            /* Supports UTF8 encoded Unicode text */
+        case DW_FEATURE_TASK_BAR:                /* Supports icons in the taskbar or similar system widget */
+        case DW_FEATURE_TREE:                    /* Supports the Tree Widget */
+        case DW_FEATURE_WINDOW_PLACEMENT:        /* Supports arbitrary window placement */
+            return DW_ERROR_GENERAL;
+        /* These features are supported and configurable */
+        /* State is the number of threads to measure with,
+         * DW_FEATURE_ENABLED uses one for each processor.
+         */
+        case DW_FEATURE_PARALLEL_LAYOUT:
+        {
+            if(state < DW_FEATURE_DISABLED)
+                return DW_ERROR_GENERAL;
+            if(state == DW_FEATURE_ENABLED)
+                state = (int)sysconf(_SC_NPROCESSORS_ONLN);
+            if(state > _DW_LAYOUT_MAX_THREADS)
+                state = _DW_LAYOUT_MAX_THREADS;
+            /* Workers are started the next time a layout needs them */
+            pthread_mutex_lock(&_dw_layout_mutex);
+            _dw_layout_threads = state;
+            pthread_mutex_unlock(&_dw_layout_mutex);
+            return DW_ERROR_NONE;
+        }
+        default:
+            return DW_FEATURE_UNSUPPORTED;
+    }
+}
+
+/*
+ * Writes the data recorded while DW_FEATURE_TRACE was enabled.
+ * Parameters:
+ *       filename: Name of the file to write, or NULL for stderr.
+ *       flags: DW_TRACE_DUMP_JSON to write Chrome trace event JSON instead
+ *              of a table of statistics per function.
+ *              DW_TRACE_DUMP_RESET to clear the data after writing it.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_trace_dump(const char *filename, unsigned long flags)
+{
+    return DW_ERROR_GENERAL;
+}
+
+/*
+ * Returns the handler timings recorded while DW_FEATURE_SIGNAL_PROFILE
+ * was enabled.  Timer callbacks are recorded as the "timer" signal.
+ * Parameters:
+ *       signame: Name of the signal to query, or NULL for all signals.
+ *       stats: Pointer to a DWSignalStats structure to fill in.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_signal_stats_get(const char *signame, DWSignalStats *stats)
+{
+    return DW_ERROR_GENERAL;
+}
@@ -23,13 +23,13 @@ void _dw_window_pointer_set(HWND handle, Box *box)
 {
 }
 
-/* This function calculates how much space the widgets and boxes require
- * and does expansion as necessary.
+/* Calculates the space required by a box and the boxes packed in it,
+ * boxes that have not changed since they were last measured keep
+ * their cached sizes and are not walked again.
  */
-static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int pass)
+static void _dw_measure_box(Box *thisbox, int *depth)
 {
-   /* Current item position */
-   int z, currentx = thisbox->pad, currenty = thisbox->pad;
+   int z;
    /* Used x, y and padding maximum values...
     * These will be used to find the widest or
     * tallest items in a box.
@@ -81,20 +81,20 @@ static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int pass)
 
          if(tmp)
          {
-            /* On the first pass calculate the box contents */
-            if(pass == 1)
+            /* Only boxes which changed need to calculate their contents */
+            if(!(tmp->layout & _DW_LAYOUT_MEASURED))
             {
                (*depth)++;
-                    
+
                /* Save the newly calculated values on the box */
-               _dw_resize_box(tmp, depth, x, y, pass);
-                    
-               /* Duplicate the values in the item list for use below */
-               thisbox->items[z].width = tmp->minwidth;
-               thisbox->items[z].height = tmp->minheight;
-               
+               _dw_measure_box(tmp, depth);
+
                (*depth)--;
             }
+
+            /* Duplicate the values in the item list for use below */
+            thisbox->items[z].width = tmp->minwidth;
+            thisbox->items[z].height = tmp->minheight;
          }
       }
         
@@ -155,6 +155,24 @@ static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int pass)
    thisbox->usedpadx += upxmax;
    thisbox->usedpady += upymax;
 
+   /* The cached sizes are valid until the box is invalidated,
+    * the contents need to be placed again using the new sizes.
+    */
+   thisbox->layout = _DW_LAYOUT_MEASURED;
+}
+
+/* This function calculates how much space the widgets and boxes require
+ * and does expansion as necessary.
+ */
+static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int pass)
+{
+   /* Current item position */
+   int z, currentx = thisbox->pad, currenty = thisbox->pad;
+
+   /* Only calculate the space requirements if something changed */
+   if(!(thisbox->layout & _DW_LAYOUT_MEASURED))
+      _dw_measure_box(thisbox, depth);
+
    /* Move the groupbox start past the group border */
    if(thisbox->grouphwnd)
    {
@@ -211,6 +229,8 @@ static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int pass)
             /* If any special handling needs to be done... like diving into
              * controls that have sub-layouts... like notebooks or splitbars...
              * do that here. Figure out the sub-layout size and call _dw_do_resize().
+             * Boxes with _DW_LAYOUT_PLACED set which are given the same size
+             * they were last placed at do not need their contents placed again.
              */
 #endif
 
@@ -221,6 +241,10 @@ static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int pass)
                currenty += height + (pad * 2);
          }
       }
+      /* Remember the size the contents were placed at */
+      thisbox->layout |= _DW_LAYOUT_PLACED;
+      thisbox->placedwidth = x;
+      thisbox->placedheight = y;
    }
 }
 
@@ -576,19 +600,69 @@ int API dw_scrollbox_get_range(HWND handle, int orient)
     return 0;
 }
 
+/* Clear the cached layout of the box handle is packed into and
+ * every box above it, so the next layout pass measures and places
+ * them again.
+ */
+void _dw_box_invalidate(HWND handle)
+{
+    while(handle)
+    {
+        Box *thisbox = (Box *)_dw_window_pointer_get(handle);
+
+        if(thisbox)
+            thisbox->layout = 0;
+#if 0
+        /* Platform specific code to get the parent window */
+        handle = GetParent(handle);
+#else
+        handle = 0;
+#endif
+    }
+}
+
+/* Make room for an item at index in the box's item array,
+ * doubling the allocation when it is full so packing many
+ * items does not reallocate and copy on every call.
+ * Returns the item array or NULL on allocation failure.
+ */
+static Item *_dw_box_item_insert(Box *thisbox, int index)
+{
+    if(thisbox->count >= thisbox->alloc)
+    {
+       int alloc = thisbox->alloc ? thisbox->alloc * 2 : 4;
+       Item *items = realloc(thisbox->items, sizeof(Item) * alloc);
+
+       if(!items)
+          return NULL;
+       thisbox->items = items;
+       thisbox->alloc = alloc;
+    }
+    memmove(&thisbox->items[index+1], &thisbox->items[index], sizeof(Item) * (thisbox->count - index));
+    memset(&thisbox->items[index], 0, sizeof(Item));
+    return thisbox->items;
+}
+
+/* Remove the item at index from the box's item array,
+ * the allocation is kept for reuse until the box is destroyed.
+ */
+static void _dw_box_item_remove(Box *thisbox, int index)
+{
+    thisbox->count--;
+    memmove(&thisbox->items[index], &thisbox->items[index+1], sizeof(Item) * (thisbox->count - index));
+}
+
 /* Internal box packing function called by the other 3 functions */
 void _dw_box_pack(HWND box, HWND item, int index, int width, int height, int hsize, int vsize, int pad, char *funcname)
 {
     Box *thisbox;
-    int z, x = 0;
-    Item *tmpitem, *thisitem;
+    Item *tmpitem;
 
     /* Sanity checks */
     if(!box || box == item)
         return;
 
     thisbox = _dw_window_pointer_get(box);
-    thisitem = thisbox->items;
 
     /* Do some sanity bounds checking */
     if(index < 0)
@@ -596,16 +670,9 @@ void _dw_box_pack(HWND box, HWND item, int index, int width, int height, int hsi
     if(index > thisbox->count)
        index = thisbox->count;
         
-    /* Duplicate the existing data */
-    tmpitem = malloc(sizeof(Item)*(thisbox->count+1));
-
-    for(z=0;z<thisbox->count;z++)
-    {
-       if(z == index)
-          x++;
-       tmpitem[x] = thisitem[z];
-       x++;
-    }
+    /* Make room for the new item */
+    if(!(tmpitem = _dw_box_item_insert(thisbox, index)))
+       return;
 
     /* Sanity checks */
     if(vsize && !height)
@@ -633,20 +700,15 @@ void _dw_box_pack(HWND box, HWND item, int index, int width, int height, int hsi
     else
        tmpitem[index].vsize = _DW_SIZE_STATIC;
 
-    thisbox->items = tmpitem;
-
     /* Update the item count */
     thisbox->count++;
+    _dw_box_invalidate(box);
 
     /* Add the item to the box */
 #if 0
     /* Platform specific code to add item to box */
     BoxAdd(box, item);
 #endif
-
-    /* Free the old data */
-    if(thisbox->count)
-       free(thisitem);
 }
 
 /*
@@ -671,7 +733,22 @@ int API dw_box_unpack(HWND handle)
  */
 HWND API dw_box_unpack_at_index(HWND box, int index)
 {
-   return 0;
+    Box *thisbox = box ? _dw_window_pointer_get(box) : NULL;
+    HWND handle = 0;
+
+    /* Try to remove it from the layout */
+    if(thisbox && index > -1 && index < thisbox->count)
+    {
+       handle = thisbox->items[index].hwnd;
+
+       _dw_box_item_remove(thisbox, index);
+       _dw_box_invalidate(box);
+#if 0
+       /* Platform specific code to remove item from box */
+       BoxRemove(box, handle);
+#endif
+    }
+    return handle;
 }
 
 /*
@@ -1063,6 +1140,46 @@ void API dw_listbox_list_append(HWND handle, char **text, int count)
 {
 }
 
+/*
+ * Makes a listbox or combobox virtual, the application supplies the
+ * text of each entry on demand instead of appending it.  Functions
+ * that add, change or delete single entries are ignored on virtual
+ * lists, call this again when the number of entries changes.
+ * Parameters:
+ *          handle: Handle to the listbox to be made virtual.
+ *          count: Number of entries in the list.
+ *          textfunc: Function returning the text of an entry, with the
+ *                    prototype char *textfunc(HWND handle, int index, void *data).
+ *                    The text only needs to remain valid until the next
+ *                    call.  NULL returns the list to normal with no entries.
+ *          data: Pointer passed to the text function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_listbox_set_virtual(HWND handle, int count, void *textfunc, void *data)
+{
+    return DW_ERROR_GENERAL;
+}
+
+/*
+ * Stops the listbox from updating while many items are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the listbox to freeze.
+ */
+void API dw_listbox_freeze(HWND handle)
+{
+}
+
+/*
+ * Resumes updating of a frozen listbox, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the listbox to thaw.
+ */
+void API dw_listbox_thaw(HWND handle)
+{
+}
+
 /*
  * Clears the listbox's (or combobox) list of all entries.
  * Parameters:
@@ -1214,6 +1331,41 @@ void API dw_mle_export(HWND handle, char *buffer, int startpoint, int length)
 {
 }
 
+/*
+ * Appends text to an MLE box in chunks read by a callback, so large
+ * files do not need to be loaded into memory first.  The callback is
+ * called with the MLE detached from its view, so it must not use the MLE.
+ * Parameters:
+ *          handle: Handle to the MLE to be inserted into.
+ *          readfunc: Function that fills in the next chunk of UTF-8 text,
+ *                    with the prototype int readfunc(HWND handle, char *buffer, int length, void *data).
+ *                    It returns the number of bytes read, 0 at the end or -1 on error.
+ *          data: Pointer passed to the read function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_mle_import_stream(HWND handle, void *readfunc, void *data)
+{
+    return DW_ERROR_GENERAL;
+}
+
+/*
+ * Passes the text of an MLE box to a callback in chunks, so large
+ * contents do not need a buffer big enough for all the text.
+ * Parameters:
+ *          handle: Handle to the MLE to be queried.
+ *          writefunc: Function that receives each chunk of UTF-8 text,
+ *                     with the prototype int writefunc(HWND handle, const char *buffer, int length, void *data).
+ *                     It returns the number of bytes written, less than length stops the export.
+ *          data: Pointer passed to the write function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_mle_export_stream(HWND handle, void *writefunc, void *data)
+{
+    return DW_ERROR_GENERAL;
+}
+
 /*
  * Obtains information about an MLE box.
  * Parameters:
@@ -1458,6 +1610,34 @@ void API dw_font_text_extents_get(HWND handle, HPIXMAP pixmap, const char *text,
 {
 }
 
+/* Query the width and height of multiple text strings at once.
+ * Parameters:
+ *       handle: Handle to the window.
+ *       pixmap: Handle to the pixmap. (choose only one of these)
+ *       count: Number of strings in the texts array.
+ *       texts: Array of text strings to be queried, NULL entries
+ *              get a width and height of 0.
+ *       widths: Array of count integers to be filled in with the widths, or NULL.
+ *       heights: Array of count integers to be filled in with the heights, or NULL.
+ */
+void API dw_font_text_extents_get_many(HWND handle, HPIXMAP pixmap, int count, char **texts, int *widths, int *heights)
+{
+    int z;
+
+    for(z=0;texts && z<count;z++)
+    {
+        if(texts[z])
+            dw_font_text_extents_get(handle, pixmap, texts[z], widths ? &widths[z] : NULL, heights ? &heights[z] : NULL);
+        else
+        {
+            if(widths)
+                widths[z] = 0;
+            if(heights)
+                heights[z] = 0;
+        }
+    }
+}
+
 /* Draw a polygon on a window (preferably a render window).
  * Parameters:
  *       handle: Handle to the window.
@@ -1574,6 +1754,24 @@ HTREEITEM API dw_tree_get_parent(HWND handle, HTREEITEM item)
     return 0;
 }
 
+/*
+ * Inserts many items into a tree window (widget) under one parent.
+ * Parameters:
+ *          handle: Handle to the tree to be inserted.
+ *          parent: Parent handle or 0 if root.
+ *          count: Number of items to insert.
+ *          titles: Array of count text titles.
+ *          icons: Array of count icon handles or NULL for no icons.
+ *          itemdata: Array of count item data pointers or NULL.
+ *          items: Array to receive the count new item handles or NULL.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_tree_insert_many(HWND handle, HTREEITEM parent, int count, char **titles, HICN *icons, void **itemdata, HTREEITEM *items)
+{
+    return DW_ERROR_GENERAL;
+}
+
 /*
  * Sets the text and icon of an item in a tree window (widget).
  * Parameters:
@@ -1629,6 +1827,25 @@ void API dw_tree_clear(HWND handle)
 {
 }
 
+/*
+ * Stops the tree from updating while many items are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the tree to freeze.
+ */
+void API dw_tree_freeze(HWND handle)
+{
+}
+
+/*
+ * Resumes updating of a frozen tree, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the tree to thaw.
+ */
+void API dw_tree_thaw(HWND handle)
+{
+}
+
 /*
  * Expands a node on a tree.
  * Parameters:
@@ -1649,6 +1866,24 @@ void API dw_tree_item_collapse(HWND handle, HTREEITEM item)
 {
 }
 
+/*
+ * Marks a tree item as having children that are inserted on demand.
+ * The item shows an expander, and the DW_SIGNAL_TREE_EXPAND handler
+ * inserts the children when the item is expanded the first time.
+ * The handler is also called on later expands, even if the children exist.
+ * Parameters:
+ *       handle: Handle to the tree window (widget).
+ *       item: Handle to the node to be marked.
+ *       flags: DW_TREE_LAZY, DW_TREE_LAZY_DROP to also delete the children
+ *              when the node is collapsed, or 0 to turn it off.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_tree_item_set_lazy(HWND handle, HTREEITEM item, int flags)
+{
+    return DW_ERROR_GENERAL;
+}
+
 /*
  * Removes a node from a tree.
  * Parameters:
@@ -1971,6 +2206,68 @@ char * API dw_container_query_next(HWND handle, unsigned long flags)
     return NULL;
 }
 
+/*
+ * Returns all matching rows of a container in one call.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       flags: DW_CRA_SELECTED or DW_CRA_CURSORED to limit the rows
+ *              returned, otherwise all rows are returned.
+ *              DW_CR_RETDATA to return the row data instead of titles.
+ *              DW_CR_RETINDEX to return zero based row indexes instead,
+ *              read each one with DW_POINTER_TO_INT().
+ *       count: Pointer to an integer to receive the number of rows.
+ * Returns:
+ *       An array of titles, data pointers or row indexes which must be
+ *       freed with dw_free(), or NULL if there are no matching rows.
+ *       Titles are copied into the same block as the array.
+ */
+void ** API dw_container_query_selected(HWND handle, unsigned long flags, int *count)
+{
+    if(count)
+        *count = 0;
+    return NULL;
+}
+
+/*
+ * Starts iterating the rows of a container.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       flags: DW_CRA_SELECTED or DW_CRA_CURSORED to limit the rows
+ *              returned, otherwise all rows are returned.
+ * Returns:
+ *       An iterator handle to pass to dw_container_iter_next() and
+ *       dw_container_iter_end(), or NULL on error.
+ */
+HCONTITER API dw_container_iter_begin(HWND handle, unsigned long flags)
+{
+    return NULL;
+}
+
+/*
+ * Moves a container iterator to the next row.  The title and data are
+ * borrowed from the container and are valid until the next call.
+ * Parameters:
+ *       iter: Iterator handle returned by dw_container_iter_begin().
+ *       title: Pointer to receive the row title or NULL.
+ *       data: Pointer to receive the row data or NULL.
+ * Returns:
+ *       TRUE if a row was returned, FALSE at the end of the rows.
+ */
+int API dw_container_iter_next(HCONTITER iter, const char **title, void **data)
+{
+    return FALSE;
+}
+
+/*
+ * Finishes a container iteration and frees the iterator.
+ * Parameters:
+ *       iter: Iterator handle returned by dw_container_iter_begin().
+ */
+void API dw_container_iter_end(HCONTITER iter)
+{
+}
+
+
 /*
  * Cursors the item with the text speficied, and scrolls to that item.
  * Parameters:
@@ -2020,6 +2317,71 @@ void API dw_container_optimize(HWND handle)
 {
 }
 
+/*
+ * Sorts the rows of a container by the contents of a column,
+ * rows with equal values keep their order.  Rows added later
+ * are not sorted.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based column to sort by.
+ *          order: DW_SORT_ASCENDING or DW_SORT_DESCENDING.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_container_sort(HWND handle, int column, int order)
+{
+    return DW_ERROR_GENERAL;
+}
+
+/*
+ * Sets whether clicking a column heading sorts the container by
+ * that column, clicking the same heading again reverses the order.
+ * The column click signal handler is called after the rows are sorted.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          sortable: TRUE to sort on heading clicks, FALSE to leave it to the application.
+ */
+void API dw_container_set_sortable(HWND handle, int sortable)
+{
+}
+
+/*
+ * Shows only the rows of a container whose text in a column contains
+ * the filter text, ignoring case unless DW_FILTER_CASESENSITIVE is set.
+ * Rows hidden by the filter are still returned by queries of all rows,
+ * and row numbers passed to other functions count hidden rows.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based string column to filter on.
+ *          text: Text the column must contain, NULL or "" shows all rows.
+ *          flags: DW_FILTER_CASESENSITIVE or 0.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_container_set_filter(HWND handle, int column, const char *text, unsigned long flags)
+{
+    return DW_ERROR_GENERAL;
+}
+
+/*
+ * Stops the container from updating while many rows are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the container to freeze.
+ */
+void API dw_container_freeze(HWND handle)
+{
+}
+
+/*
+ * Resumes updating of a frozen container, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the container to thaw.
+ */
+void API dw_container_thaw(HWND handle)
+{
+}
+
 /*
  * Inserts an icon into the taskbar.
  * Parameters:
@@ -2070,6 +2432,34 @@ HICN API dw_icon_load_from_file(const char *filename)
     return 0;
 }
 
+/*
+ * Obtains an icon from a file and passes it to a callback.
+ * There is no background loader on this platform, so the file
+ * is loaded and the callback run on the calling thread before
+ * this function returns.
+ * Parameters:
+ *       filename: Name of the file, omit extention to have
+ *                 DW pick the appropriate file extension.
+ *                 (ICO on OS/2 or Windows, XPM on Unix)
+ *       callback: Function of the form int func(HICN icon, void *data)
+ *                 icon will be NULL if the file could not be loaded.
+ *       data: User data to be passed to the callback.
+ * Returns:
+ *       DW_ERROR_NONE once the callback has run, DW_ERROR_GENERAL on error
+ *       in which case the callback will not be called.
+ */
+int API dw_icon_load_from_file_async(const char *filename, void *callback, void *data)
+{
+    int (*iconfunc)(HICN, void *) = (int (*)(HICN, void *))callback;
+
+    if(!filename || !*filename || !callback)
+        return DW_ERROR_GENERAL;
+
+    /* No background loader on this platform, load it immediately */
+    iconfunc(dw_icon_load_from_file(filename), data);
+    return DW_ERROR_NONE;
+}
+
 /*
  * Obtains an icon from data.
  * Parameters:
@@ -2182,6 +2572,35 @@ HPIXMAP API dw_pixmap_new_from_file(HWND handle, const char *filename)
     return 0;
 }
 
+/*
+ * Creates a pixmap from a file and passes it to a callback.
+ * There is no background loader on this platform, so the file
+ * is loaded and the callback run on the calling thread before
+ * this function returns.
+ * Parameters:
+ *       handle: Window handle the pixmap is associated with.
+ *       filename: Name of the file, omit extention to have
+ *                 DW pick the appropriate file extension.
+ *                 (BMP on OS/2 or Windows, XPM on Unix)
+ *       callback: Function of the form int func(HPIXMAP pixmap, void *data)
+ *                 pixmap will be NULL if the file could not be loaded.
+ *       data: User data to be passed to the callback.
+ * Returns:
+ *       DW_ERROR_NONE once the callback has run, DW_ERROR_GENERAL on error
+ *       in which case the callback will not be called.
+ */
+int API dw_pixmap_new_from_file_async(HWND handle, const char *filename, void *callback, void *data)
+{
+    int (*pixmapfunc)(HPIXMAP, void *) = (int (*)(HPIXMAP, void *))callback;
+
+    if(!filename || !*filename || !callback)
+        return DW_ERROR_GENERAL;
+
+    /* No background loader on this platform, load it immediately */
+    pixmapfunc(dw_pixmap_new_from_file(handle, filename), data);
+    return DW_ERROR_NONE;
+}
+
 /*
  * Creates a pixmap from data in memory.
  * Parameters:
@@ -2979,6 +3398,33 @@ void API dw_window_redraw(HWND handle)
 {
 }
 
+/*
+ * Suspends automatic layout of a top-level window, used
+ * when packing a large number of widgets at once.
+ * Calls may be nested, each must be matched by a thaw.
+ * Parameters:
+ *           handle: Toplevel window handle.
+ * Returns:
+ *       DW_ERROR_NONE on success or DW_ERROR_GENERAL on error.
+ */
+int API dw_window_layout_freeze(HWND handle)
+{
+    return DW_ERROR_GENERAL;
+}
+
+/*
+ * Resumes automatic layout of a top-level window, the layout
+ * is queued when the last freeze is removed.
+ * Parameters:
+ *           handle: Toplevel window handle.
+ * Returns:
+ *       DW_ERROR_NONE on success or DW_ERROR_GENERAL on error.
+ */
+int API dw_window_layout_thaw(HWND handle)
+{
+    return DW_ERROR_GENERAL;
+}
+
 /*
  * Makes the window topmost.
  * Parameters:
@@ -3819,3 +4265,32 @@ int API dw_feature_set(DWFEATURE feature, int state)
             return DW_FEATURE_UNSUPPORTED;
     }
 }
+
+/*
+ * Writes the data recorded while DW_FEATURE_TRACE was enabled.
+ * Parameters:
+ *       filename: Name of the file to write, or NULL for stderr.
+ *       flags: DW_TRACE_DUMP_JSON to write Chrome trace event JSON instead
+ *              of a table of statistics per function.
+ *              DW_TRACE_DUMP_RESET to clear the data after writing it.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_trace_dump(const char *filename, unsigned long flags)
+{
+    return DW_ERROR_GENERAL;
+}
+
+/*
+ * Returns the handler timings recorded while DW_FEATURE_SIGNAL_PROFILE
+ * was enabled.  Timer callbacks are recorded as the "timer" signal.
+ * Parameters:
+ *       signame: Name of the signal to query, or NULL for all signals.
+ *       stats: Pointer to a DWSignalStats structure to fill in.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_signal_stats_get(const char *signame, DWSignalStats *stats)
+{
+    return DW_ERROR_GENERAL;
+}
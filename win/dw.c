@@ -72,6 +72,8 @@ int _DW_MLE_RICH_EDIT = DW_FEATURE_UNSUPPORTED;
 #define BrowserClassName TEXT("dwbrowserclass")
 #define ScrollClassName TEXT("dwscrollclass")
 #define StatusbarClassName TEXT("dwstatusbar")
+/* Message posted to top-level windows to run a queued layout */
+#define _DW_WM_LAYOUT (WM_USER+20)
 #define DefaultFont NULL
 
 #ifdef GDIPLUS
@@ -383,20 +385,18 @@ HFONT _dw_acquire_font(HWND handle, const char *fontname);
 void _dw_click_default(HWND handle);
 void _dw_do_resize(Box *thisbox, int x, int y, int xborder, int yborder);
 
-/* Internal function to queue a window redraw */
-void _dw_redraw(HWND window, int skip)
+/* Internal function to queue a window redraw...
+ * Posts a single layout message to the top-level window,
+ * further requests are ignored until it has been handled
+ * so the layout is done at most once per pass of the loop.
+ */
+void _dw_redraw(HWND window)
 {
-    static HWND lastwindow = 0;
-    HWND redraw = lastwindow;
-
-    if(skip && !window)
-        return;
-
-    lastwindow = window;
-    if(redraw != lastwindow && redraw)
-    {
-        dw_window_redraw(redraw);
-    }
+   if(window && !dw_window_get_data(window, "_dw_layout_queued"))
+   {
+      dw_window_set_data(window, "_dw_layout_queued", DW_INT_TO_POINTER(1));
+      PostMessage(window, _DW_WM_LAYOUT, 0, 0);
+   }
 }
 
 typedef struct _dwsighandler
@@ -1264,7 +1264,7 @@ BOOL CALLBACK _dw_free_window_memory(HWND handle, LPARAM lParam)
    {
       Box *box = (Box *)thiscinfo;
 
-      if(box && box->count && box->items)
+      if(box && box->items)
          free(box->items);
    }
    else if(_tcsnicmp(tmpbuf, SplitbarClassName, _tcslen(SplitbarClassName)+1)==0)
@@ -1674,13 +1674,13 @@ void _dw_shift_focus(HWND handle, int direction)
    }
 }
 
-/* This function calculates how much space the widgets and boxes require
- * and does expansion as necessary.
+/* Calculates the space required by a box and the boxes packed in it,
+ * boxes that have not changed since they were last measured keep
+ * their cached sizes and are not walked again.
  */
-static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int xborder, int yborder, int pass)
+static void _dw_measure_box(Box *thisbox, int *depth)
 {
-   /* Current item position */
-   int z, currentx = thisbox->pad, currenty = thisbox->pad;
+   int z;
    /* Used x, y and padding maximum values...
     * These will be used to find the widest or
     * tallest items in a box.
@@ -1693,34 +1693,28 @@ static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int xborder,
 
    if(thisbox->grouphwnd)
    {
-      /* Only calculate the size on the first pass...
-       * use the cached values on second.
-       */
-      if(pass == 1)
-      {
-         char *text = dw_window_get_text(thisbox->grouphwnd);
+      char *text = dw_window_get_text(thisbox->grouphwnd);
 
-         thisbox->grouppady = 9;
+      thisbox->grouppady = 9;
 
-         if(text)
-         {
-            if(*text)
-               dw_font_text_extents_get(thisbox->grouphwnd, 0, text, NULL, &thisbox->grouppady);
-            dw_free(text);
-         }
-         /* If the string height is less than 9...
-          * set it to 9 anyway since that is the minimum.
-          */
-         if(thisbox->grouppady < 9)
-            thisbox->grouppady = 9;
+      if(text)
+      {
+         if(*text)
+            dw_font_text_extents_get(thisbox->grouphwnd, 0, text, NULL, &thisbox->grouppady);
+         dw_free(text);
+      }
+      /* If the string height is less than 9...
+       * set it to 9 anyway since that is the minimum.
+       */
+      if(thisbox->grouppady < 9)
+         thisbox->grouppady = 9;
 
-         if(thisbox->grouppady)
-            thisbox->grouppady += 3;
-         else
-            thisbox->grouppady = 6;
+      if(thisbox->grouppady)
+         thisbox->grouppady += 3;
+      else
+         thisbox->grouppady = 6;
 
-         thisbox->grouppadx = 6;
-      }
+      thisbox->grouppadx = 6;
 
       thisbox->minwidth += thisbox->grouppadx;
       thisbox->usedpadx += thisbox->grouppadx;
@@ -1739,26 +1733,26 @@ static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int xborder,
 
          if(tmp)
          {
-            /* On the first pass calculate the box contents */
-            if(pass == 1)
+            /* Only boxes which changed need to calculate their contents */
+            if(!(tmp->layout & _DW_LAYOUT_MEASURED))
             {
                (*depth)++;
 
                /* Save the newly calculated values on the box */
-               _dw_resize_box(tmp, depth, x, y, 0, 0, pass);
-
-               /* Duplicate the values in the item list for use below */
-               thisbox->items[z].width = tmp->minwidth;
-               thisbox->items[z].height = tmp->minheight;
-
-               /* If the box has no contents but is expandable... default the size to 1 */
-               if(!thisbox->items[z].width && thisbox->items[z].hsize)
-                  thisbox->items[z].width = 1;
-               if(!thisbox->items[z].height && thisbox->items[z].vsize)
-                  thisbox->items[z].height = 1;
+               _dw_measure_box(tmp, depth);
 
                (*depth)--;
             }
+
+            /* Duplicate the values in the item list for use below */
+            thisbox->items[z].width = tmp->minwidth;
+            thisbox->items[z].height = tmp->minheight;
+
+            /* If the box has no contents but is expandable... default the size to 1 */
+            if(!thisbox->items[z].width && thisbox->items[z].hsize)
+               thisbox->items[z].width = 1;
+            if(!thisbox->items[z].height && thisbox->items[z].vsize)
+               thisbox->items[z].height = 1;
          }
       }
 
@@ -1819,6 +1813,24 @@ static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int xborder,
    thisbox->usedpadx += upxmax;
    thisbox->usedpady += upymax;
 
+   /* The cached sizes are valid until the box is invalidated,
+    * the contents need to be placed again using the new sizes.
+    */
+   thisbox->layout = _DW_LAYOUT_MEASURED;
+}
+
+/* This function calculates how much space the widgets and boxes require
+ * and does expansion as necessary.
+ */
+static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int xborder, int yborder, int pass)
+{
+   /* Current item position */
+   int z, currentx = thisbox->pad, currenty = thisbox->pad;
+
+   /* Only calculate the space requirements if something changed */
+   if(!(thisbox->layout & _DW_LAYOUT_MEASURED))
+      _dw_measure_box(thisbox, depth);
+
    /* Move the groupbox start past the group border */
    if(thisbox->grouphwnd)
    {
@@ -2024,10 +2036,14 @@ static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int xborder,
                         MoveWindow(boxinfo->grouphwnd, 0, 0,
                                  width, height, FALSE);
                      }
-                     /* Dive into the box */
-                     (*depth)++;
-                     _dw_resize_box(boxinfo, depth, width, height, 0, 0, pass);
-                     (*depth)--;
+                     /* Dive into the box if it or its size changed */
+                     if(!(boxinfo->layout & _DW_LAYOUT_PLACED) ||
+                        boxinfo->placedwidth != width || boxinfo->placedheight != height)
+                     {
+                        (*depth)++;
+                        _dw_resize_box(boxinfo, depth, width, height, 0, 0, pass);
+                        (*depth)--;
+                     }
                   }
                }
             }
@@ -2064,6 +2080,10 @@ static void _dw_resize_box(Box *thisbox, int *depth, int x, int y, int xborder,
                currenty += height + (pad * 2);
          }
       }
+      /* Remember the size the contents were placed at */
+      thisbox->layout |= _DW_LAYOUT_PLACED;
+      thisbox->placedwidth = x;
+      thisbox->placedheight = y;
    }
 }
 
@@ -2918,6 +2938,11 @@ LRESULT CALLBACK _dw_wndproc(HWND hWnd, UINT msg, WPARAM mp1, LPARAM mp2)
       _dw_free_menu_data((HMENU)mp1);
       DestroyMenu((HMENU)mp1);
       break;
+   case _DW_WM_LAYOUT:
+      dw_window_set_data(hWnd, "_dw_layout_queued", NULL);
+      if(!dw_window_get_data(hWnd, "_dw_layout_freeze"))
+         dw_window_redraw(hWnd);
+      break;
    case WM_NOTIFY:
       {
          NMHDR FAR *tem=(NMHDR FAR *)mp2;
@@ -3032,12 +3057,7 @@ LRESULT CALLBACK _dw_wndproc(HWND hWnd, UINT msg, WPARAM mp1, LPARAM mp2)
       return _dw_colorwndproc(hWnd, msg, mp1, mp2);
    }
    if(result != -1)
-   {
-      /* Make sure any queued redraws are handled */
-      _dw_redraw(0, FALSE);
-      /* Then finally return */
       return result;
-   }
    return DefWindowProc(hWnd, msg, mp1, mp2);
 }
 
@@ -4429,7 +4449,6 @@ LRESULT CALLBACK _dw_buttonwndproc(HWND hwnd, ULONG msg, WPARAM mp1, LPARAM mp2)
 {
    ColorInfo *cinfo = _dw_window_get_cinfo(hwnd);
    WNDPROC pOldProc;
-   int retval = -1;
 
    if ( !cinfo )
       return DefWindowProc(hwnd, msg, mp1, mp2);
@@ -4473,7 +4492,7 @@ LRESULT CALLBACK _dw_buttonwndproc(HWND hwnd, ULONG msg, WPARAM mp1, LPARAM mp2)
                   if(checkbox)
                      in_checkbox_handler = 1;
 
-                  retval = clickfunc(tmp->window, tmp->data);
+                  clickfunc(tmp->window, tmp->data);
 
                   if(checkbox)
                      in_checkbox_handler = 0;
@@ -4504,7 +4523,7 @@ LRESULT CALLBACK _dw_buttonwndproc(HWND hwnd, ULONG msg, WPARAM mp1, LPARAM mp2)
                   /* Make sure it's the right window, and the right ID */
                   if(tmp->window == hwnd)
                   {
-                     retval = clickfunc(tmp->window, tmp->data);
+                     clickfunc(tmp->window, tmp->data);
                      tmp = NULL;
                   }
                }
@@ -4530,9 +4549,6 @@ LRESULT CALLBACK _dw_buttonwndproc(HWND hwnd, ULONG msg, WPARAM mp1, LPARAM mp2)
       break;
    }
 
-   /* Make sure windows are up-to-date */
-   if(retval != -1)
-      _dw_redraw(0, FALSE);
    if ( !pOldProc )
       return DefWindowProc(hwnd, msg, mp1, mp2);
    return CallWindowProc(pOldProc, hwnd, msg, mp1, mp2);
@@ -4950,8 +4966,6 @@ void API dw_main(void)
    MSG msg;
 
    _dwtid = dw_thread_id();
-   /* Make sure any queued redraws are handled */
-   _dw_redraw(0, FALSE);
 
    /* Set the running flag to TRUE */
    _dw_main_running = TRUE;
@@ -5296,6 +5310,55 @@ void API dw_window_redraw(HWND handle)
    }
 }
 
+/*
+ * Suspends automatic layout of a top-level window, used
+ * when packing a large number of widgets at once.
+ * Calls may be nested, each must be matched by a thaw.
+ * Parameters:
+ *           handle: Toplevel window handle.
+ * Returns:
+ *       DW_ERROR_NONE on success or DW_ERROR_GENERAL on error.
+ */
+int API dw_window_layout_freeze(HWND handle)
+{
+   int freeze;
+
+   if(!handle || !(handle = _dw_toplevel_window(handle)))
+      return DW_ERROR_GENERAL;
+
+   freeze = DW_POINTER_TO_INT(dw_window_get_data(handle, "_dw_layout_freeze"));
+   dw_window_set_data(handle, "_dw_layout_freeze", DW_INT_TO_POINTER(freeze + 1));
+   return DW_ERROR_NONE;
+}
+
+/*
+ * Resumes automatic layout of a top-level window, the layout
+ * is queued when the last freeze is removed.
+ * Parameters:
+ *           handle: Toplevel window handle.
+ * Returns:
+ *       DW_ERROR_NONE on success or DW_ERROR_GENERAL on error.
+ */
+int API dw_window_layout_thaw(HWND handle)
+{
+   int freeze;
+
+   if(!handle || !(handle = _dw_toplevel_window(handle)))
+      return DW_ERROR_GENERAL;
+
+   freeze = DW_POINTER_TO_INT(dw_window_get_data(handle, "_dw_layout_freeze"));
+   if(freeze < 1)
+      return DW_ERROR_GENERAL;
+   if(--freeze)
+      dw_window_set_data(handle, "_dw_layout_freeze", DW_INT_TO_POINTER(freeze));
+   else
+   {
+      dw_window_set_data(handle, "_dw_layout_freeze", NULL);
+      _dw_redraw(handle);
+   }
+   return DW_ERROR_NONE;
+}
+
 /*
  * Changes a window's parent to newparent.
  * Parameters:
@@ -5398,6 +5461,35 @@ void API dw_font_set_default(const char *fontname)
     }
 }
 
+/* Internal function to clear the cached layout of the box handle
+ * is packed into and every box above it, so the next layout pass
+ * measures and places them again.
+ */
+void _dw_box_invalidate(HWND handle)
+{
+   while(handle && handle != HWND_DESKTOP && handle != DW_HWND_OBJECT)
+   {
+      TCHAR tmpbuf[100] = {0};
+      int toplevel;
+
+      GetClassName(handle, tmpbuf, 99);
+
+      toplevel = (_tcsnicmp(tmpbuf, ClassName, _tcslen(ClassName)+1)==0);
+
+      if(toplevel || _tcsnicmp(tmpbuf, FRAMECLASSNAME, _tcslen(FRAMECLASSNAME)+1)==0)
+      {
+         Box *thisbox = (Box *)GetWindowLongPtr(handle, GWLP_USERDATA);
+
+         if(thisbox)
+            thisbox->layout = 0;
+      }
+      /* The parent of a top-level window is its owner */
+      if(toplevel)
+         return;
+      handle = GetParent(handle);
+   }
+}
+
 /* Internal function to return a pointer to an item struct
  * with information about the packing information regarding object.
  */
@@ -5826,8 +5918,9 @@ int API dw_window_set_font(HWND handle, const char *fontname)
        if(item && (item->origwidth == DW_SIZE_AUTO || item->origheight == DW_SIZE_AUTO))
        {
           _dw_control_size(handle, item->origwidth == DW_SIZE_AUTO ? &item->width : NULL, item->origheight == DW_SIZE_AUTO ? &item->height : NULL);
+          _dw_box_invalidate(handle);
           /* Queue a redraw on the top-level window */
-         _dw_redraw(_dw_toplevel_window(handle), TRUE);
+         _dw_redraw(_dw_toplevel_window(handle));
        }
        return DW_ERROR_NONE;
     }
@@ -7857,8 +7950,9 @@ int _dw_window_set_bitmap(HWND handle, HICON icon, HBITMAP hbitmap)
       if(item && (item->origwidth == DW_SIZE_AUTO || item->origheight == DW_SIZE_AUTO))
       {
          _dw_control_size(handle, item->origwidth == DW_SIZE_AUTO ? &item->width : NULL, item->origheight == DW_SIZE_AUTO ? &item->height : NULL);
+         _dw_box_invalidate(handle);
          /* Queue a redraw on the top-level window */
-         _dw_redraw(_dw_toplevel_window(handle), TRUE);
+         _dw_redraw(_dw_toplevel_window(handle));
       }
    }
    return DW_ERROR_NONE;
@@ -7996,7 +8090,11 @@ void API dw_window_set_text(HWND handle, const char *text)
       /* groupbox */
       thisbox = (Box *)GetWindowLongPtr(handle, GWLP_USERDATA);
       if(thisbox && thisbox->grouphwnd != (HWND)NULL)
+      {
          SetWindowText(thisbox->grouphwnd, wtext);
+         /* The title height is part of the groupbox layout */
+         _dw_box_invalidate(handle);
+      }
    }
    /* If we changed the text... */
    {
@@ -8017,8 +8115,9 @@ void API dw_window_set_text(HWND handle, const char *text)
                item->width = newwidth;
             if(item->origheight == DW_SIZE_AUTO)
                item->height = newheight;
+            _dw_box_invalidate(handle);
             /* Queue a redraw on the top-level window */
-            _dw_redraw(_dw_toplevel_window(handle), TRUE);
+            _dw_redraw(_dw_toplevel_window(handle));
          }
       }
    }
@@ -8150,6 +8249,37 @@ HWND API dw_window_from_id(HWND handle, int id)
     return _dw_wfid_hwnd;
 }
 
+/* Make room for an item at index in the box's item array,
+ * doubling the allocation when it is full so packing many
+ * items does not reallocate and copy on every call.
+ * Returns the item array or NULL on allocation failure.
+ */
+static Item *_dw_box_item_insert(Box *thisbox, int index)
+{
+   if(thisbox->count >= thisbox->alloc)
+   {
+      int alloc = thisbox->alloc ? thisbox->alloc * 2 : 4;
+      Item *items = realloc(thisbox->items, sizeof(Item) * alloc);
+
+      if(!items)
+         return NULL;
+      thisbox->items = items;
+      thisbox->alloc = alloc;
+   }
+   memmove(&thisbox->items[index+1], &thisbox->items[index], sizeof(Item) * (thisbox->count - index));
+   memset(&thisbox->items[index], 0, sizeof(Item));
+   return thisbox->items;
+}
+
+/* Remove the item at index from the box's item array,
+ * the allocation is kept for reuse until the box is destroyed.
+ */
+static void _dw_box_item_remove(Box *thisbox, int index)
+{
+   thisbox->count--;
+   memmove(&thisbox->items[index], &thisbox->items[index+1], sizeof(Item) * (thisbox->count - index));
+}
+
 /* Internal box packing function called by the other 3 functions */
 void _dw_box_pack(HWND box, HWND item, int index, int width, int height, int hsize, int vsize, int pad, char *funcname)
 {
@@ -8182,26 +8312,19 @@ void _dw_box_pack(HWND box, HWND item, int index, int width, int height, int hsi
        thisbox = (Box *)GetWindowLongPtr(box, GWLP_USERDATA);
    if(thisbox)
    {
-      int z, x = 0;
-      Item *tmpitem, *thisitem = thisbox->items;
+      Item *tmpitem;
 
       /* Do some sanity bounds checking */
-      if(!thisitem)
+      if(!thisbox->items)
           thisbox->count = 0;
       if(index < 0)
         index = 0;
       if(index > thisbox->count)
         index = thisbox->count;
 
-      tmpitem = calloc(sizeof(Item), (thisbox->count+1));
-
-      for(z=0;z<thisbox->count;z++)
-      {
-         if(z == index)
-            x++;
-         tmpitem[x] = thisitem[z];
-         x++;
-      }
+      /* Make room for the new item */
+      if(!(tmpitem = _dw_box_item_insert(thisbox, index)))
+         return;
 
       GetClassName(item, tmpbuf, 99);
 
@@ -8244,12 +8367,8 @@ void _dw_box_pack(HWND box, HWND item, int index, int width, int height, int hsi
       if(width == DW_SIZE_AUTO || height == DW_SIZE_AUTO)
          _dw_control_size(item, width == DW_SIZE_AUTO ? &tmpitem[index].width : NULL, height == DW_SIZE_AUTO ? &tmpitem[index].height : NULL);
 
-      thisbox->items = tmpitem;
-
-      if(thisitem)
-         free(thisitem);
-
       thisbox->count++;
+      _dw_box_invalidate(box);
 
 #ifdef AEROGLASS
       _dw_allow_dark_mode_for_window(item, _DW_DARK_MODE_ENABLED);
@@ -8281,7 +8400,7 @@ void _dw_box_pack(HWND box, HWND item, int index, int width, int height, int hsi
       }
 #endif
       /* Queue a redraw on the top-level window */
-      _dw_redraw(_dw_toplevel_window(box), TRUE);
+      _dw_redraw(_dw_toplevel_window(box));
    }
 }
 
@@ -8306,7 +8425,7 @@ int API dw_box_unpack(HWND handle)
       if(thisbox && thisbox->count)
       {
          int z, index = -1;
-         Item *tmpitem = NULL, *thisitem = thisbox->items;
+         Item *thisitem = thisbox->items;
 
          if(!thisitem)
              thisbox->count = 0;
@@ -8320,32 +8439,12 @@ int API dw_box_unpack(HWND handle)
          if(index == -1)
             return DW_ERROR_GENERAL;
 
-         if(thisbox->count > 1)
-         {
-            tmpitem = calloc(sizeof(Item), (thisbox->count-1));
-
-            /* Copy all but the current entry to the new list */
-            for(z=0;z<index;z++)
-            {
-               tmpitem[z] = thisitem[z];
-            }
-            for(z=index+1;z<thisbox->count;z++)
-            {
-               tmpitem[z-1] = thisitem[z];
-            }
-         }
-
-         thisbox->items = tmpitem;
-         if(thisitem)
-            free(thisitem);
-         if(tmpitem)
-            thisbox->count--;
-         else
-            thisbox->count = 0;
+         _dw_box_item_remove(thisbox, index);
+         _dw_box_invalidate(parent);
 
          SetParent(handle, DW_HWND_OBJECT);
          /* Queue a redraw on the top-level window */
-         _dw_redraw(_dw_toplevel_window(parent), TRUE);
+         _dw_redraw(_dw_toplevel_window(parent));
          return DW_ERROR_NONE;
       }
    }
@@ -8367,38 +8466,16 @@ HWND API dw_box_unpack_at_index(HWND box, int index)
    /* Try to remove it from the layout */
    if(thisbox && index > -1 && index < thisbox->count)
    {
-      int z;
-      Item *tmpitem = NULL, *thisitem = thisbox->items;
-      HWND handle = thisitem[index].hwnd;
+      HWND handle = thisbox->items[index].hwnd;
 
-      if(thisbox->count > 1)
-      {
-         tmpitem = calloc(sizeof(Item), (thisbox->count-1));
-
-         /* Copy all but the current entry to the new list */
-         for(z=0;z<index;z++)
-         {
-            tmpitem[z] = thisitem[z];
-         }
-         for(z=index+1;z<thisbox->count;z++)
-         {
-            tmpitem[z-1] = thisitem[z];
-         }
-      }
-
-      thisbox->items = tmpitem;
-      if(thisitem)
-         free(thisitem);
-      if(tmpitem)
-         thisbox->count--;
-      else
-         thisbox->count = 0;
+      _dw_box_item_remove(thisbox, index);
+      _dw_box_invalidate(box);
 
       /* If it isn't padding, reset the parent */
       if(handle)
          SetParent(handle, DW_HWND_OBJECT);
       /* Queue a redraw on the top-level window */
-      _dw_redraw(_dw_toplevel_window(box), TRUE);
+      _dw_redraw(_dw_toplevel_window(box));
       return handle;
    }
    return 0;
@@ -9131,6 +9208,82 @@ void API dw_listbox_list_append(HWND handle, char **text, int count)
       SendMessage(handle,(WPARAM)listbox_type,0,(LPARAM)UTF8toWide(text[i]));
 }
 
+/* Internal function to stop a control redrawing, calls may be nested */
+static void _dw_freeze_redraw(HWND handle, int freeze)
+{
+   int frozen = DW_POINTER_TO_INT(dw_window_get_data(handle, "_dw_frozen"));
+
+   if(freeze)
+   {
+      if(!frozen)
+         SendMessage(handle, WM_SETREDRAW, FALSE, 0);
+      frozen++;
+   }
+   else if(frozen > 0 && !--frozen)
+   {
+      SendMessage(handle, WM_SETREDRAW, TRUE, 0);
+      InvalidateRect(handle, NULL, TRUE);
+   }
+   dw_window_set_data(handle, "_dw_frozen", DW_INT_TO_POINTER(frozen));
+}
+
+/*
+ * Makes a listbox or combobox virtual, the application supplies the
+ * text of each entry instead of appending it.  There are no native
+ * virtual lists on this platform, so the entries are requested up
+ * front, call this again when the number of entries changes.
+ * Parameters:
+ *          handle: Handle to the listbox to be made virtual.
+ *          count: Number of entries in the list.
+ *          textfunc: Function returning the text of an entry, with the
+ *                    prototype char *textfunc(HWND handle, int index, void *data).
+ *                    The text only needs to remain valid until the next
+ *                    call.  NULL returns the list to normal with no entries.
+ *          data: Pointer passed to the text function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_listbox_set_virtual(HWND handle, int count, void *textfunc, void *data)
+{
+   char *(*func)(HWND, int, void *) = (char *(*)(HWND, int, void *))textfunc;
+   int z;
+
+   if(!handle || count < 0)
+      return DW_ERROR_GENERAL;
+
+   dw_listbox_freeze(handle);
+   dw_listbox_clear(handle);
+   for(z=0;func && z<count;z++)
+   {
+      char *text = func(handle, z, data);
+
+      dw_listbox_append(handle, text ? text : "");
+   }
+   dw_listbox_thaw(handle);
+   return DW_ERROR_NONE;
+}
+
+/*
+ * Stops the listbox from updating while many items are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the listbox to freeze.
+ */
+void API dw_listbox_freeze(HWND handle)
+{
+   _dw_freeze_redraw(handle, TRUE);
+}
+
+/*
+ * Resumes updating of a frozen listbox, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the listbox to thaw.
+ */
+void API dw_listbox_thaw(HWND handle)
+{
+   _dw_freeze_redraw(handle, FALSE);
+}
+
 /*
  * Inserts the specified text to the listbox's (or combobox) entry list.
  * Parameters:
@@ -9466,6 +9619,41 @@ void API dw_mle_export(HWND handle, char *buffer, int startpoint, int length)
    free(tmpbuf);
 }
 
+/*
+ * Appends text to an MLE box in chunks read by a callback, so large
+ * files do not need to be loaded into memory first.  The callback is
+ * called with the MLE detached from its view, so it must not use the MLE.
+ * Parameters:
+ *          handle: Handle to the MLE to be inserted into.
+ *          readfunc: Function that fills in the next chunk of UTF-8 text,
+ *                    with the prototype int readfunc(HWND handle, char *buffer, int length, void *data).
+ *                    It returns the number of bytes read, 0 at the end or -1 on error.
+ *          data: Pointer passed to the read function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_mle_import_stream(HWND handle, void *readfunc, void *data)
+{
+   return DW_ERROR_GENERAL;
+}
+
+/*
+ * Passes the text of an MLE box to a callback in chunks, so large
+ * contents do not need a buffer big enough for all the text.
+ * Parameters:
+ *          handle: Handle to the MLE to be queried.
+ *          writefunc: Function that receives each chunk of UTF-8 text,
+ *                     with the prototype int writefunc(HWND handle, const char *buffer, int length, void *data).
+ *                     It returns the number of bytes written, less than length stops the export.
+ *          data: Pointer passed to the write function.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_mle_export_stream(HWND handle, void *writefunc, void *data)
+{
+   return DW_ERROR_GENERAL;
+}
+
 /*
  * Obtains information about an MLE box.
  * Parameters:
@@ -9921,6 +10109,40 @@ HTREEITEM API dw_tree_insert(HWND handle, const char *title, HICN icon, HTREEITE
    return hti;
 }
 
+/*
+ * Inserts many items into a tree window (widget) under one parent.
+ * Parameters:
+ *          handle: Handle to the tree to be inserted.
+ *          parent: Parent handle or 0 if root.
+ *          count: Number of items to insert.
+ *          titles: Array of count text titles.
+ *          icons: Array of count icon handles or NULL for no icons.
+ *          itemdata: Array of count item data pointers or NULL.
+ *          items: Array to receive the count new item handles or NULL.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_tree_insert_many(HWND handle, HTREEITEM parent, int count, char **titles, HICN *icons, void **itemdata, HTREEITEM *items)
+{
+   int retval = DW_ERROR_NONE, z;
+
+   if(!handle || !titles || count < 0)
+      return DW_ERROR_GENERAL;
+
+   dw_tree_freeze(handle);
+   for(z=0;z<count;z++)
+   {
+      HTREEITEM item = dw_tree_insert(handle, titles[z], icons ? icons[z] : 0, parent, itemdata ? itemdata[z] : NULL);
+
+      if(!item)
+         retval = DW_ERROR_GENERAL;
+      if(items)
+         items[z] = item;
+   }
+   dw_tree_thaw(handle);
+   return retval;
+}
+
 /*
  * Sets the text and icon of an item in a tree window (widget).
  * Parameters:
@@ -10041,6 +10263,27 @@ void API dw_tree_clear(HWND handle)
    dw_window_set_data(handle, "_dw_select_item", NULL);
 }
 
+/*
+ * Stops the tree from updating while many items are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the tree to freeze.
+ */
+void API dw_tree_freeze(HWND handle)
+{
+   _dw_freeze_redraw(handle, TRUE);
+}
+
+/*
+ * Resumes updating of a frozen tree, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the tree to thaw.
+ */
+void API dw_tree_thaw(HWND handle)
+{
+   _dw_freeze_redraw(handle, FALSE);
+}
+
 /*
  * Expands a node on a tree.
  * Parameters:
@@ -10063,6 +10306,24 @@ void API dw_tree_item_collapse(HWND handle, HTREEITEM item)
    TreeView_Expand(handle, item, TVE_COLLAPSE);
 }
 
+/*
+ * Marks a tree item as having children that are inserted on demand.
+ * The item shows an expander, and the DW_SIGNAL_TREE_EXPAND handler
+ * inserts the children when the item is expanded the first time.
+ * The handler is also called on later expands, even if the children exist.
+ * Parameters:
+ *       handle: Handle to the tree window (widget).
+ *       item: Handle to the node to be marked.
+ *       flags: DW_TREE_LAZY, DW_TREE_LAZY_DROP to also delete the children
+ *              when the node is collapsed, or 0 to turn it off.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_tree_item_set_lazy(HWND handle, HTREEITEM item, int flags)
+{
+   return DW_ERROR_GENERAL;
+}
+
 /*
  * Removes a node from a tree.
  * Parameters:
@@ -10220,6 +10481,34 @@ HICN API dw_icon_load_from_file(const char *filename)
 #endif
 }
 
+/*
+ * Obtains an icon from a file and passes it to a callback.
+ * There is no background loader on this platform, so the file
+ * is loaded and the callback run on the calling thread before
+ * this function returns.
+ * Parameters:
+ *       filename: Name of the file, omit extention to have
+ *                 DW pick the appropriate file extension.
+ *                 (ICO on OS/2 or Windows, XPM on Unix)
+ *       callback: Function of the form int func(HICN icon, void *data)
+ *                 icon will be NULL if the file could not be loaded.
+ *       data: User data to be passed to the callback.
+ * Returns:
+ *       DW_ERROR_NONE once the callback has run, DW_ERROR_GENERAL on error
+ *       in which case the callback will not be called.
+ */
+int API dw_icon_load_from_file_async(const char *filename, void *callback, void *data)
+{
+   int (*iconfunc)(HICN, void *) = (int (*)(HICN, void *))callback;
+
+   if(!filename || !*filename || !callback)
+      return DW_ERROR_GENERAL;
+
+   /* No background loader on this platform, load it immediately */
+   iconfunc(dw_icon_load_from_file(filename), data);
+   return DW_ERROR_NONE;
+}
+
 /*
  * Obtains an icon from data
  * Parameters:
@@ -10864,6 +11153,231 @@ char * API dw_container_query_next(HWND handle, unsigned long flags)
    return retval;
 }
 
+/* Appends a row index to a query result, returns FALSE if it could not grow */
+static int _dw_container_index_add(void ***retval, int *rows, int *alloced, int index)
+{
+   if(*rows == *alloced)
+   {
+      int newalloced = *alloced ? *alloced * 2 : 64;
+      void **tmp = (void **)realloc(*retval, sizeof(void *) * newalloced);
+
+      if(!tmp)
+         return FALSE;
+      *retval = tmp;
+      *alloced = newalloced;
+   }
+   (*retval)[(*rows)++] = DW_INT_TO_POINTER(index);
+   return TRUE;
+}
+
+/* Returns the indexes of the matching rows for DW_CR_RETINDEX */
+static void **_dw_container_query_indexes(HWND handle, unsigned long flags, int *count)
+{
+   void **retval = NULL;
+   int rows = 0, alloced = 0, index = -1;
+
+   while((index = ListView_GetNextItem(handle, index, flags & ~(DW_CR_RETDATA | DW_CR_RETINDEX))) != -1)
+   {
+      if(!_dw_container_index_add(&retval, &rows, &alloced, index))
+         break;
+   }
+   if(!rows && retval)
+   {
+      free(retval);
+      retval = NULL;
+   }
+   if(count)
+      *count = retval ? rows : 0;
+   return retval;
+}
+
+/*
+ * Returns all matching rows of a container in one call.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       flags: DW_CRA_SELECTED or DW_CRA_CURSORED to limit the rows
+ *              returned, otherwise all rows are returned.
+ *              DW_CR_RETDATA to return the row data instead of titles.
+ *              DW_CR_RETINDEX to return zero based row indexes instead,
+ *              read each one with DW_POINTER_TO_INT().
+ *       count: Pointer to an integer to receive the number of rows.
+ * Returns:
+ *       An array of titles, data pointers or row indexes which must be
+ *       freed with dw_free(), or NULL if there are no matching rows.
+ *       Titles are copied into the same block as the array.
+ */
+void ** API dw_container_query_selected(HWND handle, unsigned long flags, int *count)
+{
+   void **retval = NULL, **tmp;
+   char *item, *buf;
+   int rows = 0, alloced = 0, z;
+   size_t size = 0;
+
+   if(flags & DW_CR_RETINDEX)
+      return _dw_container_query_indexes(handle, flags, count);
+
+   for(item = dw_container_query_start(handle, flags);item;item = dw_container_query_next(handle, flags))
+   {
+      if(rows == alloced)
+      {
+         alloced = alloced ? alloced * 2 : 64;
+         if(!(tmp = (void **)realloc(retval, sizeof(void *) * alloced)))
+         {
+            if(!(flags & DW_CR_RETDATA))
+               dw_free(item);
+            break;
+         }
+         retval = tmp;
+      }
+      if(!(flags & DW_CR_RETDATA))
+         size += strlen(item) + 1;
+      retval[rows++] = item;
+   }
+   /* Pack the titles after the array so one dw_free() releases everything */
+   if(retval && !(flags & DW_CR_RETDATA))
+   {
+      tmp = rows > 0 ? (void **)malloc((sizeof(void *) * rows) + size) : NULL;
+      buf = tmp ? (char *)&tmp[rows] : NULL;
+
+      for(z=0;z<rows;z++)
+      {
+         if(buf)
+         {
+            size_t len = strlen((char *)retval[z]) + 1;
+
+            memcpy(buf, retval[z], len);
+            tmp[z] = buf;
+            buf += len;
+         }
+         dw_free(retval[z]);
+      }
+      free(retval);
+      retval = tmp;
+   }
+   if(!rows && retval)
+   {
+      free(retval);
+      retval = NULL;
+   }
+   if(count)
+      *count = retval ? rows : 0;
+   return retval;
+}
+
+/* Container iterator state, the matching rows are walked once when
+ * the iteration starts, keeping a copy of each title with its data.
+ */
+typedef struct _dwcontiter {
+   char **titles;
+   void **data;
+   int count, alloced, pos;
+} DWContIter;
+
+/* Adds a row to an iterator, returns FALSE if the arrays could not grow */
+static int _dw_container_iter_add(DWContIter *it, const char *title, void *data)
+{
+   if(it->count == it->alloced)
+   {
+      int alloced = it->alloced ? it->alloced * 2 : 64;
+      char **titles = (char **)realloc(it->titles, sizeof(char *) * alloced);
+      void **newdata;
+
+      if(titles)
+         it->titles = titles;
+      if(!titles || !(newdata = (void **)realloc(it->data, sizeof(void *) * alloced)))
+         return FALSE;
+      it->data = newdata;
+      it->alloced = alloced;
+   }
+   it->titles[it->count] = title ? _strdup(title) : NULL;
+   it->data[it->count++] = data;
+   return TRUE;
+}
+
+/*
+ * Starts iterating the rows of a container.
+ * Parameters:
+ *       handle: Handle to the window (widget) to be queried.
+ *       flags: DW_CRA_SELECTED or DW_CRA_CURSORED to limit the rows
+ *              returned, otherwise all rows are returned.
+ * Returns:
+ *       An iterator handle to pass to dw_container_iter_next() and
+ *       dw_container_iter_end(), or NULL on error.
+ */
+HCONTITER API dw_container_iter_begin(HWND handle, unsigned long flags)
+{
+   DWContIter *it = (DWContIter *)calloc(1, sizeof(DWContIter));
+   int index = -1;
+
+   /* Walk the list view directly, the title and data come from the same row */
+   while(it && (index = ListView_GetNextItem(handle, index, flags & ~DW_CR_RETDATA)) != -1)
+   {
+      LV_ITEM lvi;
+      void **params;
+
+      memset(&lvi, 0, sizeof(LV_ITEM));
+
+      lvi.iItem = index;
+      lvi.mask = LVIF_PARAM;
+
+      ListView_GetItem(handle, &lvi);
+      params = (void **)lvi.lParam;
+
+      if(!_dw_container_iter_add(it, params ? (char *)params[_DW_DATA_TYPE_STRING] : NULL,
+                                 params ? params[_DW_DATA_TYPE_POINTER] : NULL))
+         break;
+   }
+   return (HCONTITER)it;
+}
+
+/*
+ * Moves a container iterator to the next row.  The title and data are
+ * borrowed from the container and are valid until the next call.
+ * Parameters:
+ *       iter: Iterator handle returned by dw_container_iter_begin().
+ *       title: Pointer to receive the row title or NULL.
+ *       data: Pointer to receive the row data or NULL.
+ * Returns:
+ *       TRUE if a row was returned, FALSE at the end of the rows.
+ */
+int API dw_container_iter_next(HCONTITER iter, const char **title, void **data)
+{
+   DWContIter *it = (DWContIter *)iter;
+
+   if(it && it->pos < it->count)
+   {
+      if(title)
+         *title = it->titles[it->pos];
+      if(data)
+         *data = it->data[it->pos];
+      it->pos++;
+      return TRUE;
+   }
+   return FALSE;
+}
+
+/*
+ * Finishes a container iteration and frees the iterator.
+ * Parameters:
+ *       iter: Iterator handle returned by dw_container_iter_begin().
+ */
+void API dw_container_iter_end(HCONTITER iter)
+{
+   DWContIter *it = (DWContIter *)iter;
+
+   if(it)
+   {
+      int z;
+
+      for(z=0;z<it->count;z++)
+         free(it->titles[z]);
+      free(it->titles);
+      free(it->data);
+      free(it);
+   }
+}
+
+
 /*
  * Cursors the item with the text speficied, and scrolls to that item.
  * Parameters:
@@ -11093,6 +11607,73 @@ void API dw_container_optimize(HWND handle)
    }
 }
 
+/*
+ * Sorts the rows of a container by the contents of a column,
+ * rows with equal values keep their order.  Rows added later
+ * are not sorted.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based column to sort by.
+ *          order: DW_SORT_ASCENDING or DW_SORT_DESCENDING.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_container_sort(HWND handle, int column, int order)
+{
+   return DW_ERROR_GENERAL;
+}
+
+/*
+ * Sets whether clicking a column heading sorts the container by
+ * that column, clicking the same heading again reverses the order.
+ * The column click signal handler is called after the rows are sorted.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          sortable: TRUE to sort on heading clicks, FALSE to leave it to the application.
+ */
+void API dw_container_set_sortable(HWND handle, int sortable)
+{
+}
+
+/*
+ * Shows only the rows of a container whose text in a column contains
+ * the filter text, ignoring case unless DW_FILTER_CASESENSITIVE is set.
+ * Rows hidden by the filter are still returned by queries of all rows,
+ * and row numbers passed to other functions count hidden rows.
+ * Parameters:
+ *          handle: Handle to the container window (widget).
+ *          column: Zero based string column to filter on.
+ *          text: Text the column must contain, NULL or "" shows all rows.
+ *          flags: DW_FILTER_CASESENSITIVE or 0.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_container_set_filter(HWND handle, int column, const char *text, unsigned long flags)
+{
+   return DW_ERROR_GENERAL;
+}
+
+/*
+ * Stops the container from updating while many rows are changed.
+ * Calls may be nested, the view updates after the last thaw.
+ * Parameters:
+ *       handle: Handle to the container to freeze.
+ */
+void API dw_container_freeze(HWND handle)
+{
+   _dw_freeze_redraw(handle, TRUE);
+}
+
+/*
+ * Resumes updating of a frozen container, showing all the changes at once.
+ * Parameters:
+ *       handle: Handle to the container to thaw.
+ */
+void API dw_container_thaw(HWND handle)
+{
+   _dw_freeze_redraw(handle, FALSE);
+}
+
 /*
  * Inserts an icon into the taskbar.
  * Parameters:
@@ -11752,6 +12333,34 @@ void API dw_font_text_extents_get(HWND handle, HPIXMAP pixmap, const char *text,
       ReleaseDC(handle, hdc);
 }
 
+/* Query the width and height of multiple text strings at once.
+ * Parameters:
+ *       handle: Handle to the window.
+ *       pixmap: Handle to the pixmap. (choose only one of these)
+ *       count: Number of strings in the texts array.
+ *       texts: Array of text strings to be queried, NULL entries
+ *              get a width and height of 0.
+ *       widths: Array of count integers to be filled in with the widths, or NULL.
+ *       heights: Array of count integers to be filled in with the heights, or NULL.
+ */
+void API dw_font_text_extents_get_many(HWND handle, HPIXMAP pixmap, int count, char **texts, int *widths, int *heights)
+{
+   int z;
+
+   for(z=0;texts && z<count;z++)
+   {
+      if(texts[z])
+         dw_font_text_extents_get(handle, pixmap, texts[z], widths ? &widths[z] : NULL, heights ? &heights[z] : NULL);
+      else
+      {
+         if(widths)
+            widths[z] = 0;
+         if(heights)
+            heights[z] = 0;
+      }
+   }
+}
+
 /* Call this after drawing to the screen to make sure
  * anything you have drawn is visible.
  */
@@ -11909,6 +12518,35 @@ HPIXMAP API dw_pixmap_new_from_file(HWND handle, const char *filename)
    return pixmap;
 }
 
+/*
+ * Creates a pixmap from a file and passes it to a callback.
+ * There is no background loader on this platform, so the file
+ * is loaded and the callback run on the calling thread before
+ * this function returns.
+ * Parameters:
+ *       handle: Window handle the pixmap is associated with.
+ *       filename: Name of the file, omit extention to have
+ *                 DW pick the appropriate file extension.
+ *                 (BMP on OS/2 or Windows, XPM on Unix)
+ *       callback: Function of the form int func(HPIXMAP pixmap, void *data)
+ *                 pixmap will be NULL if the file could not be loaded.
+ *       data: User data to be passed to the callback.
+ * Returns:
+ *       DW_ERROR_NONE once the callback has run, DW_ERROR_GENERAL on error
+ *       in which case the callback will not be called.
+ */
+int API dw_pixmap_new_from_file_async(HWND handle, const char *filename, void *callback, void *data)
+{
+   int (*pixmapfunc)(HPIXMAP, void *) = (int (*)(HPIXMAP, void *))callback;
+
+   if(!filename || !*filename || !callback)
+      return DW_ERROR_GENERAL;
+
+   /* No background loader on this platform, load it immediately */
+   pixmapfunc(dw_pixmap_new_from_file(handle, filename), data);
+   return DW_ERROR_NONE;
+}
+
 /*
  * Creates a pixmap from memory.
  * Parameters:
@@ -14157,3 +14795,32 @@ int API dw_feature_set(DWFEATURE feature, int state)
     }
 }
 
+/*
+ * Writes the data recorded while DW_FEATURE_TRACE was enabled.
+ * Parameters:
+ *       filename: Name of the file to write, or NULL for stderr.
+ *       flags: DW_TRACE_DUMP_JSON to write Chrome trace event JSON instead
+ *              of a table of statistics per function.
+ *              DW_TRACE_DUMP_RESET to clear the data after writing it.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_trace_dump(const char *filename, unsigned long flags)
+{
+   return DW_ERROR_GENERAL;
+}
+
+/*
+ * Returns the handler timings recorded while DW_FEATURE_SIGNAL_PROFILE
+ * was enabled.  Timer callbacks are recorded as the "timer" signal.
+ * Parameters:
+ *       signame: Name of the signal to query, or NULL for all signals.
+ *       stats: Pointer to a DWSignalStats structure to fill in.
+ * Returns:
+ *       DW_ERROR_NONE (0) on success.
+ */
+int API dw_signal_stats_get(const char *signame, DWSignalStats *stats)
+{
+   return DW_ERROR_GENERAL;
+}
+